@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <sys/mman.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -54,7 +55,8 @@ static const int isBigBuff = 0x40000000;
 /******************************************************************************/
 
 XrdBuffXL::XrdBuffXL() : bucket(0), totalo(0), pagsz(getpagesize()), slots(0),
-                         maxsz(1<<(XRD_BUSHIFT+XRD_BUCKETS-1)), totreq(0)
+                         maxsz(1<<(XRD_BUSHIFT+XRD_BUCKETS-1)), totreq(0),
+                         hugesz(0)
 { }
 
 /******************************************************************************/
@@ -130,9 +132,18 @@ XrdBuffer *XrdBuffXL::Obtain(int sz)
 //
    if (bp) return bp;
 
-// Allocate a chunk of aligned memory
+// Allocate a chunk of aligned memory. When hugepages are wanted a buffer that
+// is a multiple of the hugepage size (normally all of them) is aligned to a
+// hugepage so that it can be backed by transparent hugepages.
 //
-   if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;
+   if (hugesz && !(buffSz % hugesz))
+      {if (posix_memalign((void **)&memp, hugesz, buffSz)) return 0;
+#ifdef MADV_HUGEPAGE
+       madvise(memp, buffSz, MADV_HUGEPAGE);
+#endif
+      } else {
+       if (posix_memalign((void **)&memp, pagsz, buffSz)) return 0;
+      }
 
 // Wrap the memory with a buffer object
 //
@@ -48,6 +48,8 @@ void        Release(XrdBuffer *bp);
 
 int         MaxSize() {return maxsz;}
 
+void        SetHuge(int hpsz) {hugesz = hpsz;}
+
 void        Trim();
 
 int         Stats(char *buff, int blen, int do_sync=0);
@@ -76,5 +78,6 @@ const  int        pagsz;
        int        maxsz;
        int        totreq;
        int        totbuf;
+       int        hugesz;
 };
 #endif
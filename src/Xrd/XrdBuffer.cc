@@ -27,10 +27,16 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+
+#include <cctype>
 #include <ctime>
 #include <unistd.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -52,6 +58,41 @@ void *XrdReshaper(void *pp)
      return (void *)0;
 }
 
+/******************************************************************************/
+/*                      C l a s s   X r d B u f f M a g                       */
+/******************************************************************************/
+
+// A magazine is a small per-thread cache of free buffers for the smaller
+// buckets. Buffers are handed out and taken back by the magazine without any
+// locking. An empty magazine is refilled from the thread's pool and a full one
+// returns half of its buffers to it, in both cases with a single lock. The
+// requests are counted locally and periodically published to the pool so that
+// the reshaper still sees the real request profile. As the reshaper cannot
+// trim magazines, a thread only gets one if the memory its magazine may hold
+// fits into the share of the pool's memory set aside for magazines.
+//
+class XrdBuffMag
+{
+public:
+
+XrdBuffManager *owner;              // Pool manager this magazine belongs to
+long long       resv;               // Bytes reserved for it, 0 if unusable
+int             node;               // Pool all of the buffers belong to
+int             npend;              // Requests not yet published
+int             nhit;               // Requests not yet published that hit
+int             nreq[XRD_BUCKETS];  // Requests not yet published per bucket
+int             numbuf[XRD_BUCKETS];
+XrdBuffer      *bnext[XRD_BUCKETS];
+
+                XrdBuffMag() : owner(0), resv(0), node(0), npend(0), nhit(0)
+                             {memset(nreq,   0, sizeof(nreq));
+                              memset(numbuf, 0, sizeof(numbuf));
+                              memset(bnext,  0, sizeof(bnext));
+                             }
+
+               ~XrdBuffMag() {if (owner) owner->Retire(*this);}
+};
+
 /******************************************************************************/
 /*                               G l o b a l s                                */
 /******************************************************************************/
@@ -61,6 +102,12 @@ const char *XrdBuffManager::TraceID = "BuffManager";
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+static const int magBytes  = 64*1024; // Magazine memory unit per bucket
+static const int magDflt   = 4;       // Default magazine size
+static const int magShare  = 8;       // 1/magShare of the memory is for them
+static const int maxPend   = 64;      // Local requests before publishing them
+
+thread_local XrdBuffMag myMag;
 }
 
 namespace XrdGlobal
@@ -70,6 +117,110 @@ extern XrdSysError Log;
 }
 
 using namespace XrdGlobal;
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+/******************************************************************************/
+/*                                 A l l o c                                  */
+/******************************************************************************/
+
+// Allocate buffer memory. Buffers that are a multiple of the hugepage size are
+// aligned to it and the kernel is asked to back them by transparent hugepages.
+//
+char *Alloc(int bsz, int align, int hpsz)
+{
+   char *memp;
+
+   if (hpsz && bsz >= hpsz && !(bsz % hpsz)) align = hpsz;
+      else hpsz = 0;
+   if (posix_memalign((void **)&memp, align, bsz)) return 0;
+#ifdef MADV_HUGEPAGE
+   if (hpsz) madvise(memp, bsz, MADV_HUGEPAGE);
+#endif
+   return memp;
+}
+
+/******************************************************************************/
+/*                              H u g e S i z e                               */
+/******************************************************************************/
+
+// Return the transparent hugepage size or 0 if hugepages are not supported.
+//
+int HugeSize()
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+   long long hpsz = 0;
+   FILE *fP;
+
+   if (!(fP = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size","r")))
+      return 0;
+   if (fscanf(fP, "%lld", &hpsz) != 1) hpsz = 0;
+   fclose(fP);
+   return (hpsz > 0 && hpsz <= 1024*1024*1024 ? static_cast<int>(hpsz) : 0);
+#else
+   return 0;
+#endif
+}
+
+/******************************************************************************/
+/*                              M a g S i z e                                 */
+/******************************************************************************/
+
+// Size the magazine of each bucket. A magazine holds at most magsz buffers and
+// at most magsz*magBytes bytes so that the larger buckets get few or none.
+//
+void MagSize(int *magMax, int slots, int magsz)
+{
+   int bsz;
+
+   for (int i = 0; i < slots; i++)
+       {bsz = minBuffSz << i;
+        magMax[i] = (bsz <= magBytes ? magsz
+                    : static_cast<int>((static_cast<long long>(magsz)*magBytes)/bsz));
+       }
+}
+
+/******************************************************************************/
+/*                              M a p N o d e s                               */
+/******************************************************************************/
+
+// Record the NUMA node of each cpu and return the number of nodes. Nodes
+// beyond the number of pools we support share pools.
+//
+int MapNodes(signed char *cpuNode, int maxcpu)
+{
+#ifdef __linux__
+   struct dirent *dP;
+   DIR  *dirP;
+   char  path[80];
+   long  ncpu = sysconf(_SC_NPROCESSORS_CONF);
+   int   node, nodes = 1;
+
+   if (ncpu > 0 && ncpu < maxcpu) maxcpu = static_cast<int>(ncpu);
+
+   for (int cpu = 0; cpu < maxcpu; cpu++)
+       {snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+        if (!(dirP = opendir(path))) continue;
+        while((dP = readdir(dirP)))
+             if (!strncmp(dP->d_name, "node", 4)
+             &&  isdigit(static_cast<unsigned char>(dP->d_name[4])))
+                {node = atoi(dP->d_name+4) % XRD_BUPOOLS;
+                 cpuNode[cpu] = static_cast<signed char>(node);
+                 if (node >= nodes) nodes = node+1;
+                 break;
+                }
+        closedir(dirP);
+       }
+   return nodes;
+#else
+   return 1;
+#endif
+}
+}
  
 /******************************************************************************/
 /*                           C o n s t r u c t o r                            */
@@ -86,9 +237,9 @@ XrdBuffManager::XrdBuffManager(int minrst) :
 // Clear everything to zero
 //
    totbuf   = 0;
-   totreq   = 0;
    totalo   = 0;
    totadj   = 0;
+   magalo   = 0;
 #ifdef _SC_PHYS_PAGES
    maxalo   = static_cast<long long>(pagsz)/8
               * static_cast<long long>(sysconf(_SC_PHYS_PAGES));
@@ -97,7 +248,18 @@ XrdBuffManager::XrdBuffManager(int minrst) :
 #endif
    rsinprog = 0;
    minrsw   = minrst;
-   memset(static_cast<void *>(bucket), 0, sizeof(bucket));
+   for (int i = 0; i < XRD_BUPOOLS; i++)
+       {memset(static_cast<void *>(pool[i].bucket), 0, sizeof(pool[i].bucket));
+        pool[i].totreq = 0;
+        pool[i].lclreq = pool[i].lclhit = 0;
+       }
+   memset(cpuNode, 0, sizeof(cpuNode));
+
+// By default there is a single pool and magazines are used
+//
+   numPools = 1;
+   hugesz   = 0;
+   MagSize(magMax, slots, magDflt);
 }
 
 /******************************************************************************/
@@ -108,12 +270,13 @@ XrdBuffManager::~XrdBuffManager()
 {
    XrdBuffer *bP;
 
+   for (int p = 0; p < XRD_BUPOOLS; p++)
    for (int i = 0; i < XRD_BUCKETS; i++)
-       {while((bP = bucket[i].bnext))
-             {bucket[i].bnext = bP->next;
+       {while((bP = pool[p].bucket[i].bnext))
+             {pool[p].bucket[i].bnext = bP->next;
               delete bP;
              }
-        bucket[i].numbuf = 0;
+        pool[p].bucket[i].numbuf = 0;
        }
 }
 
@@ -139,9 +302,11 @@ void XrdBuffManager::Init()
   
 XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
-   XrdBuffer *bp;
+   XrdBuffMag *mP;
+   XrdBuffer *bp, *tp;
+   BuckPool *pP;
    char *memp;
-   int mk, pk, bindex;
+   int mk, pk, bindex, node;
 
 // Make sure the request is within our limits
 //
@@ -156,14 +321,49 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
-// Obtain a lock on the bucket array and try to give away an existing buffer
+// If the bucket has a magazine, try to give away a buffer from it. This needs
+// no locking at all. If the magazine is empty refill it from the pool.
 //
-    Reshaper.Lock();
-    totreq++;
-    bucket[bindex].numreq++;
-    if ((bp = bucket[bindex].bnext))
-       {bucket[bindex].bnext = bp->next; bucket[bindex].numbuf--;}
-    Reshaper.UnLock();
+   if (magMax[bindex] && (mP = getMag()))
+      {mP->nreq[bindex]++;
+       mP->npend++;
+       if ((bp = mP->bnext[bindex]))
+          {mP->bnext[bindex] = bp->next; mP->numbuf[bindex]--;
+           mP->nhit++;
+           if (mP->npend >= maxPend)
+              {pP = &pool[mP->node];
+               pP->bLock.Lock(); Publish(*mP); pP->bLock.UnLock();
+              }
+           return bp;
+          }
+       if ((node = getNode()) != mP->node) {Drain(*mP); mP->node = node;}
+       pP = &pool[node];
+       pP->bLock.Lock();
+       Publish(*mP);
+       if ((bp = pP->bucket[bindex].bnext))
+          {pP->bucket[bindex].bnext = bp->next; pP->bucket[bindex].numbuf--;
+           for (int n = magMax[bindex]/2; n > 0; n--)
+               {if (!(tp = pP->bucket[bindex].bnext)) break;
+                pP->bucket[bindex].bnext = tp->next;
+                pP->bucket[bindex].numbuf--;
+                tp->next = mP->bnext[bindex]; mP->bnext[bindex] = tp;
+                mP->numbuf[bindex]++;
+               }
+          }
+       pP->bLock.UnLock();
+      } else {
+
+// Obtain a lock on the pool and try to give away an existing buffer
+//
+       node = getNode();
+       pP = &pool[node];
+       pP->bLock.Lock();
+       pP->totreq++;
+       pP->bucket[bindex].numreq++;
+       if ((bp = pP->bucket[bindex].bnext))
+          {pP->bucket[bindex].bnext = bp->next; pP->bucket[bindex].numbuf--;}
+       pP->bLock.UnLock();
+      }
 
 // Check if we really allocated a buffer
 //
@@ -172,11 +372,12 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
 // Allocate a chunk of aligned memory
 //
    pk = (mk < pagsz ? mk : pagsz);
-   if (posix_memalign((void **)&memp, pk, mk)) return 0;
+   if (!(memp = Alloc(mk, pk, hugesz))) return 0;
 
 // Wrap the memory with a buffer object
 //
    if (!(bp = new XrdBuffer(memp, mk, bindex))) {free(memp); return 0;}
+   bp->bnode = node;
 
 // Update statistics
 //
@@ -220,19 +421,39 @@ int XrdBuffManager::Recalc(int sz)
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
-   int bindex = bp->bindex;
+   XrdBuffMag *mP;
+   XrdBuffer  *tp, *hp = bp;
+   BuckPool   *pP = &pool[bp->bnode];
+   int bindex = bp->bindex, numrel = 1;
 
 // Check if we should release this via the big buffer object
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
-// Obtain a lock on the bucket array and reclaim the buffer
+// If the buffer belongs in the thread's magazine keep it there if there is
+// room. Otherwise, return it together with half of the magazine to the pool.
 //
-    Reshaper.Lock();
-    bp->next = bucket[bp->bindex].bnext;
-    bucket[bp->bindex].bnext = bp;
-    bucket[bindex].numbuf++;
-    Reshaper.UnLock();
+   if (magMax[bindex] && (mP = getMag()) && bp->bnode == mP->node)
+      {if (mP->numbuf[bindex] < magMax[bindex])
+          {bp->next = mP->bnext[bindex]; mP->bnext[bindex] = bp;
+           mP->numbuf[bindex]++;
+           return;
+          }
+       for (int n = magMax[bindex]/2; n > 0; n--)
+           {if (!(tp = mP->bnext[bindex])) break;
+            mP->bnext[bindex] = tp->next; mP->numbuf[bindex]--;
+            tp->next = hp; hp = tp; numrel++;
+           }
+       pP->bLock.Lock();
+       Publish(*mP);
+      } else pP->bLock.Lock();
+
+// We have a lock on the buffer's pool, reclaim the buffers
+//
+    bp->next = pP->bucket[bindex].bnext;
+    pP->bucket[bindex].bnext = hp;
+    pP->bucket[bindex].numbuf += numrel;
+    pP->bLock.UnLock();
 }
  
 /******************************************************************************/
@@ -241,12 +462,11 @@ void XrdBuffManager::Release(XrdBuffer *bp)
   
 void XrdBuffManager::Reshape()
 {
-int i, bufprof[XRD_BUCKETS], numfreed;
+int i, p, bufprof[XRD_BUCKETS], numreq[XRD_BUCKETS], numbuf, numfreed;
 time_t delta, lastshape = time(0);
-long long memslot, memhave, memtarget = (long long)(.80*(float)maxalo);
+long long memfreed, memhave, memtarget = (long long)(.80*(float)maxalo);
 XrdSysTimer Timer;
 float requests, buffers;
-XrdBuffer *bp;
 
 // This is an endless loop to periodically reshape the buffer pool
 //
@@ -259,39 +479,52 @@ while(1)
           Timer.Wait((minrsw-delta)*1000);
           Reshaper.Lock();
          }
+      buffers = (float)totbuf; memhave = totalo;
+      Reshaper.UnLock();
 
-      // We have the lock so compute the request profile
+      // Compute the request profile across all of the pools
       //
-      if (totreq > slots)
-         {requests = (float)totreq;
-          buffers  = (float)totbuf;
-          for (i = 0; i < slots; i++)
-              {bufprof[i] = (int)(buffers*(((float)bucket[i].numreq)/requests));
-               bucket[i].numreq = 0;
+      requests = 0;
+      for (p = 0; p < numPools; p++)
+          {pool[p].bLock.Lock();
+           requests += (float)pool[p].totreq;
+           pool[p].bLock.UnLock();
+          }
+      if (requests > (float)slots)
+         {memset(numreq, 0, sizeof(numreq));
+          for (p = 0; p < numPools; p++)
+              {pool[p].bLock.Lock();
+               for (i = 0; i < slots; i++)
+                   {numreq[i] += pool[p].bucket[i].numreq;
+                    pool[p].bucket[i].numreq = 0;
+                   }
+               pool[p].totreq = 0;
+               pool[p].bLock.UnLock();
               }
-          totreq = 0; memhave = totalo;
+          for (i = 0; i < slots; i++)
+              bufprof[i] = (int)(buffers*(((float)numreq[i])/requests));
          } else memhave = 0;
-      Reshaper.UnLock();
 
       // Reshape the buffer pool to agree with the request profile
       //
-      memslot = maxsz; numfreed = 0;
+      memfreed = 0; numfreed = 0;
       for (i = slots-1; i >= 0 && memhave > memtarget; i--)
-          {Reshaper.Lock();
-           while(bucket[i].numbuf > bufprof[i])
-                if ((bp = bucket[i].bnext))
-                   {bucket[i].bnext = bp->next;
-                    delete bp;
-                    bucket[i].numbuf--; numfreed++;
-                    memhave -= memslot; totalo  -= memslot;
-                    totbuf--;
-                   } else {bucket[i].numbuf = 0; break;}
-           Reshaper.UnLock();
-           memslot = memslot>>1;
+          {numbuf = 0;
+           for (p = 0; p < numPools; p++)
+               {pool[p].bLock.Lock();
+                numbuf += pool[p].bucket[i].numbuf;
+                pool[p].bLock.UnLock();
+               }
+           if (numbuf > bufprof[i])
+              numfreed += Trim(i, numbuf - bufprof[i], memfreed);
+           memhave -= memfreed;
+           Reshaper.Lock(); totalo -= memfreed; Reshaper.UnLock();
+           memfreed = 0;
           }
 
        // All done
        //
+       Reshaper.Lock(); totbuf -= numfreed; Reshaper.UnLock();
        totadj += numfreed;
        TRACE(MEM, "Pool reshaped; " <<numfreed <<" freed; have " <<(memhave>>10) <<"K; target " <<(memtarget>>10) <<"K");
        lastshape = time(0);
@@ -315,6 +548,36 @@ void XrdBuffManager::Set(int maxmem, int minw)
    if (minw   > 0) minrsw = minw;
    Reshaper.UnLock();
 }
+
+/******************************************************************************/
+/*                               S e t O p t s                                */
+/******************************************************************************/
+
+void XrdBuffManager::SetOpts(int magsz, int opts)
+{
+
+// Size the magazines, if so wanted
+//
+   if (magsz >= 0) MagSize(magMax, slots, magsz);
+
+// Setup a pool per NUMA node if so wanted
+//
+   numPools = 1;
+   if (opts & useNuma)
+      {numPools = MapNodes(cpuNode, sizeof(cpuNode));
+       if (numPools < 2)
+          Log.Say("Config warning: only one NUMA node found; "
+                  "buffer numa option ignored.");
+      }
+
+// Use hugepages for hugepage sized buffers if so wanted
+//
+   hugesz = 0;
+   if ((opts & useHuge) && !(hugesz = HugeSize()))
+      Log.Say("Config warning: hugepages are not supported; "
+              "buffer hugepages option ignored.");
+   xlBuff.SetHuge(hugesz);
+}
  
 /******************************************************************************/
 /*                                 S t a t s                                  */
@@ -323,19 +586,183 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static const char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>"
+                "<lreqs>%lld</lreqs><lhits>%lld</lhits>%s</stats>";
     char xlStats[1024];
-    int nlen;
+    long long lclreq = 0, lclhit = 0;
+    int nlen, totreq = 0;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*6 + xlBuff.Stats(0,0);
+
+// Sum up the request counts of each pool. Requests satisfied by a magazine
+// are counted when the magazine publishes them, so they lag a bit.
+//
+   for (int p = 0; p < numPools; p++)
+       {if (do_sync) pool[p].bLock.Lock();
+        totreq += pool[p].totreq;
+        lclreq += pool[p].lclreq;
+        lclhit += pool[p].lclhit;
+        if (do_sync) pool[p].bLock.UnLock();
+       }
 
 // Return formatted stats
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   nlen = snprintf(buff, blen, statfmt, totreq, totalo, totbuf, totadj,
+                   lclreq, lclhit, xlStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+// Return all of the buffers in a magazine to its pool. This is done when the
+// thread moved to another NUMA node and when the thread exits.
+//
+void XrdBuffManager::Drain(XrdBuffMag &mag)
+{
+   BuckPool  *pP = &pool[mag.node];
+   XrdBuffer *bp;
+
+   pP->bLock.Lock();
+   Publish(mag);
+   for (int i = 0; i < XRD_BUCKETS; i++)
+       {while((bp = mag.bnext[i]))
+             {mag.bnext[i] = bp->next;
+              bp->next = pP->bucket[i].bnext;
+              pP->bucket[i].bnext = bp;
+              pP->bucket[i].numbuf++;
+             }
+        mag.numbuf[i] = 0;
+       }
+   pP->bLock.UnLock();
+}
+
+/******************************************************************************/
+/*                                g e t M a g                                 */
+/******************************************************************************/
+
+// Return the calling thread's magazine or nil if the thread already uses the
+// magazine for a different buffer manager or it could not have one.
+//
+XrdBuffMag *XrdBuffManager::getMag()
+{
+   XrdBuffMag *mP = &myMag;
+   long long need = 0;
+
+// If the magazine is already ours, we are done
+//
+   if (mP->owner == this) return (mP->resv ? mP : 0);
+   if (mP->owner) return 0;
+
+// Reserve the most memory the magazine can hold. Should that exceed what is
+// left of the magazine share of the memory, the thread goes without one.
+//
+   for (int i = 0; i < slots; i++)
+       need += static_cast<long long>(magMax[i]) * (minBuffSz << i);
+   Reshaper.Lock();
+   if (magalo + need <= maxalo/magShare) {magalo += need; mP->resv = need;}
+   Reshaper.UnLock();
+   if (!mP->resv) TRACE(MEM, "Magazine memory limit reached; thread has none");
+
+   mP->owner = this;
+   mP->node  = getNode();
+   return (mP->resv ? mP : 0);
+}
+
+/******************************************************************************/
+/*                               g e t N o d e                                */
+/******************************************************************************/
+
+// Return the index of the pool of the NUMA node the thread is running on.
+//
+int XrdBuffManager::getNode()
+{
+#ifdef __linux__
+   if (numPools > 1)
+      {int cpu = sched_getcpu();
+       if (cpu >= 0 && cpu < static_cast<int>(sizeof(cpuNode)))
+          return cpuNode[cpu];
+      }
+#endif
+   return 0;
+}
+
+/******************************************************************************/
+/*                               P u b l i s h                                */
+/******************************************************************************/
+
+// Add the request counts of a magazine to those of its pool. The caller must
+// hold the pool's lock.
+//
+void XrdBuffManager::Publish(XrdBuffMag &mag)
+{
+   BuckPool *pP = &pool[mag.node];
+
+   for (int i = 0; i < XRD_BUCKETS; i++)
+       if (mag.nreq[i])
+          {pP->bucket[i].numreq += mag.nreq[i]; mag.nreq[i] = 0;}
+   pP->totreq += mag.npend;
+   pP->lclreq += mag.npend;
+   pP->lclhit += mag.nhit;
+   mag.npend = mag.nhit = 0;
+}
+
+/******************************************************************************/
+/*                                R e t i r e                                 */
+/******************************************************************************/
+
+// Return the buffers of an exiting thread's magazine and its reservation.
+//
+void XrdBuffManager::Retire(XrdBuffMag &mag)
+{
+   Drain(mag);
+   if (mag.resv)
+      {Reshaper.Lock(); magalo -= mag.resv; Reshaper.UnLock();
+       mag.resv = 0;
+      }
+}
+
+/******************************************************************************/
+/*                                  T r i m                                   */
+/******************************************************************************/
+
+// Free up to excess free buffers of a bucket, taking them from all pools, and
+// add the amount of memory freed to memfreed. Returns the number freed.
+//
+int XrdBuffManager::Trim(int bindex, int excess, long long &memfreed)
+{
+   XrdBuffer *bp, *fList = 0;
+   int numfreed = 0;
+
+// Unchain the buffers while holding the pool's lock
+//
+   for (int p = 0; p < numPools && excess > 0; p++)
+       {pool[p].bLock.Lock();
+        while(excess > 0 && (bp = pool[p].bucket[bindex].bnext))
+             {pool[p].bucket[bindex].bnext = bp->next;
+              pool[p].bucket[bindex].numbuf--;
+              bp->next = fList; fList = bp;
+              excess--;
+             }
+        pool[p].bLock.UnLock();
+       }
+
+// Now free them without holding any lock
+//
+   while((bp = fList))
+        {fList = bp->next;
+         memfreed += bp->bsize;
+         delete bp;
+         numfreed++;
+        }
+   return numfreed;
+}
@@ -46,7 +46,7 @@ char *   buff;     // -> buffer
 int      bsize;    // size of this buffer
 
          XrdBuffer(char *bp, int sz, int ix)
-                      {buff = bp; bsize = sz; bindex = ix; next = 0;}
+                      {buff = bp; bsize = sz; bindex = ix; bnode = 0; next = 0;}
 
         ~XrdBuffer() {if (buff) free(buff);}
 
@@ -55,6 +55,7 @@ int      bsize;    // size of this buffer
 private:
 
 int        bindex;
+int        bnode;
 XrdBuffer *next;
 static int pagesz;
 };
@@ -65,6 +66,9 @@ static int pagesz;
 
 #define XRD_BUCKETS 12
 #define XRD_BUSHIFT 10
+#define XRD_BUPOOLS  8
+
+class XrdBuffMag;
 
 // There should be only one instance of this class per buffer pool.
 //
@@ -72,6 +76,9 @@ class XrdBuffManager
 {
 public:
 
+static const int useNuma = 0x01; // Keep a buffer pool per NUMA node
+static const int useHuge = 0x02; // Back hugepage sized buffers by hugepages
+
 void        Init();
 
 XrdBuffer  *Obtain(int bsz);
@@ -86,28 +93,56 @@ void        Reshape();
 
 void        Set(int maxmem=-1, int minw=-1);
 
+// Set the per-thread magazine size (the maximum number of small buffers a
+// thread caches per bucket, 0 turns magazines off) and the pool options.
+// This must be called before Init() and before any buffer is obtained.
+//
+void        SetOpts(int magsz, int opts);
+
 int         Stats(char *buff, int blen, int do_sync=0);
 
             XrdBuffManager(int minrst=20*60);
 
            ~XrdBuffManager();   // The buffmanager is never deleted
 
+friend class XrdBuffMag;
 private:
 
+void        Drain(XrdBuffMag &mag);
+XrdBuffMag *getMag();
+int         getNode();
+void        Publish(XrdBuffMag &mag);
+void        Retire(XrdBuffMag &mag);
+int         Trim(int bindex, int excess, long long &memfreed);
+
 const int  slots;
 const int  shift;
 const int  pagsz;
 const int  maxsz;
 
-struct {XrdBuffer *bnext;
-        int         numbuf;
-        int         numreq;
-       } bucket[XRD_BUCKETS];          // 1K to 1<<(szshift+slots-1)M buffers
+// Each pool has its own lock and is normally used by the threads running on
+// a single NUMA node. Without NUMA support there is only one pool.
+//
+struct alignas(64) BuckPool
+      {XrdSysMutex bLock;
+       struct {XrdBuffer *bnext;
+               int         numbuf;
+               int         numreq;
+              } bucket[XRD_BUCKETS];   // 1K to 1<<(szshift+slots-1)M buffers
+       int         totreq;
+       long long   lclreq;             // Requests presented to a magazine
+       long long   lclhit;             // Requests satisfied by a magazine
+      } pool[XRD_BUPOOLS];
+
+int       numPools;
+int       magMax[XRD_BUCKETS];         // Magazine capacity per bucket
+int       hugesz;
+signed char cpuNode[1024];             // cpu -> pool index
 
-int       totreq;
 int       totbuf;
 long long totalo;
 long long maxalo;
+long long magalo;                      // Memory reserved by magazines
 int       minrsw;
 int       rsinprog;
 int       totadj;
@@ -269,8 +269,14 @@ XrdConfig::XrdConfig()
    HomeMode = S_IRWXU;
    Police   = 0;
    Net_Opts = XRDNET_KEEPALIVE;
+   Net_Lstn = 1;
    TLS_Blen = 0;  // Accept OS default (leave Linux autotune in effect)
    TLS_Opts = XRDNET_KEEPALIVE | XRDNET_USETLS;
+   TLS_Lstn = 1;
+   Poll_Num = 0;  // Use the default number of pollers
+   Poll_Pin = false;
+   Log_QSz  = 0;  // Log synchronously
+   Log_Full = XrdSysLogger::asyncDrop;
    repDest[0] = 0;
    repDest[1] = 0;
    repInt     = 600;
@@ -774,6 +780,14 @@ int XrdConfig::Configure(int argc, char **argv)
                 }
       }
 
+// Switch to asynchronous logging if so wanted. We do this only now so that
+// any configuration problem is reported before we could possibly exit.
+//
+   if (Log_QSz && !NoGo
+   &&  !Log.logger()->setAsync(Log_QSz, Log_Full))
+      Log.Emsg("Config", errno, "start asynchronous log writer; "
+                                "logging synchronously.");
+
    // if we call this it means that the daemon has forked and we are
    // in the child process
 #ifndef WIN32
@@ -826,8 +840,10 @@ int XrdConfig::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest)
    TS_Xeq("adminpath",     xapath);
    TS_Xeq("allow",         xallow);
    TS_Xeq("homepath",      xhpath);
+   TS_Xeq("log",           xlog);
    TS_Xeq("maxfd",         xmaxfd);
    TS_Xeq("pidpath",       xpidf);
+   TS_Xeq("pollers",       xpoll);
    TS_Xeq("port",          xport);
    TS_Xeq("protocol",      xprot);
    TS_Xeq("report",        xrep);
@@ -937,7 +953,7 @@ int XrdConfig::ConfigProc()
 
 XrdInet *XrdConfig::getNet(int port, bool isTLS)
 {
-   int the_Opts, the_Blen;
+   int the_Opts, the_Blen, the_Lstn;
 
 // Try to find an existing network for this port
 //
@@ -952,10 +968,11 @@ XrdInet *XrdConfig::getNet(int port, bool isTLS)
 // Set options
 //
    if (isTLS)
-      {the_Opts = TLS_Opts; the_Blen = TLS_Blen;
+      {the_Opts = TLS_Opts; the_Blen = TLS_Blen; the_Lstn = TLS_Lstn;
       } else {
-       the_Opts = Net_Opts; the_Blen = Net_Blen;
+       the_Opts = Net_Opts; the_Blen = Net_Blen; the_Lstn = Net_Lstn;
       }
+   if (the_Lstn > 1) the_Opts |= XRDNET_REUSEPORT;
    if (the_Opts || the_Blen) newNet->setDefaults(the_Opts, the_Blen);
 
 // Set the domain if we have one
@@ -964,9 +981,28 @@ XrdInet *XrdConfig::getNet(int port, bool isTLS)
 
 // Attempt to bind to this socket.
 //
-   if (newNet->BindSD(port, "tcp") == 0) return newNet;
-   delete newNet;
-   return 0;
+   if (newNet->BindSD(port, "tcp") != 0) {delete newNet; return 0;}
+
+// If multiple listeners are wanted, bind additional sockets to the same port.
+// The kernel then spreads incoming connections across them and each one gets
+// its own accept thread. Failing that (e.g. the socket came from systemd) we
+// simply make do with fewer listeners.
+//
+   for (int i = 1; i < the_Lstn; i++)
+       {XrdInet *xNet = new XrdInet(&Log, Police);
+        xNet->setDefaults(the_Opts, the_Blen);
+        if (myDomain) xNet->setDomain(myDomain);
+        if (xNet->Bind(newNet->Port(), "tcp") != 0)
+           {char buff[64];
+            snprintf(buff, sizeof(buff), "%d", newNet->Port());
+            Log.Say("Config warning: unable to add listeners for port ", buff,
+                    "; using fewer listeners.");
+            delete xNet;
+            break;
+           }
+        NetTCPx.push_back(xNet);
+       }
+   return newNet;
 }
   
 /******************************************************************************/
@@ -1302,6 +1338,12 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
 //
    BuffPool.Init();
 
+// Determine the number of pollers. When they are to be pinned, the cpus are
+// split into a group per poller. The workers are pinned likewise.
+//
+   if (Poll_Num <= 0) Poll_Num = XrdPoll::Dflt();
+   if (Poll_Pin) Sched.setAffinity(Poll_Num);
+
 // Start the scheduler
 //
    Sched.Start();
@@ -1309,7 +1351,7 @@ int XrdConfig::Setup(char *dfltp, char *libProt)
 // Setup the link and socket polling infrastructure
 //
    if (!XrdLinkCtl::Setup(ProtInfo.ConnMax, ProtInfo.idleWait)
-   ||  !XrdPoll::Setup(ProtInfo.ConnMax)) return 1;
+   ||  !XrdPoll::Setup(ProtInfo.ConnMax, Poll_Num, Poll_Pin)) return 1;
 
 // Determine the default port number (only for xrootd) if not specified.
 //
@@ -1647,34 +1689,70 @@ int XrdConfig::xhpath(XrdSysError *eDest, XrdOucStream &Config)
 
 /* Function: xbuf
 
-   Purpose:  To parse the directive: buffers [maxbsz <bsz>] <memsz> [<rint>]
+   Purpose:  To parse the directive: buffers [maxbsz <bsz>] [magazine <msz>]
+                                             [numa] [hugepages]
+                                             <memsz> [<rint>]
 
              <bsz>      maximum size of an individualbuffer. The default is 2m.
                         Specify any value 2m < bsz <= 1g; if specified, it must
                         appear before the <memsz> and <memsz> becomes optional.
+             <msz>      maximum number of small buffers each thread keeps in
+                        its per-thread magazine for each buffer size. Larger
+                        buffers get proportionally fewer. Magazines together
+                        may hold at most 1/8 of <memsz>; threads beyond that
+                        go without. Specify 0 to disable magazines. The
+                        default is 4.
+             numa       keeps a separate buffer pool for each NUMA node.
+             hugepages  backs buffers that are a multiple of the hugepage size
+                        by transparent hugepages.
              <memsz>    maximum amount of memory devoted to buffers
              <rint>     minimum buffer reshape interval in seconds
 
+             Any of the options must appear before <memsz> which then becomes
+             optional.
+
    Output: 0 upon success or !0 upon failure.
 */
 int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 {
     static const long long minBSZ = 1024*1024*2+1;  // 2mb
     static const long long maxBSZ = 1024*1024*1024; // 1gb
-    int bint = -1;
+    int bint = -1, bmag = -1, bopts = 0;
+    bool haveOpt = false;
     long long blim;
     char *val;
 
     if (!(val = Config.GetWord()))
        {eDest->Emsg("Config", "buffer memory limit not specified"); return 1;}
 
-    if (!strcmp("maxbsz", val))
-       {if (!(val = Config.GetWord()))
-           {eDest->Emsg("Config", "max buffer size not specified"); return 1;}
-        if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
-           return 1;
-        XrdGlobal::xlBuff.Init(blim);
-        if (!(val = Config.GetWord())) return 0;
+    while(val)
+         {if (!strcmp("maxbsz", val))
+             {if (!(val = Config.GetWord()))
+                 {eDest->Emsg("Config", "max buffer size not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2sz(*eDest,"maxbz value",val,&blim,minBSZ,maxBSZ))
+                 return 1;
+              XrdGlobal::xlBuff.Init(blim);
+             }
+          else if (!strcmp("magazine", val))
+                  {if (!(val = Config.GetWord()))
+                      {eDest->Emsg("Config", "magazine size not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(*eDest,"magazine size",val,&bmag,0,64))
+                      return 1;
+                  }
+          else if (!strcmp("numa", val)) bopts |= XrdBuffManager::useNuma;
+          else if (!strcmp("hugepages", val)) bopts |= XrdBuffManager::useHuge;
+          else break;
+          haveOpt = true;
+          val = Config.GetWord();
+         }
+
+    if (haveOpt)
+       {BuffPool.SetOpts(bmag, bopts);
+        if (!val) return 0;
        }
 
     if (XrdOuca2x::a2sz(*eDest,"buffer limit value",val,&blim,
@@ -1689,6 +1767,74 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 }
 
 
+/******************************************************************************/
+/*                                  x l o g                                   */
+/******************************************************************************/
+
+/* Function: xlog
+
+   Purpose:  To parse the directive: log {sync | async [queue <num>]
+                                                        [full {drop | block}]}
+
+             sync      messages are written by the thread issuing them. This
+                       is the default.
+             async     messages are queued and written in batches by a
+                       background thread.
+             <num>     the maximum number of queued messages. The default is
+                       8192.
+             drop      discards messages when the queue is full and reports
+                       how many were dropped. This is the default.
+             block     makes the thread wait until there is room in the queue.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdConfig::xlog(XrdSysError *eDest, XrdOucStream &Config)
+{
+    char *val;
+    int qsz = 8192, onfull = XrdSysLogger::asyncDrop;
+
+// Get the mode
+//
+   val = Config.GetWord();
+   if (!val || !val[0])
+      {eDest->Emsg("Config", "log mode not specified"); return 1;}
+   if (!strcmp(val, "sync")) {Log_QSz = 0; return 0;}
+   if ( strcmp(val, "async"))
+      {eDest->Emsg("Config", "invalid log mode -", val); return 1;}
+
+// Process the async options
+//
+   while((val = Config.GetWord()))
+        {if (!strcmp(val, "queue"))
+            {if (!(val = Config.GetWord()))
+                {eDest->Emsg("Config", "log queue size not specified");
+                 return 1;
+                }
+             if (XrdOuca2x::a2i(*eDest,"log queue size",val,&qsz,16,1048576))
+                return 1;
+            }
+         else if (!strcmp(val, "full"))
+            {if (!(val = Config.GetWord()))
+                {eDest->Emsg("Config", "log full action not specified");
+                 return 1;
+                }
+                  if (!strcmp(val, "drop"))  onfull = XrdSysLogger::asyncDrop;
+             else if (!strcmp(val, "block")) onfull = XrdSysLogger::asyncBlock;
+             else {eDest->Emsg("Config", "invalid log full action -", val);
+                   return 1;
+                  }
+            }
+         else {eDest->Emsg("Config", "invalid log option -", val); return 1;}
+        }
+
+// Record the values
+//
+   Log_QSz  = qsz;
+   Log_Full = onfull;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                x m a x f d                                 */
 /******************************************************************************/
@@ -1738,7 +1884,7 @@ int XrdConfig::xmaxfd(XrdSysError *eDest, XrdOucStream &Config)
                                          [kaparms parms] [cache <ct>] [[no]dnr]
                                          [routes <rtype> [use <ifn1>,<ifn2>]]
                                          [[no]rpipa] [[no]dyndns]
-                                         [udprefresh <sec>]
+                                         [udprefresh <sec>] [listeners <n>]
 
              <rtype>: split | common | local
 
@@ -1753,6 +1899,11 @@ int XrdConfig::xmaxfd(XrdSysError *eDest, XrdOucStream &Config)
              [no]dyndns This network does [not] use a dynamic DNS.
              udprefresh Refreshes udp sendto addresses should they change
                         This only works for connected udp sockets.
+             listeners the number of sockets listening on each port, each with
+                       its own accept thread. When more than one, SO_REUSEPORT
+                       is used and the kernel spreads connections across them.
+                       Note that another process of the same user can then
+                       also listen on the port. The default is 1.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1762,6 +1913,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     int  i, n, V_keep = -1, V_nodnr = 0, V_istls = 0, V_blen = -1, V_ct = -1;
     int   V_assumev4 = -1, v_rpip = -1, V_dyndns = -1, V_udpref = -1;
+    int   V_lstn = -1;
     long long llp;
     struct netopts {const char *opname; int hasarg; int opval;
                            int *oploc;  const char *etxt;}
@@ -1776,6 +1928,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {"dnr",        0, 0, &V_nodnr,  "option"},
         {"nodnr",      0, 1, &V_nodnr,  "option"},
         {"dyndns",     0, 1, &V_dyndns, "option"},
+        {"listeners",  5, 0, &V_lstn,   "listeners"},
         {"nodyndns",   0, 0, &V_dyndns, "option"},
         {"routes",     3, 1, 0,         "routes"},
         {"rpipa",      0, 1, &v_rpip,   "rpipa"},
@@ -1822,6 +1975,11 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
                           ppNet = 1;
                           break;
                          }
+                      if (ntopts[i].hasarg == 5)
+                         {if (XrdOuca2x::a2i(*eDest,ntopts[i].etxt,val,&n,1,64))
+                             return 1;
+                          *ntopts[i].oploc = n;
+                         } else
                       if (ntopts[i].hasarg == 2)
                          {if (XrdOuca2x::a2tm(*eDest,ntopts[i].etxt,val,&n,0))
                              return 1;
@@ -1843,10 +2001,12 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
      if (V_istls)
         {if (V_blen >= 0) TLS_Blen = V_blen;
          if (V_keep >= 0) TLS_Opts = (V_keep  ? XRDNET_KEEPALIVE : 0);
+         if (V_lstn >= 0) TLS_Lstn = V_lstn;
          TLS_Opts |= (V_nodnr ? XRDNET_NORLKUP   : 0) | XRDNET_USETLS;
         } else {
          if (V_blen >= 0) Net_Blen = V_blen;
          if (V_keep >= 0) Net_Opts = (V_keep  ? XRDNET_KEEPALIVE : 0);
+         if (V_lstn >= 0) Net_Lstn = V_lstn;
          Net_Opts |= (V_nodnr ? XRDNET_NORLKUP   : 0);
         }
 
@@ -1943,6 +2103,57 @@ int XrdConfig::xpidf(XrdSysError *eDest, XrdOucStream &Config)
    return 0;
 }
   
+/******************************************************************************/
+/*                                 x p o l l                                  */
+/******************************************************************************/
+
+/* Function: xpoll
+
+   Purpose:  To parse the directive: pollers {<num> | cpu} [pin]
+
+             <num>     the number of poller threads to use (1 to 1024). The
+                       default is one per group of 8 cpus but at least 3.
+             cpu       uses one poller per cpu.
+             pin       pins each poller to its share of the cpus. When the
+                       scheduler uses multiple run queues, the workers of each
+                       queue are pinned likewise and each poller feeds the
+                       queue of its own cpus.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdConfig::xpoll(XrdSysError *eDest, XrdOucStream &Config)
+{
+    char *val;
+    int npoll;
+
+// Get the number of pollers
+//
+   val = Config.GetWord();
+   if (!val || !val[0])
+      {eDest->Emsg("Config", "number of pollers not specified"); return 1;}
+
+   if (!strcmp(val, "cpu"))
+      {npoll = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+       if (npoll < 1) npoll = 1;
+      }
+      else if (XrdOuca2x::a2i(*eDest,"pollers value",val,&npoll,1,1024))
+              return 1;
+
+// Check for pinning
+//
+   if ((val = Config.GetWord()))
+      {if (strcmp(val, "pin"))
+          {eDest->Emsg("Config", "invalid pollers option -", val); return 1;}
+       Poll_Pin = true;
+      } else Poll_Pin = false;
+
+// Record the values
+//
+   Poll_Num = npoll;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 x p o r t                                  */
 /******************************************************************************/
@@ -2235,6 +2446,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [queues {cpu | <nq>}]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -2251,6 +2463,10 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <nq>     The number of run queues. With more than one, each
+                      thread scheduling work feeds its own queue and idle
+                      workers steal from the others. Specify cpu to have one
+                      queue per cpu. The default is a single queue.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2260,7 +2476,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_queues = 0;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -2269,7 +2485,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"queues",     1, &V_queues, "sched queues"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -2296,6 +2513,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
                                   return 1;
                                  }
                            }
+                   else if (*scopts[i].opname == 'q' && !strcmp("cpu", val))
+                           ppp = -1;
                    else if (*scopts[i].opname == 's')
                            {if (XrdOuca2x::a2sz(*eDest, scopts[i].opmsg, val,
                                                 &lpp, scopts[i].minv)) return 1;
@@ -2328,6 +2547,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   Sched.setQueues(V_queues);
    return 0;
 }
 
@@ -2433,6 +2653,7 @@ int XrdConfig::xtcpmon(XrdSysError *eDest, XrdOucStream &Config)
              <opts>   options:
                       [no]detail       do [not] print TLS library msgs
                       hsto <sec>       handshake timeout (default 10).
+                      [no]ktls         do [not] use kernel TLS when possible.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -2462,6 +2683,8 @@ int XrdConfig::xtls(XrdSysError *eDest, XrdOucStream &Config)
 
 do {     if (!strcmp(val,   "detail")) SSLmsgs = true;
     else if (!strcmp(val, "nodetail")) SSLmsgs = false;
+    else if (!strcmp(val,   "ktls"  )) tlsOpts |=  XrdTlsContext::ktlON;
+    else if (!strcmp(val, "noktls"  )) tlsOpts &= ~XrdTlsContext::ktlON;
     else if (!strcmp(val, "hsto" ))
             {if (!(val = Config.GetWord()))
                 {eDest->Emsg("Config", "tls hsto value not specified");
@@ -58,6 +58,7 @@ int         ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest=0);
 XrdProtocol_Config    ProtInfo;
 XrdInet              *NetADM;
 std::vector<XrdInet*> NetTCP;
+std::vector<XrdInet*> NetTCPx;   // Additional listeners sharing a port
 
 private:
 
@@ -82,6 +83,7 @@ int   xnet(XrdSysError *edest, XrdOucStream &Config);
 int   xnkap(XrdSysError *edest, char *val);
 int   xlog(XrdSysError *edest, XrdOucStream &Config);
 int   xpidf(XrdSysError *edest, XrdOucStream &Config);
+int   xpoll(XrdSysError *edest, XrdOucStream &Config);
 int   xport(XrdSysError *edest, XrdOucStream &Config);
 int   xprot(XrdSysError *edest, XrdOucStream &Config);
 int   xrep(XrdSysError *edest, XrdOucStream &Config);
@@ -116,8 +118,14 @@ XrdConfigProt      *Firstcp;
 XrdConfigProt      *Lastcp;
 int                 Net_Blen;
 int                 Net_Opts;
+int                 Net_Lstn;
 int                 TLS_Blen;
 int                 TLS_Opts;
+int                 TLS_Lstn;
+int                 Poll_Num;
+bool                Poll_Pin;
+int                 Log_QSz;
+int                 Log_Full;
 
 int                 PortTCP;      // TCP Port to listen on
 int                 PortUDP;      // UDP Port to listen on (currently unsupported)
@@ -233,6 +233,15 @@ XrdTlsPeerCerts *XrdLink::getPeerCerts()
 
 XrdProtocol *XrdLink::getProtocol() {return linkXQ.getProtocol();}
   
+/******************************************************************************/
+/*                               h a s K T L S                                */
+/******************************************************************************/
+
+bool XrdLink::hasKTLS() const
+{
+   return isTLS && linkXQ.isKTLS;
+}
+
 /******************************************************************************/
 /*                                  H o l d                                   */
 /******************************************************************************/
@@ -562,6 +562,17 @@ bool            hasBridge() const {return isBridged;}
 
 bool            hasTLS() const {return isTLS;}
 
+//-----------------------------------------------------------------------------
+//! Determine if this link is using kernel TLS (kTLS) for sending. When true,
+//! Send(sfVec) sends file data without copying it into user space so there
+//! is no need to avoid sendfile on this TLS link.
+//!
+//! @return true    this link sends using kTLS.
+//! @return false   this link does not use TLS or encrypts in user space.
+//-----------------------------------------------------------------------------
+
+bool            hasKTLS() const;
+
 //-----------------------------------------------------------------------------
 //! Return TLS protocol version being used.
 //!
@@ -99,6 +99,7 @@ using namespace XrdGlobal;
        int             XrdLinkXeq::LinkTimeOuts  = 0;
        int             XrdLinkXeq::LinkStalls    = 0;
        int             XrdLinkXeq::LinkSfIntr    = 0;
+       long long       XrdLinkXeq::LinkKTLSOut   = 0;
        XrdSysMutex     XrdLinkXeq::statsMutex;
 
 /******************************************************************************/
@@ -120,7 +121,9 @@ void XrdLinkXeq::Reset()
    stallCnt = stallCntTot = 0;
    tardyCnt = tardyCntTot = 0;
    SfIntr   = 0;
+   KTLSOut  = 0;
    isIdle   = 0;
+   isKTLS   = false;
    BytesOut = BytesIn = BytesOutTot = BytesInTot = 0;
    LockReads= false;
    KeepFD   = false;
@@ -977,6 +980,7 @@ bool XrdLinkXeq::setTLS(bool enable, XrdTlsContext *ctx)
    if (!enable)
       {tlsIO.Shutdown();
        isTLS = enable;
+       isKTLS = false;
        Addr.SetTLS(enable);
        return true;
       }
@@ -1003,6 +1007,7 @@ bool XrdLinkXeq::setTLS(bool enable, XrdTlsContext *ctx)
 //
    if (rc != XrdTls::TLS_AOK) Log.Emsg("LinkXeq", eMsg.c_str());
       else {isTLS = enable;
+            isKTLS = tlsIO.hasKTLS();
             Addr.SetTLS(enable);
             Log.Emsg("LinkXeq", ID, "connection upgraded to", verTLS());
            }
@@ -1060,12 +1065,12 @@ int XrdLinkXeq::Stats(char *buff, int blen, bool do_sync)
    static const char statfmt[] = "<stats id=\"link\"><num>%d</num>"
           "<maxn>%d</maxn><tot>%lld</tot><in>%lld</in><out>%lld</out>"
           "<ctime>%lld</ctime><tmo>%d</tmo><stall>%d</stall>"
-          "<sfps>%d</sfps></stats>";
+          "<sfps>%d</sfps><ktls>%lld</ktls></stats>";
    int i;
 
 // Check if actual length wanted
 //
-   if (!buff) return sizeof(statfmt)+17*6;
+   if (!buff) return sizeof(statfmt)+17*7;
 
 // We must synchronize the statistical counters
 //
@@ -1082,7 +1087,8 @@ int XrdLinkXeq::Stats(char *buff, int blen, bool do_sync)
                                      AtomicGet(LinkConTime),
                                      AtomicGet(LinkTimeOuts),
                                      AtomicGet(LinkStalls),
-                                     AtomicGet(LinkSfIntr));
+                                     AtomicGet(LinkSfIntr),
+                                     AtomicGet(LinkKTLSOut));
    AtomicEnd(statsMutex);
    return i;
 }
@@ -1133,6 +1139,8 @@ void XrdLinkXeq::syncStats(int *ctime)
    AtomicAdd(LinkBytesOut, tmpLL); AtomicAdd(BytesOutTot, tmpLL);
    tmpI4 = AtomicFAZ(SfIntr);
    AtomicAdd(LinkSfIntr, tmpI4);
+   tmpLL = AtomicFAZ(KTLSOut);
+   AtomicAdd(LinkKTLSOut, tmpLL);
    AtomicEnd(statsMutex); AtomicEnd(wrMutex);
 
 // Make sure the protocol updates it's statistics as well
@@ -1389,15 +1397,32 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
    ssize_t totamt = 0;
    char myBuff[65536];
 
-// Convert the sendfile to a regular send. The conversion is not particularly
-// fast and caller are advised to avoid using sendfile on TLS connections.
+// With kernel TLS the file data is encrypted by the kernel and can be sent
+// without copying it into user space.
 //
    isIdle = 0;
+   if (isKTLS)
+      {for (int i = 0; i < sfN; sfP++, i++)
+           {if (!(bytes = sfP->sendsz)) continue;
+            if (sfP->fdnum < 0)
+               {if (!TLS_Write(sfP->buffer, bytes)) return -1;}
+               else if (TLS_SendFile(sfP->fdnum, sfP->offset, bytes) < 0)
+                       return -1;
+            totamt += bytes;
+           }
+       AtomicAdd(BytesOut, totamt);
+       return totamt;
+      }
+
+// Convert the sendfile to a regular send. The conversion is not particularly
+// fast and caller are advised to avoid using sendfile on TLS connections
+// that do not use kTLS (see XrdLink::hasKTLS()).
+//
    for (int i = 0; i < sfN; sfP++, i++)
        {if (!(bytes = sfP->sendsz)) continue;
-        totamt += bytes;
         if (sfP->fdnum < 0)
            {if (!TLS_Write(sfP->buffer, bytes)) return -1;
+            totamt += bytes;
             continue;
            }
         offset = sfP->offset;
@@ -1407,8 +1432,9 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
                        while(retc < 0 && errno == EINTR);
             if (retc < 0) return SFError(errno);
             if (!retc) break;
-            if (!TLS_Write(myBuff, buffsz)) return -1;
-            offset += buffsz; bytes -= buffsz; totamt += retc;
+            if (!TLS_Write(myBuff, retc)) return -1;
+            offset += retc; bytes -= retc; totamt += retc;
+            if (bytes < buffsz) buffsz = bytes;
            } while(bytes > 0);
        }
 
@@ -1418,6 +1444,30 @@ int XrdLinkXeq::TLS_Send(const sfVec *sfP, int sfN)
    return totamt;
 }
 
+/******************************************************************************/
+/* Protected:               T L S _ S e n d F i l e                           */
+/******************************************************************************/
+
+int XrdLinkXeq::TLS_SendFile(int fd, off_t offset, int bytes)
+{
+   XrdTls::RC retc;
+   int bytesout, totamt = bytes;
+
+// Have the kernel send the data, the caller holds the write mutex
+//
+   while(bytes)
+        {retc = tlsIO.SendFile(fd, offset, bytes, bytesout);
+         if (retc != XrdTls::TLS_AOK) return TLS_Error("sendfile to", retc);
+         if (!bytesout) return SFError(ECANCELED);
+         offset += bytesout; bytes -= bytesout;
+        }
+
+// All done
+//
+   AtomicAdd(KTLSOut, totamt);
+   return totamt;
+}
+
 /******************************************************************************/
 /* Protected:                  T L S _ W r i t e                              */
 /******************************************************************************/
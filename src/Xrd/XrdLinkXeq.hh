@@ -143,6 +143,7 @@ const char   *verTLS();
 
 XrdLinkInfo   LinkInfo;
 XrdPollInfo   PollInfo;
+bool          isKTLS;    // TLS records are sent encrypted by the kernel
 
 protected:
 
@@ -151,6 +152,7 @@ void   Reset();
 int    sendData(const char *Buff, int Blen);
 int    SendIOV(const struct iovec *iov, int iocnt, int bytes);
 int    SFError(int rc);
+int    TLS_SendFile(int fd, off_t offset, int bytes);
 int    TLS_Error(const char *act, XrdTls::RC rc);
 bool   TLS_Write(const char *Buff, int Blen);
 
@@ -167,6 +169,7 @@ static int          LinkCountMax;
 static int          LinkTimeOuts;
 static int          LinkStalls;
 static int          LinkSfIntr;
+static long long    LinkKTLSOut;
        long long    BytesIn;
        long long    BytesInTot;
        long long    BytesOut;
@@ -176,6 +179,7 @@ static int          LinkSfIntr;
        int          tardyCnt;
        int          tardyCntTot;
        int          SfIntr;
+       long long    KTLSOut;
 static XrdSysMutex  statsMutex;
 
 // Protocol section
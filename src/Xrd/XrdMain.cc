@@ -77,6 +77,7 @@ Where:
 
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
+#include "XrdSys/XrdSysLogger.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysUtils.hh"
 
@@ -196,6 +197,7 @@ int main(int argc, char *argv[])
                              (void *)new XrdMain(Main.Config.NetADM),
                              XRDSYSTHREAD_BIND, "Admin handler")))
       {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create admin thread");
+       Main.Config.ProtInfo.eDest->logger()->Flush();
        _exit(3);
       }
 
@@ -212,10 +214,24 @@ int main(int argc, char *argv[])
            if ((retc = XrdSysThread::Run(&tid, mainAccept, (void *)Parms,
                                          XRDSYSTHREAD_BIND, strdup(buff))))
               {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create", buff);
+               Main.Config.ProtInfo.eDest->logger()->Flush();
                _exit(3);
               }
           }
 
+// Do the same for any additional listeners sharing a port with a network
+//
+   for (i = 0; i < (int)Main.Config.NetTCPx.size(); i++)
+       {XrdMain *Parms = new XrdMain(Main.Config.NetTCPx[i]);
+        sprintf(buff, "Port %d listener %d", Parms->thePort, i+1);
+        if ((retc = XrdSysThread::Run(&tid, mainAccept, (void *)Parms,
+                                      XRDSYSTHREAD_BIND, strdup(buff))))
+           {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create", buff);
+            Main.Config.ProtInfo.eDest->logger()->Flush();
+            _exit(3);
+           }
+       }
+
 // Finally, start accepting connections on the main port
 //
    Main.theNet  = Main.Config.NetTCP[0];
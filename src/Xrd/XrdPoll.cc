@@ -37,6 +37,7 @@
 #include "XrdSys/XrdSysPthread.hh"
 #include "Xrd/XrdLink.hh"
 #include "Xrd/XrdProtocol.hh"
+#include "Xrd/XrdScheduler.hh"
 
 #define  TRACE_IDENT pInfo.Link.ID
 #include "Xrd/XrdTrace.hh"
@@ -76,7 +77,8 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
 /*                           G l o b a l   D a t a                            */
 /******************************************************************************/
   
-       XrdPoll   *XrdPoll::Pollers[XRD_NUMPOLLERS] = {0, 0, 0};
+       XrdPoll  **XrdPoll::Pollers    = 0;
+       int        XrdPoll::numPollers = 0;
 
        XrdSysMutex  XrdPoll::doingAttach;
 
@@ -97,9 +99,10 @@ using namespace XrdGlobal;
 struct XrdPollArg
        {XrdPoll      *Poller;
         int            retcode;
+        bool           pinned;
         XrdSysSemaphore PollSync;
 
-        XrdPollArg() : PollSync(0, "poll sync") {}
+        XrdPollArg() : pinned(false), PollSync(0, "poll sync") {}
        ~XrdPollArg()               {}
        };
 
@@ -107,6 +110,7 @@ struct XrdPollArg
 void *XrdStartPolling(void *parg)
 {
      struct XrdPollArg *PArg = (struct XrdPollArg *)parg;
+     if (PArg->pinned) Sched.Affine(PArg->Poller->PID);
      PArg->Poller->Start(&(PArg->PollSync), PArg->retcode);
      return (void *)0;
 }
@@ -146,30 +150,43 @@ int XrdPoll::Attach(XrdPollInfo &pInfo)
    int i;
    XrdPoll *pp;
 
-// We allow only one attach at a time to simplify the processing
+// Find a poller with the smallest number of entries and count this link as
+// attached to it. Only this is serialized, the FD is included unlocked.
 //
    doingAttach.Lock();
-
-// Find a poller with the smallest number of entries
-//
    pp = Pollers[0];
-   for (i = 1; i < XRD_NUMPOLLERS; i++)
+   for (i = 1; i < numPollers; i++)
        if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
+   pp->numAttached++;
+   doingAttach.UnLock();
 
 // Include this FD into the poll set of the poller
 //
-   if (!pp->Include(pInfo)) {doingAttach.UnLock(); return 0;}
+   if (!pp->Include(pInfo))
+      {doingAttach.Lock(); pp->numAttached--; doingAttach.UnLock();
+       return 0;
+      }
 
 // Complete the link setup
 //
    pInfo.Poller = pp;
-   pp->numAttached++;
-   doingAttach.UnLock();
    TRACEI(POLL, "FD " <<pInfo.FD <<" attached to poller " <<pp->PID
                 <<"; num=" <<pp->numAttached);
    return 1;                                                           
 }
 
+/******************************************************************************/
+/*                                  D f l t                                   */
+/******************************************************************************/
+
+int XrdPoll::Dflt()
+{
+   long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+   int  npoll = static_cast<int>((ncpu + 7) / 8);
+
+   return (npoll > XRD_NUMPOLLERS ? npoll : XRD_NUMPOLLERS);
+}
+
 /******************************************************************************/
 /*                                D e t a c h                                 */
 /******************************************************************************/
@@ -288,19 +305,26 @@ char *XrdPoll::Poll2Text(short events)
 /*                                 S e t u p                                  */
 /******************************************************************************/
   
-int XrdPoll::Setup(int numfd)
+int XrdPoll::Setup(int numfd, int npoll, bool pin)
 {
    pthread_t tid;
    int maxfd, retc, i;
    struct XrdPollArg PArg;
 
+// Allocate the poller table
+//
+   numPollers = (npoll > 0 ? npoll : Dflt());
+   Pollers    = new XrdPoll *[numPollers]();
+   PArg.pinned = pin;
+   TRACE(POLL, "Using " <<numPollers <<(pin ? " pinned" : "") <<" pollers");
+
 // Calculate the number of table entries per poller
 //
-   maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
+   maxfd  = (numfd / numPollers) + 16;
 
 // Verify that we initialized the poller table
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {if (!(Pollers[i] = newPoller(i, maxfd))) return 0;
         Pollers[i]->PID = i;
 
@@ -344,7 +368,7 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
 // costly and hardly worth it. So, we do not include code such as:
 //    x = pp->y; if (do_sync) while(x != pp->y) x = pp->y; tot += x;
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {pp = Pollers[i];
         numatt += pp->numAttached; 
         numen  += pp->numEnabled;
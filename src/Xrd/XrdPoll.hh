@@ -65,9 +65,16 @@ static  int   Finish(XrdPollInfo &pInfo, const char *etxt=0); //Implementation s
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
-// Setup() is called at config time to perform poller configuration
+// Setup() is called at config time to perform poller configuration. When
+// npoll is not positive the default number of pollers is used. When pin is
+// true each poller is pinned to its own scheduler cpu group.
 //
-static  int   Setup(int numfd);        // Implementation supplied
+static  int   Setup(int numfd, int npoll=0, bool pin=false); // Impl supplied
+
+// Dflt() returns the default number of pollers: one per group of 8 cpus but
+// never fewer than XRD_NUMPOLLERS.
+//
+static  int   Dflt();                  // Implementation supplied
 
 // Start() is called via a thread for each poller that was created
 //
@@ -84,7 +91,8 @@ static  int   Stats(char *buff, int blen, int do_sync=0);
 
 // The following table reference the pollers in effect
 //
-static     XrdPoll   *Pollers[XRD_NUMPOLLERS];
+static     XrdPoll  **Pollers;
+static     int        numPollers;
 
            XrdPoll();
 virtual   ~XrdPoll() {}
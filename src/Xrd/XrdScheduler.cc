@@ -27,8 +27,10 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cerrno>
 #include <fcntl.h>
+#include <sched.h>
 #include <signal.h>
 #include <cstdio>
 #include <sys/resource.h>
@@ -67,7 +69,273 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+/******************************************************************************/
+/*                    X r d S c h e d u l e r Q u e u e s                     */
+/******************************************************************************/
+
+// With multiple run queues each thread that schedules work (a poller, the
+// timer or a worker) feeds a queue of its own so that there is no single lock
+// they all contend for. Workers first look in their own queue and otherwise
+// steal half of the jobs queued elsewhere. Wakeups are rationed: an idle
+// worker is only posted when nobody is searching for work, and a worker that
+// finds work while searching wakes the next one if more is pending. Each post
+// adds one to Searching; whoever returns from the wait inherits that count.
+//
+namespace
+{
+thread_local unsigned int myQueue = ~0U;
+std::atomic<unsigned int> nextQueue(0);
+}
+
+class XrdSchedulerQueues
+{
+public:
+
+struct alignas(64) RunQ
+      {XrdSysMutex       qMutex;
+       XrdJob           *First = 0;
+       XrdJob           *Last  = 0;
+       std::atomic<int>  Count{0};   // Only changed under qMutex
+       int               Jobs  = 0;  // Number of jobs ever queued here
+      };
+
+std::atomic<int>  inQ;       // Jobs in all of the queues
+std::atomic<int>  maxQ;      // Longest total queue length we had
+std::atomic<int>  Idle;      // Workers waiting for a post
+std::atomic<int>  Searching; // Outstanding posts plus workers searching
+std::atomic<int>  Layoffs;   // Workers asked to terminate
+
+RunQ             *Q;
+int               numQ;
+
+RunQ   &Home() {if (myQueue == ~0U) myQueue = nextQueue++;
+                return Q[myQueue % numQ];
+               }
+
+void    Add(XrdJob *jfirst, XrdJob *jlast, int num);
+
+void    AddIdle(int n) {Publish(idleOut, Idle += n);}
+
+XrdJob *Take();
+
+void    Wake(int num);
+
+        XrdSchedulerQueues(int nq, XrdSysSemaphore &wsem, int &idle, int &jobs)
+                          : inQ(0), maxQ(0), Idle(0), Searching(0), Layoffs(0),
+                            Q(new RunQ[nq]), numQ(nq), workAvail(wsem),
+                            idleOut(idle), jobsOut(jobs) {}
+       ~XrdSchedulerQueues() {delete [] Q;}
+
+private:
+
+void    Append(RunQ &q, XrdJob *jfirst, XrdJob *jlast, int num);
+XrdJob *Pop(RunQ &q, RunQ &home, bool steal, bool wait);
+
+// The inline Active() and canStick() read the scheduler's idl_Workers and
+// num_JobsinQ, so we keep them current. They are only ever read unlocked.
+//
+void    Publish(int &cnt, int val) {__atomic_store_n(&cnt,val,__ATOMIC_RELAXED);}
+
+XrdSysSemaphore  &workAvail;
+int              &idleOut;
+int              &jobsOut;
+};
+
+/******************************************************************************/
+/*                   X r d S c h e d u l e r Q u e u e s : : A d d            */
+/******************************************************************************/
+  
+void XrdSchedulerQueues::Add(XrdJob *jfirst, XrdJob *jlast, int num)
+{
+   RunQ &q = Home();
+   int n, m;
+
+// Place the jobs on our queue
+//
+   q.qMutex.Lock();
+   Append(q, jfirst, jlast, num);
+   q.Jobs += num;
+   q.qMutex.UnLock();
+
+// Account for them (must precede the wakeup check, see Run) and wake a worker
+//
+   n = (inQ += num);
+   Publish(jobsOut, n);
+   m = maxQ.load(std::memory_order_relaxed);
+   while(n > m && !maxQ.compare_exchange_weak(m, n, std::memory_order_relaxed)) {}
+   Wake(num);
+}
+
+/******************************************************************************/
+/*               X r d S c h e d u l e r Q u e u e s : : A p p e n d          */
+/******************************************************************************/
+  
+void XrdSchedulerQueues::Append(RunQ &q, XrdJob *jfirst, XrdJob *jlast, int num)
+{
+// The queue must be locked by the caller
+//
+   if (q.Last) q.Last->NextJob = jfirst;
+      else     q.First         = jfirst;
+   q.Last = jlast;
+   q.Count.store(q.Count.load(std::memory_order_relaxed) + num,
+                 std::memory_order_relaxed);
+}
+
+/******************************************************************************/
+/*                  X r d S c h e d u l e r Q u e u e s : : P o p             */
+/******************************************************************************/
+
+XrdJob *XrdSchedulerQueues::Pop(RunQ &q, RunQ &home, bool steal, bool wait)
+{
+   XrdJob *jp, *jl;
+   int n, cnt;
+
+// Lock the queue, when only probing do not wait for a busy one
+//
+   if (wait) q.qMutex.Lock();
+      else if (!q.qMutex.CondLock()) return 0;
+
+// Detach the first job or, when stealing, the first half of the jobs
+//
+   if (!(jp = q.First)) {q.qMutex.UnLock(); return 0;}
+   cnt = q.Count.load(std::memory_order_relaxed);
+   n = (steal ? (cnt+1)/2 : 1);
+   jl = jp;
+   for (int i = 1; i < n && jl->NextJob; i++) jl = jl->NextJob;
+   if (!(q.First = jl->NextJob)) q.Last = 0;
+   q.Count.store(cnt - n, std::memory_order_relaxed);
+   q.qMutex.UnLock();
+   jl->NextJob = 0;
+   Publish(jobsOut, --inQ);
+
+// Move whatever else we stole to our own queue. They stay counted in inQ.
+//
+   if (jp != jl)
+      {home.qMutex.Lock();
+       Append(home, jp->NextJob, jl, n-1);
+       home.qMutex.UnLock();
+      }
+   return jp;
+}
+
+/******************************************************************************/
+/*                 X r d S c h e d u l e r Q u e u e s : : T a k e            */
+/******************************************************************************/
+
+XrdJob *XrdSchedulerQueues::Take()
+{
+   RunQ &home = Home();
+   XrdJob *jp;
+   int hIdx = &home - Q;
+
+// Look at our own queue first and then at everybody else's. The first pass
+// skips queues that are locked, the second one does not.
+//
+   for (int pass = 0; pass < 2 && inQ.load() > 0; pass++)
+       for (int i = 0; i < numQ; i++)
+           {RunQ &q = Q[(hIdx + i) % numQ];
+            if (q.Count.load(std::memory_order_relaxed) > 0
+            &&  (jp = Pop(q, home, i != 0, pass != 0))) return jp;
+           }
+   return 0;
+}
+
+/******************************************************************************/
+/*                  X r d S c h e d u l e r Q u e u e s : : W a k e           */
+/******************************************************************************/
+
+void XrdSchedulerQueues::Wake(int num)
+{
+   int idle, none = 0;
+
+// If nobody is idle or someone is already searching there is nothing to do
+//
+   if ((idle = Idle.load()) <= 0
+   ||  !Searching.compare_exchange_strong(none, 1)) return;
+
+// Wake as many workers as there are jobs, up to the number that is idle
+//
+   if (num > idle) num = idle;
+   if (num > 1) Searching += num-1;
+   while(num--) workAvail.Post();
+}
   
+/******************************************************************************/
+/*                      X r d S c h e d u l e r E x t                         */
+/******************************************************************************/
+
+// The run queue and cpu affinity state is kept here instead of in XrdScheduler
+// so that the layout of the class, which plugins allocate themselves, stays the same.
+// Entries are found by scheduler address and there normally is only one, so
+// schedulers that never asked for any of this find an empty list. Schedulers
+// are never deleted; the destructor merely disowns its entry.
+//
+namespace
+{
+struct XrdSchedulerExt
+      {XrdSchedulerExt                 *Next;
+       std::atomic<const XrdScheduler*> Sched;
+       XrdSchedulerQueues              *Queues;    // Run queues, once started
+       int                              numQueues; // Run queues wanted
+       int                             *cpuList;   // Cpus in the affinity groups
+       int                              numCPUs;
+       int                              numGroups; // Affinity groups, if any
+
+       int  Pin(int grp);
+
+       XrdSchedulerExt(const XrdScheduler *sP, XrdSchedulerExt *nP)
+                      : Next(nP), Sched(sP), Queues(0), numQueues(0),
+                        cpuList(0), numCPUs(0), numGroups(0) {}
+      };
+
+std::atomic<XrdSchedulerExt *> extList(0);
+XrdSysMutex                    extMutex;
+
+XrdSchedulerExt *getExt(const XrdScheduler *sP, bool add=false)
+{
+   XrdSchedulerExt *eP;
+
+// Look for an existing entry, this is done without a lock
+//
+   for (eP = extList.load(std::memory_order_acquire); eP; eP = eP->Next)
+       if (eP->Sched.load(std::memory_order_relaxed) == sP) return eP;
+   if (!add) return 0;
+
+// Add a new one at the front, we must look again under the lock
+//
+   XrdSysMutexHelper mHelp(extMutex);
+   for (eP = extList.load(); eP; eP = eP->Next)
+       if (eP->Sched.load() == sP) return eP;
+   eP = new XrdSchedulerExt(sP, extList.load());
+   extList.store(eP, std::memory_order_release);
+   return eP;
+}
+
+// Restrict the calling thread to the cpus of a group. When there are more
+// groups than cpus, groups share cpus. Returns 0 or the error code.
+//
+int XrdSchedulerExt::Pin(int grp)
+{
+#ifdef __linux__
+   cpu_set_t cset;
+   int lo, hi;
+
+   if (grp < 0 || !numGroups) return 0;
+   grp %= numGroups;
+   lo = grp     * numCPUs / numGroups;
+   hi = (grp+1) * numCPUs / numGroups;
+   if (hi <= lo) {lo = grp % numCPUs; hi = lo+1;}
+
+   CPU_ZERO(&cset);
+   for (int i = lo; i < hi; i++) CPU_SET(cpuList[i], &cset);
+   return pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset);
+#else
+   return 0;
+#endif
+}
+}
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
@@ -176,8 +444,36 @@ void XrdScheduler::Boot(XrdSysError *eP, XrdSysTrace *tP,
 
 XrdScheduler::~XrdScheduler()  // The scheduler is never deleted!
 {
+   XrdSchedulerExt *eP = getExt(this);
+
+   if (eP) eP->Sched = 0;
 }
  
+/******************************************************************************/
+/*                                A f f i n e                                 */
+/******************************************************************************/
+
+void XrdScheduler::Affine(int grp)
+{
+   XrdSchedulerExt *eP = getExt(this);
+   int rc;
+
+// Feed the run queue corresponding to the group. With multiple run queues
+// there is one cpu group per queue (see Start()), so we fold the group onto
+// the queue it feeds and run on the same cpus as that queue's workers. This
+// is harmless if we end up with a single run queue.
+//
+   if (grp >= 0)
+      {if (eP && eP->Queues) grp %= eP->Queues->numQ;
+       myQueue = static_cast<unsigned int>(grp);
+      }
+
+// Pin the thread to the group's cpus
+//
+   if (eP && eP->numGroups && (rc = eP->Pin(grp)) && XrdLog)
+      XrdLog->Emsg("Sched", rc, "set thread cpu affinity");
+}
+  
 /******************************************************************************/
 /*                                C a n c e l                                 */
 /******************************************************************************/
@@ -214,8 +510,29 @@ void XrdScheduler::Cancel(XrdJob *jp)
 
 void XrdScheduler::DoIt()
 {
+   XrdSchedulerExt *eP = getExt(this);
+   XrdSchedulerQueues *Queues = (eP ? eP->Queues : 0);
    int num_kill, num_idle;
 
+// With multiple run queues idle workers are told to leave in the same way
+// but the posts must be accounted for (see XrdSchedulerQueues).
+//
+   if (Queues)
+      {if (!Queues->inQ)
+          {num_idle = Queues->Idle;
+           num_kill = num_idle - min_Workers;
+           TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
+           if (num_kill > 0)
+              {if (num_kill > 1) num_kill = num_kill/2;
+               Queues->Layoffs    = num_kill;
+               Queues->Searching += num_kill;
+               while(num_kill--) WorkAvail.Post();
+              }
+          }
+       if (max_Workidl > 0) Schedule((XrdJob *)this, max_Workidl+time(0));
+       return;
+      }
+
 // Now check if there are too many idle threads (kill them if there are)
 //
    if (!num_JobsinQ)
@@ -328,9 +645,14 @@ void *XrdScheduler::Reaper()
   
 void XrdScheduler::Run()
 {
+   XrdSchedulerExt *eP = getExt(this);
    int waiting;
    XrdJob *jp;
 
+// Use the multiple run queue loop if so configured
+//
+   if (eP && eP->Queues) {RunQueues(*(eP->Queues)); return;}
+
 // Wait for work then do it (an endless task for a worker thread)
 //
    do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
@@ -372,6 +694,16 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
+   XrdSchedulerExt *eP = getExt(this);
+
+// With multiple run queues, place it on the one for this thread
+//
+   if (eP && eP->Queues)
+      {jp->NextJob = 0;
+       eP->Queues->Add(jp, jp, 1);
+       return;
+      }
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -403,6 +735,15 @@ void XrdScheduler::Schedule(XrdJob *jp)
   
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
+   XrdSchedulerExt *eP = getExt(this);
+
+// With multiple run queues, place them on the one for this thread
+//
+   if (eP && eP->Queues)
+      {jlast->NextJob = 0;
+       eP->Queues->Add(jfirst, jlast, numjobs);
+       return;
+      }
 
 // Lock down our data area
 //
@@ -541,6 +882,30 @@ void XrdScheduler::setNproc(const bool limlower)
 #endif
 }
 
+/******************************************************************************/
+/*                           s e t A f f i n i t y                            */
+/******************************************************************************/
+
+void XrdScheduler::setAffinity(int ng)
+{
+#ifdef __linux__
+   XrdSchedulerExt *eP;
+   cpu_set_t cset;
+   int n = 0;
+
+// Get the cpus we may run on, the groups are formed from these in order
+//
+   if (ng < 1 || sched_getaffinity(0, sizeof(cset), &cset)
+   ||  (eP = getExt(this, true))->cpuList) return;
+   eP->cpuList = new int[CPU_COUNT(&cset)];
+   for (int i = 0; i < CPU_SETSIZE; i++)
+       if (CPU_ISSET(i, &cset)) eP->cpuList[n++] = i;
+   eP->numCPUs   = n;
+   eP->numGroups = ng;
+   TRACE(SCHED, "Set " <<ng <<" affinity groups over " <<n <<" cpus");
+#endif
+}
+
 /******************************************************************************/
 /*                              s e t P a r m s                               */
 /******************************************************************************/
@@ -587,12 +952,33 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                             s e t Q u e u e s                              */
+/******************************************************************************/
+
+void XrdScheduler::setQueues(int nq)
+{
+   XrdSchedulerExt *eP = getExt(this);
+
+// A negative value asks for one queue per cpu. Once started this is fixed.
+//
+   if (eP && eP->Queues) return;
+   if (nq < 0) nq = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+   if (nq > 1024) nq = 1024;
+   if (nq < 2) nq = 0;
+   if (nq && !eP) eP = getExt(this, true);
+   if (eP) eP->numQueues = nq;
+   TRACE(SCHED, "Set num_Queues=" <<nq);
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
   
 void XrdScheduler::Start() // Serialized one time call!
 {
+   XrdSchedulerExt *eP = getExt(this);
+   XrdSchedulerQueues *Queues = 0;
    int retc, numw;
    pthread_t tid;
 
@@ -601,6 +987,18 @@ void XrdScheduler::Start() // Serialized one time call!
    if (getenv("XRDDEBUG") != 0) XrdTrace->What = TRACE_SCHED;
       else if (XrdTraceOld) XrdTrace->What |= XrdTraceOld->What;
 
+// Set up multiple run queues if so wanted
+//
+   if (eP && eP->numQueues > 1)
+      Queues = eP->Queues = new XrdSchedulerQueues(eP->numQueues, WorkAvail,
+                                                   idl_Workers, num_JobsinQ);
+
+// With multiple run queues and affinity the cpus are split into one group per
+// run queue. Workers run on the cpus of their home queue and Affine() maps a
+// thread onto the queue it feeds, so work stays on the cpus it came from.
+//
+   if (Queues && eP->numGroups) eP->numGroups = Queues->numQ;
+
 // Start a time based scheduler
 //
    if ((retc = XrdSysThread::Run(&tid, XrdStartTSched, (void *)this,
@@ -618,7 +1016,8 @@ void XrdScheduler::Start() // Serialized one time call!
 
 // Unlock the data area
 //
-   TRACE(SCHED, "Starting with " <<num_Workers <<" workers" );
+   TRACE(SCHED, "Starting with " <<num_Workers <<" workers and "
+                <<(Queues ? Queues->numQ : 1) <<" run queues");
 }
 
 /******************************************************************************/
@@ -627,6 +1026,8 @@ void XrdScheduler::Start() // Serialized one time call!
   
 int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 {
+    XrdSchedulerExt *eP = getExt(this);
+    XrdSchedulerQueues *Queues = (eP ? eP->Queues : 0);
     int cnt_Jobs, cnt_JobsinQ, xam_QLength, cnt_Workers, cnt_idl;
     int cnt_TCreate, cnt_TDestroy, cnt_Limited;
     static const char statfmt[] = "<stats id=\"sched\"><jobs>%d</jobs>"
@@ -644,6 +1045,7 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
    if (do_sync) DispatchMutex.Lock();
    cnt_idl = idl_Workers;
    if (do_sync) DispatchMutex.UnLock();
+   if (Queues) cnt_idl = Queues->Idle;
 
 // Get values protected by the Scheduler lock (avoid lock if no sync needed)
 //
@@ -657,6 +1059,19 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
    cnt_Limited = num_Limited;
    if (do_sync) SchedMutex.UnLock();
 
+// With multiple run queues the job counts are kept per queue
+//
+   if (Queues)
+      {cnt_JobsinQ = Queues->inQ;
+       xam_QLength = Queues->maxQ;
+       for (int i = 0; i < Queues->numQ; i++)
+           {XrdSchedulerQueues::RunQ &q = Queues->Q[i];
+            if (do_sync) q.qMutex.Lock();
+            cnt_Jobs += q.Jobs;
+            if (do_sync) q.qMutex.UnLock();
+           }
+      }
+
 // Format the stats and return them
 //
    return snprintf(buff, blen, statfmt, cnt_Jobs, cnt_JobsinQ, xam_QLength,
@@ -758,6 +1173,63 @@ void XrdScheduler::Init(int minw, int maxw, int maxi)
    WorkFirst = WorkLast = TimerQueue = 0;
 }
 
+/******************************************************************************/
+/*                             R u n Q u e u e s                              */
+/******************************************************************************/
+
+void XrdScheduler::RunQueues(XrdSchedulerQueues &RQ)
+{
+   XrdSchedulerExt *eP = getExt(this);
+   XrdJob *jp;
+   bool searching = false;
+   int n;
+
+// Pick the queue we will be feeding from and to and, if so wanted, run on the
+// cpus of that queue.
+//
+   RQ.Home();
+   if (eP->numGroups) eP->Pin(&RQ.Home() - RQ.Q);
+
+// Find work then do it (an endless task for a worker thread). When none is
+// found we declare ourselves idle before checking the job count one last
+// time; Add() does the reverse so that a new job is never left unnoticed.
+//
+   do {if (!(jp = RQ.Take()))
+          {RQ.AddIdle(1);
+           if (searching) {searching = false; RQ.Searching--;}
+           if (RQ.inQ > 0) {RQ.AddIdle(-1); continue;}
+           WorkAvail.Wait();
+           RQ.AddIdle(-1);
+           searching = true;
+           if (RQ.Layoffs > 0 && !RQ.inQ)
+              {n = RQ.Layoffs;
+               while(n > 0 && !RQ.Layoffs.compare_exchange_weak(n, n-1)) {}
+               if (n > 0 && RQ.Idle > 0)
+                  {RQ.Searching--;
+                   SchedMutex.Lock();
+                   num_TDestroy++; num_Workers--;
+                   TRACE(SCHED, "terminating thread; workers=" <<num_Workers);
+                   SchedMutex.UnLock();
+                   return;
+                  }
+              }
+           continue;
+          }
+
+    // If we were the last one searching, let another worker take over if
+    // there is more to do. Then make sure we always have an idle thread.
+    //
+       if (searching)
+          {searching = false;
+           if (--RQ.Searching == 0 && RQ.inQ > 0) RQ.Wake(1);
+          }
+       if (!RQ.Idle && !RQ.Searching) hireWorker();
+       if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
+          {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<RQ.inQ);}
+       jp->DoIt();
+      } while(1);
+}
+
 /******************************************************************************/
 /*                             t r a c e E x i t                              */
 /******************************************************************************/
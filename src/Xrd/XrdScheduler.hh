@@ -37,6 +37,7 @@
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerQueues;
 class XrdSysError;
 class XrdSysTrace;
 
@@ -49,6 +50,13 @@ public:
 
 int           Active() {return num_Workers - idl_Workers + num_JobsinQ;}
 
+// Pin the calling thread to cpu group grp (see setAffinity()) and make the
+// work it schedules go to run queue grp when there are multiple run queues.
+// With fewer run queues than groups, grp is folded onto a queue and the
+// thread is pinned to that queue's cpus.
+//
+void          Affine(int grp);
+
 void          Cancel(XrdJob *jp);
 
 inline int    canStick() {return  num_Workers              < stk_Workers
@@ -66,8 +74,21 @@ void          Schedule(XrdJob *jp);
 void          Schedule(int num, XrdJob *jfirst, XrdJob *jlast);
 void          Schedule(XrdJob *jp, time_t atime);
 
+// Split the cpus the process may use into ng groups of adjacent cpus for
+// Affine(). With multiple run queues there is instead one group per queue
+// and the workers feeding from queue q are pinned to group q. Must precede
+// Start().
+//
+void          setAffinity(int ng);
+
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// Use nq separate run queues instead of a single one (0 means one queue and
+// a negative value one queue per cpu). Threads scheduling work feed their
+// own queue and idle workers steal from the others. Must precede Start().
+//
+void          setQueues(int nq);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -134,6 +155,7 @@ void Boot(XrdSysError *eP, XrdSysTrace *tP, int minw, int maxw, int maxi);
 void hireWorker(int dotrace=1);
 void Init(int minw, int maxw, int maxi);
 void Monitor();
+void RunQueues(XrdSchedulerQueues &RQ);
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
 };
@@ -57,6 +57,86 @@ extern unsigned long XrdOucHashVal2(const char *KeyVal, int KeyLen);
   
 extern XrdAccConfig XrdAccConfiguration;
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// PrivsQuery collects the capability lists that apply to an entity so that
+// the path trie can be descended once for all of them. Lists that are not in
+// the trie are searched right away.
+//
+class PrivsQuery
+{
+public:
+
+void Add(XrdAccCapability *cp)
+        {int lnum = cp->ListNum();
+         if (lnum < 0 || !pTrie) cp->Privs(caps, path, plen, phash);
+            else {if (lnCnt >= maxLN) Flush();
+                  lnVec[lnCnt++] = lnum;
+                 }
+        }
+
+void Flush()
+          {if (lnCnt) {pTrie->Privs(caps, path, plen, lnVec, lnCnt); lnCnt = 0;}}
+
+     PrivsQuery(XrdAccPrivCaps &cap, XrdAccPathTrie *trie,
+                const char *pname, int pnlen, unsigned long pnhash)
+               : caps(cap), pTrie(trie), path(pname), plen(pnlen),
+                 phash(pnhash), lnCnt(0) {}
+    ~PrivsQuery() {}
+
+private:
+
+static const int maxLN = 64;
+
+XrdAccPrivCaps &caps;
+XrdAccPathTrie *pTrie;
+const char     *path;
+int             plen;
+unsigned long   phash;
+int             lnCnt;
+int             lnVec[maxLN];
+};
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+int TrieAdd(const char *key, XrdAccCapability *cap, void *arg)
+{
+   ((XrdAccPathTrie *)arg)->Add(cap);
+   return 0;
+}
+
+// Compile the capability lists of the tables into a path trie. The fungible
+// list is not included as its paths depend on the user name (see Access()).
+//
+XrdAccPathTrie *TrieBuild(struct XrdAccAccess_Tables &tabs)
+{
+   XrdAccPathTrie *trie = new XrdAccPathTrie;
+   XrdOucHash<XrdAccCapability> *hVec[] = {tabs.G_Hash, tabs.H_Hash,
+                                           tabs.N_Hash, tabs.O_Hash,
+                                           tabs.R_Hash, tabs.U_Hash};
+
+   for (int i = 0; i < (int)(sizeof(hVec)/sizeof(hVec[0])); i++)
+       if (hVec[i]) hVec[i]->Apply(TrieAdd, (void *)trie);
+
+   for (XrdAccCapName *ncp = tabs.D_List; ncp; ncp = ncp->Next())
+       trie->Add(ncp->Caps());
+
+   for (XrdAccAccess_ID *xlP = tabs.SXList; xlP; xlP = xlP->next)
+       trie->Add(xlP->caps);
+   for (XrdAccAccess_ID *ylP = tabs.SYList; ylP; ylP = ylP->next)
+       trie->Add(ylP->caps);
+
+   trie->Add(tabs.Z_List);
+   return trie;
+}
+}
+
 /******************************************************************************/
 /*       Autorization Object Creation via XrdAccDefaultAuthorizeObject        */
 /******************************************************************************/
@@ -140,6 +220,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 // Get a shared context for these potentially long running routines
 //
    Access_Context.Lock(xs_Shared);
+   PrivsQuery query(caps, Atab.P_Trie, path, plen, phash);
 
 // Setup the host entry in the eInfo structure (it may need to be resolved)
 //
@@ -152,7 +233,8 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
        do {int aSeq = 0;
            while(aeP->Next(aSeq, eInfo))
                 {if (xlP->Applies(eInfo))
-                    {xlP->caps->Privs(caps, path, plen, phash);
+                    {query.Add(xlP->caps);
+                     query.Flush();
                      Access_Context.UnLock(xs_Shared);
                      return Access(caps, Entity, path, oper);
                     }
@@ -168,17 +250,17 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // Establish default privileges
 //
-   if (Atab.Z_List) Atab.Z_List->Privs(caps, path, plen, phash);
+   if (Atab.Z_List) query.Add(Atab.Z_List);
 
 // Next add in the host domain privileges
 //
    if (Atab.D_List && (cp = Atab.D_List->Find(eInfo.host)))
-      cp->Privs(caps, path, plen, phash);
+      query.Add(cp);
 
 // Next add in the host-specific privileges
 //
    if (Atab.H_Hash && (cp = Atab.H_Hash->Find(eInfo.host)))
-      cp->Privs(caps, path, plen, phash);
+      query.Add(cp);
 
 // Now add in the netgroup privileges
 //
@@ -187,11 +269,12 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
       {char *gname;
        while((gname = (char *)glp->Next()))
             if ((cp = Atab.N_Hash->Find((const char *)gname)))
-               cp->Privs(caps, path, plen, phash);
+               query.Add(cp);
        delete glp;
       }
 
-// Check for user fungible privileges
+// Check for user fungible privileges. These are matched after substituting
+// the user name and are not part of the path trie.
 //
    if (isuser && Atab.X_List)
       Atab.X_List->Privs(caps, path, plen, phash, eInfo.name);
@@ -199,7 +282,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 // Add in specific user privileges
 //
    if (isuser && Atab.U_Hash && (cp = Atab.U_Hash->Find(eInfo.name)))
-      cp->Privs(caps, path, plen, phash);
+      query.Add(cp);
 
 // The following privileges are based on multiple attributes. Orgs and roles
 // may be repeated but groups generally will not be.
@@ -212,14 +295,14 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
          // Add in the group privileges.
          //
          if (Atab.G_Hash && eInfo.grup && (cp = Atab.G_Hash->Find(eInfo.grup)))
-            cp->Privs(caps, path, plen, phash);
+            query.Add(cp);
 
          // Add in the org-specific privileges
          //
          if (Atab.O_Hash && eInfo.vorg && eInfo.vorg != vorgPrev)
             {vorgPrev = eInfo.vorg;
              if ((cp = Atab.O_Hash->Find(eInfo.vorg)))
-                cp->Privs(caps, path, plen, phash);
+                query.Add(cp);
             }
 
          // Add in the role-specific privileges
@@ -227,7 +310,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
          if (Atab.R_Hash && eInfo.role && eInfo.role != rolePrev)
             {rolePrev = eInfo.role;
              if ((cp = Atab.R_Hash->Find(eInfo.role)))
-                cp->Privs(caps, path, plen, phash);
+                query.Add(cp);
             }
 
          // Finally run through the inclusive list and apply all relevant rules
@@ -235,13 +318,15 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
          XrdAccAccess_ID *ylP = Atab.SYList;
          while (ylP)
                {if (ylP->Applies(eInfo))
-                   ylP->caps->Privs(caps, path, plen, phash);
+                   query.Add(ylP->caps);
                 ylP = ylP->next;
                }
         }
 
-// We are now done with looking at changeable data
+// Search the path trie for all of the lists collected above. We are then done
+// with looking at changeable data.
 //
+   query.Flush();
    Access_Context.UnLock(xs_Shared);
 
 // Return the privileges as needed
@@ -378,6 +463,11 @@ void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
                }
       }
 
+// Compile the capability lists into a path trie while searches may still use
+// the current tables.
+//
+   if (!newtab.P_Trie) newtab.P_Trie = TrieBuild(newtab);
+
 // Get an exclusive context to change the table pointers
 //
    Access_Context.Lock(xs_Exclusive);
@@ -398,6 +488,7 @@ void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
    XrdAccSWAP(Z_List);
    XrdAccSWAP(SXList);
    XrdAccSWAP(SYList);
+   XrdAccSWAP(P_Trie);
    hostRefX = hRefX;
    hostRefY = hRefY;
 
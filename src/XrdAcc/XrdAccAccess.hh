@@ -33,6 +33,7 @@
 #include "XrdAcc/XrdAccAudit.hh"
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPathTrie.hh"
 #include "XrdSec/XrdSecEntity.hh"
 #include "XrdOuc/XrdOucHash.hh"
 #include "XrdSys/XrdSysXSLock.hh"
@@ -97,6 +98,7 @@ struct XrdAccAccess_Tables
                   XrdAccCapability  *Z_List;  // Default  capbailities
                   XrdAccAccess_ID   *SXList;  // 's' exclusive list
                   XrdAccAccess_ID   *SYList;  // 's' inclusive list
+                  XrdAccPathTrie    *P_Trie;  // Compiled path index
 
         XrdAccAccess_Tables() {G_Hash = 0; H_Hash = 0; N_Hash = 0;
                                O_Hash = 0; R_Hash = 0;
@@ -104,6 +106,7 @@ struct XrdAccAccess_Tables
                                D_List = 0; E_List = 0;
                                X_List = 0; Z_List = 0;
                                SXList = 0; SYList = 0;
+                               P_Trie = 0;
                               }
        ~XrdAccAccess_Tables() {if (G_Hash) delete G_Hash;
                                if (H_Hash) delete H_Hash;
@@ -115,6 +118,7 @@ struct XrdAccAccess_Tables
                                if (U_Hash) delete U_Hash;
                                if (X_List) delete X_List;
                                if (Z_List) delete Z_List;
+                               if (P_Trie) delete P_Trie;
                               }
        };
 
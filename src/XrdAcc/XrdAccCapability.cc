@@ -46,7 +46,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; listNum = -1;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
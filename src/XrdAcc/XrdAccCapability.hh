@@ -43,8 +43,16 @@
 class XrdAccCapability
 {
 public:
+
+friend class XrdAccPathTrie;
+
 void                Add(XrdAccCapability *newcap) {next = newcap;}
 
+// ListNum() returns the number given to the list headed by this capability by
+// XrdAccPathTrie::Add() or -1 if the list is not part of a path trie.
+//
+int                 ListNum() {return listNum;}
+
 XrdAccCapability   *Next() {return next;}
 
 // Privs() searches the associated capability for a prefix matching path. If one
@@ -81,6 +89,7 @@ int                 Subcomp(const char *pathname, const int pathlen,
                   XrdAccCapability(XrdAccCapability *taddr)
                         {next = 0; ctmp = taddr;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
+                         listNum = -1;
                         }
 
                  ~XrdAccCapability();
@@ -96,6 +105,7 @@ char            *path;
 int              plen;
 int              pins;    // index of @=
 int              prem;    // remaining length after @=
+int              listNum; // list number in the path trie or -1
 };
 
 /******************************************************************************/
@@ -109,6 +119,10 @@ void              Add(XrdAccCapName *cnp) {next = cnp;}
 
 XrdAccCapability *Find(const char *name);
 
+XrdAccCapName    *Next() {return next;}
+
+XrdAccCapability *Caps() {return C_List;}
+
        XrdAccCapName(char *name, XrdAccCapability *cap)
                     {next = 0; CapName = strdup(name); CNlen = strlen(name);
                      C_List = cap;
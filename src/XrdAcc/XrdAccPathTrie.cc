@@ -0,0 +1,204 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d A c c P a t h T r i e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPathTrie.hh"
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccPathTrie::XrdAccPathTrie() : nodes(1), numLists(0) {}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdAccPathTrie::Add(XrdAccCapability *cap)
+{
+   int rank = 0;
+
+// Each list is indexed only once even if it is reachable from several ids
+//
+   if (!cap || cap->listNum >= 0) return;
+   cap->listNum = numLists++;
+   AddCaps(cap, cap->listNum, rank);
+}
+
+/******************************************************************************/
+/* Private:                      A d d C a p s                                */
+/******************************************************************************/
+
+void XrdAccPathTrie::AddCaps(XrdAccCapability *cap, int lnum, int &rank)
+{
+   std::vector<Entry>::iterator it;
+   Entry ent;
+
+// Walk the list in order. A template stands for its own list at the point
+// where it is referenced, so that its capabilities are ranked right there.
+//
+   ent.lnum = lnum;
+   do {if (cap->ctmp) {AddCaps(cap->ctmp, lnum, rank); continue;}
+       ent.rank = rank++;
+       ent.priv = cap->priv;
+       std::vector<Entry> &ents = nodes[Insert(cap->path, cap->plen)].ents;
+       it = std::lower_bound(ents.begin(), ents.end(), ent,
+                             [](const Entry &a, const Entry &b)
+                               {return a.lnum < b.lnum;});
+
+// Should a path appear more than once in a list the first one always wins
+//
+       if (it == ents.end() || it->lnum != lnum) ents.insert(it, ent);
+      } while((cap = cap->next));
+}
+
+/******************************************************************************/
+/* Private:                      F i n d K i d                                */
+/******************************************************************************/
+
+int XrdAccPathTrie::FindKid(const Node &node, char c) const
+{
+   int lo = 0, hi = (int)node.kids.size() - 1;
+
+// Children are ordered by the first character of their label
+//
+   while(lo <= hi)
+        {int mid = (lo + hi) / 2;
+         char kc = nodes[node.kids[mid]].label[0];
+              if (kc == c) return node.kids[mid];
+         else if (kc <  c) lo = mid + 1;
+         else              hi = mid - 1;
+        }
+   return -1;
+}
+
+/******************************************************************************/
+/* Private:                       I n s e r t                                 */
+/******************************************************************************/
+
+int XrdAccPathTrie::Insert(const char *key, int klen)
+{
+   int n = 0, k, common;
+
+// Descend as far as the key matches, splitting an edge when the key ends
+// or diverges in its middle. Note that nodes may be reallocated as we add
+// to the vector so we only ever hold on to indexes.
+//
+   while(klen > 0)
+        {if ((k = FindKid(nodes[n], *key)) < 0)
+            {Node leaf;
+             leaf.label.assign(key, klen);
+             nodes.push_back(leaf);
+             k = (int)nodes.size() - 1;
+             std::vector<int> &kids = nodes[n].kids;
+             kids.insert(std::lower_bound(kids.begin(), kids.end(), k,
+                         [this](int a, int b)
+                           {return nodes[a].label[0] < nodes[b].label[0];}),k);
+             return k;
+            }
+
+         const std::string &label = nodes[k].label;
+         int llen = (int)label.size();
+         common = 1;
+         while(common < llen && common < klen && label[common] == key[common])
+              common++;
+
+         if (common < llen)
+            {Node mid;
+             mid.label = label.substr(0, common);
+             mid.kids.push_back(k);
+             nodes[k].label.erase(0, common);
+             nodes.push_back(mid);
+             int m = (int)nodes.size() - 1;
+             std::replace(nodes[n].kids.begin(), nodes[n].kids.end(), k, m);
+             k = m;
+            }
+
+         n = k; key += common; klen -= common;
+        }
+   return n;
+}
+
+/******************************************************************************/
+/*                                 P r i v s                                  */
+/******************************************************************************/
+
+int XrdAccPathTrie::Privs(      XrdAccPrivCaps &pathpriv,
+                          const char           *pathname,
+                          const int             pathlen,
+                          const int            *lnVec,
+                          const int             lnCnt) const
+{
+   static const int maxLN = 64;
+   int best[maxLN], hits = 0, n = 0, k, plen = pathlen;
+   const Entry *bEnt[maxLN];
+
+// Handle an oversized request in pieces, the result is the same
+//
+   if (lnCnt > maxLN)
+      return Privs(pathpriv, pathname, pathlen, lnVec, maxLN)
+           + Privs(pathpriv, pathname, pathlen, lnVec+maxLN, lnCnt-maxLN);
+
+   for (int i = 0; i < lnCnt; i++) best[i] = -1;
+
+// Descend along the path looking at every node whose key is a prefix of it
+//
+   do {const std::vector<Entry> &ents = nodes[n].ents;
+       if (!ents.empty())
+          {for (int i = 0; i < lnCnt; i++)
+               {Entry ent;
+                ent.lnum = lnVec[i];
+                std::vector<Entry>::const_iterator it =
+                     std::lower_bound(ents.begin(), ents.end(), ent,
+                                      [](const Entry &a, const Entry &b)
+                                        {return a.lnum < b.lnum;});
+                if (it != ents.end() && it->lnum == lnVec[i]
+                &&  (best[i] < 0 || it->rank < best[i]))
+                   {best[i] = it->rank; bEnt[i] = &(*it);}
+               }
+          }
+       if (!plen || (k = FindKid(nodes[n], *pathname)) < 0) break;
+       const std::string &label = nodes[k].label;
+       int llen = (int)label.size();
+       if (llen > plen || memcmp(label.data(), pathname, llen)) break;
+       pathname += llen; plen -= llen; n = k;
+      } while(1);
+
+// Combine the privileges of the winning capability of each list
+//
+   for (int i = 0; i < lnCnt; i++)
+       if (best[i] >= 0)
+          {pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs|bEnt[i]->priv.pprivs);
+           pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs|bEnt[i]->priv.nprivs);
+           hits++;
+          }
+   return hits;
+}
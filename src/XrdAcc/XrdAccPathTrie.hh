@@ -0,0 +1,99 @@
+#ifndef __ACC_PATHTRIE__
+#define __ACC_PATHTRIE__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d A c c P a t h T r i e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "XrdAcc/XrdAccPrivs.hh"
+
+class XrdAccCapability;
+
+/******************************************************************************/
+/*                        X r d A c c P a t h T r i e                         */
+/******************************************************************************/
+
+// The path trie is a compiled form of the capability lists of an authorization
+// database. Every capability path ends at a node of a radix trie keyed by path
+// prefix; the node records, for each list holding the path, the privileges and
+// the position of the capability in its list. A lookup descends the trie once
+// along the path and, for each list asked about, takes the privileges of the
+// matching capability that comes first in the list. This gives the same result
+// as calling XrdAccCapability::Privs() on each list without a substitution.
+//
+// The trie is built once per database load and is read-only afterwards so
+// that lookups need no locking beyond that of the access tables.
+//
+class XrdAccPathTrie
+{
+public:
+
+// Add() indexes a capability list, expanding any templates in place, and
+// assigns the list a number retrievable with XrdAccCapability::ListNum().
+// Adding a list that is already indexed has no effect.
+//
+void        Add(XrdAccCapability *cap);
+
+// Lists() returns the number of lists indexed.
+//
+int         Lists() const {return numLists;}
+
+// Privs() or's into pathpriv the privileges that each of the lists numbered
+// lnVec[0..lnCnt-1] grants for pathname and returns the number of lists that
+// had a matching capability. Unknown list numbers are ignored.
+//
+int         Privs(      XrdAccPrivCaps &pathpriv,
+                  const char           *pathname,
+                  const int             pathlen,
+                  const int            *lnVec,
+                  const int             lnCnt) const;
+
+            XrdAccPathTrie();
+           ~XrdAccPathTrie() {}
+
+private:
+
+struct Entry {int            lnum;    // List number
+              int            rank;    // Position of the capability in list
+              XrdAccPrivCaps priv;    // The capability's privileges
+             };
+
+struct Node  {std::string        label;  // Edge label leading to the node
+              std::vector<int>   kids;   // Children sorted by first char
+              std::vector<Entry> ents;   // Entries sorted by list number
+             };
+
+void        AddCaps(XrdAccCapability *cap, int lnum, int &rank);
+int         FindKid(const Node &node, char c) const;
+int         Insert(const char *key, int klen);
+
+std::vector<Node> nodes;                 // nodes[0] is the root
+int               numLists;
+};
+#endif
@@ -69,6 +69,8 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"buff.mem",        "Buffer bytes:"},
 {"buff.buffs",      "Buffer count:"},
 {"buff.adj",        "Buffer adjustments:"},
+{"buff.lreqs",      "Buffer local requests:"},
+{"buff.lhits",      "Buffer local hits:"},
 {"buff.xlreqs",     "Buffer XL requests:"},
 {"buff.xlmem",      "Buffer XL bytes:"},
 {"buff.xlbuffs",    "Buffer XL count:"},
@@ -81,6 +83,7 @@ std::map<const char *, const char *, vCmp> vnMap {
 {"link.tmo",        "Read request timeouts:"},
 {"link.stall",      "Number of partial reads:"},
 {"link.sfps",       "Number of partial sends:"},
+{"link.ktls",       "Bytes sent using kTLS:"},
 {"poll.att",        "Poll sockets:"},
 {"poll.en",         "Poll enables:"},
 {"poll.ev",         "Poll events: "},
@@ -0,0 +1,471 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C k s A d l e r 3 2 . c c                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+
+#include "XrdCks/XrdCksAdler32.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define XRDCKS_ADLER_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define XRDCKS_ADLER_NEON 1
+#include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+/*                        L o c a l   D e f i n e s                           */
+/******************************************************************************/
+
+/* The scalar kernel is the zlib 1.1.4 algorithm (license terms below). The
+   vector kernels compute exactly the same sums.
+   For a block of B bytes b[0..B-1] entered with sums s1 and s2:
+
+      s1' = s1 + sum(b[i])
+      s2' = s2 + B*s1 + sum((B-i)*b[i])
+
+   The byte sums come from sad (sum of absolute differences against zero) and
+   the weighted sums from a multiply-add against a vector of descending taps.
+   The B*s1 term is carried in a separate accumulator that is scaled once per
+   run of blocks. Runs are limited to NMAX bytes so that no 32 bit lane can
+   overflow before the modulo reduction, as in the scalar kernel.
+*/
+
+/* The following implementation of adler32 was derived from zlib and is
+                   * Copyright (C) 1995-1998 Mark Adler
+   Below are the zlib license terms for this implementation.
+*/
+  
+/* zlib.h -- interface of the 'zlib' general purpose compression library
+  version 1.1.4, March 11th, 2002
+
+  Copyright (C) 1995-2002 Jean-loup Gailly and Mark Adler
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  Jean-loup Gailly        Mark Adler
+  jloup@gzip.org          madler@alumni.caltech.edu
+
+
+  The data format used by the zlib library is described by RFCs (Request for
+  Comments) 1950 to 1952 in the files ftp://ds.internic.net/rfc/rfc1950.txt
+  (zlib format), rfc1951.txt (deflate format) and rfc1952.txt (gzip format).
+*/
+
+namespace
+{
+const uint32_t AdlerBase = 65521; // largest prime smaller than 65536
+const size_t   AdlerNMax = 5552;  // 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+
+#define DO1(buf)  {s1 += *buf++; s2 += s1;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+/******************************************************************************/
+/*                          a d l e r 3 2 _ t a i l                           */
+/******************************************************************************/
+
+// Scalar code for anything left over after the vector loop. The incomming
+// sums must already be reduced and blen must be less than AdlerNMax.
+//
+inline uint32_t adler32_tail(uint32_t s1, uint32_t s2,
+                             const unsigned char *buf, size_t blen)
+{
+   while(blen >= 16) {DO16(buf); blen -= 16;}
+   while(blen--) {DO1(buf);}
+   s1 %= AdlerBase; s2 %= AdlerBase;
+   return (s2 << 16) | s1;
+}
+
+/******************************************************************************/
+/*                        a d l e r 3 2 _ s c a l a r                         */
+/******************************************************************************/
+
+uint32_t adler32_scalar(uint32_t adler, const void *buff, size_t blen)
+{
+   const unsigned char *buf = (const unsigned char *)buff;
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t k;
+
+   while(blen >= AdlerNMax)
+        {k = AdlerNMax; blen -= k;
+         while(k >= 16) {DO16(buf); k -= 16;}
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return adler32_tail(s1, s2, buf, blen);
+}
+
+#ifdef XRDCKS_ADLER_X86
+/******************************************************************************/
+/*                         a d l e r 3 2 _ s s s e 3                          */
+/******************************************************************************/
+
+__attribute__((target("ssse3")))
+inline uint32_t hsum128(__m128i v)
+{
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)));
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)));
+   return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+__attribute__((target("ssse3")))
+uint32_t adler32_ssse3(uint32_t adler, const void *buff, size_t blen)
+{
+   static const size_t BSize = 32;
+   const unsigned char *buf = (const unsigned char *)buff;
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t blocks = blen / BSize;
+
+   const __m128i tap1 = _mm_setr_epi8(32,31,30,29,28,27,26,25,
+                                      24,23,22,21,20,19,18,17);
+   const __m128i tap2 = _mm_setr_epi8(16,15,14,13,12,11,10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i ones = _mm_set1_epi16(1);
+
+   blen -= blocks * BSize;
+   while(blocks)
+        {size_t n = AdlerNMax / BSize;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         __m128i v_ps = _mm_setr_epi32((int)(s1 * n), 0, 0, 0);
+         __m128i v_s2 = _mm_setr_epi32((int)s2, 0, 0, 0);
+         __m128i v_s1 = zero;
+         do {const __m128i b1 = _mm_loadu_si128((const __m128i *)buf);
+             const __m128i b2 = _mm_loadu_si128((const __m128i *)(buf+16));
+             v_ps = _mm_add_epi32(v_ps, v_s1);
+             v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(b1, zero));
+             v_s2 = _mm_add_epi32(v_s2,
+                    _mm_madd_epi16(_mm_maddubs_epi16(b1, tap1), ones));
+             v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(b2, zero));
+             v_s2 = _mm_add_epi32(v_s2,
+                    _mm_madd_epi16(_mm_maddubs_epi16(b2, tap2), ones));
+             buf += BSize;
+            } while(--n);
+         v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+         s1 += hsum128(v_s1);
+         s2  = hsum128(v_s2);
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return adler32_tail(s1, s2, buf, blen);
+}
+
+/******************************************************************************/
+/*                          a d l e r 3 2 _ a v x 2                           */
+/******************************************************************************/
+
+__attribute__((target("avx2")))
+inline uint32_t hsum256(__m256i v)
+{
+   __m128i h = _mm_add_epi32(_mm256_castsi256_si128(v),
+                             _mm256_extracti128_si256(v, 1));
+   h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2,3,0,1)));
+   h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1,0,3,2)));
+   return (uint32_t)_mm_cvtsi128_si32(h);
+}
+
+__attribute__((target("avx2")))
+uint32_t adler32_avx2(uint32_t adler, const void *buff, size_t blen)
+{
+   static const size_t BSize = 64;
+   const unsigned char *buf = (const unsigned char *)buff;
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t blocks = blen / BSize;
+
+   const __m256i tap1 = _mm256_setr_epi8(64,63,62,61,60,59,58,57,
+                                         56,55,54,53,52,51,50,49,
+                                         48,47,46,45,44,43,42,41,
+                                         40,39,38,37,36,35,34,33);
+   const __m256i tap2 = _mm256_setr_epi8(32,31,30,29,28,27,26,25,
+                                         24,23,22,21,20,19,18,17,
+                                         16,15,14,13,12,11,10, 9,
+                                          8, 7, 6, 5, 4, 3, 2, 1);
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i ones = _mm256_set1_epi16(1);
+
+   blen -= blocks * BSize;
+   while(blocks)
+        {size_t n = AdlerNMax / BSize;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         __m256i v_ps = _mm256_setr_epi32((int)(s1 * n), 0, 0, 0, 0, 0, 0, 0);
+         __m256i v_s2 = _mm256_setr_epi32((int)s2, 0, 0, 0, 0, 0, 0, 0);
+         __m256i v_s1 = zero;
+         do {const __m256i b1 = _mm256_loadu_si256((const __m256i *)buf);
+             const __m256i b2 = _mm256_loadu_si256((const __m256i *)(buf+32));
+             v_ps = _mm256_add_epi32(v_ps, v_s1);
+             v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(b1, zero));
+             v_s2 = _mm256_add_epi32(v_s2,
+                    _mm256_madd_epi16(_mm256_maddubs_epi16(b1, tap1), ones));
+             v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(b2, zero));
+             v_s2 = _mm256_add_epi32(v_s2,
+                    _mm256_madd_epi16(_mm256_maddubs_epi16(b2, tap2), ones));
+             buf += BSize;
+            } while(--n);
+         v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 6));
+         s1 += hsum256(v_s1);
+         s2  = hsum256(v_s2);
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return adler32_tail(s1, s2, buf, blen);
+}
+
+/******************************************************************************/
+/*                        a d l e r 3 2 _ a v x 5 1 2                         */
+/******************************************************************************/
+
+// Note that the reduction intrinsics trigger bogus uninitialized warnings in
+// some gcc versions, so we do the horizontal sum the long way.
+//
+__attribute__((target("avx512f")))
+inline uint32_t hsum512(__m512i v)
+{
+   uint32_t lane[16], sum = 0;
+   _mm512_storeu_si512((void *)lane, v);
+   for (int i = 0; i < 16; i++) sum += lane[i];
+   return sum;
+}
+
+__attribute__((target("avx512f,avx512bw")))
+uint32_t adler32_avx512(uint32_t adler, const void *buff, size_t blen)
+{
+   static const size_t BSize = 64;
+   const unsigned char *buf = (const unsigned char *)buff;
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t blocks = blen / BSize;
+
+   const __m512i tap  = _mm512_set_epi8( 1, 2, 3, 4, 5, 6, 7, 8,
+                                         9,10,11,12,13,14,15,16,
+                                        17,18,19,20,21,22,23,24,
+                                        25,26,27,28,29,30,31,32,
+                                        33,34,35,36,37,38,39,40,
+                                        41,42,43,44,45,46,47,48,
+                                        49,50,51,52,53,54,55,56,
+                                        57,58,59,60,61,62,63,64);
+   const __m512i zero = _mm512_setzero_si512();
+   const __m512i ones = _mm512_set1_epi16(1);
+
+   blen -= blocks * BSize;
+   while(blocks)
+        {size_t n = AdlerNMax / BSize;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         __m512i v_ps = _mm512_set_epi32(0, 0, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0, (int)(s1 * n));
+         __m512i v_s2 = _mm512_set_epi32(0, 0, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 0, 0, 0, (int)s2);
+         __m512i v_s1 = zero;
+         do {const __m512i b = _mm512_loadu_si512((const void *)buf);
+             v_ps = _mm512_add_epi32(v_ps, v_s1);
+             v_s1 = _mm512_add_epi32(v_s1, _mm512_sad_epu8(b, zero));
+             v_s2 = _mm512_add_epi32(v_s2,
+                    _mm512_madd_epi16(_mm512_maddubs_epi16(b, tap), ones));
+             buf += BSize;
+            } while(--n);
+         s1 += hsum512(v_s1);
+         s2  = hsum512(v_s2) + (hsum512(v_ps) << 6);
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return adler32_tail(s1, s2, buf, blen);
+}
+#endif
+
+#ifdef XRDCKS_ADLER_NEON
+/******************************************************************************/
+/*                          a d l e r 3 2 _ n e o n                           */
+/******************************************************************************/
+
+uint32_t adler32_neon(uint32_t adler, const void *buff, size_t blen)
+{
+   static const size_t BSize = 32;
+   static const uint16_t taps[32] = {32,31,30,29,28,27,26,25,
+                                     24,23,22,21,20,19,18,17,
+                                     16,15,14,13,12,11,10, 9,
+                                      8, 7, 6, 5, 4, 3, 2, 1};
+   const unsigned char *buf = (const unsigned char *)buff;
+   uint32_t s1 = adler & 0xffff, s2 = adler >> 16;
+   size_t blocks = blen / BSize;
+
+   blen -= blocks * BSize;
+   while(blocks)
+        {size_t n = AdlerNMax / BSize;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         uint32x4_t v_s2 = vsetq_lane_u32((uint32_t)(s1 * n), vdupq_n_u32(0), 0);
+         uint32x4_t v_s1 = vdupq_n_u32(0);
+         uint16x8_t v_c1 = vdupq_n_u16(0), v_c2 = vdupq_n_u16(0);
+         uint16x8_t v_c3 = vdupq_n_u16(0), v_c4 = vdupq_n_u16(0);
+         do {const uint8x16_t b1 = vld1q_u8(buf);
+             const uint8x16_t b2 = vld1q_u8(buf + 16);
+             v_s2 = vaddq_u32(v_s2, v_s1);
+             v_s1 = vpadalq_u16(v_s1, vpadalq_u8(vpaddlq_u8(b1), b2));
+             v_c1 = vaddw_u8(v_c1, vget_low_u8 (b1));
+             v_c2 = vaddw_u8(v_c2, vget_high_u8(b1));
+             v_c3 = vaddw_u8(v_c3, vget_low_u8 (b2));
+             v_c4 = vaddw_u8(v_c4, vget_high_u8(b2));
+             buf += BSize;
+            } while(--n);
+         v_s2 = vshlq_n_u32(v_s2, 5);
+         v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_c1), vld1_u16(taps +  0));
+         v_s2 = vmlal_u16(v_s2, vget_high_u16(v_c1), vld1_u16(taps +  4));
+         v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_c2), vld1_u16(taps +  8));
+         v_s2 = vmlal_u16(v_s2, vget_high_u16(v_c2), vld1_u16(taps + 12));
+         v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_c3), vld1_u16(taps + 16));
+         v_s2 = vmlal_u16(v_s2, vget_high_u16(v_c3), vld1_u16(taps + 20));
+         v_s2 = vmlal_u16(v_s2, vget_low_u16 (v_c4), vld1_u16(taps + 24));
+         v_s2 = vmlal_u16(v_s2, vget_high_u16(v_c4), vld1_u16(taps + 28));
+         s1 += vaddvq_u32(v_s1);
+         s2 += vaddvq_u32(v_s2);
+         s1 %= AdlerBase; s2 %= AdlerBase;
+        }
+   return adler32_tail(s1, s2, buf, blen);
+}
+#endif
+
+/******************************************************************************/
+/*                           K e r n e l   T a b l e                          */
+/******************************************************************************/
+
+struct adlerKernel
+      {const char            *name;
+       XrdCksAdler32::Kernel  kern;
+       bool                 (*usable)();
+      };
+
+bool isUsable() {return true;}
+
+#ifdef XRDCKS_ADLER_X86
+bool hasSSSE3()  {return __builtin_cpu_supports("ssse3");}
+bool hasAVX2()   {return __builtin_cpu_supports("avx2");}
+bool hasAVX512() {return __builtin_cpu_supports("avx512f")
+                      && __builtin_cpu_supports("avx512bw");}
+#endif
+
+// The table is ordered from most to least preferred kernel.
+//
+const adlerKernel kernTab[] =
+{
+#ifdef XRDCKS_ADLER_X86
+   {"avx512", adler32_avx512, hasAVX512},
+   {"avx2",   adler32_avx2,   hasAVX2},
+   {"ssse3",  adler32_ssse3,  hasSSSE3},
+#endif
+#ifdef XRDCKS_ADLER_NEON
+   {"neon",   adler32_neon,   isUsable},
+#endif
+   {"scalar", adler32_scalar, isUsable}
+};
+
+const adlerKernel *bestKernel()
+{
+   const adlerKernel *kP = kernTab;
+
+   while(!(kP->usable())) kP++; // The scalar kernel is always usable
+   return kP;
+}
+}
+
+/******************************************************************************/
+/*                                  C a l c                                   */
+/******************************************************************************/
+
+uint32_t XrdCksAdler32::Calc(uint32_t adler, const void *buff, size_t blen)
+{
+   static const Kernel kern = bestKernel()->kern;
+
+   return kern(adler, buff, blen);
+}
+
+/******************************************************************************/
+/*                                C a l c S W                                 */
+/******************************************************************************/
+
+uint32_t XrdCksAdler32::CalcSW(uint32_t adler, const void *buff, size_t blen)
+{
+   return adler32_scalar(adler, buff, blen);
+}
+
+/******************************************************************************/
+/*                               C o m b i n e                                */
+/******************************************************************************/
+
+// This is the zlib adler32_combine() computation. The low half of the second
+// checksum is simply added while the high half also picks up len2 copies of
+// the low half of the first checksum.
+//
+uint32_t XrdCksAdler32::Combine(uint32_t adler1, uint32_t adler2, uint64_t len2)
+{
+   uint32_t rem  = (uint32_t)(len2 % AdlerBase);
+   uint32_t sum1 = adler1 & 0xffff;
+   uint32_t sum2 = (uint32_t)(((uint64_t)rem * sum1) % AdlerBase);
+
+   sum1 += (adler2 & 0xffff) + AdlerBase - 1;
+   sum2 += (adler1 >> 16) + (adler2 >> 16) + AdlerBase - rem;
+   if (sum1 >= AdlerBase) sum1 -= AdlerBase;
+   if (sum1 >= AdlerBase) sum1 -= AdlerBase;
+   if (sum2 >= (AdlerBase << 1)) sum2 -= (AdlerBase << 1);
+   if (sum2 >= AdlerBase) sum2 -= AdlerBase;
+   return sum1 | (sum2 << 16);
+}
+
+/******************************************************************************/
+/*                                E n g i n e                                 */
+/******************************************************************************/
+
+XrdCksAdler32::Kernel XrdCksAdler32::Engine(const char *kname)
+{
+   if (!kname) return bestKernel()->kern;
+
+   for (const adlerKernel &k : kernTab)
+       if (!strcmp(kname, k.name)) return (k.usable() ? k.kern : 0);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  N a m e                                   */
+/******************************************************************************/
+
+const char *XrdCksAdler32::Name() {return bestKernel()->name;}
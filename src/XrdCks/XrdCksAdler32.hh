@@ -0,0 +1,106 @@
+#ifndef __XRDCKSADLER32_HH__
+#define __XRDCKSADLER32_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d C k s A d l e r 3 2 . h h                       */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+//! This class provides vectorized adler32 kernels. The kernel used by Calc()
+//! is selected once at run time based on the capabilities of the cpu. All
+//! kernels produce results that are bit-identical to the scalar kernel.
+//------------------------------------------------------------------------------
+
+class XrdCksAdler32
+{
+public:
+
+typedef uint32_t (*Kernel)(uint32_t adler, const void *buff, size_t blen);
+
+//------------------------------------------------------------------------------
+//! Compute a running adler32 checksum using the best available kernel.
+//!
+//! @param  adler  The previous checksum value. The initial value of a checksum
+//!                sequence must be 1 (i.e. adler32 of the empty string).
+//! @param  buff   Pointer to the data to be checksummed.
+//! @param  blen   The number of bytes pointed to by buff.
+//!
+//! @return The updated adler32 checksum.
+//------------------------------------------------------------------------------
+
+static uint32_t Calc(uint32_t adler, const void *buff, size_t blen);
+
+//------------------------------------------------------------------------------
+//! Compute a running adler32 checksum using the portable scalar kernel.
+//!
+//! @param  adler  The previous checksum value (see Calc()).
+//! @param  buff   Pointer to the data to be checksummed.
+//! @param  blen   The number of bytes pointed to by buff.
+//!
+//! @return The updated adler32 checksum.
+//------------------------------------------------------------------------------
+
+static uint32_t CalcSW(uint32_t adler, const void *buff, size_t blen);
+
+//------------------------------------------------------------------------------
+//! Combine the adler32 checksums of two adjacent pieces of data so that the
+//! result is the checksum of their concatenation.
+//!
+//! @param  adler1 The checksum of the first piece.
+//! @param  adler2 The checksum of the second piece (started with 1).
+//! @param  len2   The length of the second piece in bytes.
+//!
+//! @return The adler32 checksum of the first piece followed by the second.
+//------------------------------------------------------------------------------
+
+static uint32_t Combine(uint32_t adler1, uint32_t adler2, uint64_t len2);
+
+//------------------------------------------------------------------------------
+//! Obtain a specific kernel (mainly used for testing and benchmarking).
+//!
+//! @param  kname  The kernel name: "scalar", "ssse3", "avx2", "avx512", "neon".
+//!                When nil, the kernel that Calc() uses is returned.
+//!
+//! @return Pointer to the kernel or nil if it is not supported on this host.
+//------------------------------------------------------------------------------
+
+static Kernel   Engine(const char *kname=0);
+
+//------------------------------------------------------------------------------
+//! Get the name of the kernel that Calc() uses.
+//!
+//! @return The kernel name.
+//------------------------------------------------------------------------------
+
+static const char *Name();
+
+                XrdCksAdler32() {}
+               ~XrdCksAdler32() {}
+};
+#endif
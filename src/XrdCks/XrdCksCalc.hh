@@ -129,6 +129,39 @@ virtual void  Update(const char *Buff, int BLen) = 0;
 virtual      ~XrdCksCalc() {}
 };
 
+/******************************************************************************/
+/*                 C o m b i n a b l e   C h e c k s u m s                    */
+/******************************************************************************/
+
+/*! A checksum calculation object may optionally also inherit this class when
+    the checksums of adjacent pieces of data can be mathematically combined
+    (e.g. adler32 and the CRC family). The checksum manager then computes the
+    checksum of a large file in pieces on several threads and merges them.
+*/
+
+class XrdCksCalcMerge
+{
+public:
+
+//------------------------------------------------------------------------------
+//! Merge the running checksum of the data that immediately follows the data
+//! already accounted for by this object.
+//!
+//! @param    part   -> Checksum object, obtained from New() of this object,
+//!                     used to compute the following piece of data. Final()
+//!                     must not have been called on it.
+//! @param    pLen   -> The number of bytes accounted for by part.
+//!
+//! @return   true if the checksums were merged and false if part is not a
+//!           compatible checksum object.
+//------------------------------------------------------------------------------
+
+virtual bool  Merge(XrdCksCalc &part, long long pLen) = 0;
+
+              XrdCksCalcMerge() {}
+virtual      ~XrdCksCalcMerge() {}
+};
+
 /******************************************************************************/
 /*               C h e c k s u m   O b j e c t   C r e a t o r                */
 /******************************************************************************/
@@ -38,7 +38,7 @@
 #include "XrdCks/XrdCksCalc.hh"
 #include "XrdSys/XrdSysPlatform.hh"
   
-class XrdCksCalccrc32 : public XrdCksCalc
+class XrdCksCalccrc32 : public XrdCksCalc, public XrdCksCalcMerge
 {
 public:
 
@@ -58,6 +58,8 @@ char *Final() {char buff[sizeof(long long)];
 
 void        Init() {C32Result = CRC32_XINIT; TotLen = 0;}
 
+bool        Merge(XrdCksCalc &part, long long pLen);
+
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32;}
 
 void        Update(const char *Buff, int BLen);
@@ -70,7 +72,6 @@ virtual    ~XrdCksCalccrc32() {}
 private:
 static const unsigned int CRC32_XINIT = 0;
 static const unsigned int CRC32_XOROT = 0xffffffff;
-static       unsigned int crctable[256];
              unsigned int C32Result;
              unsigned int TheResult;
              long long    TotLen;
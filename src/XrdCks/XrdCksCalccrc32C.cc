@@ -1,4 +1,5 @@
 #include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdOuc/XrdOucCRCEngine.hh"
 
 /*
     C++ implementation of CRC-32C checksums based upon
@@ -30,6 +31,15 @@ const char *XrdCksCalccrc32C::Type(int &csSz)
 
 XrdCksCalc *XrdCksCalccrc32C::New() { return (XrdCksCalc *)new XrdCksCalccrc32C; }
 
+bool XrdCksCalccrc32C::Merge(XrdCksCalc &part, long long pLen)
+{
+    XrdCksCalccrc32C *cP = dynamic_cast<XrdCksCalccrc32C *>(&part);
+    if (!cP) return false;
+    C32CResult = XrdOucCRCEngine::Combine(XrdOucCRCEngine::CRC32C, C32CResult,
+                                          cP->C32CResult, pLen);
+    return true;
+}
+
 void XrdCksCalccrc32C::Init()
 {
     C32CResult = C32C_XINIT;
@@ -39,13 +39,15 @@
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdOuc/XrdOucCRC.hh"
 
-class XrdCksCalccrc32C : public XrdCksCalc
+class XrdCksCalccrc32C : public XrdCksCalc, public XrdCksCalcMerge
 {
 public:
     char *Final();
     
     void Init();
     
+    bool Merge(XrdCksCalc &part, long long pLen);
+    
     XrdCksCalc *New(); 
     void Update(const char *Buff, int BLen);
     const char *Type(int &csSz);
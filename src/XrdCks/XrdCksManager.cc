@@ -54,6 +54,7 @@
 #include "XrdSys/XrdSysFAttr.hh"
 #include "XrdSys/XrdSysPlugin.hh"
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
 
 #ifndef ENOATTR
 #define ENOATTR ENODATA
@@ -65,7 +66,139 @@
 
 namespace
 {
-int CksOpts = 0;
+int CksOpts    = 0;
+int CksThreads = 1;
+
+// Parallel checksums are only worth it when each thread gets a decent amount
+// of data. Piece boundaries are kept at multiples of pieceAln so that they
+// can always be memory mapped.
+//
+const off_t pieceMin = 64*1024*1024;
+const off_t pieceAln =  1*1024*1024;
+
+// Pipelined checksums use a ring of read buffers filled by a read-ahead
+// thread while the calling thread computes the checksum.
+//
+const int    pipeNum = 4;
+const size_t pipeBsz = 8*1024*1024;
+
+/******************************************************************************/
+/*                               c a l c M a p                                */
+/******************************************************************************/
+
+// Compute the checksum over [Offset, Offset+Length) one segment at a time
+// using mmap I/O. Returns 0 upon success and -errno otherwise.
+//
+int calcMap(XrdSysError *eDest, const char *Pfn, int fd, off_t Offset,
+            off_t Length, size_t segSize, XrdCksCalc *csP)
+{
+   char  *inBuff;
+   size_t ioSize, calcSize = Length;
+   int rc = 0;
+
+   ioSize = (Length < (off_t)segSize ? Length : segSize);
+   while(calcSize)
+        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
+#if defined(__FreeBSD__)
+                       MAP_RESERVED0040|MAP_PRIVATE, fd, Offset)) == MAP_FAILED)
+#elif defined(__GNU__)
+                       MAP_PRIVATE, fd, Offset)) == MAP_FAILED)
+#else
+                       MAP_NORESERVE|MAP_PRIVATE, fd, Offset)) == MAP_FAILED)
+#endif
+            {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
+         madvise(inBuff, ioSize, MADV_SEQUENTIAL);
+         csP->Update(inBuff, ioSize);
+         calcSize -= ioSize; Offset += ioSize;
+         if (munmap(inBuff, ioSize) < 0)
+            {rc = errno; eDest->Emsg("Cks",rc,"unmap memory for",Pfn); break;}
+         if (calcSize < segSize) ioSize = calcSize;
+        }
+
+// Return if we failed
+//
+   if (calcSize) return (rc ? -rc : -EIO);
+   return 0;
+}
+
+/******************************************************************************/
+/*                   P a r a l l e l   C h e c k s u m s                      */
+/******************************************************************************/
+
+struct cksPiece
+      {XrdSysError *eDest;
+       const char  *Pfn;
+       XrdCksCalc  *csP;
+       off_t        Offset;
+       off_t        Length;
+       size_t       segSize;
+       pthread_t    tid;
+       int          fd;
+       int          rc;
+       bool         isRun;
+      };
+
+void *cksPieceRun(void *pp)
+{
+   cksPiece *pP = (cksPiece *)pp;
+
+   pP->rc = calcMap(pP->eDest, pP->Pfn, pP->fd, pP->Offset, pP->Length,
+                    pP->segSize, pP->csP);
+   return 0;
+}
+
+/******************************************************************************/
+/*                   P i p e l i n e d   C h e c k s u m s                    */
+/******************************************************************************/
+
+struct cksPipe
+      {XrdSysSemaphore  Empty;
+       XrdSysSemaphore  Full;
+       char            *Buff[pipeNum];
+       ssize_t          Blen[pipeNum];  // Bytes read or -errno
+       off_t            fSize;
+       int              fd;
+       RAtomic_bool     Stop;
+
+                        cksPipe(int ifd, off_t fsz)
+                               : Empty(pipeNum), Full(0), fSize(fsz), fd(ifd),
+                                 Stop(false)
+                               {memset(Buff, 0, sizeof(Buff));}
+                       ~cksPipe() {for (int i = 0; i < pipeNum; i++)
+                                       if (Buff[i]) free(Buff[i]);
+                                  }
+      };
+
+void *cksPipeRead(void *pp)
+{
+   cksPipe *pP = (cksPipe *)pp;
+   off_t Offset = 0;
+   int   slot = 0;
+
+// Read ahead filling each free buffer in turn until we reach end of file or
+// encounter an error. The consumer stops us if it runs into trouble.
+//
+   while(Offset < pP->fSize)
+        {pP->Empty.Wait();
+         if (pP->Stop) break;
+         size_t  bsz = pipeBsz, got = 0;
+         ssize_t rlen = 0;
+         if ((off_t)bsz > pP->fSize - Offset) bsz = pP->fSize - Offset;
+         while(got < bsz)
+              {rlen = pread(pP->fd, pP->Buff[slot]+got, bsz-got, Offset+got);
+               if (rlen > 0) got += rlen;
+                  else if (rlen < 0 && errno == EINTR) continue;
+                  else break;
+              }
+         pP->Blen[slot] = (got == bsz ? (ssize_t)got
+                                      : (rlen < 0 ? -errno : -EIO));
+         Offset += bsz;
+         pP->Full.Post();
+         if (pP->Blen[slot] < 0) break;
+         slot = (slot + 1) % pipeNum;
+        }
+   return 0;
+}
 }
   
 /******************************************************************************/
@@ -167,10 +300,7 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
             ~ioFD() {if (FD >= 0) close(FD);}
         } In;
    struct stat Stat;
-   char *inBuff;
-   off_t  Offset=0, fileSize;
-   size_t ioSize, calcSize;
-   int rc;
+   off_t  fileSize;
 
 // Open the input file
 //
@@ -180,34 +310,136 @@ int XrdCksManager::Calc(const char *Pfn, time_t &MTime, XrdCksCalc *csP)
 //
    if (fstat(In.FD, &Stat)) return -errno;
    if (!(Stat.st_mode & S_IFREG)) return -EPERM;
-   calcSize = fileSize = Stat.st_size;
+   fileSize = Stat.st_size;
    MTime = Stat.st_mtime;
 
+// If we have more than one thread available then either split the checksum
+// into pieces (if the checksum can be combined) or at least overlap the i/o
+// with the checksum computation.
+//
+   if (CksThreads > 1 && fileSize > (off_t)pipeBsz)
+      {XrdCksCalcMerge *mP = dynamic_cast<XrdCksCalcMerge *>(csP);
+       if (mP && fileSize >= 2*pieceMin)
+          return CalcSplit(Pfn, In.FD, fileSize, csP, mP);
+       return CalcPipe(Pfn, In.FD, fileSize, csP);
+      }
+
 // We now compute checksum 64MB at a time using mmap I/O
 //
-   ioSize = (fileSize < (off_t)segSize ? fileSize : segSize); rc = 0;
+   return calcMap(eDest, Pfn, In.FD, 0, fileSize, segSize, csP);
+}
+
+/******************************************************************************/
+/* Private:                     C a l c P i p e                               */
+/******************************************************************************/
+
+int XrdCksManager::CalcPipe(const char *Pfn, int fd, off_t fileSize,
+                            XrdCksCalc *csP)
+{
+   cksPipe   Pipe(fd, fileSize);
+   pthread_t tid;
+   off_t     calcSize = fileSize;
+   int       rc = 0, slot = 0;
+
+// Allocate the read buffers
+//
+   for (int i = 0; i < pipeNum; i++)
+       if (!(Pipe.Buff[i] = (char *)malloc(pipeBsz))) return -ENOMEM;
+
+// Start the read-ahead thread. If we can't, do it the old fashioned way.
+//
+   if (XrdSysThread::Run(&tid, cksPipeRead, (void *)&Pipe, XRDSYSTHREAD_HOLD,
+                         "cks read-ahead"))
+      {eDest->Emsg("Cks", errno, "start read-ahead thread for", Pfn);
+       return calcMap(eDest, Pfn, fd, 0, fileSize, segSize, csP);
+      }
+
+// Checksum each buffer as it becomes available and hand it back to the
+// read-ahead thread.
+//
    while(calcSize)
-        {if ((inBuff = (char *)mmap(0, ioSize, PROT_READ, 
-#if defined(__FreeBSD__)
-                       MAP_RESERVED0040|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#elif defined(__GNU__)
-                       MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#else
-                       MAP_NORESERVE|MAP_PRIVATE, In.FD, Offset)) == MAP_FAILED)
-#endif
-            {rc = errno; eDest->Emsg("Cks", rc, "memory map", Pfn); break;}
-         madvise(inBuff, ioSize, MADV_SEQUENTIAL);
-         csP->Update(inBuff, ioSize);
-         calcSize -= ioSize; Offset += ioSize;
-         if (munmap(inBuff, ioSize) < 0)
-            {rc = errno; eDest->Emsg("Cks",rc,"unmap memory for",Pfn); break;}
-         if (calcSize < (size_t)segSize) ioSize = calcSize;
+        {Pipe.Full.Wait();
+         if (Pipe.Blen[slot] < 0)
+            {rc = (int)Pipe.Blen[slot];
+             eDest->Emsg("Cks", -rc, "read", Pfn);
+             break;
+            }
+         csP->Update(Pipe.Buff[slot], (int)Pipe.Blen[slot]);
+         calcSize -= Pipe.Blen[slot];
+         Pipe.Empty.Post();
+         slot = (slot + 1) % pipeNum;
         }
 
-// Return if we failed
+// Make sure the read-ahead thread is done before the buffers go away
 //
-   if (calcSize) return (rc ? -rc : -EIO);
-   return 0;
+   Pipe.Stop = true;
+   Pipe.Empty.Post();
+   XrdSysThread::Join(tid, 0);
+   return rc;
+}
+
+/******************************************************************************/
+/* Private:                    C a l c S p l i t                              */
+/******************************************************************************/
+
+int XrdCksManager::CalcSplit(const char *Pfn, int fd, off_t fileSize,
+                             XrdCksCalc *csP, XrdCksCalcMerge *mP)
+{
+   int pNum = CksThreads;
+   off_t pSize;
+
+// Determine how many pieces we will have; each at least pieceMin bytes long
+// and aligned so that it can be memory mapped.
+//
+   if (fileSize / pieceMin < pNum) pNum = fileSize / pieceMin;
+   pSize = (fileSize / pNum + pieceAln - 1) / pieceAln * pieceAln;
+   pNum  = (fileSize + pSize - 1) / pSize;
+
+   cksPiece *Piece = new cksPiece[pNum];
+   off_t Offset = 0;
+   int   rc = 0;
+
+// Fill out each piece. The first piece is computed by us into the caller's
+// object while all the others get a fresh object and their own thread.
+//
+   for (int i = 0; i < pNum; i++)
+       {Piece[i].eDest   = eDest;
+        Piece[i].Pfn     = Pfn;
+        Piece[i].csP     = (i ? csP->New() : csP);
+        Piece[i].Offset  = Offset;
+        Piece[i].Length  = (fileSize - Offset < pSize ? fileSize-Offset : pSize);
+        Piece[i].segSize = segSize;
+        Piece[i].fd      = fd;
+        Piece[i].rc      = -ENOMEM;
+        Piece[i].isRun   = false;
+        Offset += Piece[i].Length;
+        if (i && Piece[i].csP)
+           Piece[i].isRun = !XrdSysThread::Run(&Piece[i].tid, cksPieceRun,
+                                               (void *)&Piece[i],
+                                               XRDSYSTHREAD_HOLD, "cks piece");
+       }
+
+// Compute our piece and any piece that could not get a thread
+//
+   for (int i = 0; i < pNum; i++)
+       if (!Piece[i].isRun && Piece[i].csP) cksPieceRun((void *)&Piece[i]);
+
+// Wait for all the threads to finish and merge the results in file order
+//
+   for (int i = 0; i < pNum; i++)
+       {if (Piece[i].isRun) XrdSysThread::Join(Piece[i].tid, 0);
+        if (!rc && (rc = Piece[i].rc) == 0 && i
+        &&  !mP->Merge(*Piece[i].csP, Piece[i].Length))
+           {eDest->Emsg("Cks", "Unable to merge checksum pieces for", Pfn);
+            rc = -ENOTSUP;
+           }
+        if (i && Piece[i].csP) Piece[i].csP->Recycle();
+       }
+
+// All done
+//
+   delete [] Piece;
+   return rc;
 }
 
 /******************************************************************************/
@@ -630,6 +862,12 @@ int XrdCksManager::Set(const char *Pfn, XrdCksData &Cks, int myTime)
 /******************************************************************************/
 
 void XrdCksManager::SetOpts(int opt) {CksOpts = opt;}
+
+/******************************************************************************/
+/*                            S e t T h r e a d s                             */
+/******************************************************************************/
+
+void XrdCksManager::SetThreads(int num) {CksThreads = (num > 0 ? num : 1);}
   
 /******************************************************************************/
 /*                                   V e r                                    */
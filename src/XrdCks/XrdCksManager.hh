@@ -41,6 +41,7 @@
 */
 
 class  XrdCksCalc;
+class  XrdCksCalcMerge;
 class  XrdCksLoader;
 class  XrdSysError;
 struct XrdVersionInfo;
@@ -74,6 +75,12 @@ virtual int         Set(  const char *Pfn, XrdCksData &Cks, int myTime=0);
 
         void        SetOpts(int opt);
 
+// Set the number of threads used to compute the checksum of a single file.
+// With more than one, file reads overlap the computation and checksums that
+// can be combined (see XrdCksCalcMerge) are computed in parallel pieces.
+//
+static  void        SetThreads(int num);
+
 virtual int         Ver(  const char *Pfn, XrdCksData &Cks);
 
                     XrdCksManager(XrdSysError *erP, int iosz,
@@ -111,6 +118,9 @@ struct csInfo
                                 {memset(Name, 0, sizeof(Name));}
       };
 
+int     CalcPipe(const char *Pfn, int fd, off_t fileSize, XrdCksCalc *csP);
+int     CalcSplit(const char *Pfn, int fd, off_t fileSize, XrdCksCalc *csP,
+                  XrdCksCalcMerge *mP);
 int     Config(const char *cFN, csInfo &Info);
 csInfo *Find(const char *Name);
 
@@ -0,0 +1,415 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClBlockPool.hh"
+#include "XrdCl/XrdClConstants.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  using namespace XrdCl;
+
+  //----------------------------------------------------------------------------
+  // Size classes: class c holds blocks of MinBlock << c bytes
+  //----------------------------------------------------------------------------
+  const int      NumClasses = 15;
+  const uint32_t PageSize   = 4096;
+  const int      NumShards  = 64;         // shards of the block registry
+  const int      TLMax      = 32;         // blocks per class in a thread cache
+  const uint32_t TLBytes    = 256*1024;   // bytes per class in a thread cache
+
+  static_assert( ( BlockPool::MinBlock << ( NumClasses - 1 ) ) ==
+                 BlockPool::MaxBlock, "Inconsistent block pool classes" );
+
+  inline int SizeClass( uint32_t size )
+  {
+    if( size <= BlockPool::MinBlock ) return 0;
+    return 32 - __builtin_clz( ( size - 1 ) / BlockPool::MinBlock );
+  }
+
+  inline uint32_t ClassSize( int cls )
+  {
+    return BlockPool::MinBlock << cls;
+  }
+
+  inline int ThreadMax( int cls )
+  {
+    int n = TLBytes / ClassSize( cls );
+    return n < 2 ? 2 : ( n > TLMax ? TLMax : n );
+  }
+
+  //----------------------------------------------------------------------------
+  // The registry of all blocks owned by the pool and their size class. Blocks
+  // are only added and removed when they are obtained from and given back to
+  // the system allocator, lookups share the lock of their shard.
+  //----------------------------------------------------------------------------
+  struct Registry
+  {
+    Registry(): count( 0 ) { }
+
+    struct alignas(64) Shard
+    {
+      std::shared_mutex                     mtx;
+      std::unordered_map<const char*, int>  blocks;
+    };
+
+    Shard &ShardOf( const char *block )
+    {
+      uint64_t h = uint64_t( uintptr_t( block ) >> 6 ) * 0x9E3779B97F4A7C15ULL;
+      return shards[h >> 58];
+    }
+
+    void Add( const char *block, int cls )
+    {
+      Shard &shard = ShardOf( block );
+      std::unique_lock<std::shared_mutex> lck( shard.mtx );
+      shard.blocks[block] = cls;
+      count.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    void Remove( const char *block )
+    {
+      Shard &shard = ShardOf( block );
+      std::unique_lock<std::shared_mutex> lck( shard.mtx );
+      shard.blocks.erase( block );
+      count.fetch_sub( 1, std::memory_order_relaxed );
+    }
+
+    //--------------------------------------------------------------------------
+    // Get the size class of a block, -1 if the pool does not own it
+    //--------------------------------------------------------------------------
+    int Find( const char *block )
+    {
+      if( !count.load( std::memory_order_relaxed ) ) return -1;
+      Shard &shard = ShardOf( block );
+      std::shared_lock<std::shared_mutex> lck( shard.mtx );
+      auto itr = shard.blocks.find( block );
+      return itr == shard.blocks.end() ? -1 : itr->second;
+    }
+
+    Shard                 shards[NumShards];
+    std::atomic<uint64_t> count;
+  };
+
+  static_assert( NumShards == 64, "Registry::ShardOf assumes 64 shards" );
+
+  //----------------------------------------------------------------------------
+  // Statistics counters. Every thread counts into its own so that allocations
+  // with the pool off do not all hit the same cache line, GetStats adds them
+  // up.
+  //----------------------------------------------------------------------------
+  enum Counter { SysAllocs = 0, SysFrees, NumCounters };
+
+  struct ThreadStats
+  {
+    ThreadStats();
+    ~ThreadStats();
+
+    std::atomic<uint64_t> counts[NumCounters];
+  };
+
+  void Count( Counter what );
+
+  //----------------------------------------------------------------------------
+  // The shared part of the pool
+  //----------------------------------------------------------------------------
+  struct SharedPool
+  {
+    SharedPool(): maxCached( DefaultBufferPoolSize ), cachedBytes( 0 )
+    {
+      for( int i = 0; i < NumCounters; ++i ) counts[i] = 0;
+    }
+
+    char *SysAlloc( int cls )
+    {
+      void *ptr = nullptr;
+      size_t align = ClassSize( cls ) >= PageSize ? PageSize : 64;
+      if( posix_memalign( &ptr, align, ClassSize( cls ) ) ) return nullptr;
+      char *block = static_cast<char*>( ptr );
+      registry.Add( block, cls );
+      Count( SysAllocs );
+      return block;
+    }
+
+    void SysFree( char *block )
+    {
+      registry.Remove( block );
+      free( block );
+      Count( SysFrees );
+    }
+
+    //--------------------------------------------------------------------------
+    // Move up to n blocks of a class into vec, return how many were moved
+    //--------------------------------------------------------------------------
+    int Take( int cls, char **vec, int n )
+    {
+      std::unique_lock<std::mutex> lck( classes[cls].mtx );
+      std::vector<char*> &free = classes[cls].blocks;
+      int k = 0;
+      while( k < n && !free.empty() )
+      {
+        vec[k++] = free.back();
+        free.pop_back();
+      }
+      cachedBytes.fetch_sub( uint64_t( k ) * ClassSize( cls ),
+                             std::memory_order_relaxed );
+      return k;
+    }
+
+    //--------------------------------------------------------------------------
+    // Keep as many of the n blocks as the limit allows, free the rest
+    //--------------------------------------------------------------------------
+    void Give( int cls, char **vec, int n )
+    {
+      uint64_t sz = ClassSize( cls );
+      int k = 0;
+      {
+        std::unique_lock<std::mutex> lck( classes[cls].mtx );
+        while( k < n && cachedBytes.load( std::memory_order_relaxed ) + sz
+                        <= maxCached.load( std::memory_order_relaxed ) )
+        {
+          classes[cls].blocks.push_back( vec[k++] );
+          cachedBytes.fetch_add( sz, std::memory_order_relaxed );
+        }
+      }
+      for( ; k < n; ++k ) SysFree( vec[k] );
+    }
+
+    struct alignas(64) Class
+    {
+      std::mutex         mtx;
+      std::vector<char*> blocks;
+    };
+
+    Class                     classes[NumClasses];
+    Registry                  registry;
+    std::atomic<uint64_t>     maxCached;
+    std::atomic<uint64_t>     cachedBytes;
+    std::mutex                statsMtx;
+    std::vector<ThreadStats*> threadStats;         // of the running threads
+    std::atomic<uint64_t>     counts[NumCounters]; // of the exited threads
+  };
+
+  //----------------------------------------------------------------------------
+  // The shared pool is never destroyed as thread caches may be flushed into
+  // it during process exit
+  //----------------------------------------------------------------------------
+  SharedPool &Shared()
+  {
+    static SharedPool *pool = new SharedPool();
+    return *pool;
+  }
+
+  //----------------------------------------------------------------------------
+  // A thread's counters register with the shared pool and are added to its
+  // totals when the thread exits. Blocks freed after that, e.g. by the
+  // destructors of other thread local objects, are counted there directly.
+  //----------------------------------------------------------------------------
+  thread_local bool tlStatsGone = false;
+
+  ThreadStats::ThreadStats()
+  {
+    for( int i = 0; i < NumCounters; ++i ) counts[i] = 0;
+    SharedPool &shared = Shared();
+    std::unique_lock<std::mutex> lck( shared.statsMtx );
+    shared.threadStats.push_back( this );
+  }
+
+  ThreadStats::~ThreadStats()
+  {
+    SharedPool &shared = Shared();
+    std::unique_lock<std::mutex> lck( shared.statsMtx );
+    for( int i = 0; i < NumCounters; ++i )
+      shared.counts[i].fetch_add( counts[i].load( std::memory_order_relaxed ),
+                                  std::memory_order_relaxed );
+    for( size_t i = 0; i < shared.threadStats.size(); ++i )
+      if( shared.threadStats[i] == this )
+      {
+        shared.threadStats[i] = shared.threadStats.back();
+        shared.threadStats.pop_back();
+        break;
+      }
+    tlStatsGone = true;
+  }
+
+  thread_local ThreadStats tlStats;
+
+  //----------------------------------------------------------------------------
+  // Only the owning thread changes its counters, so no atomic increment is
+  // needed
+  //----------------------------------------------------------------------------
+  void Count( Counter what )
+  {
+    if( tlStatsGone )
+    {
+      Shared().counts[what].fetch_add( 1, std::memory_order_relaxed );
+      return;
+    }
+    std::atomic<uint64_t> &ctr = tlStats.counts[what];
+    ctr.store( ctr.load( std::memory_order_relaxed ) + 1,
+               std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Per thread cache
+  //----------------------------------------------------------------------------
+  struct ThreadCache
+  {
+    //--------------------------------------------------------------------------
+    // The counters must outlive the cache as it may free blocks on the way
+    // out, so they are set up first
+    //--------------------------------------------------------------------------
+    ThreadCache(): stats( &tlStats )
+    {
+      for( int i = 0; i < NumClasses; ++i ) count[i] = 0;
+    }
+
+    ~ThreadCache()
+    {
+      for( int i = 0; i < NumClasses; ++i )
+        if( count[i] ) Shared().Give( i, blocks[i], count[i] );
+    }
+
+    ThreadStats *stats;
+    char        *blocks[NumClasses][TLMax];
+    int          count[NumClasses];
+  };
+
+  thread_local ThreadCache tlCache;
+
+  std::atomic<bool> poolOn( DefaultBufferPoolSize != 0 );
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Get a block
+  //----------------------------------------------------------------------------
+  char *BlockPool::Allocate( uint32_t size )
+  {
+    //--------------------------------------------------------------------------
+    // Large blocks and everything while the pool is off come from malloc
+    //--------------------------------------------------------------------------
+    if( size > MaxBlock || !poolOn.load( std::memory_order_relaxed ) )
+    {
+      Count( SysAllocs );
+      return static_cast<char*>( malloc( size ) );
+    }
+
+    //--------------------------------------------------------------------------
+    // Take a block from the thread cache, refilling it from the shared cache
+    // with half its capacity if it is empty
+    //--------------------------------------------------------------------------
+    int          cls = SizeClass( size );
+    ThreadCache &tc  = tlCache;
+    if( !tc.count[cls] )
+      tc.count[cls] = Shared().Take( cls, tc.blocks[cls],
+                                     ( ThreadMax( cls ) + 1 ) / 2 );
+    if( tc.count[cls] )
+      return tc.blocks[cls][--tc.count[cls]];
+
+    return Shared().SysAlloc( cls );
+  }
+
+  //----------------------------------------------------------------------------
+  // Give back a block
+  //----------------------------------------------------------------------------
+  void BlockPool::Free( char *block )
+  {
+    if( !block ) return;
+    SharedPool &shared = Shared();
+    int         cls    = shared.registry.Find( block );
+    if( cls < 0 )
+    {
+      Count( SysFrees );
+      free( block );
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // Blocks allocated before the pool was switched off go back to the system
+    //--------------------------------------------------------------------------
+    if( !poolOn.load( std::memory_order_relaxed ) )
+    {
+      shared.SysFree( block );
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // Keep the block in the thread cache, if it is full hand half of it over
+    // to the shared cache
+    //--------------------------------------------------------------------------
+    int          max = ThreadMax( cls );
+    ThreadCache &tc  = tlCache;
+    if( tc.count[cls] >= max )
+    {
+      int n = max / 2;
+      tc.count[cls] -= n;
+      shared.Give( cls, &tc.blocks[cls][tc.count[cls]], n );
+    }
+    tc.blocks[cls][tc.count[cls]++] = block;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the size of a pooled block
+  //----------------------------------------------------------------------------
+  uint32_t BlockPool::Capacity( const char *block )
+  {
+    if( !block ) return 0;
+    int cls = Shared().registry.Find( block );
+    return cls < 0 ? 0 : ClassSize( cls );
+  }
+
+  //----------------------------------------------------------------------------
+  // Set the size of the shared cache
+  //----------------------------------------------------------------------------
+  void BlockPool::SetMaxCached( uint64_t bytes )
+  {
+    Shared().maxCached.store( bytes, std::memory_order_relaxed );
+    poolOn.store( bytes != 0, std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the statistics
+  //----------------------------------------------------------------------------
+  BlockPool::Stats BlockPool::GetStats()
+  {
+    SharedPool &shared = Shared();
+    uint64_t counts[NumCounters];
+    {
+      std::unique_lock<std::mutex> lck( shared.statsMtx );
+      for( int i = 0; i < NumCounters; ++i )
+      {
+        counts[i] = shared.counts[i].load( std::memory_order_relaxed );
+        for( ThreadStats *ts : shared.threadStats )
+          counts[i] += ts->counts[i].load( std::memory_order_relaxed );
+      }
+    }
+    Stats stats;
+    stats.sysAllocs   = counts[SysAllocs];
+    stats.sysFrees    = counts[SysFrees];
+    stats.cachedBytes = shared.cachedBytes.load( std::memory_order_relaxed );
+    return stats;
+  }
+}
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_BLOCK_POOL_HH__
+#define __XRD_CL_BLOCK_POOL_HH__
+
+#include <cstdint>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Pool of the memory blocks backing Buffer and Message objects
+  //!
+  //! Blocks come in power of two size classes from 64 bytes to 1MB. Blocks of
+  //! a page or more are page aligned, smaller ones are cache line aligned.
+  //! Every thread keeps a small cache of free blocks per class so that most
+  //! allocations take no lock; the surplus goes to a shared cache bounded by
+  //! the BufferPoolSize setting. Larger requests, and all requests while the
+  //! pool is off (the default), are served by the system allocator. The pool
+  //! keeps track of its blocks itself so the memory of a Buffer may come from
+  //! either source.
+  //!
+  //! Pooled blocks must not be handed to free() or realloc(), so the pool
+  //! should only be switched on when all code handling Buffer and Message
+  //! objects has been built against this version.
+  //----------------------------------------------------------------------------
+  class BlockPool
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Statistics
+      //------------------------------------------------------------------------
+      struct Stats
+      {
+        uint64_t sysAllocs;   //!< blocks obtained from the system allocator
+        uint64_t sysFrees;    //!< blocks returned to the system allocator
+        uint64_t cachedBytes; //!< bytes held in the shared cache
+      };
+
+      //------------------------------------------------------------------------
+      //! Get a block of at least size bytes
+      //!
+      //! @param size the number of bytes needed, must not be zero
+      //! @return the block or nullptr if no memory is available
+      //------------------------------------------------------------------------
+      static char *Allocate( uint32_t size );
+
+      //------------------------------------------------------------------------
+      //! Give back a block obtained with Allocate or with malloc
+      //!
+      //! @param block the block, may be nullptr
+      //------------------------------------------------------------------------
+      static void Free( char *block );
+
+      //------------------------------------------------------------------------
+      //! Get the usable size of a pooled block
+      //!
+      //! @param block the block
+      //! @return the size of the block if it belongs to the pool, 0 if it was
+      //!         obtained with malloc
+      //------------------------------------------------------------------------
+      static uint32_t Capacity( const char *block );
+
+      //------------------------------------------------------------------------
+      //! Set the number of bytes the shared cache may hold, 0 disables the
+      //! pool altogether
+      //------------------------------------------------------------------------
+      static void SetMaxCached( uint64_t bytes );
+
+      //------------------------------------------------------------------------
+      //! Get the statistics
+      //------------------------------------------------------------------------
+      static Stats GetStats();
+
+      //------------------------------------------------------------------------
+      //! Smallest and largest pooled block size
+      //------------------------------------------------------------------------
+      static const uint32_t MinBlock = 64;
+      static const uint32_t MaxBlock = 1024*1024;
+  };
+}
+
+#endif // __XRD_CL_BLOCK_POOL_HH__
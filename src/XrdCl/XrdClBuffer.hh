@@ -25,10 +25,15 @@
 #include <cstring>
 #include <string>
 
+#include "XrdCl/XrdClBlockPool.hh"
+
 namespace XrdCl
 {
   //----------------------------------------------------------------------------
   //! Binary blob representation
+  //!
+  //! The memory comes from the BlockPool unless it was handed over with
+  //! Grab(). Memory handed out by Release() is always malloc'ed.
   //----------------------------------------------------------------------------
   class Buffer
   {
@@ -87,9 +92,30 @@ namespace XrdCl
       //------------------------------------------------------------------------
       void ReAllocate( uint32_t size )
       {
-        pBuffer = (char *)realloc( pBuffer, size );
-        if( !pBuffer )
-          throw std::bad_alloc();
+        //----------------------------------------------------------------------
+        // Pooled blocks are only replaced if they are too small, others are
+        // reallocated in place as they may have come from outside
+        //----------------------------------------------------------------------
+        uint32_t capacity = BlockPool::Capacity( pBuffer );
+        if( capacity || !pBuffer )
+        {
+          if( size > capacity || !pBuffer )
+          {
+            char *buffer = BlockPool::Allocate( size ? size : 1 );
+            if( !buffer )
+              throw std::bad_alloc();
+            if( pBuffer )
+              memcpy( buffer, pBuffer, pSize < size ? pSize : size );
+            BlockPool::Free( pBuffer );
+            pBuffer = buffer;
+          }
+        }
+        else
+        {
+          pBuffer = (char *)realloc( pBuffer, size );
+          if( !pBuffer )
+            throw std::bad_alloc();
+        }
         pSize = size;
       }
 
@@ -98,7 +124,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       void Free()
       {
-        free( pBuffer );
+        BlockPool::Free( pBuffer );
         pBuffer = 0;
         pSize   = 0;
         pCursor = 0;
@@ -112,7 +138,7 @@ namespace XrdCl
         if( !size )
          return;
 
-        pBuffer = (char *)malloc( size );
+        pBuffer = BlockPool::Allocate( size );
         if( !pBuffer )
           throw std::bad_alloc();
         pSize = size;
@@ -238,6 +264,14 @@ namespace XrdCl
       char *Release()
       {
         char *buffer = pBuffer;
+        if( BlockPool::Capacity( pBuffer ) )
+        {
+          buffer = (char *)malloc( pSize ? pSize : 1 );
+          if( !buffer )
+            throw std::bad_alloc();
+          memcpy( buffer, pBuffer, pSize );
+          BlockPool::Free( pBuffer );
+        }
         pBuffer = 0;
         pSize   = 0;
         pCursor = 0;
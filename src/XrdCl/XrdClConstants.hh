@@ -49,6 +49,7 @@ namespace XrdCl
   // Environment settings
   //----------------------------------------------------------------------------
   const int DefaultSubStreamsPerChannel    = 1;
+  const int DefaultAdaptiveSubStreams      = 0;
   const int DefaultConnectionWindow        = 120;
   const int DefaultConnectionRetry         = 5;
   const int DefaultRequestTimeout          = 1800;
@@ -58,6 +59,7 @@ namespace XrdCl
   const int DefaultRunForkHandler          = 1;
   const int DefaultRedirectLimit           = 16;
   const int DefaultWorkerThreads           = 3;
+  const int DefaultWorkerQueues            = 0;
   const int DefaultCPChunkSize             = 8388608;
   const int DefaultCPParallelChunks        = 4;
   const int DefaultDataServerTTL           = 300;
@@ -96,6 +98,8 @@ namespace XrdCl
   const int DefaultRetryWrtAtLBLimit       = 3;
   const int DefaultCpRetry                 = 0;
   const int DefaultCpUsePgWrtRd            = 1;
+  const int DefaultBufferPoolSize          = 0;
+  const int DefaultZipIndexSpan            = 1048576;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -112,6 +116,7 @@ namespace XrdCl
   const char * const DefaultClConfFile         = "";
   const char * const DefaultCpTarget           = "";
   const char * const DefaultCpRetryPolicy      = "force";
+  const char * const DefaultZipIndexDir        = "";
 
   inline static std::string to_lower( std::string str )
   {
@@ -122,6 +127,7 @@ namespace XrdCl
   static std::unordered_map<std::string, int> theDefaultInts
     {
       { to_lower( "SubStreamsPerChannel" ),    DefaultSubStreamsPerChannel },
+      { to_lower( "AdaptiveSubStreams" ),      DefaultAdaptiveSubStreams },
       { to_lower( "ConnectionWindow" ),        DefaultConnectionWindow },
       { to_lower( "ConnectionRetry" ),         DefaultConnectionRetry },
       { to_lower( "RequestTimeout" ),          DefaultRequestTimeout },
@@ -131,6 +137,7 @@ namespace XrdCl
       { to_lower( "RunForkHandler" ),          DefaultRunForkHandler },
       { to_lower( "RedirectLimit" ),           DefaultRedirectLimit },
       { to_lower( "WorkerThreads" ),           DefaultWorkerThreads },
+      { to_lower( "WorkerQueues" ),            DefaultWorkerQueues },
       { to_lower( "CPChunkSize" ),             DefaultCPChunkSize },
       { to_lower( "CPParallelChunks" ),        DefaultCPParallelChunks },
       { to_lower( "DataServerTTL" ),           DefaultDataServerTTL },
@@ -161,7 +168,9 @@ namespace XrdCl
       { to_lower( "ZipMtlnCksum" ),            DefaultZipMtlnCksum },
       { to_lower( "IPNoShuffle" ),             DefaultIPNoShuffle },
       { to_lower( "WantTlsOnNoPgrw" ),         DefaultWantTlsOnNoPgrw },
-      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit }
+      { to_lower( "RetryWrtAtLBLimit" ),       DefaultRetryWrtAtLBLimit },
+      { to_lower( "BufferPoolSize" ),          DefaultBufferPoolSize },
+      { to_lower( "ZipIndexSpan" ),            DefaultZipIndexSpan }
     };
 
   static std::unordered_map<std::string, std::string> theDefaultStrs
@@ -180,7 +189,8 @@ namespace XrdCl
       { to_lower( "ClConfDir" ),          DefaultClConfDir },
       { to_lower( "DefaultClConfFile" ),  DefaultClConfFile },
       { to_lower( "CpTarget" ),           DefaultCpTarget },
-      { to_lower( "CpRetryPolicy" ),      DefaultCpRetryPolicy }
+      { to_lower( "CpRetryPolicy" ),      DefaultCpRetryPolicy },
+      { to_lower( "ZipIndexDir" ),        DefaultZipIndexDir }
     };
 }
 
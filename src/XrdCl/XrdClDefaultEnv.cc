@@ -17,6 +17,7 @@
 //------------------------------------------------------------------------------
 
 #include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClBlockPool.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClPostMaster.hh"
 #include "XrdCl/XrdClLog.hh"
@@ -268,11 +269,13 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "RequestTimeout",          DefaultRequestTimeout          );
     REGISTER_VAR_INT( varsInt, "StreamTimeout",           DefaultStreamTimeout           );
     REGISTER_VAR_INT( varsInt, "SubStreamsPerChannel",    DefaultSubStreamsPerChannel    );
+    REGISTER_VAR_INT( varsInt, "AdaptiveSubStreams",      DefaultAdaptiveSubStreams      );
     REGISTER_VAR_INT( varsInt, "TimeoutResolution",       DefaultTimeoutResolution       );
     REGISTER_VAR_INT( varsInt, "StreamErrorWindow",       DefaultStreamErrorWindow       );
     REGISTER_VAR_INT( varsInt, "RunForkHandler",          DefaultRunForkHandler          );
     REGISTER_VAR_INT( varsInt, "RedirectLimit",           DefaultRedirectLimit           );
     REGISTER_VAR_INT( varsInt, "WorkerThreads",           DefaultWorkerThreads           );
+    REGISTER_VAR_INT( varsInt, "WorkerQueues",            DefaultWorkerQueues            );
     REGISTER_VAR_INT( varsInt, "CPChunkSize",             DefaultCPChunkSize             );
     REGISTER_VAR_INT( varsInt, "CPParallelChunks",        DefaultCPParallelChunks        );
     REGISTER_VAR_INT( varsInt, "DataServerTTL",           DefaultDataServerTTL           );
@@ -306,6 +309,8 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "XRateThreshold",          DefaultXRateThreshold          );
     REGISTER_VAR_INT( varsInt, "CpRetry",                 DefaultCpRetry                 );
     REGISTER_VAR_INT( varsInt, "CpUsePgWrtRd",            DefaultCpUsePgWrtRd            );
+    REGISTER_VAR_INT( varsInt, "BufferPoolSize",          DefaultBufferPoolSize          );
+    REGISTER_VAR_INT( varsInt, "ZipIndexSpan",            DefaultZipIndexSpan            );
 
     REGISTER_VAR_STR( varsStr, "ClientMonitor",           DefaultClientMonitor           );
     REGISTER_VAR_STR( varsStr, "ClientMonitorParam",      DefaultClientMonitorParam      );
@@ -319,6 +324,7 @@ namespace XrdCl
     REGISTER_VAR_STR( varsStr, "TlsDbgLvl",               DefaultTlsDbgLvl               );
     REGISTER_VAR_STR( varsStr, "CpTarget",                DefaultCpTarget                );
     REGISTER_VAR_STR( varsStr, "CpRetryPolicy",           DefaultCpRetryPolicy           );
+    REGISTER_VAR_STR( varsStr, "ZipIndexDir",             DefaultZipIndexDir             );
 
     //--------------------------------------------------------------------------
     // Process the configuration files
@@ -696,6 +702,13 @@ namespace XrdCl
     sPlugInManager->ProcessEnvironmentSettings();
     sForkHandler->RegisterFileTimer( sFileTimer );
 
+    //--------------------------------------------------------------------------
+    // Size the shared cache of the message buffer pool, 0 turns pooling off
+    //--------------------------------------------------------------------------
+    int poolSize = DefaultBufferPoolSize;
+    sEnv->GetInt( "BufferPoolSize", poolSize );
+    BlockPool::SetMaxCached( poolSize > 0 ? poolSize : 0 );
+
     //--------------------------------------------------------------------------
     // MacOSX library loading is completely moronic. We cannot dlopen a library
     // from a thread other than a main thread, so we-pre dlopen all the
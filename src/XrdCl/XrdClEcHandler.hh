@@ -99,20 +99,9 @@ namespace XrdCl
       size_t nbpages = chunk->length / XrdSys::PageSize;
       if( chunk->length % XrdSys::PageSize )
         ++nbpages;
-      cksums.reserve( nbpages );
+      cksums.resize( nbpages );
 
-      size_t  size = chunk->length;
-      char   *buffer = reinterpret_cast<char*>( chunk->buffer );
-
-      for( size_t pg = 0; pg < nbpages; ++pg )
-      {
-        size_t pgsize = XrdSys::PageSize;
-        if( pgsize > size ) pgsize = size;
-        uint32_t crcval = XrdOucCRC::Calc32C( buffer, pgsize );
-        cksums.push_back( crcval );
-        buffer += pgsize;
-        size   -= pgsize;
-      }
+      XrdOucCRC::Calc32C( chunk->buffer, chunk->length, cksums.data() );
   
       PageInfo *pages = new PageInfo(chunk->offset, chunk->length, chunk->buffer, std::move(cksums));
       delete rdresp;
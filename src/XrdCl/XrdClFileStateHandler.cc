@@ -160,10 +160,16 @@ namespace
         uint32_t               pgsize    = XrdSys::PageSize - pgoff % XrdSys::PageSize;
         if( pgsize > bytesRead ) pgsize = bytesRead;
 
+        //----------------------------------------------------------------------
+        // Compute the checksums of all the pages in one go, this allows the
+        // checksum engine to work on several pages in parallel
+        //----------------------------------------------------------------------
+        std::vector<uint32_t> crcvals;
+        XrdOucPgrwUtils::csCalc( buffer, pgoff, bytesRead, crcvals );
+
         for( size_t pgnb = 0; pgnb < nbpages; ++pgnb )
         {
-          uint32_t crcval = XrdOucCRC::Calc32C( buffer, pgsize );
-          if( crcval != cksums[pgnb] )
+          if( crcvals[pgnb] != cksums[pgnb] )
           {
             Log *log = DefaultEnv::GetLog();
             log->Info( FileMsg, "[%p@%s] Received corrupted page, will retry page #%zu.",
@@ -357,20 +363,9 @@ namespace
           size_t nbpages = chunk->length / XrdSys::PageSize;
           if( chunk->length % XrdSys::PageSize )
             ++nbpages;
-          cksums.reserve( nbpages );
+          cksums.resize( nbpages );
 
-          size_t  size = chunk->length;
-          char   *buffer = reinterpret_cast<char*>( chunk->buffer );
-
-          for( size_t pg = 0; pg < nbpages; ++pg )
-          {
-            size_t pgsize = XrdSys::PageSize;
-            if( pgsize > size ) pgsize = size;
-            uint32_t crcval = XrdOucCRC::Calc32C( buffer, pgsize );
-            cksums.push_back( crcval );
-            buffer += pgsize;
-            size   -= pgsize;
-          }
+          XrdOucCRC::Calc32C( chunk->buffer, chunk->length, cksums.data() );
         }
 
         PageInfo *pages = new PageInfo( chunk->offset, chunk->length,
@@ -25,6 +25,7 @@
 #include "XrdCl/XrdClConstants.hh"
 
 #include <arpa/inet.h>              // for network unmarshalling stuff
+#include <thread>
 
 namespace XrdCl
 {
@@ -48,15 +49,75 @@ namespace XrdCl
     return false;
   }
 
+  //----------------------------------------------------------------------------
+  // Take the ownership of a slot, spinning while another thread holds it
+  // unless told not to wait
+  //----------------------------------------------------------------------------
+  InQueue::SlotLock::SlotLock( Slot &slot, bool wait ): pSlot( slot ),
+                                                        pLocked( false )
+  {
+    static thread_local char token;
+    uintptr_t me = reinterpret_cast<uintptr_t>( &token );
+
+    if( pSlot.owner.load( std::memory_order_relaxed ) == me )
+    {
+      ++pSlot.depth;
+      pLocked = true;
+      return;
+    }
+
+    uintptr_t none = 0;
+    while( !pSlot.owner.compare_exchange_weak( none, me,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed ) )
+    {
+      if( !wait && none ) return;
+      if( none ) std::this_thread::yield();
+      none = 0;
+    }
+    pSlot.depth = 1;
+    pLocked     = true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Give up the ownership of a slot
+  //----------------------------------------------------------------------------
+  InQueue::SlotLock::~SlotLock()
+  {
+    if( pLocked && !--pSlot.depth )
+      pSlot.owner.store( 0, std::memory_order_release );
+  }
+
+  //----------------------------------------------------------------------------
+  // Install a handler
+  //----------------------------------------------------------------------------
+  void InQueue::Install( Slot &slot, uint16_t sid, MsgHandler *handler,
+                         time_t expires )
+  {
+    slot.handler = handler;
+    slot.expires = expires;
+    pActive.Set( sid );
+  }
+
+  //----------------------------------------------------------------------------
+  // Remove the handler
+  //----------------------------------------------------------------------------
+  void InQueue::Remove( Slot &slot, uint16_t sid )
+  {
+    slot.handler = 0;
+    slot.expires = 0;
+    pActive.Clear( sid );
+  }
+
   //----------------------------------------------------------------------------
   // Add a listener that should be notified about incoming messages
   //----------------------------------------------------------------------------
   void InQueue::AddMessageHandler( MsgHandler *handler, bool &rmMsg )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-
-    pHandlers[handlerSid] = HandlerAndExpire( handler, 0 );
+    Slot    &slot       = pSlots.Get( handlerSid );
+    SlotLock lck( slot );
+    Install( slot, handlerSid, handler, 0 );
   }
 
   //----------------------------------------------------------------------------
@@ -77,27 +138,29 @@ namespace XrdCl
       return handler;
     }
 
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    Slot *slot = pSlots.Find( msgSid );
+    if( !slot )
+      return handler;
 
-    if (it != pHandlers.end())
+    SlotLock lck( *slot );
+    if( slot->handler )
     {
       Log *log = DefaultEnv::GetLog();
-      handler = it->second.first;
+      handler = slot->handler;
       act     = handler->Examine( msg );
-      if( it->second.second == 0 ) {
-        it->second.second = handler->GetExpiration();
+      if( slot->expires == 0 ) {
+        slot->expires = handler->GetExpiration();
         log->Debug( ExDbgMsg, "[handler: %p] Assigned expiration %lld.",
-                    (void*)handler, (long long)it->second.second );
+                    (void*)handler, (long long)slot->expires );
       }
-      exp     = it->second.second;
+      exp     = slot->expires;
       log->Debug( ExDbgMsg, "[msg: %p] Assigned MsgHandler: %p.",
                   (void*)msg.get(), (void*)handler );
 
 
       if( act & MsgHandler::RemoveHandler )
       {
-        pHandlers.erase( it );
+        Remove( *slot, msgSid );
         log->Debug( ExDbgMsg, "[handler: %p] Removed MsgHandler: %p from the in-queue.",
                     (void*)handler, (void*)handler );
       }
@@ -119,8 +182,9 @@ namespace XrdCl
 				     time_t              expires )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    Slot    &slot       = pSlots.Get( handlerSid );
+    SlotLock lck( slot );
+    Install( slot, handlerSid, handler, expires );
   }
 
   //----------------------------------------------------------------------------
@@ -129,8 +193,12 @@ namespace XrdCl
   void InQueue::RemoveMessageHandler( MsgHandler *handler )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers.erase(handlerSid);
+    Slot    *slot       = pSlots.Find( handlerSid );
+    if( slot )
+    {
+      SlotLock lck( *slot );
+      Remove( *slot, handlerSid );
+    }
     Log *log = DefaultEnv::GetLog();
     log->Debug( ExDbgMsg, "[handler: %p] Removed MsgHandler: %p from the in-queue.",
                 (void*)handler, (void*)handler );
@@ -143,47 +211,49 @@ namespace XrdCl
   void InQueue::ReportStreamEvent( MsgHandler::StreamEvent event,
 				   XRootDStatus                    status )
   {
-    uint8_t action = 0;
-    XrdSysMutexHelper scopedLock( pMutex );
-    for( HandlerMap::iterator it = pHandlers.begin(); it != pHandlers.end(); )
+    pActive.ForEach( [&]( uint16_t sid )
     {
-      action = it->second.first->OnStreamEvent( event, status );
+      Slot *slot = pSlots.Find( sid );
+      if( !slot )
+        return;
+
+      SlotLock lck( *slot );
+      if( !slot->handler )
+        return;
 
+      uint8_t action = slot->handler->OnStreamEvent( event, status );
       if( action & MsgHandler::RemoveHandler )
-      {
-        auto next = it; ++next;
-        pHandlers.erase( it );
-        it = next;
-      }
-      else
-        ++it;
-    }
+        Remove( *slot, sid );
+    } );
   }
 
   //----------------------------------------------------------------------------
-  // Timeout handlers
+  // Timeout handlers, the slots busy with a message are left for the next
+  // round
   //----------------------------------------------------------------------------
   void InQueue::ReportTimeout( time_t now )
   {
     if( !now )
       now = ::time(0);
 
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.begin();
-    while( it != pHandlers.end() )
+    pActive.ForEach( [&]( uint16_t sid )
     {
-      if( it->second.second && it->second.second <= now )
+      Slot *slot = pSlots.Find( sid );
+      if( !slot )
+        return;
+
+      SlotLock lck( *slot, false );
+      if( !lck.IsLocked() || !slot->handler )
+        return;
+
+      if( slot->expires && slot->expires <= now )
       {
-        uint8_t act = it->second.first->OnStreamEvent( MsgHandler::Timeout,
+        uint8_t act = slot->handler->OnStreamEvent( MsgHandler::Timeout,
                                          Status( stError, errOperationExpired ) );
-        auto next = it; ++next;
         if( act & MsgHandler::RemoveHandler )
-          pHandlers.erase( it );
-        it = next;
+          Remove( *slot, sid );
       }
-      else
-        ++it;
-    }
+    } );
   }
 
   //----------------------------------------------------------------------------
@@ -192,19 +262,18 @@ namespace XrdCl
   void InQueue::AssignTimeout( MsgHandler *handler )
   {
     uint16_t handlerSid = handler->GetSid();
-    XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find( handlerSid );
-    if( it != pHandlers.end() )
-    {
-      if( it->second.second == 0 )
-      {
-        it->second.second   = handler->GetExpiration();
+    Slot    *slot       = pSlots.Find( handlerSid );
+    if( !slot )
+      return;
 
-        Log *log = DefaultEnv::GetLog();
-        log->Debug( ExDbgMsg, "[handler: %p] Assigned expiration %lld.",
-                    (void*)handler, (long long)it->second.second );
+    SlotLock lck( *slot );
+    if( slot->handler && slot->expires == 0 )
+    {
+      slot->expires = handler->GetExpiration();
 
-      }
+      Log *log = DefaultEnv::GetLog();
+      log->Debug( ExDbgMsg, "[handler: %p] Assigned expiration %lld.",
+                  (void*)handler, (long long)slot->expires );
     }
   }
 
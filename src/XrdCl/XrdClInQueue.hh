@@ -19,12 +19,12 @@
 #ifndef __XRD_CL_IN_QUEUE_HH__
 #define __XRD_CL_IN_QUEUE_HH__
 
-#include <XrdSys/XrdSysPthread.hh>
-#include <map>
+#include <atomic>
 #include <memory>
 #include <utility>
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdCl/XrdClPostMasterInterfaces.hh"
+#include "XrdCl/XrdClSIDTable.hh"
 
 namespace XrdCl
 {
@@ -32,6 +32,12 @@ namespace XrdCl
 
   //----------------------------------------------------------------------------
   //! A synchronize queue for incoming data
+  //!
+  //! The handlers are kept in a table indexed by the stream ID, a bitmap of
+  //! the occupied slots lets the timeout and stream event reports skip the
+  //! empty ones. There is no queue wide lock: every slot has an owner flag,
+  //! taken with a single compare and swap, that serializes the calls made to
+  //! its handler the way the queue mutex used to. The owner may re-enter.
   //----------------------------------------------------------------------------
   class InQueue
   {
@@ -107,10 +113,45 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool DiscardMessage(Message& msg, uint16_t& sid) const;
 
-      typedef std::pair<MsgHandler *, time_t> HandlerAndExpire;
-      typedef std::map<uint16_t, HandlerAndExpire> HandlerMap;
-      HandlerMap pHandlers;
-      XrdSysRecMutex pMutex;
+      //------------------------------------------------------------------------
+      //! A handler slot, the fields other than owner may only be accessed
+      //! by the owner of the slot
+      //------------------------------------------------------------------------
+      struct Slot
+      {
+        std::atomic<uintptr_t>  owner;
+        uint32_t                depth;
+        MsgHandler             *handler;
+        time_t                  expires;
+      };
+
+      //------------------------------------------------------------------------
+      //! Scoped ownership of a slot
+      //------------------------------------------------------------------------
+      class SlotLock
+      {
+        public:
+          SlotLock( Slot &slot, bool wait = true );
+          ~SlotLock();
+          bool IsLocked() const { return pLocked; }
+        private:
+          Slot &pSlot;
+          bool  pLocked;
+      };
+
+      //------------------------------------------------------------------------
+      //! Install a handler, must be called by the owner of the slot
+      //------------------------------------------------------------------------
+      void Install( Slot &slot, uint16_t sid, MsgHandler *handler,
+                    time_t expires );
+
+      //------------------------------------------------------------------------
+      //! Remove the handler, must be called by the owner of the slot
+      //------------------------------------------------------------------------
+      void Remove( Slot &slot, uint16_t sid );
+
+      SIDSlots<Slot> pSlots;
+      SIDBitmap      pActive;
   };
 }
 
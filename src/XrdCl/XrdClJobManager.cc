@@ -22,6 +22,9 @@
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdSys/XrdSysE2T.hh"
 
+#include <atomic>
+#include <deque>
+
 //------------------------------------------------------------------------------
 // The thread
 //------------------------------------------------------------------------------
@@ -36,8 +39,105 @@ extern "C"
   }
 }
 
+namespace
+{
+  //----------------------------------------------------------------------------
+  // The worker a thread belongs to, if any
+  //----------------------------------------------------------------------------
+  thread_local XrdCl::JobManager *workerOf    = 0;
+  thread_local uint32_t           workerIndex = 0;
+
+  //----------------------------------------------------------------------------
+  // Arguments of a worker thread with a queue of its own
+  //----------------------------------------------------------------------------
+  struct WorkerArg
+  {
+    XrdCl::JobManager *mgr;
+    uint32_t           index;
+  };
+}
+
+//------------------------------------------------------------------------------
+// The thread of a worker with a queue of its own
+//------------------------------------------------------------------------------
+extern "C"
+{
+  static void *RunQueueThread( void *arg )
+  {
+    WorkerArg *wa = (WorkerArg*)arg;
+    XrdCl::JobManager *mgr   = wa->mgr;
+    uint32_t           index = wa->index;
+    delete wa;
+    mgr->RunJobs( index );
+    return 0;
+  }
+
+  static void *RunForwardThread( void *arg )
+  {
+    using namespace XrdCl;
+    JobManager *mgr = (JobManager*)arg;
+    mgr->ForwardJobs();
+    return 0;
+  }
+}
+
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // The worker queues
+  //----------------------------------------------------------------------------
+  struct JobManager::WorkerQueues
+  {
+    //--------------------------------------------------------------------------
+    // The queue of a worker
+    //--------------------------------------------------------------------------
+    struct Queue
+    {
+      Queue(): sem( new XrdSysSemaphore( 0 ) ), idle( false ) { }
+      ~Queue() { delete sem; }
+
+      XrdSysMutex            mtx;
+      std::deque<JobHelper>  jobs;
+      XrdSysSemaphore       *sem;
+      std::atomic<bool>      idle;
+    };
+
+    WorkerQueues( uint32_t workers ): next( 0 ), forwarder( 0 )
+    {
+      for( uint32_t i = 0; i < workers; ++i )
+        queues.push_back( new Queue() );
+    }
+
+    ~WorkerQueues()
+    {
+      for( size_t i = 0; i < queues.size(); ++i )
+        delete queues[i];
+    }
+
+    std::vector<Queue*>    queues;
+    std::atomic<uint32_t>  next;
+    pthread_t              forwarder;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  JobManager::JobManager( uint32_t workers, bool perWorker ): pQueues( 0 )
+  {
+    pRunning = false;
+    pWorkers.resize( workers );
+    if( perWorker && workers )
+      pQueues = new WorkerQueues( workers );
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  JobManager::~JobManager()
+  {
+    delete pQueues;
+  }
+
   //----------------------------------------------------------------------------
   // Initialize the job manager
   //----------------------------------------------------------------------------
@@ -52,6 +152,15 @@ namespace XrdCl
   bool JobManager::Finalize()
   {
     pJobs.Clear();
+    if( pQueues )
+      for( size_t i = 0; i < pQueues->queues.size(); ++i )
+      {
+        WorkerQueues::Queue *q = pQueues->queues[i];
+        XrdSysMutexHelper scopedLock( q->mtx );
+        q->jobs.clear();
+        delete q->sem;
+        q->sem = new XrdSysSemaphore( 0 );
+      }
     return true;
   }
 
@@ -72,7 +181,15 @@ namespace XrdCl
 
     for( uint32_t i = 0; i < pWorkers.size(); ++i )
     {
-      int ret = ::pthread_create( &pWorkers[i], 0, ::RunRunnerThread, this );
+      int ret;
+      if( !pQueues )
+        ret = ::pthread_create( &pWorkers[i], 0, ::RunRunnerThread, this );
+      else
+      {
+        WorkerArg *wa = new WorkerArg{ this, i };
+        ret = ::pthread_create( &pWorkers[i], 0, ::RunQueueThread, wa );
+        if( ret != 0 ) delete wa;
+      }
       if( ret != 0 )
       {
         log->Error( JobMgrMsg, "Unable to spawn a job worker thread: %s",
@@ -82,8 +199,22 @@ namespace XrdCl
         return false;
       }
     }
+
+    //--------------------------------------------------------------------------
+    // With worker queues someone has to serve the shared queue as well
+    //--------------------------------------------------------------------------
+    if( pQueues &&
+        ::pthread_create( &pQueues->forwarder, 0, ::RunForwardThread, this ) )
+    {
+      log->Error( JobMgrMsg, "Unable to spawn the job forwarder thread: %s",
+                  XrdSysE2T( errno ) );
+      StopWorkers( pWorkers.size() );
+      return false;
+    }
+
     pRunning = true;
-    log->Debug( JobMgrMsg, "Job manager started, %zu workers", pWorkers.size() );
+    log->Debug( JobMgrMsg, "Job manager started, %zu workers, %s", pWorkers.size(),
+                !pQueues ? "shared queue" : "queue per worker" );
     return true;
   }
 
@@ -101,6 +232,11 @@ namespace XrdCl
       return false;
     }
 
+    if( pQueues )
+    {
+      pthread_cancel( pQueues->forwarder );
+      pthread_join( pQueues->forwarder, 0 );
+    }
     StopWorkers( pWorkers.size() );
 
     pRunning = false;
@@ -141,10 +277,11 @@ namespace XrdCl
   }
 
   //----------------------------------------------------------------------------
-  // Initialize the job manager
+  // Run the jobs
   //----------------------------------------------------------------------------
   void JobManager::RunJobs()
   {
+    workerOf = this;
     pthread_setcanceltype( PTHREAD_CANCEL_DEFERRED, 0 );
     for( ;; )
     {
@@ -154,4 +291,151 @@ namespace XrdCl
       pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, 0 );
     }
   }
+
+  //----------------------------------------------------------------------------
+  // Run the jobs of the given worker queue
+  //----------------------------------------------------------------------------
+  void JobManager::RunJobs( uint32_t worker )
+  {
+    workerOf    = this;
+    workerIndex = worker;
+    WorkerQueues::Queue *q = pQueues->queues[worker];
+    pthread_setcanceltype( PTHREAD_CANCEL_DEFERRED, 0 );
+    for( ;; )
+    {
+      //------------------------------------------------------------------------
+      // Look for work once more after declaring ourselves idle, a job queued
+      // in between may have been assigned to us
+      //------------------------------------------------------------------------
+      JobHelper h;
+      if( !TakeJob( worker, h ) )
+      {
+        q->idle.store( true );
+        bool found = TakeJob( worker, h );
+        if( !found )
+          q->sem->Wait();
+        q->idle.store( false );
+        if( !found )
+          continue;
+      }
+      pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, 0 );
+      h.job->Run( h.arg );
+      pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, 0 );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Hand the jobs put into the shared queue on to the worker queues
+  //----------------------------------------------------------------------------
+  void JobManager::ForwardJobs()
+  {
+    pthread_setcanceltype( PTHREAD_CANCEL_DEFERRED, 0 );
+    for( ;; )
+    {
+      JobHelper h = pJobs.Get();
+      pthread_setcancelstate( PTHREAD_CANCEL_DISABLE, 0 );
+      QueueJob( h.job, h.arg, 0 );
+      pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, 0 );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Add a job to be run
+  //----------------------------------------------------------------------------
+  void JobManager::QueueJob( Job *job, void *arg )
+  {
+    QueueJob( job, arg, 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Add a job to be run
+  //----------------------------------------------------------------------------
+  void JobManager::QueueJob( Job *job, void *arg, uint64_t affinity )
+  {
+    if( !pQueues )
+    {
+      pJobs.Put( JobHelper( job, arg ) );
+      return;
+    }
+
+    //--------------------------------------------------------------------------
+    // Pick the queue: by affinity, our own if we are a worker, otherwise
+    // round robin
+    //--------------------------------------------------------------------------
+    std::vector<WorkerQueues::Queue*> &queues = pQueues->queues;
+    uint32_t n = queues.size();
+    uint32_t target;
+    if( affinity )
+      target = ( ( affinity * 0x9E3779B97F4A7C15ULL ) >> 32 ) % n;
+    else if( workerOf == this )
+      target = workerIndex;
+    else
+      target = pQueues->next.fetch_add( 1, std::memory_order_relaxed ) % n;
+
+    WorkerQueues::Queue *q = queues[target];
+    {
+      XrdSysMutexHelper scopedLock( q->mtx );
+      q->jobs.push_back( JobHelper( job, arg ) );
+    }
+
+    //--------------------------------------------------------------------------
+    // Wake up the owner of the queue if it is idle, otherwise an idle worker
+    // that will steal the job; if nobody is idle the owner gets to it
+    //--------------------------------------------------------------------------
+    WorkerQueues::Queue *wake = q;
+    if( !q->idle.load() )
+      for( uint32_t i = 1; i < n; ++i )
+      {
+        WorkerQueues::Queue *other = queues[( target + i ) % n];
+        if( other->idle.load() )
+        {
+          wake = other;
+          break;
+        }
+      }
+    wake->sem->Post();
+  }
+
+  //----------------------------------------------------------------------------
+  // Take a job from the worker's own queue or steal one from another, the
+  // first pass over the other queues skips the busy ones
+  //----------------------------------------------------------------------------
+  bool JobManager::TakeJob( uint32_t worker, JobHelper &h )
+  {
+    std::vector<WorkerQueues::Queue*> &queues = pQueues->queues;
+    uint32_t n = queues.size();
+    for( int pass = 0; pass < 2; ++pass )
+    {
+      for( uint32_t i = 0; i < n; ++i )
+      {
+        WorkerQueues::Queue *q = queues[( worker + i ) % n];
+        if( i && !pass )
+        {
+          if( !q->mtx.CondLock() ) continue;
+        }
+        else
+        {
+          if( i == 0 && pass ) continue;
+          q->mtx.Lock();
+        }
+        bool found = !q->jobs.empty();
+        if( found )
+        {
+          h = q->jobs.front();
+          q->jobs.pop_front();
+        }
+        q->mtx.UnLock();
+        if( found ) return true;
+      }
+    }
+    return false;
+  }
+
+  //----------------------------------------------------------------------------
+  // Check if the calling thread is one of the workers
+  //----------------------------------------------------------------------------
+  bool JobManager::IsWorker()
+  {
+    return workerOf == this;
+  }
 }
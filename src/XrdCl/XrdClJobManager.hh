@@ -45,26 +45,31 @@ namespace XrdCl
   };
 
   //----------------------------------------------------------------------------
-  //! A synchronized queue
+  //! A pool of worker threads running jobs
+  //!
+  //! By default the workers share a single queue. Optionally every worker
+  //! gets a queue of its own: jobs queued by a worker go to its own queue,
+  //! jobs with an affinity key always go to the same queue, and the other
+  //! jobs are spread round robin. Idle workers steal jobs from the queues of
+  //! busy ones. Jobs put straight into the shared queue, as done by code
+  //! built against older versions of this header, are handed on to the
+  //! worker queues.
   //----------------------------------------------------------------------------
   class JobManager
   {
     public:
       //------------------------------------------------------------------------
       //! Constructor
+      //!
+      //! @param workers   number of worker threads
+      //! @param perWorker give every worker a queue of its own
       //------------------------------------------------------------------------
-      JobManager( uint32_t workers )
-      {
-        pRunning = false;
-        pWorkers.resize( workers );
-      }
+      JobManager( uint32_t workers, bool perWorker = false );
 
       //------------------------------------------------------------------------
       //! Destructor
       //------------------------------------------------------------------------
-      ~JobManager()
-      {
-      }
+      ~JobManager();
 
       //------------------------------------------------------------------------
       //! Initialize the job manager
@@ -89,23 +94,34 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Add a job to be run
       //------------------------------------------------------------------------
-      void QueueJob( Job *job, void *arg = 0 )
-      {
-        pJobs.Put( JobHelper( job, arg ) );
-      }
+      void QueueJob( Job *job, void *arg = 0 );
+
+      //------------------------------------------------------------------------
+      //! Add a job to be run, the jobs with the same non-zero affinity key
+      //! are queued to the same worker if the workers have queues of their
+      //! own
+      //------------------------------------------------------------------------
+      void QueueJob( Job *job, void *arg, uint64_t affinity );
 
       //------------------------------------------------------------------------
       //! Run the jobs
       //------------------------------------------------------------------------
       void RunJobs();
 
-      bool IsWorker()
-      {
-        pthread_t thread = pthread_self();
-        std::vector<pthread_t>::iterator itr =
-            std::find( pWorkers.begin(), pWorkers.end(), thread );
-        return itr != pWorkers.end();
-      }
+      //------------------------------------------------------------------------
+      //! Run the jobs of the given worker queue
+      //------------------------------------------------------------------------
+      void RunJobs( uint32_t worker );
+
+      //------------------------------------------------------------------------
+      //! Hand the jobs put into the shared queue on to the worker queues
+      //------------------------------------------------------------------------
+      void ForwardJobs();
+
+      //------------------------------------------------------------------------
+      //! Check if the calling thread is one of the workers
+      //------------------------------------------------------------------------
+      bool IsWorker();
 
     private:
       //------------------------------------------------------------------------
@@ -120,10 +136,21 @@ namespace XrdCl
         void *arg;
       };
 
+      //------------------------------------------------------------------------
+      //! Take a job from the worker's own queue or steal one from another
+      //------------------------------------------------------------------------
+      bool TakeJob( uint32_t worker, JobHelper &h );
+
+      //------------------------------------------------------------------------
+      //! The worker queues, defined in the implementation
+      //------------------------------------------------------------------------
+      struct WorkerQueues;
+
       std::vector<pthread_t> pWorkers;
       SyncQueue<JobHelper>   pJobs;
       XrdSysMutex            pMutex;
       bool                   pRunning;
+      WorkerQueues          *pQueues;   //!< 0 if the workers share pJobs
   };
 }
 
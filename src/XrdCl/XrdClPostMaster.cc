@@ -62,9 +62,11 @@ namespace XrdCl
       Env *env = DefaultEnv::GetEnv();
       int workerThreads = DefaultWorkerThreads;
       env->GetInt( "WorkerThreads", workerThreads );
+      int workerQueues = DefaultWorkerQueues;
+      env->GetInt( "WorkerQueues", workerQueues );
 
       pTaskManager = new TaskManager();
-      pJobManager  = new JobManager(workerThreads);
+      pJobManager  = new JobManager( workerThreads, workerQueues != 0 );
     }
 
     ~PostMasterImpl()
@@ -18,40 +18,66 @@
 
 #include "XrdCl/XrdClSIDManager.hh"
 
-#include <algorithm>
+#include <cstring>
 
 namespace XrdCl
 {
-  //----------------------------------------------------------------------------
-  // Allocate a SID
-  //---------------------------------------------------------------------------
-  Status SIDManager::AllocateSID( uint8_t sid[2] )
+  namespace
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-
-    uint16_t allocSID = 1;
-
     //--------------------------------------------------------------------------
-    // Get a SID from the list of free SIDs if it's not empty
+    // SIDs 0 and 0xffff are never handed out
     //--------------------------------------------------------------------------
-    if( !pFreeSIDs.empty() )
+    const uint16_t FirstSID = 0x0000;
+    const uint16_t LastSID  = 0xffff;
+
+    inline uint16_t GetSID( const uint8_t sid[2] )
     {
-      allocSID = pFreeSIDs.front();
-      pFreeSIDs.pop_front();
+      uint16_t s = 0;
+      memcpy( &s, sid, 2 );
+      return s;
     }
+  }
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  SIDManager::SIDManager(): pHint( 0 ), pRefCount( 0 )
+  {
+    pUsedSIDs.Set( FirstSID );
+    pUsedSIDs.Set( LastSID );
+  }
+
+  //----------------------------------------------------------------------------
+  // Allocate a SID
+  //---------------------------------------------------------------------------
+  Status SIDManager::AllocateSID( uint8_t sid[2] )
+  {
     //--------------------------------------------------------------------------
-    // Allocate a new SID if possible
+    // Starting at the hint look for a word with a clear bit and try to grab
+    // the lowest one, another thread may beat us to it in which case we try
+    // the next one
     //--------------------------------------------------------------------------
-    else
+    uint32_t start = pHint.load( std::memory_order_relaxed );
+    for( uint32_t n = 0; n < SIDBitmap::NumWords; ++n )
     {
-      if( pSIDCeiling == 0xffff )
-        return Status( stError, errNoMoreFreeSIDs );
-      allocSID = pSIDCeiling++;
+      uint32_t               w    = ( start + n ) % SIDBitmap::NumWords;
+      std::atomic<uint64_t> &word = pUsedSIDs.Word( w );
+      uint64_t               bits = word.load( std::memory_order_relaxed );
+      while( bits != ~uint64_t( 0 ) )
+      {
+        uint64_t mask = ~bits & ( bits + 1 );
+        bits = word.fetch_or( mask, std::memory_order_acq_rel );
+        if( bits & mask ) continue;
+
+        uint16_t allocSID = w * 64 + __builtin_ctzll( mask );
+        if( w != start )
+          pHint.compare_exchange_strong( start, w, std::memory_order_relaxed );
+        pAllocTime.Get( allocSID ).store( time(0), std::memory_order_release );
+        memcpy( sid, &allocSID, 2 );
+        return Status();
+      }
     }
-
-    memcpy( sid, &allocSID, 2 );
-    pAllocTime[allocSID] = time(0);
-    return Status();
+    return Status( stError, errNoMoreFreeSIDs );
   }
 
   //----------------------------------------------------------------------------
@@ -59,11 +85,11 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::ReleaseSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    uint16_t relSID = 0;
-    memcpy( &relSID, sid, 2 );
-    pFreeSIDs.push_back( relSID );
-    pAllocTime.erase( relSID );
+    uint16_t relSID = GetSID( sid );
+    std::atomic<time_t> *tm = pAllocTime.Find( relSID );
+    if( tm ) tm->store( 0, std::memory_order_release );
+    if( pUsedSIDs.Clear( relSID ) )
+      LowerHint( relSID );
   }
 
   //----------------------------------------------------------------------------
@@ -71,11 +97,10 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::TimeOutSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    uint16_t tiSID = 0;
-    memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.insert( tiSID );
-    pAllocTime.erase( tiSID );
+    uint16_t tiSID = GetSID( sid );
+    pTimeOutSIDs.Set( tiSID );
+    std::atomic<time_t> *tm = pAllocTime.Find( tiSID );
+    if( tm ) tm->store( 0, std::memory_order_release );
   }
 
   //----------------------------------------------------------------------------
@@ -83,12 +108,20 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool SIDManager::IsAnySIDOldAs( const time_t tlim ) const
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    return std::any_of( pAllocTime.begin(), pAllocTime.end(),
-                        [tlim](const auto& p)
+    for( uint32_t w = 0; w < SIDBitmap::NumWords; ++w )
     {
-      return p.second <= tlim;
-    } );
+      uint64_t bits = pUsedSIDs.Word( w ).load( std::memory_order_acquire );
+      while( bits )
+      {
+        uint16_t s = w * 64 + __builtin_ctzll( bits );
+        bits &= bits - 1;
+        std::atomic<time_t> *tm = pAllocTime.Find( s );
+        if( !tm ) continue;
+        time_t t = tm->load( std::memory_order_acquire );
+        if( t && t <= tlim ) return true;
+      }
+    }
+    return false;
   }
 
   //----------------------------------------------------------------------------
@@ -96,13 +129,7 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool SIDManager::IsTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    uint16_t tiSID = 0;
-    memcpy( &tiSID, sid, 2 );
-    std::set<uint16_t>::iterator it = pTimeOutSIDs.find( tiSID );
-    if( it != pTimeOutSIDs.end() )
-      return true;
-    return false;
+    return pTimeOutSIDs.Test( GetSID( sid ) );
   }
 
   //----------------------------------------------------------------------------
@@ -110,11 +137,10 @@ namespace XrdCl
   //-----------------------------------------------------------------------------
   void SIDManager::ReleaseTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    uint16_t tiSID = 0;
-    memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.erase( tiSID );
-    pFreeSIDs.push_back( tiSID );
+    uint16_t tiSID = GetSID( sid );
+    pTimeOutSIDs.Clear( tiSID );
+    if( pUsedSIDs.Clear( tiSID ) )
+      LowerHint( tiSID );
   }
 
   //------------------------------------------------------------------------
@@ -122,11 +148,14 @@ namespace XrdCl
   //------------------------------------------------------------------------
   void SIDManager::ReleaseAllTimedOut()
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    std::set<uint16_t>::iterator it;
-    for( it = pTimeOutSIDs.begin(); it != pTimeOutSIDs.end(); ++it )
-      pFreeSIDs.push_back( *it );
-    pTimeOutSIDs.clear();
+    for( uint32_t w = 0; w < SIDBitmap::NumWords; ++w )
+    {
+      uint64_t bits = pTimeOutSIDs.Word( w ).exchange( 0,
+                                                  std::memory_order_acq_rel );
+      if( !bits ) continue;
+      pUsedSIDs.Word( w ).fetch_and( ~bits, std::memory_order_acq_rel );
+      LowerHint( w * 64 );
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -134,8 +163,23 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   uint16_t SIDManager::GetNumberOfAllocatedSIDs() const
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    return pSIDCeiling - pFreeSIDs.size() - pTimeOutSIDs.size() - 1;
+    uint32_t n = 0;
+    for( uint32_t w = 0; w < SIDBitmap::NumWords; ++w )
+      n += __builtin_popcountll(
+             pUsedSIDs.Word( w ).load( std::memory_order_relaxed ) &
+             ~pTimeOutSIDs.Word( w ).load( std::memory_order_relaxed ) );
+    return n - 2;
+  }
+
+  //----------------------------------------------------------------------------
+  // Lower the word at which the search for a free SID starts
+  //----------------------------------------------------------------------------
+  void SIDManager::LowerHint( uint16_t sid )
+  {
+    uint32_t w   = sid / 64;
+    uint32_t cur = pHint.load( std::memory_order_relaxed );
+    while( w < cur &&
+           !pHint.compare_exchange_weak( cur, w, std::memory_order_relaxed ) );
   }
 
   //----------------------------------------------------------------------------
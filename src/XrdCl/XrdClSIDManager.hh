@@ -19,8 +19,7 @@
 #ifndef __XRD_CL_SID_MANAGER_HH__
 #define __XRD_CL_SID_MANAGER_HH__
 
-#include <list>
-#include <set>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -28,6 +27,7 @@
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClStatus.hh"
 #include "XrdCl/XrdClURL.hh"
+#include "XrdCl/XrdClSIDTable.hh"
 
 namespace XrdCl
 {
@@ -38,6 +38,10 @@ namespace XrdCl
 
   //----------------------------------------------------------------------------
   //! Handle XRootD stream IDs
+  //!
+  //! The SIDs in use and the timed out ones are kept in two atomic bitmaps,
+  //! so allocating and releasing a SID takes no lock. The lowest free SIDs
+  //! are handed out first to keep the tables indexed by SID compact.
   //----------------------------------------------------------------------------
   class SIDManager
   {
@@ -48,7 +52,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      SIDManager(): pSIDCeiling(1), pRefCount(0) { }
+      SIDManager();
 
 #if __cplusplus < 201103L
     //------------------------------------------------------------------------
@@ -108,8 +112,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       uint32_t NumberOfTimedOutSIDs() const
       {
-        XrdSysMutexHelper scopedLock( pMutex );
-        return pTimeOutSIDs.size();
+        return pTimeOutSIDs.Count();
       }
 
       //------------------------------------------------------------------------
@@ -118,12 +121,17 @@ namespace XrdCl
       uint16_t GetNumberOfAllocatedSIDs() const;
 
     private:
-      std::unordered_map<uint16_t, time_t> pAllocTime;
-      std::list<uint16_t>  pFreeSIDs;
-      std::set<uint16_t>   pTimeOutSIDs;
-      uint16_t             pSIDCeiling;
-      mutable XrdSysMutex  pMutex;
-      mutable size_t       pRefCount;
+      //------------------------------------------------------------------------
+      //! Lower the word at which the search for a free SID starts
+      //------------------------------------------------------------------------
+      void LowerHint( uint16_t sid );
+
+      SIDBitmap                     pUsedSIDs;    // allocated or timed out
+      SIDBitmap                     pTimeOutSIDs;
+      SIDSlots<std::atomic<time_t>> pAllocTime;   // 0 unless allocated
+      std::atomic<uint32_t>         pHint;
+      mutable XrdSysMutex           pMutex;       // protects pRefCount
+      mutable size_t                pRefCount;
   };
 
   //----------------------------------------------------------------------------
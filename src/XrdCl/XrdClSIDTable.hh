@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_SID_TABLE_HH__
+#define __XRD_CL_SID_TABLE_HH__
+
+#include <atomic>
+#include <cstdint>
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! Atomic bitmap with one bit per stream ID
+  //----------------------------------------------------------------------------
+  class SIDBitmap
+  {
+    public:
+      static const uint32_t NumSIDs  = 65536;
+      static const uint32_t NumWords = NumSIDs / 64;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      SIDBitmap()
+      {
+        for( uint32_t i = 0; i < NumWords; ++i )
+          pWords[i].store( 0, std::memory_order_relaxed );
+      }
+
+      //------------------------------------------------------------------------
+      //! Set a bit, return true if it was clear before
+      //------------------------------------------------------------------------
+      bool Set( uint16_t sid )
+      {
+        uint64_t mask = Mask( sid );
+        return !( pWords[sid / 64].fetch_or( mask, std::memory_order_acq_rel )
+                  & mask );
+      }
+
+      //------------------------------------------------------------------------
+      //! Clear a bit, return true if it was set before
+      //------------------------------------------------------------------------
+      bool Clear( uint16_t sid )
+      {
+        uint64_t mask = Mask( sid );
+        return pWords[sid / 64].fetch_and( ~mask, std::memory_order_acq_rel )
+               & mask;
+      }
+
+      //------------------------------------------------------------------------
+      //! Test a bit
+      //------------------------------------------------------------------------
+      bool Test( uint16_t sid ) const
+      {
+        return pWords[sid / 64].load( std::memory_order_acquire ) & Mask( sid );
+      }
+
+      //------------------------------------------------------------------------
+      //! Access a word of the map
+      //------------------------------------------------------------------------
+      std::atomic<uint64_t> &Word( uint32_t index )
+      {
+        return pWords[index];
+      }
+
+      const std::atomic<uint64_t> &Word( uint32_t index ) const
+      {
+        return pWords[index];
+      }
+
+      //------------------------------------------------------------------------
+      //! Call func( sid ) for every bit set at the time its word is looked at
+      //------------------------------------------------------------------------
+      template<typename Func>
+      void ForEach( Func func ) const
+      {
+        for( uint32_t i = 0; i < NumWords; ++i )
+        {
+          uint64_t word = pWords[i].load( std::memory_order_acquire );
+          while( word )
+          {
+            int bit = __builtin_ctzll( word );
+            word &= word - 1;
+            func( uint16_t( i * 64 + bit ) );
+          }
+        }
+      }
+
+      //------------------------------------------------------------------------
+      //! Count the bits that are set
+      //------------------------------------------------------------------------
+      uint32_t Count() const
+      {
+        uint32_t n = 0;
+        for( uint32_t i = 0; i < NumWords; ++i )
+          n += __builtin_popcountll( pWords[i].load( std::memory_order_relaxed ) );
+        return n;
+      }
+
+      static uint64_t Mask( uint16_t sid )
+      {
+        return uint64_t( 1 ) << ( sid % 64 );
+      }
+
+    private:
+      std::atomic<uint64_t> pWords[NumWords];
+  };
+
+  //----------------------------------------------------------------------------
+  //! A 64K array of slots indexed by stream ID. The slots are allocated in
+  //! pages of 256 on first use and are zero initialized, so that a channel
+  //! that only ever uses a few hundred stream IDs pays for a few pages only.
+  //! Pages are never freed before the array itself.
+  //----------------------------------------------------------------------------
+  template<typename T>
+  class SIDSlots
+  {
+    public:
+      static const uint32_t PageSize = 256;
+      static const uint32_t NumPages = SIDBitmap::NumSIDs / PageSize;
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      SIDSlots()
+      {
+        for( uint32_t i = 0; i < NumPages; ++i )
+          pPages[i].store( nullptr, std::memory_order_relaxed );
+      }
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~SIDSlots()
+      {
+        for( uint32_t i = 0; i < NumPages; ++i )
+          delete [] pPages[i].load( std::memory_order_relaxed );
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the slot of a SID, allocating its page if needed
+      //------------------------------------------------------------------------
+      T &Get( uint16_t sid )
+      {
+        T *page = pPages[sid / PageSize].load( std::memory_order_acquire );
+        if( !page )
+        {
+          T *fresh = new T[PageSize]();
+          if( pPages[sid / PageSize].compare_exchange_strong( page, fresh,
+                                                 std::memory_order_acq_rel ) )
+            page = fresh;
+          else
+            delete [] fresh;
+        }
+        return page[sid % PageSize];
+      }
+
+      //------------------------------------------------------------------------
+      //! Get the slot of a SID or nullptr if its page was never allocated
+      //------------------------------------------------------------------------
+      T *Find( uint16_t sid ) const
+      {
+        T *page = pPages[sid / PageSize].load( std::memory_order_acquire );
+        return page ? &page[sid % PageSize] : nullptr;
+      }
+
+    private:
+      SIDSlots( const SIDSlots& ) = delete;
+      SIDSlots &operator=( const SIDSlots& ) = delete;
+
+      std::atomic<T*> pPages[NumPages];
+  };
+}
+
+#endif // __XRD_CL_SID_TABLE_HH__
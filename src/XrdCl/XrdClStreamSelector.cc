@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClStreamSelector.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  const uint64_t SampleSpan   = 50000;      // minimum throughput sample, us
+  const uint64_t RttWindow    = 10000000;   // lifetime of the minimum rtt, us
+  const uint64_t AdaptPeriod  = 500000;     // between sub-stream count changes
+  const uint64_t ExpirePeriod = 1000000;    // between scans for lost requests
+  const uint64_t RequestTTL   = 300000000;  // after which a request is lost
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  StreamSelector::StreamSelector( uint16_t size, bool adaptive ):
+    pAdaptive( adaptive ), pActive( 0 ), pLastAdapt( 0 ), pLastExpire( 0 )
+  {
+    AdjustQueues( size );
+  }
+
+  //----------------------------------------------------------------------------
+  // Adjust the number of sub-streams
+  //----------------------------------------------------------------------------
+  void StreamSelector::AdjustQueues( uint16_t size )
+  {
+    //--------------------------------------------------------------------------
+    // Subtract one because we shouldn't take into account the control stream
+    //--------------------------------------------------------------------------
+    uint16_t data = size > 0 ? size - 1 : 0;
+    if( data > pStreams.size() )
+      pStreams.resize( data );
+    if( !pAdaptive || !pActive )
+      pActive = data;
+  }
+
+  //----------------------------------------------------------------------------
+  // Select the sub-stream for a request
+  //----------------------------------------------------------------------------
+  uint16_t StreamSelector::Select( const std::vector<bool> &connected,
+                                   uint16_t sid, uint64_t bytes, uint64_t now )
+  {
+    if( now - pLastExpire >= ExpirePeriod )
+      Expire( now );
+
+    std::vector<uint16_t> usable;
+    for( uint16_t i = 0; i < connected.size() && i < pStreams.size(); ++i )
+      if( connected[i] ) usable.push_back( i );
+    if( usable.empty() )
+      return 1;
+
+    if( pAdaptive )
+    {
+      Adapt( usable, now );
+      if( usable.size() > pActive )
+        usable.resize( pActive );
+    }
+
+    //--------------------------------------------------------------------------
+    // Sub-streams without a throughput estimate are assumed to be as fast as
+    // the average of the others; if none has one we go by the bytes
+    // outstanding
+    //--------------------------------------------------------------------------
+    double   sum   = 0;
+    uint16_t known = 0;
+    for( uint16_t i : usable )
+      if( pStreams[i].throughput > 0 )
+      {
+        sum += pStreams[i].throughput;
+        ++known;
+      }
+    double avg = known ? sum / known : 0;
+
+    uint16_t ret    = usable[0];
+    double   minval = HUGE_VAL;
+    for( uint16_t i : usable )
+    {
+      const SubStream &s   = pStreams[i];
+      double           thr = s.throughput > 0 ? s.throughput : avg;
+      double           est = thr > 0 ?
+                             s.minRtt + ( s.outstanding + bytes ) / thr :
+                             double( s.outstanding );
+      if( est < minval )
+      {
+        ret    = i;
+        minval = est;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    // Account for the request, the throughput is only measured while there
+    // are requests in flight
+    //--------------------------------------------------------------------------
+    if( bytes )
+    {
+      auto it = pRequests.find( sid );
+      if( it != pRequests.end() )
+        Retire( it->second, now );
+
+      SubStream &s = pStreams[ret];
+      if( !s.requests )
+        s.busySince = now;
+      Request &req = pRequests[sid];
+      req.substrm = ret;
+      req.bytes   = bytes;
+      req.ahead   = s.outstanding;
+      req.sent    = now;
+      s.outstanding += bytes;
+      ++s.requests;
+    }
+
+    return ret + 1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Account for the final response to a request
+  //----------------------------------------------------------------------------
+  void StreamSelector::MsgReceived( uint16_t sid, uint64_t now )
+  {
+    auto it = pRequests.find( sid );
+    if( it == pRequests.end() )
+      return;
+    Request req = it->second;
+    pRequests.erase( it );
+
+    SubStream &s = pStreams[req.substrm];
+    uint64_t   busy = s.busyTime + ( now - s.busySince );
+    Retire( req, now );
+
+    //--------------------------------------------------------------------------
+    // Take a throughput sample once enough busy time has passed
+    //--------------------------------------------------------------------------
+    s.doneBytes += req.bytes;
+    if( busy >= SampleSpan )
+    {
+      double sample = double( s.doneBytes ) / busy;
+      s.throughput  = s.throughput > 0 ? 0.75 * s.throughput + 0.25 * sample
+                                       : sample;
+      s.doneBytes   = 0;
+      s.busyTime    = 0;
+      s.busySince   = now;
+    }
+
+    //--------------------------------------------------------------------------
+    // The round trip time is what is left of the latency once the transfer
+    // of the request and of the data queued ahead of it is accounted for
+    //--------------------------------------------------------------------------
+    double rtt = double( now - req.sent );
+    if( s.throughput > 0 )
+      rtt -= ( req.ahead + req.bytes ) / s.throughput;
+    uint64_t sample = rtt > 0 ? uint64_t( rtt ) : 0;
+    if( !s.rttStamp || sample <= s.minRtt || now - s.rttStamp >= RttWindow )
+    {
+      s.minRtt   = sample;
+      s.rttStamp = now;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Account for a response
+  //----------------------------------------------------------------------------
+  void StreamSelector::MsgReceived( const Message &msg, uint64_t now )
+  {
+    if( !IsFinal( msg ) )
+      return;
+    uint16_t sid;
+    memcpy( &sid, ( (const ServerResponseHeader*)msg.GetBuffer() )->streamid,
+            2 );
+    MsgReceived( sid, now );
+  }
+
+  //----------------------------------------------------------------------------
+  // Check if a response is the final response to its request
+  //----------------------------------------------------------------------------
+  bool StreamSelector::IsFinal( const Message &msg )
+  {
+    if( msg.GetSize() < sizeof( ServerResponseHeader ) )
+      return false;
+    const ServerResponseHeader *hdr =
+      (const ServerResponseHeader*)msg.GetBuffer();
+    switch( hdr->status )
+    {
+      case kXR_ok:
+      case kXR_error:
+      case kXR_redirect:
+        return true;
+
+      //------------------------------------------------------------------------
+      // pgread sends a kXR_status response per chunk, only the last one is
+      // flagged as the final result
+      //------------------------------------------------------------------------
+      case kXR_status:
+      {
+        if( msg.GetSize() < sizeof( ServerResponseStatus ) )
+          return false;
+        const ServerResponseStatus *rsp =
+          (const ServerResponseStatus*)msg.GetBuffer();
+        return rsp->bdy.resptype == XrdProto::kXR_FinalResult;
+      }
+
+      default:
+        return false;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Remove a request from the accounting
+  //----------------------------------------------------------------------------
+  void StreamSelector::Retire( const Request &req, uint64_t now )
+  {
+    SubStream &s = pStreams[req.substrm];
+    s.outstanding -= req.bytes < s.outstanding ? req.bytes : s.outstanding;
+    if( s.requests && !--s.requests )
+      s.busyTime += now - s.busySince;
+  }
+
+  //----------------------------------------------------------------------------
+  // Forget requests that never got an answer
+  //----------------------------------------------------------------------------
+  void StreamSelector::Expire( uint64_t now )
+  {
+    pLastExpire = now;
+    for( auto it = pRequests.begin(); it != pRequests.end(); )
+    {
+      if( now - it->second.sent >= RequestTTL )
+      {
+        Retire( it->second, now );
+        it = pRequests.erase( it );
+      }
+      else
+        ++it;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Recompute the number of sub-streams to use: enough of them for the bytes
+  // outstanding to fit in their bandwidth-delay product. We grow at once and
+  // shrink one sub-stream at a time.
+  //----------------------------------------------------------------------------
+  void StreamSelector::Adapt( const std::vector<uint16_t> &usable,
+                              uint64_t now )
+  {
+    uint16_t n = pActive;
+    if( n < 1 ) n = 1;
+    if( n > usable.size() ) n = usable.size();
+    pActive = n;
+
+    if( now - pLastAdapt < AdaptPeriod )
+      return;
+    pLastAdapt = now;
+
+    uint64_t demand   = 0;
+    double   bdp      = 0;
+    uint16_t measured = 0;
+    for( uint16_t k = 0; k < n; ++k )
+    {
+      const SubStream &s = pStreams[usable[k]];
+      demand += s.outstanding;
+      if( s.throughput > 0 )
+      {
+        bdp += s.throughput * s.minRtt;
+        ++measured;
+      }
+    }
+    if( !measured )
+      return;
+
+    double perStream = bdp / measured;
+    if( perStream < 1 ) perStream = 1;
+    double target = std::ceil( demand / perStream );
+
+    if( target > n )
+      pActive = target < usable.size() ? uint16_t( target ) : usable.size();
+    else if( target < n && n > 1 )
+      pActive = n - 1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Monotonic time in microseconds
+  //----------------------------------------------------------------------------
+  uint64_t StreamSelector::Now()
+  {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(
+             steady_clock::now().time_since_epoch() ).count();
+  }
+}
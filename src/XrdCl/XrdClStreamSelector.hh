@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_STREAM_SELECTOR_HH__
+#define __XRD_CL_STREAM_SELECTOR_HH__
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace XrdCl
+{
+  class Message;
+
+  //----------------------------------------------------------------------------
+  //! Selects the sub-stream that is expected to deliver the response to a
+  //! read soonest
+  //!
+  //! For every data sub-stream the selector keeps the number of bytes
+  //! requested but not yet received, the throughput observed while it had
+  //! work and the round trip time, i.e. the part of a request's latency not
+  //! explained by the data queued ahead of it. A request goes to the
+  //! sub-stream minimizing rtt + (outstanding + requested) / throughput.
+  //!
+  //! In adaptive mode only some of the connected sub-streams are used: as
+  //! many as are needed for the outstanding bytes not to exceed the
+  //! bandwidth-delay product of the sub-streams carrying them.
+  //!
+  //! The selector is not thread safe, the caller serializes the calls.
+  //! Sub-stream numbers passed in and out count the control stream as 0.
+  //----------------------------------------------------------------------------
+  class StreamSelector
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param size     : number of streams including the control stream
+      //! @param adaptive : vary the number of sub-streams in use
+      //------------------------------------------------------------------------
+      StreamSelector( uint16_t size, bool adaptive = false );
+
+      //------------------------------------------------------------------------
+      //! @param size : number of streams including the control stream
+      //------------------------------------------------------------------------
+      void AdjustQueues( uint16_t size );
+
+      //------------------------------------------------------------------------
+      //! Select the sub-stream for a request
+      //!
+      //! @param connected : bitarray stating if given sub-stream is connected
+      //!                    (not including the control stream)
+      //! @param sid       : stream id of the request
+      //! @param bytes     : number of bytes requested, 0 if the request is
+      //!                    not a read and should not be accounted for
+      //! @param now       : current time in microseconds, see Now()
+      //!
+      //! @return          : substream number
+      //------------------------------------------------------------------------
+      uint16_t Select( const std::vector<bool> &connected, uint16_t sid,
+                       uint64_t bytes, uint64_t now );
+
+      //------------------------------------------------------------------------
+      //! Account for the final response to a request
+      //!
+      //! @param sid : stream id of the response
+      //! @param now : current time in microseconds
+      //------------------------------------------------------------------------
+      void MsgReceived( uint16_t sid, uint64_t now );
+
+      //------------------------------------------------------------------------
+      //! Account for a response, only the final response to a request (i.e.
+      //! not kXR_oksofar, kXR_wait, kXR_waitresp or a partial kXR_status)
+      //! retires it
+      //!
+      //! @param msg : the response, the header must be unmarshalled
+      //! @param now : current time in microseconds
+      //------------------------------------------------------------------------
+      void MsgReceived( const Message &msg, uint64_t now );
+
+      //------------------------------------------------------------------------
+      //! Check if a response is the final response to its request
+      //------------------------------------------------------------------------
+      static bool IsFinal( const Message &msg );
+
+      //------------------------------------------------------------------------
+      //! Number of sub-streams currently in use
+      //------------------------------------------------------------------------
+      uint16_t GetActive() const
+      {
+        return pActive;
+      }
+
+      //------------------------------------------------------------------------
+      //! Bytes requested and not yet received on a sub-stream
+      //------------------------------------------------------------------------
+      uint64_t GetOutstanding( uint16_t substrm ) const
+      {
+        return substrm > 0 && substrm <= pStreams.size() ?
+               pStreams[substrm - 1].outstanding : 0;
+      }
+
+      //------------------------------------------------------------------------
+      //! Monotonic time in microseconds
+      //------------------------------------------------------------------------
+      static uint64_t Now();
+
+    private:
+
+      struct SubStream
+      {
+        SubStream(): outstanding( 0 ), requests( 0 ), throughput( 0 ),
+                     minRtt( 0 ), rttStamp( 0 ), doneBytes( 0 ),
+                     busyTime( 0 ), busySince( 0 ) { }
+
+        uint64_t outstanding;  // bytes requested and not yet received
+        uint32_t requests;     // requests in flight
+        double   throughput;   // bytes per microsecond, 0 if unknown
+        uint64_t minRtt;       // microseconds
+        uint64_t rttStamp;     // when minRtt was taken
+        uint64_t doneBytes;    // bytes received in the current sample
+        uint64_t busyTime;     // time with requests in flight in the sample
+        uint64_t busySince;    // start of the current busy period
+      };
+
+      struct Request
+      {
+        uint16_t substrm;      // index into pStreams
+        uint64_t bytes;
+        uint64_t ahead;        // bytes outstanding when the request was sent
+        uint64_t sent;
+      };
+
+      //------------------------------------------------------------------------
+      //! Remove a request from the accounting
+      //------------------------------------------------------------------------
+      void Retire( const Request &req, uint64_t now );
+
+      //------------------------------------------------------------------------
+      //! Forget requests that never got an answer
+      //------------------------------------------------------------------------
+      void Expire( uint64_t now );
+
+      //------------------------------------------------------------------------
+      //! Recompute the number of sub-streams to use
+      //------------------------------------------------------------------------
+      void Adapt( const std::vector<uint16_t> &usable, uint64_t now );
+
+      std::vector<SubStream>                pStreams;
+      std::unordered_map<uint16_t, Request> pRequests;
+      bool                                  pAdaptive;
+      uint16_t                              pActive;
+      uint64_t                              pLastAdapt;
+      uint64_t                              pLastExpire;
+  };
+}
+
+#endif // __XRD_CL_STREAM_SELECTOR_HH__
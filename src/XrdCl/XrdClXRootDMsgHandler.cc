@@ -2329,7 +2329,31 @@ namespace XrdCl
       log->Debug( ExDbgMsg, "[%s] Passing to the thread-pool MsgHandler: %p (message: %s ).",
                   pUrl.GetHostId().c_str(), (void*)this,
                   pRequest->GetObfuscatedDescription().c_str() );
-      jobMgr->QueueJob( new HandleRspJob( this ), 0 );
+      jobMgr->QueueJob( new HandleRspJob( this ), 0, GetAffinity() );
+    }
+  }
+
+  //------------------------------------------------------------------------
+  // Get the job manager affinity key of the response
+  //------------------------------------------------------------------------
+  uint64_t XRootDMsgHandler::GetAffinity() const
+  {
+    ClientRequest *req = (ClientRequest *)pRequest->GetBuffer();
+    switch( ntohs( req->header.requestid ) )
+    {
+      case kXR_read:
+      case kXR_pgread:
+      case kXR_write:
+      case kXR_pgwrite:
+      case kXR_sync:
+      case kXR_close:
+      {
+        uint32_t fh;
+        memcpy( &fh, req->read.fhandle, sizeof( fh ) );
+        return ( ( uint64_t( uintptr_t( pSidMgr.get() ) ) << 16 ) ^ fh ) | 1;
+      }
+      default:
+        return 0;
     }
   }
   
@@ -508,6 +508,13 @@ namespace XrdCl
       //------------------------------------------------------------------------
       void HandleRspOrQueue();
 
+      //------------------------------------------------------------------------
+      //! Get the job manager affinity key of the response, non-zero for
+      //! requests on an open file so that its responses are handled by the
+      //! same worker
+      //------------------------------------------------------------------------
+      uint64_t GetAffinity() const;
+
       //------------------------------------------------------------------------ 
       //! Handle a redirect to a local file
       //------------------------------------------------------------------------
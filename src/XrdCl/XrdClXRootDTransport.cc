@@ -29,6 +29,7 @@
 #include "XrdCl/XrdClMessage.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClSIDManager.hh"
+#include "XrdCl/XrdClStreamSelector.hh"
 #include "XrdCl/XrdClUtils.hh"
 #include "XrdCl/XrdClTransportManager.hh"
 #include "XrdCl/XrdClTls.hh"
@@ -132,65 +133,36 @@ namespace XrdCl
   };
 
   //----------------------------------------------------------------------------
-  //! Selects less loaded stream for read operation over multiple streams
+  //! Number of bytes requested by an unmarshalled read request, 0 for the
+  //! other requests
   //----------------------------------------------------------------------------
-  struct StreamSelector
+  static uint64_t GetReadSize( Message *msg )
   {
-      StreamSelector( uint16_t size )
-      {
-        //----------------------------------------------------------------------
-        // Subtract one because we shouldn't take into account the control
-        // stream.
-        //----------------------------------------------------------------------
-        strmqueues.resize( size - 1, 0 );
-      }
-
-      //------------------------------------------------------------------------
-      // @param size : number of streams
-      //------------------------------------------------------------------------
-      void AdjustQueues( uint16_t size )
-      {
-         strmqueues.resize( size - 1, 0);
-      }
-
-      //------------------------------------------------------------------------
-      // @param connected : bitarray stating if given sub-stream is connected
-      //
-      // @return          : substream number
-      //------------------------------------------------------------------------
-      uint16_t Select( const std::vector<bool> &connected )
-      {
-        uint16_t ret    = 0;
-        size_t   minval = std::numeric_limits<size_t>::max();
-
-        for( uint16_t i = 0; i < connected.size() && i < strmqueues.size(); ++i )
-        {
-          if( !connected[i] ) continue;
-
-          if( strmqueues[i] < minval )
-          {
-            ret = i;
-            minval = strmqueues[i];
-          }
-        }
+    ClientRequest *req = (ClientRequest*)msg->GetBuffer();
+    switch( req->header.requestid )
+    {
+      case kXR_read:
+        return req->read.rlen > 0 ? req->read.rlen : 0;
 
-        ++strmqueues[ret];
-        return ret + 1;
-      }
+      case kXR_pgread:
+        return req->pgread.rlen > 0 ? req->pgread.rlen : 0;
 
-      //--------------------------------------------------------------------------
-      // Update queue for given substream
-      //--------------------------------------------------------------------------
-      void MsgReceived( uint16_t substrm )
+      case kXR_readv:
       {
-        if( substrm > 0 )
-        --strmqueues[substrm - 1];
+        uint64_t size = 0;
+        size_t   numChunks = req->readv.dlen / 16;
+        if( msg->GetSize() < 24 + numChunks * 16 )
+          return 0;
+        readahead_list *dataChunk = (readahead_list*)msg->GetBuffer( 24 );
+        for( size_t i = 0; i < numChunks; ++i )
+          if( dataChunk[i].rlen > 0 ) size += dataChunk[i].rlen;
+        return size;
       }
 
-    private:
-
-      std::vector<size_t> strmqueues;
-  };
+      default:
+        return 0;
+    }
+  }
 
   struct BindPrefSelector
   {
@@ -447,8 +419,10 @@ namespace XrdCl
     int streams = DefaultSubStreamsPerChannel;
     env->GetInt( "SubStreamsPerChannel", streams );
     if( streams < 1 ) streams = 1;
+    int adaptive = DefaultAdaptiveSubStreams;
+    env->GetInt( "AdaptiveSubStreams", adaptive );
     info->stream.resize( streams );
-    info->strmSelector.reset( new StreamSelector( streams ) );
+    info->strmSelector.reset( new StreamSelector( streams, adaptive != 0 ) );
     info->encrypted    = url.IsSecure();
     info->istpc        = url.IsTPC();
     info->logintoken   = url.GetLoginToken();
@@ -889,6 +863,9 @@ namespace XrdCl
     if( !(info->serverFlags & kXR_isServer) || info->stream.size() == 0 )
       return PathID( 0, 0 );
 
+    UnMarshallRequest( msg );
+    ClientRequestHdr *hdr = (ClientRequestHdr*)msg->GetBuffer();
+
     //--------------------------------------------------------------------------
     // Select the streams
     //--------------------------------------------------------------------------
@@ -919,7 +896,13 @@ namespace XrdCl
       if( nbConnected == 0 )
         downStream = 0;
       else
-        downStream = info->strmSelector->Select( connected );
+      {
+        uint16_t sid;
+        memcpy( &sid, hdr->streamid, 2 );
+        downStream = info->strmSelector->Select( connected, sid,
+                                                 GetReadSize( msg ),
+                                                 StreamSelector::Now() );
+      }
     }
 
     if( upStream >= info->stream.size() )
@@ -941,8 +924,6 @@ namespace XrdCl
     //--------------------------------------------------------------------------
     // Modify the message
     //--------------------------------------------------------------------------
-    UnMarshallRequest( msg );
-    ClientRequestHdr *hdr = (ClientRequestHdr*)msg->GetBuffer();
     switch( hdr->requestid )
     {
       //------------------------------------------------------------------------
@@ -1636,11 +1617,6 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( info->mutex );
     Log *log = DefaultEnv::GetLog();
 
-    //--------------------------------------------------------------------------
-    // Update the substream queues
-    //--------------------------------------------------------------------------
-    info->strmSelector->MsgReceived( subStream );
-
     //--------------------------------------------------------------------------
     // Check whether this message is a response to a request that has
     // timed out, and if so, drop it
@@ -1651,6 +1627,11 @@ namespace XrdCl
       return NoAction;
     }
 
+    //--------------------------------------------------------------------------
+    // Update the substream accounting
+    //--------------------------------------------------------------------------
+    info->strmSelector->MsgReceived( msg, StreamSelector::Now() );
+
     if( info->sidManager->IsTimedOut( rsp->hdr.streamid ) )
     {
       log->Error( XRootDTransportMsg, "Message %p, stream [%d, %d] is a "
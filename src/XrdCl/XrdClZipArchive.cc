@@ -25,6 +25,7 @@
 #include "XrdCl/XrdClFileOperations.hh"
 #include "XrdCl/XrdClCheckpointOperation.hh"
 #include "XrdCl/XrdClZipArchive.hh"
+#include "XrdCl/XrdClZipIndexCache.hh"
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
@@ -32,6 +33,74 @@
 #include "XrdZip/XrdZipZIP64EOCDL.hh"
 
 #include <sys/stat.h>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+  using namespace XrdCl;
+
+  //---------------------------------------------------------------------------
+  // The inflate caches of the compressed files of an archive. They are kept
+  // here rather than in ZipArchive so that its layout does not change. A
+  // cache is only reused for a file at the same place with the same sizes
+  // and checksum, as a cleared archive object may be opened again.
+  //---------------------------------------------------------------------------
+  struct IndexCacheEntry
+  {
+    uint64_t                        fileoff;
+    uint64_t                        csize;
+    uint64_t                        usize;
+    uint32_t                        crc32;
+    std::shared_ptr<ZipIndexCache>  cache;
+  };
+
+  typedef std::unordered_map<std::string, IndexCacheEntry> IndexCaches;
+
+  std::mutex                                              cachesMtx;
+  std::unordered_map<const ZipArchive*, IndexCaches>      allCaches;
+
+  std::shared_ptr<ZipIndexCache> FindIndexCache( const ZipArchive *me,
+                                                 const std::string &fn,
+                                                 uint64_t fileoff,
+                                                 uint64_t csize,
+                                                 uint64_t usize,
+                                                 uint32_t crc32 )
+  {
+    std::unique_lock<std::mutex> lck( cachesMtx );
+    auto aitr = allCaches.find( me );
+    if( aitr == allCaches.end() ) return nullptr;
+    auto itr = aitr->second.find( fn );
+    if( itr == aitr->second.end() ) return nullptr;
+    const IndexCacheEntry &e = itr->second;
+    if( e.fileoff != fileoff || e.csize != csize || e.usize != usize ||
+        e.crc32 != crc32 ) return nullptr;
+    return e.cache;
+  }
+
+  //---------------------------------------------------------------------------
+  // Register a new cache, unless another read got there first
+  //---------------------------------------------------------------------------
+  std::shared_ptr<ZipIndexCache> AddIndexCache( const ZipArchive *me,
+                                                const std::string &fn,
+                                                const IndexCacheEntry &entry )
+  {
+    std::unique_lock<std::mutex> lck( cachesMtx );
+    IndexCacheEntry &e = allCaches[me][fn];
+    if( e.cache && e.fileoff == entry.fileoff && e.csize == entry.csize &&
+        e.usize == entry.usize && e.crc32 == entry.crc32 )
+      return e.cache;
+    e = entry;
+    return e.cache;
+  }
+
+  void DropIndexCaches( const ZipArchive *me )
+  {
+    std::unique_lock<std::mutex> lck( cachesMtx );
+    allCaches.erase( me );
+  }
+}
 
 namespace XrdCl
 {
@@ -94,11 +163,6 @@ namespace XrdCl
     if( cdfh->compressionMethod == Z_DEFLATED )
     {
       log->Dump( ZipMsg, "[%p] Reading compressed data.", (void*)&me );
-      // check if respective ZIP cache exists
-      bool empty = me.zipcache.find( fn ) == me.zipcache.end();
-      // if the entry does not exist, it will be created using
-      // default constructor
-      ZipCache &cache = me.zipcache[fn];
 
       if( relativeOffset > uncompressedSize )
       {
@@ -111,58 +175,74 @@ namespace XrdCl
         return XRootDStatus();
       }
 
-      uint32_t sizereq = size;
-      if( relativeOffset + size > uncompressedSize )
-        sizereq = uncompressedSize - relativeOffset;
-      cache.QueueReq( relativeOffset, sizereq, usrbuff, usrHandler );
-
-      // if we have the whole ZIP archive we can populate the cache
-      // straight away
-      if( empty && me.buffer)
+      // get the respective ZIP cache, it is created on first access
+      std::shared_ptr<ZipIndexCache> cache = FindIndexCache( &me, fn, fileoff, filesize,
+                                                             uncompressedSize, cdfh->ZCRC32 );
+      if( !cache )
       {
-        auto begin = me.buffer.get() + fileoff;
-        auto end   = begin + filesize ;
-        buffer_t buff( begin, end );
-        cache.QueueRsp( XRootDStatus(), 0, std::move( buff ) );
-        return XRootDStatus();
-      }
-
-      // if we don't have the data we need to issue a remote read
-      if( !me.buffer )
-      {
-        if( relativeOffset > filesize ) return XRootDStatus(); // there's nothing to do,
-                                                                           // we already have all the data locally
-        uint32_t rdsize = size;
-        // check if this is the last read (we reached the end of
-        // file from user perspective)
-        if( relativeOffset + size >= uncompressedSize )
+        Env *env = DefaultEnv::GetEnv();
+        int span = DefaultZipIndexSpan;
+        env->GetInt( "ZipIndexSpan", span );
+        std::string dir = DefaultZipIndexDir;
+        env->GetString( "ZipIndexDir", dir );
+
+        // the sidecar file is named after the archive and the file
+        std::string sidecar, key;
+        if( !dir.empty() )
         {
-          // if yes, make sure we readout all the compressed data
-          // Note: In a patological case the compressed size may
-          //       be greater than the uncompressed size
-          rdsize = filesize > relativeOffset ?
-                   filesize - relativeOffset :
-                   0;
+          std::string lasturl;
+          me.archive.GetProperty( "LastURL", lasturl );
+          key = URL( lasturl ).GetLocation() + "#" + fn;
+          std::ostringstream ss;
+          ss << dir << "/" << std::hex << std::setw( 16 ) << std::setfill( '0' )
+             << std::hash<std::string>()( key ) << ".zidx";
+          sidecar = ss.str();
         }
-        // make sure we are not reading past the end of
-        // compressed data
-        if( relativeOffset + size > filesize )
-          rdsize = filesize - relativeOffset;
-
-
-        // now read the data ...
-        auto rdbuff = std::make_shared<ZipCache::buffer_t>( rdsize );
-        Pipeline p = XrdCl::RdWithRsp<RSP>( me.archive, offset, rdbuff->size(), rdbuff->data() ) >>
-                       [relativeOffset, rdbuff, &cache, &me]( XRootDStatus &st, RSP &rsp )
-                       {
-                         Log *log = DefaultEnv::GetLog();
-                         log->Dump( ZipMsg, "[%p] Read %u bytes of remote data at offset %llu.",
-                                            (void*)&me, rsp.GetLength(), (unsigned long long) rsp.GetOffset() );
-                         cache.QueueRsp( st, relativeOffset, std::move( *rdbuff ) );
-                       };
-        Async( std::move( p ), timeout );
+
+        // compressed data are served from the local buffer if we have the
+        // whole archive, otherwise they are read from the archive
+        auto fetch = [&me, fileoff, timeout]( uint64_t off, uint32_t len,
+                                              ZipIndexCache::fetched_t cb )
+        {
+          if( me.buffer )
+          {
+            char *begin = me.buffer.get() + fileoff + off;
+            cb( XRootDStatus(), ZipIndexCache::buffer_t( begin, begin + len ) );
+            return;
+          }
+
+          auto rdbuff = std::make_shared<ZipIndexCache::buffer_t>( len );
+          Pipeline p = XrdCl::RdWithRsp<ChunkInfo>( me.archive, fileoff + off, len, rdbuff->data() ) >>
+                         [rdbuff, cb, &me]( XRootDStatus &st, ChunkInfo &rsp )
+                         {
+                           Log *log = DefaultEnv::GetLog();
+                           if( st.IsOK() )
+                           {
+                             log->Dump( ZipMsg, "[%p] Read %u bytes of remote data at offset %llu.",
+                                                (void*)&me, rsp.GetLength(), (unsigned long long) rsp.GetOffset() );
+                             rdbuff->resize( rsp.GetLength() );
+                           }
+                           cb( st, std::move( *rdbuff ) );
+                         };
+          Async( std::move( p ), timeout );
+        };
+
+        IndexCacheEntry entry;
+        entry.fileoff = fileoff;
+        entry.csize   = filesize;
+        entry.usize   = uncompressedSize;
+        entry.crc32   = cdfh->ZCRC32;
+        entry.cache   = std::make_shared<ZipIndexCache>( filesize, uncompressedSize, cdfh->ZCRC32,
+                                                         std::move( fetch ),
+                                                         span > 0 ? span : DefaultZipIndexSpan,
+                                                         sidecar, key );
+        cache = AddIndexCache( &me, fn, entry );
       }
 
+      uint32_t sizereq = size;
+      if( relativeOffset + size > uncompressedSize )
+        sizereq = uncompressedSize - relativeOffset;
+      cache->QueueReq( relativeOffset, sizereq, usrbuff, usrHandler );
       return XRootDStatus();
     }
 
@@ -222,6 +302,7 @@ namespace XrdCl
   //---------------------------------------------------------------------------
   ZipArchive::~ZipArchive()
   {
+    DropIndexCaches( this );
   }
 
   //---------------------------------------------------------------------------
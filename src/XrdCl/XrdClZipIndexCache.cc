@@ -0,0 +1,561 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClZipIndexCache.hh"
+#include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClJobManager.hh"
+#include "XrdCl/XrdClLog.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  //! Size of the inflate window
+  //----------------------------------------------------------------------------
+  const uint32_t WinSize = 32768;
+
+  //----------------------------------------------------------------------------
+  //! Bounds on the compressed data fetched at a time
+  //----------------------------------------------------------------------------
+  const uint32_t MinFetch = 65536;
+  const uint32_t MaxFetch = 4194304;
+
+  //----------------------------------------------------------------------------
+  //! Maximum number of idle inflaters kept per file
+  //----------------------------------------------------------------------------
+  const size_t MaxIdle = 4;
+
+  //----------------------------------------------------------------------------
+  //! Magic number of the sidecar files
+  //----------------------------------------------------------------------------
+  const char IndexMagic[8] = { 'X', 'r', 'd', 'Z', 'i', 'd', 'x', '1' };
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  //! A checkpoint from which inflating can be resumed
+  //----------------------------------------------------------------------------
+  struct ZipIndexCache::Point
+  {
+    uint64_t                   out;    //< offset in the uncompressed data
+    uint64_t                   in;     //< offset of the next whole compressed byte
+    int                        bits;   //< bits of the byte before 'in' still to be inflated
+    std::vector<unsigned char> window; //< uncompressed data preceding 'out' (none at 0)
+  };
+
+  //----------------------------------------------------------------------------
+  //! An inflater positioned somewhere in the data
+  //----------------------------------------------------------------------------
+  struct ZipIndexCache::Cursor
+  {
+    Cursor() : out( 0 ), in( 0 ), prime( 0 ), end( false )
+    {
+      memset( &strm, 0, sizeof( strm ) );
+      // make sure zlib doesn't look for gzip headers, in order to do so
+      // pass negative window bits !!!
+      int rc = inflateInit2( &strm, -MAX_WBITS );
+      XRootDStatus st = ToXRootDStatus( rc, "inflateInit2" );
+      if( !st.IsOK() ) throw ZipError( st );
+    }
+
+    ~Cursor()
+    {
+      inflateEnd( &strm );
+    }
+
+    z_stream      strm;            //< the zlib stream
+    unsigned char window[WinSize]; //< ring holding the latest uncompressed data
+    uint64_t      out;             //< offset of the next uncompressed byte
+    uint64_t      in;              //< offset of the compressed byte at strm.next_in
+    int           prime;           //< bits to take from the first byte fetched
+    bool          end;             //< we reached the end of the compressed data
+    buffer_t      input;           //< compressed data being inflated
+  };
+
+  //----------------------------------------------------------------------------
+  //! A read of uncompressed data
+  //----------------------------------------------------------------------------
+  struct ZipIndexCache::Request
+  {
+    Request( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler ) :
+      offset( offset ), length( length ), buffer( (char*)buffer ),
+      handler( handler ), fetched( false )
+    {
+    }
+
+    uint64_t                offset;  //< offset in the uncompressed data
+    uint32_t                length;  //< number of bytes to read
+    char                   *buffer;  //< user buffer
+    ResponseHandler        *handler; //< user handler
+    std::unique_ptr<Cursor> cursor;  //< the inflater serving the read
+    bool                    fetched; //< compressed data have arrived
+    XRootDStatus            status;  //< status of fetching the compressed data
+    buffer_t                data;    //< the compressed data
+  };
+
+  //----------------------------------------------------------------------------
+  //! Job inflating data for a read in a worker thread
+  //----------------------------------------------------------------------------
+  class ZipIndexCache::InflateJob : public Job
+  {
+    public:
+      InflateJob( std::shared_ptr<ZipIndexCache> cache, std::shared_ptr<Request> req ) :
+        cache( std::move( cache ) ), req( std::move( req ) )
+      {
+      }
+
+      virtual void Run( void* )
+      {
+        cache->Inflate( std::move( req ) );
+        delete this;
+      }
+
+      static void Queue( std::shared_ptr<ZipIndexCache> cache, std::shared_ptr<Request> req )
+      {
+        InflateJob *job = new InflateJob( std::move( cache ), std::move( req ) );
+        DefaultEnv::GetPostMaster()->GetJobManager()->QueueJob( job );
+      }
+
+    private:
+      std::shared_ptr<ZipIndexCache> cache;
+      std::shared_ptr<Request>  req;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  ZipIndexCache::ZipIndexCache( uint64_t           csize,
+                      uint64_t           usize,
+                      uint32_t           crc32,
+                      fetch_t            fetch,
+                      uint32_t           span,
+                      const std::string &sidecar,
+                      const std::string &key ) : csize( csize ),
+                                                 usize( usize ),
+                                                 crc32( crc32 ),
+                                                 fetch( std::move( fetch ) ),
+                                                 span( std::max( span, 2 * WinSize ) ),
+                                                 sidecar( sidecar ),
+                                                 key( key ),
+                                                 nextpt( 0 ),
+                                                 complete( false ),
+                                                 saved( false )
+  {
+    // inflating can always start at the very beginning
+    std::unique_ptr<Point> pt( new Point() );
+    pt->out  = 0;
+    pt->in   = 0;
+    pt->bits = 0;
+    index.push_back( std::move( pt ) );
+    nextpt = this->span;
+
+    if( !sidecar.empty() ) LoadIndex();
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  ZipIndexCache::~ZipIndexCache()
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Queue a read of uncompressed data
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::QueueReq( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler )
+  {
+    auto req = std::make_shared<Request>( offset, length, buffer, handler );
+    InflateJob::Queue( shared_from_this(), std::move( req ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the number of checkpoints and whether the index is complete
+  //----------------------------------------------------------------------------
+  std::pair<size_t, bool> ZipIndexCache::IndexInfo()
+  {
+    std::unique_lock<std::mutex> lck( mtx );
+    return std::make_pair( index.size(), complete );
+  }
+
+  //----------------------------------------------------------------------------
+  // Inflate data for a read until it is complete or more input is needed
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::Inflate( std::shared_ptr<Request> req )
+  {
+    try
+    {
+      if( !req->length ) return Finish( req, XRootDStatus(), 0 );
+      if( !req->cursor ) Acquire( *req );
+    }
+    catch( const ZipError &ex )
+    {
+      return Finish( req, ex.status, 0 );
+    }
+
+    Cursor   &cur    = *req->cursor;
+    uint64_t  reqend = req->offset + req->length;
+
+    //--------------------------------------------------------------------------
+    // Take over the compressed data we have been waiting for
+    //--------------------------------------------------------------------------
+    if( req->fetched )
+    {
+      req->fetched = false;
+      if( !req->status.IsOK() ) return Finish( req, req->status, 0 );
+      if( req->data.empty() )
+        return Finish( req, XRootDStatus( stError, errDataError, 0,
+                                          "[zlib] unexpected end of compressed data." ), 0 );
+      cur.input = std::move( req->data );
+      cur.strm.next_in  = (Bytef*)cur.input.data();
+      cur.strm.avail_in = cur.input.size();
+      // a checkpoint may start in the middle of a byte
+      if( cur.prime )
+      {
+        int byte = (unsigned char)cur.input[0];
+        int rc = inflatePrime( &cur.strm, cur.prime, byte >> ( 8 - cur.prime ) );
+        if( rc != Z_OK ) return Finish( req, ToXRootDStatus( rc, "inflatePrime" ), 0 );
+        cur.prime = 0;
+        ++cur.strm.next_in;
+        --cur.strm.avail_in;
+        ++cur.in;
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    // A read reaching the end of the data inflates up to the end of the
+    // stream so that we learn the index is complete
+    //--------------------------------------------------------------------------
+    bool tillend = reqend >= usize;
+    while( ( cur.out < reqend || tillend ) && !cur.end )
+    {
+      //------------------------------------------------------------------------
+      // If we ran out of input fetch the compressed data up to the checkpoint
+      // following the read or, if there is none, as much as we expect to need
+      // (past the end of the compressed data inflate may still have output
+      // pending that did not fit in the window)
+      //------------------------------------------------------------------------
+      if( !cur.strm.avail_in && cur.in < csize )
+      {
+        uint64_t size = std::min<uint64_t>( std::max<uint64_t>( reqend - cur.out, MinFetch ), MaxFetch );
+        {
+          std::unique_lock<std::mutex> lck( mtx );
+          auto itr = std::lower_bound( index.begin(), index.end(), reqend,
+                                       []( const std::unique_ptr<Point> &pt, uint64_t off )
+                                       {
+                                         return pt->out < off;
+                                       } );
+          if( itr != index.end() && (*itr)->in > cur.in )
+            size = std::min<uint64_t>( (*itr)->in - cur.in, MaxFetch );
+        }
+        size = std::min( size, csize - cur.in );
+        auto self = shared_from_this();
+        fetch( cur.in, size, [self, req]( const XRootDStatus &st, buffer_t &&data )
+               {
+                 req->status  = st;
+                 req->data    = std::move( data );
+                 req->fetched = true;
+                 InflateJob::Queue( self, req );
+               } );
+        return;
+      }
+
+      //------------------------------------------------------------------------
+      // Inflate into the window up to the end of a deflate block at most
+      //------------------------------------------------------------------------
+      uint32_t pos = cur.out % WinSize;
+      cur.strm.next_out  = cur.window + pos;
+      cur.strm.avail_out = WinSize - pos;
+      uInt inbefore = cur.strm.avail_in;
+      int rc = inflate( &cur.strm, Z_BLOCK );
+      if( rc == Z_BUF_ERROR )
+        return Finish( req, XRootDStatus( stError, errDataError, 0,
+                                          "[zlib] unexpected end of compressed data." ), 0 );
+      if( rc != Z_OK && rc != Z_STREAM_END )
+        return Finish( req, ToXRootDStatus( rc, "inflate" ), 0 );
+      uint32_t produced = WinSize - pos - cur.strm.avail_out;
+      cur.in += inbefore - cur.strm.avail_in;
+
+      //------------------------------------------------------------------------
+      // Copy the part of the output that has been asked for
+      //------------------------------------------------------------------------
+      uint64_t begin = std::max( cur.out, req->offset );
+      uint64_t end   = std::min( cur.out + produced, reqend );
+      if( begin < end )
+        memcpy( req->buffer + ( begin - req->offset ),
+                cur.window + pos + ( begin - cur.out ), end - begin );
+      cur.out += produced;
+
+      if( rc == Z_STREAM_END )
+      {
+        cur.end = true;
+        std::unique_lock<std::mutex> lck( mtx );
+        complete = true;
+        if( saved || sidecar.empty() ) continue;
+        saved = true;
+        lck.unlock();
+        SaveIndex();
+        continue;
+      }
+
+      //------------------------------------------------------------------------
+      // At the end of a block we can add a checkpoint
+      //------------------------------------------------------------------------
+      if( ( cur.strm.data_type & 128 ) && !( cur.strm.data_type & 64 ) &&
+          cur.out >= nextpt.load( std::memory_order_relaxed ) )
+        AddPoint( cur );
+    }
+
+    uint64_t done = std::min( cur.out, reqend );
+    Finish( req, XRootDStatus(), done > req->offset ? done - req->offset : 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Call the user handler
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::Finish( std::shared_ptr<Request> req, const XRootDStatus &st, uint32_t length )
+  {
+    AnyObject *rsp = nullptr;
+    if( st.IsOK() )
+    {
+      rsp = new AnyObject();
+      rsp->Set( new ChunkInfo( req->offset, length, req->buffer ) );
+      if( req->cursor ) Release( std::move( req->cursor ) );
+    }
+    else
+    {
+      Log *log = DefaultEnv::GetLog();
+      log->Error( ZipMsg, "[%p] Failed to inflate %u bytes at offset %llu: %s",
+                  (void*)this, req->length, (unsigned long long)req->offset,
+                  st.ToString().c_str() );
+    }
+    req->cursor.reset();
+    req->handler->HandleResponse( new XRootDStatus( st ), rsp );
+  }
+
+  //----------------------------------------------------------------------------
+  // Add a checkpoint at the current position of an inflater
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::AddPoint( Cursor &cur )
+  {
+    std::unique_lock<std::mutex> lck( mtx );
+    if( complete || cur.out < index.back()->out + span ) return;
+
+    std::unique_ptr<Point> pt( new Point() );
+    pt->out  = cur.out;
+    pt->in   = cur.in;
+    pt->bits = cur.strm.data_type & 7;
+    pt->window.resize( WinSize );
+    uint32_t pos = cur.out % WinSize;
+    memcpy( pt->window.data(), cur.window + pos, WinSize - pos );
+    memcpy( pt->window.data() + WinSize - pos, cur.window, pos );
+    index.push_back( std::move( pt ) );
+    nextpt = cur.out + span;
+  }
+
+  //----------------------------------------------------------------------------
+  // Get an inflater for a read: either an idle one that stopped before the
+  // read and after the closest checkpoint, or a new one at that checkpoint
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::Acquire( Request &req )
+  {
+    std::unique_lock<std::mutex> lck( mtx );
+    auto itr = std::upper_bound( index.begin(), index.end(), req.offset,
+                                 []( uint64_t off, const std::unique_ptr<Point> &pt )
+                                 {
+                                   return off < pt->out;
+                                 } );
+    const Point *pt = ( *( itr - 1 ) ).get();
+
+    auto best = idle.end();
+    for( auto cur = idle.begin(); cur != idle.end(); ++cur )
+      if( (*cur)->out <= req.offset && (*cur)->out >= pt->out &&
+          ( best == idle.end() || (*cur)->out > (*best)->out ) )
+        best = cur;
+    if( best != idle.end() )
+    {
+      req.cursor = std::move( *best );
+      idle.erase( best );
+      return;
+    }
+    lck.unlock();
+
+    //--------------------------------------------------------------------------
+    // The checkpoints are never modified once added so we can use this one
+    // without the lock
+    //--------------------------------------------------------------------------
+    std::unique_ptr<Cursor> cur( new Cursor() );
+    cur->out   = pt->out;
+    cur->in    = pt->in - ( pt->bits ? 1 : 0 );
+    cur->prime = pt->bits;
+    if( !pt->window.empty() )
+    {
+      int rc = inflateSetDictionary( &cur->strm, pt->window.data(), WinSize );
+      XRootDStatus st = ToXRootDStatus( rc, "inflateSetDictionary" );
+      if( !st.IsOK() ) throw ZipError( st );
+      uint32_t pos = pt->out % WinSize;
+      memcpy( cur->window + pos, pt->window.data(), WinSize - pos );
+      memcpy( cur->window, pt->window.data() + WinSize - pos, pos );
+    }
+    req.cursor = std::move( cur );
+  }
+
+  //----------------------------------------------------------------------------
+  // Keep an inflater for subsequent reads, dropping the one that is the
+  // furthest behind if we have too many
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::Release( std::unique_ptr<Cursor> cur )
+  {
+    if( cur->end ) return;
+    std::unique_lock<std::mutex> lck( mtx );
+    idle.push_back( std::move( cur ) );
+    if( idle.size() <= MaxIdle ) return;
+    auto last = std::min_element( idle.begin(), idle.end(),
+                                  []( const std::unique_ptr<Cursor> &lhs,
+                                      const std::unique_ptr<Cursor> &rhs )
+                                  {
+                                    return lhs->out < rhs->out;
+                                  } );
+    idle.erase( last );
+  }
+
+  //----------------------------------------------------------------------------
+  // Load a complete index from the sidecar file if it matches our data
+  //----------------------------------------------------------------------------
+  bool ZipIndexCache::LoadIndex()
+  {
+    std::ifstream file( sidecar, std::ios::binary );
+    if( !file ) return false;
+
+    char     magic[sizeof( IndexMagic )];
+    uint64_t keylen = 0, cs = 0, us = 0, count = 0;
+    uint32_t crc = 0, sp = 0;
+    file.read( magic, sizeof( magic ) );
+    file.read( (char*)&keylen, sizeof( keylen ) );
+    if( !file || memcmp( magic, IndexMagic, sizeof( magic ) ) || keylen != key.size() )
+      return false;
+    std::string k( keylen, '\0' );
+    file.read( &k[0], keylen );
+    file.read( (char*)&cs,    sizeof( cs ) );
+    file.read( (char*)&us,    sizeof( us ) );
+    file.read( (char*)&crc,   sizeof( crc ) );
+    file.read( (char*)&sp,    sizeof( sp ) );
+    file.read( (char*)&count, sizeof( count ) );
+    if( !file || k != key || cs != csize || us != usize || crc != crc32 || !count )
+      return false;
+
+    std::vector<std::unique_ptr<Point>> points;
+    for( uint64_t i = 0; i < count; ++i )
+    {
+      std::unique_ptr<Point> pt( new Point() );
+      uint32_t winlen = 0;
+      file.read( (char*)&pt->out,  sizeof( pt->out ) );
+      file.read( (char*)&pt->in,   sizeof( pt->in ) );
+      file.read( (char*)&pt->bits, sizeof( pt->bits ) );
+      file.read( (char*)&winlen,   sizeof( winlen ) );
+      if( !file || ( winlen != 0 && winlen != WinSize ) || pt->bits < 0 || pt->bits > 7 ||
+          pt->in > csize || pt->out > usize ||
+          ( points.empty() ? pt->out != 0 || winlen : pt->out <= points.back()->out || !winlen ) )
+        return false;
+      pt->window.resize( winlen );
+      file.read( (char*)pt->window.data(), winlen );
+      if( !file ) return false;
+      points.push_back( std::move( pt ) );
+    }
+
+    std::unique_lock<std::mutex> lck( mtx );
+    index.swap( points );
+    nextpt   = index.back()->out + span;
+    complete = true;
+    saved    = true;
+    Log *log = DefaultEnv::GetLog();
+    log->Debug( ZipMsg, "[%p] Loaded %llu inflate checkpoints from %s.", (void*)this,
+                (unsigned long long)count, sidecar.c_str() );
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Save the complete index to the sidecar file
+  //----------------------------------------------------------------------------
+  void ZipIndexCache::SaveIndex()
+  {
+    Log *log = DefaultEnv::GetLog();
+    std::string tmp = sidecar + "." + std::to_string( getpid() );
+    std::ofstream file( tmp, std::ios::binary | std::ios::trunc );
+
+    // the index is complete, so nobody is going to modify it anymore
+    uint64_t keylen = key.size(), count = index.size();
+    uint32_t sp = span;
+    file.write( IndexMagic, sizeof( IndexMagic ) );
+    file.write( (const char*)&keylen, sizeof( keylen ) );
+    file.write( key.data(), keylen );
+    file.write( (const char*)&csize, sizeof( csize ) );
+    file.write( (const char*)&usize, sizeof( usize ) );
+    file.write( (const char*)&crc32, sizeof( crc32 ) );
+    file.write( (const char*)&sp,    sizeof( sp ) );
+    file.write( (const char*)&count, sizeof( count ) );
+    for( auto &pt : index )
+    {
+      uint32_t winlen = pt->window.size();
+      file.write( (const char*)&pt->out,  sizeof( pt->out ) );
+      file.write( (const char*)&pt->in,   sizeof( pt->in ) );
+      file.write( (const char*)&pt->bits, sizeof( pt->bits ) );
+      file.write( (const char*)&winlen,   sizeof( winlen ) );
+      file.write( (const char*)pt->window.data(), winlen );
+    }
+    file.close();
+
+    if( !file || rename( tmp.c_str(), sidecar.c_str() ) )
+    {
+      log->Warning( ZipMsg, "[%p] Unable to save inflate checkpoints to %s.",
+                    (void*)this, sidecar.c_str() );
+      unlink( tmp.c_str() );
+      return;
+    }
+    log->Debug( ZipMsg, "[%p] Saved %llu inflate checkpoints to %s.", (void*)this,
+                (unsigned long long)count, sidecar.c_str() );
+  }
+
+  //----------------------------------------------------------------------------
+  // Convert a zlib return code to an XRootDStatus
+  //----------------------------------------------------------------------------
+  XRootDStatus ZipIndexCache::ToXRootDStatus( int rc, const std::string &func )
+  {
+    std::string msg = "[zlib] " + func + " : ";
+
+    switch( rc )
+    {
+      case Z_STREAM_END    :
+      case Z_OK            : return XrdCl::XRootDStatus();
+      case Z_BUF_ERROR     : return XrdCl::XRootDStatus( XrdCl::stOK,    XrdCl::suContinue );
+      case Z_MEM_ERROR     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_MEM_ERROR,     msg + "not enough memory." );
+      case Z_VERSION_ERROR : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInternal,    Z_VERSION_ERROR, msg + "version mismatch." );
+      case Z_STREAM_ERROR  : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errInvalidArgs, Z_STREAM_ERROR,  msg + "invalid argument." );
+      case Z_NEED_DICT     : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_NEED_DICT,     msg + "need dict.");
+      case Z_DATA_ERROR    : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errDataError,   Z_DATA_ERROR,    msg + "corrupted data." );
+      default              : return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errUnknown );
+    }
+  }
+}
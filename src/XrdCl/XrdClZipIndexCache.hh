@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_ZIP_INDEX_CACHE_HH__
+#define __XRD_CL_ZIP_INDEX_CACHE_HH__
+
+#include "XrdCl/XrdClZipCache.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace XrdCl
+{
+  //---------------------------------------------------------------------------
+  //! Random access inflater for a deflated file in a ZIP archive
+  //!
+  //! While inflating, the cache records a checkpoint (the position in the
+  //! compressed and uncompressed data together with the preceding 32 KiB
+  //! inflate window) roughly every 'span' bytes of uncompressed data. A read
+  //! restarts inflating from the closest checkpoint at or before its offset,
+  //! or continues from where an earlier read stopped, instead of inflating
+  //! everything before it. A read past the checkpoints extends them as it
+  //! goes, so the index is built by the first accesses. Once complete, the
+  //! index can be saved to and later loaded from a sidecar file.
+  //!
+  //! Reads are inflated in the worker threads of the client, so reads from
+  //! different files (and different parts of one file) run in parallel.
+  //---------------------------------------------------------------------------
+  class ZipIndexCache : public std::enable_shared_from_this<ZipIndexCache>
+  {
+    public:
+
+      typedef std::vector<char> buffer_t;
+
+      //-----------------------------------------------------------------------
+      //! Callback receiving compressed data
+      //-----------------------------------------------------------------------
+      typedef std::function<void( const XRootDStatus&, buffer_t&& )> fetched_t;
+
+      //-----------------------------------------------------------------------
+      //! Function fetching compressed data given the offset relative to the
+      //! start of the compressed data and the size
+      //-----------------------------------------------------------------------
+      typedef std::function<void( uint64_t, uint32_t, fetched_t )> fetch_t;
+
+      //-----------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param csize   : size of the compressed data
+      //! @param usize   : size of the uncompressed data
+      //! @param crc32   : crc32 of the uncompressed data
+      //! @param fetch   : function fetching compressed data
+      //! @param span    : uncompressed bytes between checkpoints
+      //! @param sidecar : the sidecar file for the index (none if empty)
+      //! @param key     : string identifying the file in the sidecar
+      //-----------------------------------------------------------------------
+      ZipIndexCache( uint64_t           csize,
+                uint64_t           usize,
+                uint32_t           crc32,
+                fetch_t            fetch,
+                uint32_t           span,
+                const std::string &sidecar = "",
+                const std::string &key     = "" );
+
+      //-----------------------------------------------------------------------
+      //! Destructor
+      //-----------------------------------------------------------------------
+      ~ZipIndexCache();
+
+      //-----------------------------------------------------------------------
+      //! Queue a read of uncompressed data, the handler is called with a
+      //! ChunkInfo once the data have been inflated
+      //-----------------------------------------------------------------------
+      void QueueReq( uint64_t offset, uint32_t length, void *buffer, ResponseHandler *handler );
+
+      //-----------------------------------------------------------------------
+      //! @return : number of checkpoints and whether the index is complete
+      //-----------------------------------------------------------------------
+      std::pair<size_t, bool> IndexInfo();
+
+    private:
+
+      struct Point;
+      struct Cursor;
+      struct Request;
+      class  InflateJob;
+
+      void Inflate( std::shared_ptr<Request> req );
+      void Finish( std::shared_ptr<Request> req, const XRootDStatus &st, uint32_t length );
+      void AddPoint( Cursor &cur );
+      void Acquire( Request &req );
+      void Release( std::unique_ptr<Cursor> cur );
+      bool LoadIndex();
+      void SaveIndex();
+
+      static XRootDStatus ToXRootDStatus( int rc, const std::string &func );
+
+      const uint64_t                       csize;    //< size of the compressed data
+      const uint64_t                       usize;    //< size of the uncompressed data
+      const uint32_t                       crc32;    //< crc32 of the uncompressed data
+      const fetch_t                        fetch;    //< fetches compressed data
+      const uint32_t                       span;     //< distance between checkpoints
+      const std::string                    sidecar;  //< file for saving the index
+      const std::string                    key;      //< identifies us in the sidecar
+
+      std::mutex                           mtx;
+      std::vector<std::unique_ptr<Point>>  index;    //< checkpoints ordered by offset
+      std::atomic<uint64_t>                nextpt;   //< offset of the next checkpoint
+      bool                                 complete; //< the index covers all data
+      bool                                 saved;    //< the index has been saved
+      std::vector<std::unique_ptr<Cursor>> idle;     //< inflaters left by earlier reads
+  };
+
+}
+
+#endif // __XRD_CL_ZIP_INDEX_CACHE_HH__
@@ -63,13 +63,14 @@ public:
 
 void   DoIt() {Cache.Recycle(myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsKeyItem **List)
+                     : XrdJob("cache scrubber")
+                     {memcpy(myList, List, sizeof(myList));}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsKeyItem *myList[XrdCmsCache::PartNum];
 };
 
 /******************************************************************************/
@@ -116,18 +117,19 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Partition &pP = getPart(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   pP.pMutex.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = pP.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -138,7 +140,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
            iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Key.TOD = pP.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,8 +157,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = pP.Tock;
+                 if ((iP = pP.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
                      iP->Loc.TOD_B    = BClock;
@@ -170,7 +172,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   pP.pMutex.UnLock();
    return isnew;
 }
   
@@ -190,29 +192,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Partition &pP = getPart(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   pP.pMutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = pP.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  pP.Pool.Unload(iP) && !pP.CTable.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   pP.pMutex.UnLock();
    return gone4good;
 }
   
@@ -231,19 +234,26 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   Partition &pP = getPart(Sel.Path);
    XrdCmsKeyItem *iP;
-   SMask_t bVec;
+   SMask_t bVec, okv;
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   pP.pMutex.Lock();
 
-// Look up the entry and return location information
+// Look up the entry and return location information. The bounce history is
+// only consulted, under its own lock, when some server bounced since the
+// entry was last brought up to date.
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = pP.CTable.Find(Sel.Path)))
+      {if (iP->Loc.TOD_B < BClock)
+          {myMutex.Lock();
+           bVec = getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask;
+           myMutex.UnLock();
+          } else bVec = 0;
+       if (bVec)
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +268,16 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       okv             = okVec;
+       Sel.Vec.hf      = okv & iP->Loc.hfvec;
+       Sel.Vec.pf      = okv & iP->Loc.pfvec;
+       Sel.Vec.bf      = okv & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
       } else retc = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   pP.pMutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -278,11 +289,12 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   Partition &pP = getPart(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   pP.pMutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +306,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   pP.pMutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +325,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Partition &pP = getPart(Sel.Path);
+   pP.pMutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +341,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   pP.pMutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -379,7 +392,6 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
   
 int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
 {
-   XrdCmsKeyItem *iP;
    pthread_t tid;
 
 // Indicate whether we are a shared-everything setup as this changes how we
@@ -409,11 +421,9 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        return 0;
       }
 
-// Get the first reserve of cache items
+// Get the first reserve of cache items for each partition
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   for (int i = 0; i < PartNum; i++) Part[i].Pool.Replenish();
 
 // All done
 //
@@ -426,17 +436,26 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 void *XrdCmsCache::TickTock()
 {
-   XrdCmsKeyItem *iP;
+   XrdCmsKeyItem *iP[PartNum];
+   unsigned int theTock;
+   bool haveOld;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries. Each partition is trimmed
+// under its own lock so that only lookups in that partition wait for it.
 //
    do {XrdSysTimer::Snooze(Tick);
        myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
+       theTock = Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
        Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
        myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       haveOld = false;
+       for (int i = 0; i < PartNum; i++)
+           {Part[i].pMutex.Lock();
+            Part[i].Tock = theTock;
+            if ((iP[i] = Part[i].Pool.Unload(theTock))) haveOld = true;
+            Part[i].pMutex.UnLock();
+           }
+       if (haveOld) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
       } while(1);
 
 // Keep compiler happy
@@ -531,40 +550,47 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(XrdCmsKeyItem **theList)
 {
    XrdCmsKeyItem *iP;
    char msgBuff[100];
-   int numNull, numHave, numFree, numRecycled = 0;
+   int numNull, numHave, numFree, numRecycled = 0, totHave = 0, totFree = 0;
+
+// Process each partition in turn
+//
+   for (int i = 0; i < PartNum; i++)
+       {Partition &pP = Part[i];
 
 // Recycle the list of cache items, as needed
 //
-   while((iP = theList))
-        {theList = iP->Key.TODRef;
-         if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
-         if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
-         numRecycled++;
-        }
+        while((iP = theList[i]))
+             {theList[i] = iP->Key.TODRef;
+              if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
+              if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
+              pP.pMutex.Lock(); pP.CTable.Recycle(iP); pP.pMutex.UnLock();
+              numRecycled++;
+             }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
-   XrdCmsKeyItem::Stats(numHave, numFree, numNull);
-   if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
-       numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+        pP.pMutex.Lock();
+        pP.Pool.Stats(numHave, numFree, numNull);
+        if (numFree < XrdCmsKeyItem::minFree)
+           {pP.pMutex.UnLock();
+            if (!(numNull /= 4)) numNull = 1;
+            numHave += XrdCmsKeyItem::minAlloc * numNull;
+            while(numNull--)
+                 {pP.pMutex.Lock();
+                  numFree = pP.Pool.Replenish();
+                  pP.pMutex.UnLock();
+                 }
+           } else pP.pMutex.UnLock();
+        totHave += numHave; totFree += numFree;
+       }
 
 // Log the stats
 //
    sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+           numRecycled, totHave, totFree);
    Say.Emsg("Recycle", msgBuff);
 }
@@ -30,6 +30,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cstring>
   
 #include "Xrd/XrdJob.hh"
@@ -80,7 +81,7 @@ void       *TickTock();
 
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
+            XrdCmsCache() : okVec(0), BClock(0), Tick(8*60*60), Tock(0),
                             nilTMO(0),
                             DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
                             isDFS(0)
@@ -91,24 +92,47 @@ static const int min_nxTime = 60;
 
 private:
 
+// The cache is split into partitions by the high order bits of the key hash.
+// Each partition has its own lock, hash table, and pool of key items so that
+// lookups of different paths rarely contend. The server bounce information is
+// shared by all partitions and protected by myMutex which, when both are
+// needed, is always obtained after the partition lock.
+//
+static const int PartBits = 4;
+static const int PartNum  = 1 << PartBits;
+
+struct alignas(64) Partition
+      {XrdSysMutex   pMutex;
+       XrdCmsKeyPool Pool;
+       XrdCmsNash    CTable;
+       unsigned int  Tock;     // Partition's view of the cache clock
+
+                     Partition() : CTable(Pool, 987, 1597), Tock(0) {}
+                    ~Partition() {}
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
 SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
+Partition    &getPart(XrdCmsKey &Key)
+                     {if (!Key.Hash) Key.setHash();
+                      return Part[Key.Hash >> (32 - PartBits)];
+                     }
+void          Recycle(XrdCmsKeyItem **theList);
 
 struct  {SMask_t      Vec;
          unsigned int Start;
          unsigned int End;
         }             Bhistory[XrdCmsKeyItem::TickRate];
 
+Partition     Part[PartNum];
 XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
 unsigned int  Bounced[STMax];
-SMask_t       okVec;
+std::atomic<SMask_t>      okVec;   // Read without myMutex
+std::atomic<unsigned int> BClock;  // Read without myMutex
 unsigned int  Tick;
 unsigned int  Tock;
-unsigned int  BClock;
          int  nilTMO;
          int  DLTime;
          int  QDelay;
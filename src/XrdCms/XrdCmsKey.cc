@@ -52,23 +52,13 @@ void XrdCmsKey::setHash()
 }
 
 /******************************************************************************/
-/*                   C l a s s   X r d C m s K e y I t e m                    */
+/*                   C l a s s   X r d C m s K e y P o o l                    */
 /******************************************************************************/
 /******************************************************************************/
-/*                           S t a t i c   D a t a                            */
+/* public                          A l l o c                                  */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
-XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
-int            XrdCmsKeyItem::numFree = 0;
-int            XrdCmsKeyItem::numHave = 0;
-int            XrdCmsKeyItem::numNull = 0;
-
-/******************************************************************************/
-/* static public                   A l l o c                                  */
-/******************************************************************************/
-  
-XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyPool::Alloc(unsigned int theTock)
 {
   XrdCmsKeyItem *kP;
 
@@ -77,7 +67,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
    do {if ((kP = Free))
           {Free = kP->Next;
            numFree--;
-           theTock &= TickMask;
+           theTock &= XrdCmsKeyItem::TickMask;
            kP->Key.TOD    = theTock;
            kP->Key.TODRef = TockTable[theTock];
            TockTable[theTock] = kP;
@@ -98,18 +88,19 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
 /* public                        R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsKeyItem::Recycle()
+void XrdCmsKeyPool::Recycle(XrdCmsKeyItem *theItem)
 {
    static char *noKey = (char *)"";
 
 // Clear up data areas
 //
-   if (Key.Val && Key.Val != noKey) {free(Key.Val); Key.Val = noKey;}
-   Key.Ref++; Key.Hash = 0;
+   if (theItem->Key.Val && theItem->Key.Val != noKey)
+      {free(theItem->Key.Val); theItem->Key.Val = noKey;}
+   theItem->Key.Ref++; theItem->Key.Hash = 0;
 
 // Put entry on the free list
 //
-   Next = Free; Free = this;
+   theItem->Next = Free; Free = theItem;
    numFree++;
 }
 
@@ -117,20 +108,21 @@ void XrdCmsKeyItem::Recycle()
 /* public                         R e l o a d                                 */
 /******************************************************************************/
   
-void XrdCmsKeyItem::Reload()
+void XrdCmsKeyPool::Reload(XrdCmsKeyItem *theItem)
 {
-   Key.TOD &= static_cast<unsigned char>(TickMask);
-   Key.TODRef = TockTable[Key.TOD];
-   TockTable[Key.TOD] = this;
+   theItem->Key.TOD &= static_cast<unsigned char>(XrdCmsKeyItem::TickMask);
+   theItem->Key.TODRef = TockTable[theItem->Key.TOD];
+   TockTable[theItem->Key.TOD] = theItem;
 }
 
 /******************************************************************************/
-/* static public               R e p l e n i s h                              */
+/* public                      R e p l e n i s h                              */
 /******************************************************************************/
 
-int XrdCmsKeyItem::Replenish()
+int XrdCmsKeyPool::Replenish()
 {
    EPNAME("Replenish");
+   const int minAlloc = XrdCmsKeyItem::minAlloc;
    XrdCmsKeyItem *kP;
    int i;
 
@@ -153,10 +145,10 @@ int XrdCmsKeyItem::Replenish()
 }
 
 /******************************************************************************/
-/* static public                   S t a t s                                  */
+/* public                          S t a t s                                  */
 /******************************************************************************/
 
-void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
+void XrdCmsKeyPool::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
 
    isAlloc  = numHave;
@@ -166,10 +158,10 @@ void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 }
 
 /******************************************************************************/
-/* static public                  U n l o a d                                 */
+/* public                         U n l o a d                                 */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyPool::Unload(unsigned int theTock)
 {
    XrdCmsKeyItem myItem, *nP, *pP = &myItem;
 
@@ -178,7 +170,7 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 // make the entry unfindable by clearing the hash code. Since item recycling
 // requires knowing the hash code, we save it elsewhere in the object.
 //
-   theTock &= TickMask;
+   theTock &= XrdCmsKeyItem::TickMask;
    myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
    while((nP = pP->Key.TODRef))
          if (nP->Key.TOD == theTock) 
@@ -192,10 +184,10 @@ XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
 
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
+XrdCmsKeyItem *XrdCmsKeyPool::Unload(XrdCmsKeyItem *theItem)
 {
    XrdCmsKeyItem *kP, *pP = 0;
-   unsigned int theTock = theItem->Key.TOD & TickMask;
+   unsigned int theTock = theItem->Key.TOD & XrdCmsKeyItem::TickMask;
 
 // Remove the entry from the right list
 //
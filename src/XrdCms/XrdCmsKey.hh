@@ -130,34 +130,51 @@ public:
        XrdCmsKey      Key;
        XrdCmsKeyItem *Next;
 
-static XrdCmsKeyItem *Alloc(unsigned int theTock);
+       XrdCmsKeyItem() {}  // Warning see the constructor!
+      ~XrdCmsKeyItem() {}  // These are usually never deleted
 
-       void           Recycle();
+static const unsigned int TickRate =   64;
+static const unsigned int TickMask =   63;
+static const          int minAlloc = 1024;  // Per key pool
+static const          int minFree  =  256;  // Per key pool
+};
 
-       void           Reload();
+/******************************************************************************/
+/*                   C l a s s   X r d C m s K e y P o o l                    */
+/******************************************************************************/
+  
+// The XrdCmsKeyPool object supplies the key items of one partition of the
+// key cache and keeps them on per-tick lists so that they can be aged out.
+// It is not MT-safe; the cache serializes access using the partition lock.
+//
+class XrdCmsKeyPool
+{
+public:
 
-static int            Replenish();
+XrdCmsKeyItem *Alloc(unsigned int theTock);
 
-static void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
+void           Recycle(XrdCmsKeyItem *theItem);
 
-static XrdCmsKeyItem *Unload(unsigned int   theTock);
+void           Reload(XrdCmsKeyItem *theItem);
 
-static XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+int            Replenish();
 
-       XrdCmsKeyItem() {}  // Warning see the constructor!
-      ~XrdCmsKeyItem() {}  // These are usually never deleted
+void           Stats(int &isAlloc, int &isFree, int &wasEmpty);
 
-static const unsigned int TickRate =   64;
-static const unsigned int TickMask =   63;
-static const          int minAlloc = 4096;
-static const          int minFree  = 1024;
+XrdCmsKeyItem *Unload(unsigned int   theTock);
+
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+
+               XrdCmsKeyPool() : Free(0), numFree(0), numHave(0), numNull(0)
+                               {memset(TockTable, 0, sizeof(TockTable));}
+              ~XrdCmsKeyPool() {}  // Never gets deleted
 
 private:
 
-static XrdCmsKeyItem *TockTable[TickRate];
-static XrdCmsKeyItem *Free;
-static int            numFree;
-static int            numHave;
-static int            numNull;
+XrdCmsKeyItem *TockTable[XrdCmsKeyItem::TickRate];
+XrdCmsKeyItem *Free;
+int            numFree;
+int            numHave;
+int            numNull;
 };
 #endif
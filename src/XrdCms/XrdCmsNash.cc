@@ -36,7 +36,8 @@
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
   
-XrdCmsNash::XrdCmsNash(int psize, int csize)
+XrdCmsNash::XrdCmsNash(XrdCmsKeyPool &pool, int psize, int csize)
+          : keyPool(pool)
 {
      prevtablesize = psize;
      nashtablesize = csize;
@@ -58,7 +59,7 @@ XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 
 // Allocate the entry
 //
-   if (!(hip = XrdCmsKeyItem::Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
+   if (!(hip = keyPool.Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
 
 // Check if we should expand the table
 //
@@ -172,7 +173,7 @@ int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
    if (nip)
       {if (pip) pip->Next = nip->Next;
           else nashtable[kent] = nip->Next;
-          rip->Recycle();
+          keyPool.Recycle(rip);
           nashnum--;
       }
    return nip != 0;
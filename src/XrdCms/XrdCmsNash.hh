@@ -45,7 +45,9 @@ int            Recycle(XrdCmsKeyItem *rip);
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
 //
-    XrdCmsNash(int psize = 17711, int size = 28657);
+// Items are allocated from and recycled to the passed key pool.
+//
+    XrdCmsNash(XrdCmsKeyPool &pool, int psize = 17711, int size = 28657);
    ~XrdCmsNash() {} // Never gets deleted
 
 private:
@@ -54,6 +56,7 @@ static const int LoadMax = 80;
 
 void               Expand();
 
+XrdCmsKeyPool   &keyPool;
 XrdCmsKeyItem  **nashtable;
 int              prevtablesize;
 int              nashtablesize;
@@ -40,6 +40,7 @@
 #include "XrdVersion.hh"
 
 #include "Xrd/XrdInfo.hh"
+#include "XrdCks/XrdCksManager.hh"
 #include "XrdFrc/XrdFrcTrace.hh"
 #include "XrdFrc/XrdFrcUtils.hh"
 #include "XrdFrm/XrdFrmCns.hh"
@@ -1307,9 +1308,11 @@ int XrdFrmConfig::xapath()
 
 /* Function: xcks
 
-   Purpose:  To parse the directive: chksum [max <n>] <type> <path>
+   Purpose:  To parse the directive: chksum [max <n>] [threads <t>]
+                                            <type> <path>
 
              max       maximum number of simultaneous jobs
+             threads   number of threads used to compute a single checksum
              <type>    algorithm of checksum (e.g., md5)
              <path>    the path of the program performing the checksum
 
@@ -1319,11 +1322,19 @@ int XrdFrmConfig::xapath()
 int XrdFrmConfig::xcks()
 {
    char *palg;
+   int   jthr;
 
 // Get the algorithm name and the program implementing it
 //
    while ((palg = cFile->GetWord()) && *palg != '/')
-         {if (strcmp(palg, "max")) break;
+         {if (!strcmp(palg, "threads"))
+             {if (!(palg = cFile->GetWord()))
+                 {Say.Emsg("Config", "chksum threads not specified"); return 1;}
+              if (XrdOuca2x::a2i(Say,"chksum threads",palg,&jthr,1,64)) return 1;
+              XrdCksManager::SetThreads(jthr);
+              continue;
+             }
+          if (strcmp(palg, "max")) break;
           if (!(palg = cFile->GetWord()))
              {Say.Emsg("Config", "chksum max not specified"); return 1;}
          }
@@ -231,6 +231,51 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return (retc < 0 ? retErr(errno, specDest) : 0);
 }
   
+/******************************************************************************/
+/*                             S e n d B a t c h                              */
+/******************************************************************************/
+
+int XrdNetMsg::SendBatch(const struct iovec msgs[], int msgcnt)
+{
+   int retc, numDone = 0, rc = 0;
+
+// We only support sending to the connected address
+//
+   if (!destOK)
+      {eDest->Emsg("NetMsg", "Destination not specified."); return -1;}
+
+// Send as many messages per system call as possible. Should a message fail
+// we report it, skip it, and continue with the next one.
+//
+#if defined(__linux__)
+   const int mMax = 64;
+   struct mmsghdr mVec[mMax];
+
+   while(numDone < msgcnt)
+        {int n = (msgcnt - numDone > mMax ? mMax : msgcnt - numDone);
+         memset(mVec, 0, sizeof(struct mmsghdr) * n);
+         for (int i = 0; i < n; i++)
+             {mVec[i].msg_hdr.msg_iov    = const_cast<struct iovec*>(&msgs[numDone+i]);
+              mVec[i].msg_hdr.msg_iovlen = 1;
+             }
+         do {retc = sendmmsg(FD, mVec, n, 0);} while(retc < 0 && errno == EINTR);
+         if (retc > 0) numDone += retc;
+            else {rc = retErr(errno, dfltDest); numDone++;}
+        }
+#else
+   for (numDone = 0; numDone < msgcnt; numDone++)
+       {do {retc = send(FD, (Sokdata_t)msgs[numDone].iov_base,
+                        msgs[numDone].iov_len, 0);
+           } while(retc < 0 && errno == EINTR);
+        if (retc < 0) rc = retErr(errno, dfltDest);
+       }
+#endif
+
+// All done
+//
+   return (rc ? -1 : 0);
+}
+
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
@@ -111,6 +111,19 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+//------------------------------------------------------------------------------
+//! Send a batch of UDP messages to the endpoint specified in the constructor.
+//! Each element of the vector is sent as a separate message. Where available
+//! sendmmsg() is used to send many messages with a single system call.
+//!
+//! @param  msgs     The vector of messages to send.
+//! @param  msgcnt   The number of elements (i.e. messages) in the vector.
+//! @return <0       One or more messages not sent due to error.
+//! @return =0       All messages sent (well as defined by UDP)
+//------------------------------------------------------------------------------
+
+int           SendBatch(const struct iovec msgs[], int msgcnt);
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
@@ -45,6 +45,7 @@
 
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -102,6 +103,13 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 int XrdOssFile::Fsync(XrdSfsAio *aiop)
 {
 
+// Use io_uring if it is available and there is room in the ring
+//
+   if (XrdOssUring::Active())
+      {aiop->TIdent = tident;
+       if (!XrdOssUring::Fsync(fd, aiop)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    int rc;
 
@@ -153,9 +161,19 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
   
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
+   EPNAME("AioRead");
+
+// Use io_uring if it is available and there is room in the ring
+//
+   if (XrdOssUring::Active())
+      {aiop->TIdent = tident;
+       TRACE(Debug,  "fd=" <<fd <<" uring read " <<aiop->sfsAio.aio_nbytes
+                           <<'@' <<aiop->sfsAio.aio_offset <<" started; aiocb="
+                           <<Xrd::hex1 <<aiop);
+       if (!XrdOssUring::Read(fd, aiop)) return 0;
+      }
 
 #ifdef _POSIX_ASYNCHRONOUS_IO
-   EPNAME("AioRead");
    int rc;
 
 // Complete the aio request block and do the operation
@@ -211,8 +229,19 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
   
 int XrdOssFile::Write(XrdSfsAio *aiop)
 {
-#ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioWrite");
+
+// Use io_uring if it is available and there is room in the ring
+//
+   if (XrdOssUring::Active())
+      {aiop->TIdent = tident;
+       TRACE(Debug, "fd=" <<fd <<" uring write " <<aiop->sfsAio.aio_nbytes
+                          <<'@' <<aiop->sfsAio.aio_offset <<" started; aiocb="
+                          <<Xrd::hex1 <<aiop);
+       if (!XrdOssUring::Write(fd, aiop)) return 0;
+      }
+
+#ifdef _POSIX_ASYNCHRONOUS_IO
    int rc;
 
 // Complete the aio request block and do the operation
@@ -41,6 +41,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 #ifdef __solaris__
 #include <sys/vnode.h>
 #endif
@@ -54,6 +55,7 @@
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
@@ -65,6 +67,7 @@
 #include "XrdSys/XrdSysHeaders.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPlugin.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 #ifdef XRDOSSCX
 #include "oocx_CXFile.h"
@@ -87,6 +90,83 @@ XrdSysTrace OssTrace("oss");
 char      XrdOssSys::tryMmap = 0;
 char      XrdOssSys::chkMmap = 0;
 
+/******************************************************************************/
+/*                    R e a d V   T h r e a d   P o o l                       */
+/******************************************************************************/
+
+namespace
+{
+// An rvTask reads a slice of the runs of a readv request. Tasks are queued
+// for the readv threads; the requester reclaims and reads itself whatever
+// has not been picked up by the time it is done with its own slice so that
+// a request never waits on a busy pool.
+//
+struct rvTask
+      {rvTask          *Next;
+       XrdOssRVRun     *Runs;
+       XrdSysSemaphore *Done;
+       int              nRuns;
+       int              fd;
+
+       void             Read()
+                            {ssize_t rdsz;
+                             for (int i = 0; i < nRuns; i++)
+                                 {do {rdsz = preadv(fd, Runs[i].iov,
+                                                   Runs[i].iovcnt,
+                                                   Runs[i].offset);
+                                     } while(rdsz < 0 && errno == EINTR);
+                                  Runs[i].Result = (rdsz < 0 ? -errno
+                                                 : static_cast<int>(rdsz));
+                                 }
+                            }
+      };
+
+XrdSysCondVar rvQCond(0, "oss readv queue");
+rvTask       *rvQFirst = 0;
+rvTask       *rvQLast  = 0;
+
+void rvQueue(rvTask *tP)
+{
+   rvQCond.Lock();
+   tP->Next = 0;
+   if (rvQLast) rvQLast->Next = tP;
+      else      rvQFirst       = tP;
+   rvQLast = tP;
+   rvQCond.Signal();
+   rvQCond.UnLock();
+}
+
+bool rvReclaim(rvTask *tP)
+{
+   rvTask *pP = 0, *qP;
+
+   rvQCond.Lock();
+   for (qP = rvQFirst; qP && qP != tP; qP = qP->Next) pP = qP;
+   if (qP)
+      {if (pP) pP->Next = qP->Next;
+          else rvQFirst = qP->Next;
+       if (rvQLast == qP) rvQLast = pP;
+      }
+   rvQCond.UnLock();
+   return qP != 0;
+}
+
+void *rvWorker(void *)
+{
+   rvTask *tP;
+
+   while(true)
+        {rvQCond.Lock();
+         while(!(tP = rvQFirst)) rvQCond.Wait();
+         if (!(rvQFirst = tP->Next)) rvQLast = 0;
+         rvQCond.UnLock();
+         tP->Read();
+         tP->Done->Post();
+        }
+   return 0;
+}
+}
+
 /******************************************************************************/
 /*                XrdOssGetSS (a.k.a. XrdOssGetStorageSystem)                 */
 /******************************************************************************/
@@ -172,6 +252,17 @@ XrdOss *XrdOssGetSS(XrdSysLogger *Logger, const char *config_fn,
 /******************************************************************************/
 /*                      o o s s _ S y s   M e t h o d s                       */
 /******************************************************************************/
+/******************************************************************************/
+/*                              F e a t u r e s                               */
+/******************************************************************************/
+
+uint64_t XrdOssSys::Features()
+{
+// Async I/O is turned off for disk unless io_uring is being used
+//
+   return (XrdOssUring::Active() ? 0 : XRDOSS_HASNAIO);
+}
+
 /******************************************************************************/
 /*                                  i n i t                                   */
 /******************************************************************************/
@@ -947,7 +1038,125 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 
 ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 {
-   ssize_t rdsz, totBytes = 0;
+   static const int iovMax = XrdSys::getIovMax();
+   char     *rvHole = 0; // Data between elements is read and discarded
+   XrdOssRVRun *rvP, *runs;
+   struct iovec *iov;
+   rvInfo   *info;
+   long long hole, endOff = 0;
+   ssize_t   rdsz, totBytes = 0;
+   int       gap = XrdOssSS->rvGap, span = XrdOssSS->rvSpan;
+   int       i, k = 0, nRuns = 0;
+
+// Coalesce the elements into runs, each of which can be read with a single
+// preadv(). Elements are combined when they are in ascending order and are
+// separated by no more than the configured gap; the hole is read into a
+// scratch buffer. A run never covers more than the configured span.
+//
+   iov  = new struct iovec[n*2];
+   runs = new XrdOssRVRun[n];
+   info = new rvInfo[n];
+   rvP  = runs;
+   for (i = 0; i < n; i++)
+       {hole = readV[i].offset - endOff;
+        if (!nRuns || gap < 0 || hole < 0 || hole > gap
+        ||  readV[i].offset + readV[i].size - rvP->offset > span
+        ||  rvP->iovcnt + 2 > iovMax)
+           {rvP = &runs[nRuns];
+            rvP->iov    = &iov[k];
+            rvP->offset = readV[i].offset;
+            rvP->iovcnt = 0;
+            info[nRuns].first = i;
+            info[nRuns].rLen  = info[nRuns].dLen = 0;
+            nRuns++;
+           } else if (hole)
+                     {if (!rvHole) rvHole = new char[gap];
+                      iov[k].iov_base = rvHole;
+                      iov[k].iov_len  = hole;
+                      info[nRuns-1].rLen += hole;
+                      rvP->iovcnt++; k++;
+                     }
+        iov[k].iov_base = readV[i].data;
+        iov[k].iov_len  = readV[i].size;
+        info[nRuns-1].rLen += readV[i].size;
+        info[nRuns-1].dLen += readV[i].size;
+        info[nRuns-1].last  = i;
+        rvP->iovcnt++; k++;
+        endOff = readV[i].offset + readV[i].size;
+       }
+
+// If we are using io_uring then all the runs can be issued at once and
+// there is no point in pre-advising anything. Otherwise, the runs are spread
+// over the readv threads, if we have them.
+//
+   if (nRuns > 1 && XrdOssUring::Active())
+      XrdOssUring::ReadV(fd, runs, nRuns);
+      else if (nRuns > 1 && XrdOssSS->rvFanout > 1)
+              ReadVFan(runs, nRuns, XrdOssSS->rvFanout);
+              else ReadVRuns(runs, info, nRuns);
+
+// Tally up the results. Should a run come up short we redo its elements one
+// at a time as it may simply be that a hole lies past the end of the file.
+//
+   for (i = 0; i < nRuns && totBytes >= 0; i++)
+       {if (runs[i].Result == info[i].rLen) {totBytes += info[i].dLen; continue;}
+        if (runs[i].Result < 0) {totBytes = runs[i].Result; break;}
+        for (k = info[i].first; k <= info[i].last; k++)
+            {do {rdsz = pread(fd,readV[k].data,readV[k].size,readV[k].offset);}
+                while(rdsz < 0 && errno == EINTR);
+             if (rdsz < 0 || rdsz != readV[k].size)
+                {totBytes =  (rdsz < 0 ? -errno : -ESPIPE); break;}
+             totBytes += rdsz;
+            }
+       }
+
+// All done, return bytes read.
+//
+   delete [] info;
+   delete [] runs;
+   delete [] iov;
+   delete [] rvHole;
+   return totBytes;
+}
+
+/******************************************************************************/
+/* Private:                     R e a d V F a n                               */
+/******************************************************************************/
+
+void XrdOssFile::ReadVFan(XrdOssRVRun *runs, int n, int fanout)
+{
+   XrdSysSemaphore rvDone(0);
+   rvTask tasks[64];
+   int i, per, nTasks = (n < fanout ? n : fanout);
+
+// Split the runs into contiguous slices so that each slice is still read in
+// ascending offset order. All but the first slice go to the readv threads.
+//
+   per = n / nTasks;
+   for (i = 0; i < nTasks; i++)
+       {tasks[i].Runs  = runs + i*per + (i < n%nTasks ? i : n%nTasks);
+        tasks[i].nRuns = per + (i < n%nTasks ? 1 : 0);
+        tasks[i].Done  = &rvDone;
+        tasks[i].fd    = fd;
+        if (i) rvQueue(&tasks[i]);
+       }
+
+// Read our own slice and then anything nobody got around to. Then wait for
+// the slices that are being read by the threads.
+//
+   tasks[0].Read();
+   for (i = nTasks-1; i > 0; i--)
+       if (rvReclaim(&tasks[i])) {tasks[i].Read(); rvDone.Post();}
+   for (i = 1; i < nTasks; i++) rvDone.Wait();
+}
+
+/******************************************************************************/
+/* Private:                    R e a d V R u n s                              */
+/******************************************************************************/
+
+void XrdOssFile::ReadVRuns(XrdOssRVRun *runs, rvInfo *info, int n)
+{
+   ssize_t rdsz;
    int i;
 
 // For platforms that support fadvise, pre-advise what we will be reading
@@ -962,10 +1171,11 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    if (XrdOssSS->prDepth
    && AtomicInc((XrdOssSS->prActive)) < XrdOssSS->prQSize && n > 2)
       {int faBytes = 0;
-       for (nPR=0;nPR < XrdOssSS->prDepth && faBytes < XrdOssSS->prBytes;nPR++)
-           if (readV[nPR].size > 0)
-              {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
-               endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
+       for (nPR=0;nPR < n && nPR < XrdOssSS->prDepth
+                  && faBytes < XrdOssSS->prBytes;nPR++)
+           if (info[nPR].rLen > 0)
+              {begOff = XrdOssSS->prPMask &  runs[nPR].offset;
+               endOff = XrdOssSS->prPBits | (runs[nPR].offset+info[nPR].rLen);
                rdsz = endOff - begOff + 1;
                if ((begOff > endLst || endOff < begLst)
                &&  rdsz < XrdOssSS->prBytes)
@@ -978,18 +1188,19 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
       }
 #endif
 
-// Read in the vector and do a pre-advise if we support that
+// Read in each run and do a pre-advise if we support that. We stop at the
+// first run that fails or comes up short as the caller will sort it out.
 //
+   for (i = 0; i < n; i++) runs[i].Result = 0;
    for (i = 0; i < n; i++)
-       {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
+       {do {rdsz = preadv(fd, runs[i].iov, runs[i].iovcnt, runs[i].offset);}
            while(rdsz < 0 && errno == EINTR);
-        if (rdsz < 0 || rdsz != readV[i].size)
-           {totBytes =  (rdsz < 0 ? -errno : -ESPIPE); break;}
-        totBytes += rdsz;
+        runs[i].Result = (rdsz < 0 ? -errno : static_cast<int>(rdsz));
+        if (rdsz != info[i].rLen) break;
 #if (defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))) && defined(HAVE_ATOMICS)
-        if (nPR < n && readV[nPR].size > 0)
-           {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
-            endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
+        if (nPR < n && info[nPR].rLen > 0)
+           {begOff = XrdOssSS->prPMask &  runs[nPR].offset;
+            endOff = XrdOssSS->prPBits | (runs[nPR].offset+info[nPR].rLen);
             rdsz = endOff - begOff + 1;
             if ((begOff > endLst || endOff < begLst)
             &&  rdsz <= XrdOssSS->prBytes)
@@ -1002,12 +1213,28 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 #endif
        }
 
-// All done, return bytes read.
+// All done
 //
 #if (defined(__linux__) || (defined(__FreeBSD_kernel__) && defined(__GLIBC__))) && defined(HAVE_ATOMICS)
    if (XrdOssSS->prDepth) AtomicDec((XrdOssSS->prActive));
 #endif
-   return totBytes;
+}
+
+/******************************************************************************/
+/*                            S t a r t R e a d V                             */
+/******************************************************************************/
+
+int XrdOssFile::StartReadV(int threads)
+{
+   pthread_t tid;
+   int rc;
+
+// Should we not get all the threads we wanted, make do with what we got
+//
+   for (int i = 0; i < threads; i++)
+       if ((rc = XrdSysThread::Run(&tid, rvWorker, 0, 0, "readv reader")))
+          return (i ? 0 : rc);
+   return 0;
 }
 
 /******************************************************************************/
@@ -1073,6 +1300,61 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      return retval;
 }
 
+/******************************************************************************/
+/*                                W r i t e V                                 */
+/******************************************************************************/
+
+/*
+  Function: Perform all the writes specified in the writeV vector.
+
+  Input:    writeV    - A description of the writes to perform; includes the
+                        absolute offset, the size of the write, and the buffer
+                        holding the data.
+            n         - The size of the writeV vector.
+
+  Output:   Returns the number of bytes written upon success and -errno o/w.
+            If the number of bytes written is less than requested, it is
+            considered an error (-ESPIPE).
+
+  Notes:    Elements that are contiguous in the file are written together with
+            a single pwritev().
+*/
+
+ssize_t XrdOssFile::WriteV(XrdOucIOVec *writeV, int n)
+{
+   static const int iovMax = XrdSys::getIovMax();
+   struct iovec iov[64];
+   long long endOff, wrLen;
+   ssize_t retval, totBytes = 0;
+   int i, k, iovNum = (iovMax < 64 ? iovMax : 64);
+
+   if (fd < 0) return (ssize_t)-XRDOSS_E8004;
+
+// Write out each run of contiguous elements
+//
+   for (i = 0; i < n; i = k)
+       {endOff = writeV[i].offset; wrLen = 0;
+        for (k = i; k < n && k-i < iovNum && writeV[k].offset == endOff; k++)
+            {iov[k-i].iov_base = writeV[k].data;
+             iov[k-i].iov_len  = writeV[k].size;
+             endOff += writeV[k].size; wrLen += writeV[k].size;
+            }
+
+        if (XrdOssSS->MaxSize && endOff > XrdOssSS->MaxSize)
+           return (ssize_t)-XRDOSS_E8007;
+
+        do {retval = pwritev(fd, iov, k-i, writeV[i].offset);}
+           while(retval < 0 && errno == EINTR);
+
+        if (retval != wrLen)
+           {if (retval >= 0) return -ESPIPE;
+            return (errno == EBADF && cxobj ? -XRDOSS_E8022 : -errno);
+           }
+        totBytes += retval;
+       }
+   return totBytes;
+}
+
 /******************************************************************************/
 /*                                F c h m o d                                 */
 /******************************************************************************/
@@ -82,6 +82,7 @@ static const int    noDread  = 0x04;
 /******************************************************************************/
 
 class oocx_CXFile;
+struct XrdOssRVRun;
 class XrdSfsAio;
 class XrdOssCache_FS;
 class XrdOssMioFile;
@@ -113,6 +114,14 @@ ssize_t ReadV(XrdOucIOVec *readV, int);
 ssize_t ReadRaw(    void *, off_t, size_t);
 ssize_t Write(const void *, off_t, size_t);
 int     Write(XrdSfsAio *aiop);
+ssize_t WriteV(XrdOucIOVec *writeV, int);
+
+static const int rvGapMax = 65536; // Largest readv hole that may be coalesced
+
+// Start the threads that read the runs of a readv request in parallel. Returns
+// 0 upon success and an errno value otherwise.
+//
+static int StartReadV(int threads);
  
         // Constructor and destructor
         XrdOssFile(const char *tid, int fdnum=-1)
@@ -123,7 +132,11 @@ int     Write(XrdSfsAio *aiop);
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
 private:
+struct  rvInfo {long long rLen; long long dLen; int first; int last;};
+
 int     Open_ufs(const char *, int, int, unsigned long long);
+void    ReadVFan(XrdOssRVRun *runs, int n, int fanout);
+void    ReadVRuns(XrdOssRVRun *runs, rvInfo *info, int n);
 
 static int      AioFailure;
 oocx_CXFile    *cxobj;
@@ -164,7 +177,7 @@ int       Configure(const char *, XrdSysError &, XrdOucEnv *envP);
 void      Config_Display(XrdSysError &);
 virtual
 int       Create(const char *, const char *, mode_t, XrdOucEnv &, int opts=0);
-uint64_t  Features() {return XRDOSS_HASNAIO;} // Turn async I/O off for disk
+uint64_t  Features();
 int       GenLocalPath(const char *, char *);
 int       GenRemotePath(const char *, char *);
 int       Init(XrdSysLogger *, const char *, XrdOucEnv *envP);
@@ -280,6 +293,15 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+int               aioDepth;  //    io_uring ring depth
+short             aioRings;  //    io_uring ring count
+char              aioUring;  //    io_uring wanted for async I/O
+
+int               rvGap;     //    readv largest gap to coalesce (-1 -> off)
+int               rvSpan;    //    readv largest coalesced read
+short             rvFanout;  //    readv parallel reads per request (1 -> off)
+short             rvThreads; //    readv threads shared by all requests
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -347,6 +369,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -357,6 +380,7 @@ int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadv(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute,
               const char *grp, bool isAsgn);
@@ -53,6 +53,7 @@
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysError.hh"
@@ -248,6 +249,13 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+   aioDepth      = 256;
+   aioRings      = 2;
+   aioUring      = 0;
+   rvGap         = 4096;
+   rvSpan        = 1048576;
+   rvFanout      = 4;
+   rvThreads     = 8;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -378,9 +386,21 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 //
    if (!NoGo) NoGo = ConfigStage(Eroute);
 
-// Configure async I/O
+// Configure async I/O. We prefer io_uring, if so wanted, and fall back to
+// POSIX async I/O should it not be available.
 //
-   if (!NoGo) NoGo = !AioInit();
+   if (!NoGo && (!aioUring || !XrdOssUring::Init(Eroute, aioDepth, aioRings)))
+      NoGo = !AioInit();
+
+// Start the readv threads unless io_uring does the job. Without them each
+// readv request reads its runs one after another.
+//
+   if (!NoGo && rvFanout > 1 && !XrdOssUring::Active()
+   &&  (retc = XrdOssFile::StartReadV(rvThreads)))
+      {Eroute.Emsg("Config", retc, "create readv thread; "
+                                   "readv requests are read serially.");
+       rvFanout = 1;
+      }
 
 // Initialize memory mapping setting to speed execution
 //
@@ -500,6 +520,19 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
 
      Eroute.Say(buff);
 
+     if (aioUring)
+        {snprintf(buff, sizeof(buff), "       oss.aio          uring depth %d "
+                                      "rings %d", aioDepth, aioRings);
+         Eroute.Say(buff);
+        }
+
+     if (rvGap < 0) Eroute.Say("       oss.readv        gap off");
+        else {snprintf(buff, sizeof(buff), "       oss.readv        gap %d "
+                                           "span %d fanout %d threads %d",
+                                           rvGap, rvSpan, rvFanout, rvThreads);
+              Eroute.Say(buff);
+             }
+
      XrdOssMio::Display(Eroute);
 
      XrdOssCache::List("       oss.", Eroute);
@@ -1106,6 +1139,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan); // Backward compatibility
@@ -1117,6 +1151,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readv",         xreadv);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1174,6 +1209,62 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring} [depth <n>] [rings <n>]
+
+             posix       use POSIX async I/O (the default).
+             uring       use Linux io_uring, falling back to posix if it is
+                         not available. This also enables async I/O for disk.
+             depth       the number of requests each ring can hold (default
+                         256, rounded up to a power of two by the kernel).
+             rings       the number of rings, each of which has its own
+                         completion thread (default 2).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int depth = aioDepth, rings = aioRings;
+
+    if (!(val = Config.GetWord()))
+       {Eroute.Emsg("Config", "aio type not specified"); return 1;}
+
+         if (!strcmp(val, "posix")) aioUring = 0;
+    else if (!strcmp(val, "uring")) aioUring = 1;
+    else {Eroute.Emsg("Config", "invalid aio type -", val); return 1;}
+
+    while((val = Config.GetWord()))
+         {     if (!strcmp(val, "depth"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio depth not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute,"aio depth",val,&depth,1,32768))
+                      return 1;
+                  }
+          else if (!strcmp(val, "rings"))
+                  {if (!(val = Config.GetWord()))
+                      {Eroute.Emsg("Config", "aio rings not specified");
+                       return 1;
+                      }
+                   if (XrdOuca2x::a2i(Eroute,"aio rings",val,&rings,1,64))
+                      return 1;
+                  }
+          else {Eroute.Emsg("Config", "invalid aio option -", val); return 1;}
+         }
+
+    aioDepth = depth;
+    aioRings = rings;
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -1594,6 +1685,86 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       return 0;
 }
   
+/******************************************************************************/
+/*                                x r e a d v                                 */
+/******************************************************************************/
+
+/* Function: xreadv
+
+   Purpose:  To parse the directive: readv [gap {off | <bytes>}] [span <bytes>]
+                                           [fanout <n>] [threads <n>]
+
+             gap      the largest hole between two readv elements that will
+                      be read and discarded so that both elements can be
+                      read with a single preadv(). A value of 0 only combines
+                      adjacent elements while "off" reads each element on its
+                      own. The default is 4k and the maximum is 64k.
+             span     the largest number of bytes a combined read may cover.
+                      The default is 1m and the maximum is 16m.
+             fanout   the number of combined reads of a readv request that
+                      are issued in parallel when io_uring is not in use.
+                      A value of 1 reads them one after another. The
+                      default is 4 and the maximum is 64.
+             threads  the number of threads, shared by all readv requests,
+                      that issue the parallel reads. The default is 8 and
+                      the maximum is 256.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadv(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m16 = 16777216LL;
+    char *val;
+    long long gap = rvGap, span = rvSpan;
+    int fanout = rvFanout, threads = rvThreads;
+
+    if (!(val = Config.GetWord()))
+       {Eroute.Emsg("Config", "readv option not specified"); return 1;}
+
+    do {     if (!strcmp(val, "gap"))
+                {if (!(val = Config.GetWord()))
+                    {Eroute.Emsg("Config", "readv gap not specified");
+                     return 1;
+                    }
+                 if (!strcmp(val, "off")) gap = -1;
+                    else if (XrdOuca2x::a2sz(Eroute, "readv gap", val, &gap,
+                                             0, XrdOssFile::rvGapMax)) return 1;
+                }
+        else if (!strcmp(val, "span"))
+                {if (!(val = Config.GetWord()))
+                    {Eroute.Emsg("Config", "readv span not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2sz(Eroute,"readv span",val,&span,4096,m16))
+                    return 1;
+                }
+        else if (!strcmp(val, "fanout"))
+                {if (!(val = Config.GetWord()))
+                    {Eroute.Emsg("Config", "readv fanout not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2i(Eroute,"readv fanout",val,&fanout,1,64))
+                    return 1;
+                }
+        else if (!strcmp(val, "threads"))
+                {if (!(val = Config.GetWord()))
+                    {Eroute.Emsg("Config", "readv threads not specified");
+                     return 1;
+                    }
+                 if (XrdOuca2x::a2i(Eroute,"readv threads",val,&threads,1,256))
+                    return 1;
+                }
+        else {Eroute.Emsg("Config", "invalid readv option -", val); return 1;}
+       } while((val = Config.GetWord()));
+
+    rvGap  = static_cast<int>(gap);
+    rvSpan = static_cast<int>(span);
+    rvFanout  = static_cast<short>(fanout);
+    rvThreads = static_cast<short>(threads);
+    return 0;
+}
+  
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
@@ -0,0 +1,629 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysRAtomic.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#if defined(__linux__) && defined(HAVE_IO_URING) && defined(__NR_io_uring_setup)
+#define XRDOSS_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#endif
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdSysTrace OssTrace;
+
+extern XrdSysError OssEroute;
+
+bool XrdOssUring::isActive = false;
+
+#ifdef XRDOSS_URING
+namespace
+{
+/******************************************************************************/
+/*                     L o c a l   D e f i n i t i o n s                      */
+/******************************************************************************/
+
+// The low order bits of the user data identify the type of request; the rest
+// is the address of the object to be notified upon completion.
+//
+const uint64_t tagRead  = 0;
+const uint64_t tagWrite = 1;
+const uint64_t tagRdV   = 2;
+const uint64_t tagMask  = 3;
+
+// A ReadV() request is tracked by an rvReq with an rvElem for each run.
+//
+struct rvReq
+      {XrdSysSemaphore  Done;
+       RAtomic_int      Pending;
+                        rvReq() : Done(0), Pending(0) {}
+      };
+
+struct rvElem
+      {rvReq              *reqP;
+       XrdOssUring::rvRun *runP;
+       bool                Queued;
+      };
+
+/******************************************************************************/
+/*                     S y s t e m   C a l l   S t u b s                      */
+/******************************************************************************/
+
+// We use the system calls directly as liburing is not universally available
+// and we only need a very small subset of it.
+//
+int uSetup(unsigned int entries, struct io_uring_params *p)
+   {return (int)syscall(__NR_io_uring_setup, entries, p);}
+
+int uEnter(int fd, unsigned int toSub, unsigned int minComp, unsigned int flg)
+   {return (int)syscall(__NR_io_uring_enter, fd, toSub, minComp, flg, 0, 0);}
+
+int uRegister(int fd, unsigned int opc, void *arg, unsigned int nargs)
+   {return (int)syscall(__NR_io_uring_register, fd, opc, arg, nargs);}
+
+// Perform the request described by an sqe synchronously, returning what the
+// corresponding cqe would have held.
+//
+int uSync(const io_uring_sqe &sqe)
+{
+   ssize_t rc;
+
+   do {switch(sqe.opcode)
+             {case IORING_OP_READ:
+                   rc = pread(sqe.fd, (void *)sqe.addr, sqe.len, sqe.off);
+                   break;
+              case IORING_OP_READV:
+                   rc = preadv(sqe.fd, (const struct iovec *)sqe.addr,
+                               (int)sqe.len, sqe.off);
+                   break;
+              case IORING_OP_WRITE:
+                   rc = pwrite(sqe.fd, (const void *)sqe.addr, sqe.len,
+                               sqe.off);
+                   break;
+              case IORING_OP_FSYNC:
+                   rc = fsync(sqe.fd);
+                   break;
+              default: errno = ENOTSUP; rc = -1;
+             }
+      } while(rc < 0 && errno == EINTR);
+
+   return (rc < 0 ? -errno : (int)rc);
+}
+
+/******************************************************************************/
+/*                            C l a s s   u R i n g                           */
+/******************************************************************************/
+
+class uRing
+{
+public:
+
+// Commit() makes the last sqe obtained via getSQE() visible to the kernel.
+//
+// Close() unmaps the rings and closes the ring file descriptor.
+//
+void          Close();
+
+void          Commit()
+                    {__atomic_store_n(sqTail, *sqTail + 1, __ATOMIC_RELEASE);
+                     sqPend++; inFlight++;
+                    }
+
+// Flush() submits all pending requests. Called with sqMutex held and it is
+//         released upon return. Only one thread submits at a time; others
+//         simply add to the batch that the submitting thread will pick up.
+//
+void          Flush();
+
+// getSQE() returns the next free sqe or nil if the ring is full. Must be
+//          called with sqMutex held.
+//
+io_uring_sqe *getSQE()
+                    {unsigned int tail = *sqTail;
+                     if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE)
+                         >= sqEntries || inFlight >= cqEntries) return 0;
+                     unsigned int idx = tail & sqMask;
+                     sqArray[idx] = idx;
+                     memset(&sqes[idx], 0, sizeof(io_uring_sqe));
+                     return &sqes[idx];
+                    }
+
+int           Init(int depth);
+
+void          Reap();
+
+XrdSysMutex   sqMutex;
+
+              uRing() : ringFD(-1), ringMem(0), ringLen(0), sqeMem(0),
+                        sqeLen(0), sqPend(0), sqBusy(false), inFlight(0) {}
+             ~uRing() {Close();} // Only deleted when setup fails
+
+private:
+
+void          Done(uint64_t udata, int res);
+void          Unsubmit(int err);
+
+int           ringFD;
+char         *ringMem;
+size_t        ringLen;
+void         *sqeMem;
+size_t        sqeLen;
+unsigned int *sqHead;
+unsigned int *sqTail;
+unsigned int *sqArray;
+unsigned int  sqMask;
+unsigned int  sqEntries;
+unsigned int  sqPend;    // Requests not yet handed to the kernel
+bool          sqBusy;    // A thread is submitting requests
+io_uring_sqe *sqes;
+unsigned int *cqHead;
+unsigned int *cqTail;
+unsigned int  cqMask;
+unsigned int  cqEntries;
+io_uring_cqe *cqes;
+RAtomic_uint  inFlight;  // Requests not yet reaped
+};
+
+/******************************************************************************/
+/*                         u R i n g : : C l o s e                            */
+/******************************************************************************/
+
+void uRing::Close()
+{
+   if (sqeMem)  {munmap(sqeMem,  sqeLen);  sqeMem  = 0;}
+   if (ringMem) {munmap(ringMem, ringLen); ringMem = 0;}
+   if (ringFD >= 0) {close(ringFD); ringFD = -1;}
+}
+
+/******************************************************************************/
+/*                          u R i n g : : D o n e                             */
+/******************************************************************************/
+
+void uRing::Done(uint64_t udata, int res)
+{
+   EPNAME("UringDone");
+   void *objP = (void *)(udata & ~tagMask);
+
+   switch(udata & tagMask)
+         {case tagRead:
+          case tagWrite:
+               {XrdSfsAio *aiop = (XrdSfsAio *)objP;
+                DEBUG((udata & tagMask ? "write" : "read") <<" completed for "
+                      <<aiop->TIdent <<"; result=" <<res
+                      <<" aiocb=" <<Xrd::hex1 <<aiop);
+                aiop->Result = res;
+                if ((udata & tagMask) == tagRead) aiop->doneRead();
+                   else aiop->doneWrite();
+               }
+               break;
+          case tagRdV:
+               {rvElem *eP  = (rvElem *)objP;
+                rvReq *reqP = eP->reqP;
+                eP->runP->Result = res;
+                if (--(reqP->Pending) == 0) reqP->Done.Post();
+               }
+               break;
+          default: break;
+         }
+}
+
+/******************************************************************************/
+/*                         u R i n g : : F l u s h                            */
+/******************************************************************************/
+
+void uRing::Flush()
+{
+   unsigned int n;
+   int rc, err = 0;
+
+// If someone is already submitting, they will pick up our requests
+//
+   if (sqBusy) {sqMutex.UnLock(); return;}
+   sqBusy = true;
+
+// Submit requests until there are no more
+//
+   while((n = sqPend))
+        {sqPend = 0;
+         sqMutex.UnLock();
+         do {rc = uEnter(ringFD, n, 0, 0);} while(rc < 0 && errno == EINTR);
+         err = (rc < 0 ? errno : 0);
+         sqMutex.Lock();
+         if (rc <= 0) {sqPend += n; break;}
+         if ((unsigned int)rc < n) sqPend += n - rc;
+        }
+
+// Should the kernel refuse to take requests because too many completions are
+// outstanding, they are resubmitted when completions are reaped. Any other
+// error is not going away and, with nothing in flight, there is nothing to
+// be reaped. In either case we take the requests back and complete them here.
+//
+   if (sqPend && ((err && err != EAGAIN && err != EBUSY) || inFlight == sqPend))
+      {Unsubmit(err); return;}
+
+   sqBusy = false;
+   sqMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                          u R i n g : : I n i t                             */
+/******************************************************************************/
+
+int uRing::Init(int depth)
+{
+   static const int probeOps[] = {IORING_OP_READ, IORING_OP_READV,
+                                  IORING_OP_WRITE, IORING_OP_FSYNC};
+   struct io_uring_params uParms;
+   struct io_uring_probe *probe;
+   size_t probeLen;
+   int rc;
+
+// Create the ring
+//
+   memset(&uParms, 0, sizeof(uParms));
+   if ((ringFD = uSetup(depth, &uParms)) < 0) return errno;
+
+// We need a kernel that has a single mmap for the sq and cq rings and that
+// never drops completions (i.e. 5.5 or later). On any failure from here on
+// the ring is closed so that nothing is left behind.
+//
+   if (!(uParms.features & IORING_FEAT_SINGLE_MMAP)
+   ||  !(uParms.features & IORING_FEAT_NODROP)) {Close(); return ENOTSUP;}
+
+// Make sure all of the operations we need are supported (5.6 or later)
+//
+   probeLen = sizeof(io_uring_probe) + 256*sizeof(io_uring_probe_op);
+   probe = (struct io_uring_probe *)calloc(1, probeLen);
+   rc = uRegister(ringFD, IORING_REGISTER_PROBE, probe, 256);
+   if (rc < 0) rc = errno;
+      else {rc = 0;
+            for (int op : probeOps)
+                if (op > probe->last_op
+                || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+                   {rc = ENOTSUP; break;}
+           }
+   free(probe);
+   if (rc) {Close(); return rc;}
+
+// Map the rings
+//
+   ringLen = uParms.sq_off.array + uParms.sq_entries*sizeof(unsigned int);
+   if (ringLen < uParms.cq_off.cqes + uParms.cq_entries*sizeof(io_uring_cqe))
+       ringLen = uParms.cq_off.cqes + uParms.cq_entries*sizeof(io_uring_cqe);
+   ringMem = (char *)mmap(0, ringLen, PROT_READ|PROT_WRITE,
+                          MAP_SHARED|MAP_POPULATE, ringFD, IORING_OFF_SQ_RING);
+   if (ringMem == MAP_FAILED) {rc = errno; ringMem = 0; Close(); return rc;}
+
+   sqeLen = uParms.sq_entries * sizeof(io_uring_sqe);
+   sqeMem = mmap(0, sqeLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                 ringFD, IORING_OFF_SQES);
+   if (sqeMem == MAP_FAILED) {rc = errno; sqeMem = 0; Close(); return rc;}
+
+// Record the locations of everything
+//
+   sqHead    = (unsigned int *)(ringMem + uParms.sq_off.head);
+   sqTail    = (unsigned int *)(ringMem + uParms.sq_off.tail);
+   sqArray   = (unsigned int *)(ringMem + uParms.sq_off.array);
+   sqMask    = *(unsigned int *)(ringMem + uParms.sq_off.ring_mask);
+   sqEntries = uParms.sq_entries;
+   sqes      = (io_uring_sqe *)sqeMem;
+   cqHead    = (unsigned int *)(ringMem + uParms.cq_off.head);
+   cqTail    = (unsigned int *)(ringMem + uParms.cq_off.tail);
+   cqMask    = *(unsigned int *)(ringMem + uParms.cq_off.ring_mask);
+   cqEntries = uParms.cq_entries;
+   cqes      = (io_uring_cqe *)(ringMem + uParms.cq_off.cqes);
+   return 0;
+}
+
+/******************************************************************************/
+/*                          u R i n g : : R e a p                             */
+/******************************************************************************/
+
+void uRing::Reap()
+{
+   unsigned int head, tail, n;
+   int rc;
+
+// Wait for completions and dispatch them. We release each cqe before running
+// the callback as the callback may queue another request.
+//
+   while(true)
+        {rc = uEnter(ringFD, 0, 1, IORING_ENTER_GETEVENTS);
+         if (rc < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {OssEroute.Emsg("AioReap", errno, "wait for io_uring completions");
+             XrdSysTimer::Wait(1000);
+            }
+         head = *cqHead; n = 0;
+         tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+         while(head != tail)
+              {io_uring_cqe *cqe = &cqes[head & cqMask];
+               uint64_t udata = cqe->user_data;
+               int      res   = cqe->res;
+               __atomic_store_n(cqHead, ++head, __ATOMIC_RELEASE);
+               n++;
+               Done(udata, res);
+              }
+
+         // Now that there is room, push out anything the kernel refused
+         //
+         if (n)
+            {inFlight -= n;
+             sqMutex.Lock();
+             if (sqPend) Flush();
+                else sqMutex.UnLock();
+            }
+        }
+}
+
+/******************************************************************************/
+/*                      u R i n g : : U n s u b m i t                         */
+/******************************************************************************/
+
+void uRing::Unsubmit(int err)
+{
+   bool fatal = err && err != EAGAIN && err != EBUSY;
+   io_uring_sqe *held;
+   unsigned int head, num;
+
+// Copy the requests the kernel did not take and remove them from the ring.
+// This is safe as we are the only submitter (sqBusy is set and sqMutex held).
+//
+   head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+   num  = *sqTail - head;
+   held = new io_uring_sqe[num];
+   for (unsigned int i = 0; i < num; i++)
+       held[i] = sqes[sqArray[(head + i) & sqMask]];
+   __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+   sqPend = 0;
+   inFlight -= num;
+   sqBusy = false;
+   sqMutex.UnLock();
+
+// Fail them with the error or, when the kernel merely had no room and there
+// is nothing in flight to make room, do them synchronously.
+//
+   if (fatal) OssEroute.Emsg("AioSubmit", err, "submit io_uring requests");
+   for (unsigned int i = 0; i < num; i++)
+       Done(held[i].user_data, (fatal ? -err : uSync(held[i])));
+   delete [] held;
+}
+
+/******************************************************************************/
+/*                           L o c a l   D a t a                              */
+/******************************************************************************/
+
+uRing       *ringTab = 0;
+int          ringNum = 0;
+RAtomic_uint ringNxt(0);
+
+uRing *Pick() {return &ringTab[ringNxt++ % ringNum];}
+
+void *ReapRing(void *rP)
+{
+   ((uRing *)rP)->Reap();
+   return 0;
+}
+
+// Queue a single request on behalf of an XrdSfsAio object.
+//
+int Submit(int opc, int fd, XrdSfsAio *aiop, uint64_t tag)
+{
+   uRing *rP = Pick();
+   io_uring_sqe *sqe;
+
+   rP->sqMutex.Lock();
+   if (!(sqe = rP->getSQE())) {rP->sqMutex.UnLock(); return 1;}
+
+   sqe->opcode    = opc;
+   sqe->fd        = fd;
+   if (opc != IORING_OP_FSYNC)
+      {sqe->addr  = (uint64_t)aiop->sfsAio.aio_buf;
+       sqe->len   = (uint32_t)aiop->sfsAio.aio_nbytes;
+       sqe->off   = (uint64_t)aiop->sfsAio.aio_offset;
+      }
+   sqe->user_data = (uint64_t)aiop | tag;
+
+   rP->Commit();
+   rP->Flush();
+   return 0;
+}
+}
+#endif
+
+/******************************************************************************/
+/*                                 F s y n c                                  */
+/******************************************************************************/
+
+int XrdOssUring::Fsync(int fd, XrdSfsAio *aiop)
+{
+#ifdef XRDOSS_URING
+   return Submit(IORING_OP_FSYNC, fd, aiop, tagWrite);
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+bool XrdOssUring::Init(XrdSysError &eDest, int depth, int rings)
+{
+#ifdef XRDOSS_URING
+   pthread_t tid;
+   int rc;
+
+// Allocate the rings. Should any of them fail, we cannot use io_uring and
+// release whatever was set up so far.
+//
+   ringTab = new uRing[rings];
+   for (int i = 0; i < rings; i++)
+       {if ((rc = ringTab[i].Init(depth)))
+           {eDest.Emsg("AioInit", rc, "initialize io_uring; "
+                                      "using POSIX async I/O instead.");
+            delete [] ringTab;
+            ringTab = 0;
+            return false;
+           }
+       }
+
+// Start a completion thread for each ring. Once one is started we must
+// use the rings as requests may be outstanding.
+//
+   for (int i = 0; i < rings; i++)
+       {if ((rc = XrdSysThread::Run(&tid, ReapRing, (void *)&ringTab[i], 0,
+                                    "io_uring reaper")))
+           {if (!i)
+               {eDest.Emsg("AioInit", rc, "create io_uring reaper thread; "
+                                          "using POSIX async I/O instead.");
+                delete [] ringTab;
+                ringTab = 0;
+                return false;
+               }
+            for (int j = i; j < rings; j++) ringTab[j].Close();
+            break;
+           }
+        ringNum = i+1;
+       }
+
+// All done
+//
+   isActive = true;
+   char buff[64];
+   snprintf(buff, sizeof(buff), "%d ring%s of depth %d", ringNum,
+            (ringNum == 1 ? "" : "s"), depth);
+   eDest.Say("Config using io_uring async I/O with ", buff, ".");
+   return true;
+#else
+   eDest.Say("Config warning: io_uring is not supported on this platform; "
+             "using POSIX async I/O instead.");
+   return false;
+#endif
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+int XrdOssUring::Read(int fd, XrdSfsAio *aiop)
+{
+#ifdef XRDOSS_URING
+   return Submit(IORING_OP_READ, fd, aiop, tagRead);
+#else
+   return 1;
+#endif
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+void XrdOssUring::ReadV(int fd, rvRun *rdVec, int n)
+{
+#ifdef XRDOSS_URING
+   rvReq    theReq;
+   rvElem  *elem = new rvElem[n];
+   uRing   *rP   = Pick();
+   io_uring_sqe *sqe;
+   ssize_t  rdsz;
+   int      i, nQ = 0;
+
+// Queue as many of the reads as will fit into the ring. All of them are
+// handed to the kernel in one go.
+//
+   rP->sqMutex.Lock();
+   for (i = 0; i < n; i++)
+       {elem[i].reqP = &theReq;
+        elem[i].runP = &rdVec[i];
+        if ((elem[i].Queued = (sqe = rP->getSQE()) != 0))
+           {sqe->opcode    = IORING_OP_READV;
+            sqe->fd        = fd;
+            sqe->addr      = (uint64_t)rdVec[i].iov;
+            sqe->len       = (uint32_t)rdVec[i].iovcnt;
+            sqe->off       = (uint64_t)rdVec[i].offset;
+            sqe->user_data = (uint64_t)&elem[i] | tagRdV;
+            rP->Commit();
+            nQ++;
+           }
+       }
+   theReq.Pending = nQ;
+   if (nQ) rP->Flush();
+      else rP->sqMutex.UnLock();
+
+// Perform any reads that did not fit synchronously while the others are in
+// progress and then wait for the queued ones to complete.
+//
+   for (i = 0; i < n; i++)
+       if (!elem[i].Queued)
+          {do {rdsz = preadv(fd, rdVec[i].iov, rdVec[i].iovcnt,
+                             rdVec[i].offset);
+              } while(rdsz < 0 && errno == EINTR);
+           rdVec[i].Result = (rdsz < 0 ? -errno : (int)rdsz);
+          }
+   if (nQ) theReq.Done.Wait();
+
+// All done
+//
+   delete [] elem;
+#else
+   for (int i = 0; i < n; i++) rdVec[i].Result = -ENOTSUP;
+#endif
+}
+
+/******************************************************************************/
+/*                                 W r i t e                                  */
+/******************************************************************************/
+
+int XrdOssUring::Write(int fd, XrdSfsAio *aiop)
+{
+#ifdef XRDOSS_URING
+   return Submit(IORING_OP_WRITE, fd, aiop, tagWrite);
+#else
+   return 1;
+#endif
+}
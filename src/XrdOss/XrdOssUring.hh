@@ -0,0 +1,91 @@
+#ifndef __XRDOSSURING_H__
+#define __XRDOSSURING_H__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+/* This class implements asynchronous disk I/O using the Linux io_uring
+   interface. Requests are placed in one of several submission rings and are
+   handed to the kernel in batches. Each ring has a thread that reaps the
+   completions and drives the XrdSfsAio doneRead()/doneWrite() callbacks just
+   as the POSIX aio signal threads do. It is selected via the oss.aio
+   directive and, when unavailable, POSIX async I/O is used instead.
+*/
+
+struct iovec;
+class  XrdSfsAio;
+class  XrdSysError;
+
+// A run of a readv request that can be read with a single preadv() call.
+//
+struct XrdOssRVRun {const struct iovec *iov;
+                    long long           offset;
+                    int                 iovcnt;
+                    int                 Result;
+                   };
+
+class XrdOssUring
+{
+public:
+
+// Active() returns true if io_uring has been successfully initialized.
+//
+static bool    Active() {return isActive;}
+
+// Fsync(), Read(), and Write() queue the request described by aiop. They
+//          return 0 if the request was queued, and >0 if there is no room in
+//          the ring (the caller should perform the request synchronously).
+//
+static int     Fsync(int fd, XrdSfsAio *aiop);
+
+static int     Read (int fd, XrdSfsAio *aiop);
+
+static int     Write(int fd, XrdSfsAio *aiop);
+
+// Init()   creates rings rings each capable of holding depth requests and
+//          starts their completion threads. Returns true upon success.
+//
+static bool    Init(XrdSysError &eDest, int depth, int rings);
+
+// ReadV()  performs the n preadv() style requests in rdVec by submitting them
+//          together and waiting for all of them to complete. The Result of
+//          each request is set to the number of bytes read or -errno.
+//
+typedef XrdOssRVRun rvRun;
+
+static void    ReadV(int fd, rvRun *rdVec, int n);
+
+               XrdOssUring() {}
+              ~XrdOssUring() {}
+
+private:
+
+static bool    isActive;
+};
+#endif
@@ -47,6 +47,38 @@
 
 #include "XrdOuc/XrdOucCRC.hh"
 #include "XrdOuc/XrdOucCRC32C.hh"
+#include "XrdOuc/XrdOucCRCEngine.hh"
+
+/******************************************************************************/
+/*                         L o c a l   S t a t i c s                          */
+/******************************************************************************/
+
+namespace
+{
+// Page checksums are computed in batches of this many pages.
+//
+static const int pgBatch = 16;
+
+// Compute the checksum of up to pgBatch pages (the last one may be short)
+// advancing the data pointer and count. Returns the number of checksums.
+//
+int PageBatch(const uint8_t*& dataP, size_t& count, uint32_t* csval)
+{
+   const void* bP[pgBatch];
+   size_t      bL[pgBatch];
+   int n;
+
+   for (n = 0; n < pgBatch && count > 0; n++)
+       {bL[n] = (count < (size_t)XrdSys::PageSize ? count : XrdSys::PageSize);
+        bP[n] = dataP;
+        dataP += bL[n];
+        count -= bL[n];
+       }
+
+   XrdOucCRCEngine::Crc32C(bP, bL, csval, n);
+   return n;
+}
+}
 
 /*****************************************************************/
 /*                                                               */
@@ -199,20 +231,19 @@ uint32_t XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t prevcs)
   
 void XrdOucCRC::Calc32C(const void* data, size_t count, uint32_t* csval)
 {
-   int i, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
 
-// Calculate the CRC32C for each page
+// Calculate the CRC32C for each page, the last one may be a partial page
 //
-   for (i = 0; i < numpages; i++)
-       {csval[i] = crc32c(0, dataP, XrdSys::PageSize);
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
+   while(count > 0) csval += PageBatch(dataP, count, csval);
+}
 
-// if there is anything left, calculate that as well
-//
-   if (count > 0) csval[i] = crc32c(0, dataP, count);
+/******************************************************************************/
+
+void XrdOucCRC::Calc32C(const void* const* data, const size_t* count,
+                        uint32_t* csval, int num)
+{
+   if (num > 0) XrdOucCRCEngine::Crc32C(data, count, csval, num);
 }
 
 /******************************************************************************/
@@ -236,33 +267,22 @@ bool XrdOucCRC::Ver32C(const void*    data,  size_t    count,
 int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t& valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[pgBatch];
+   int i, n, pgNum = 0;
 
 // Calculate the CRC32C for each page and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != actualCS)
-           {valcs = actualCS;
-            return i;
-           }
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
-//
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] != actualCS)
-          {valcs = actualCS;
-           return i;
-          }
-      }
+   while(count > 0)
+        {n = PageBatch(dataP, count, actualCS);
+         for (i = 0; i < n; i++)
+             {if (csval[pgNum+i] != actualCS[i])
+                 {valcs = actualCS[i];
+                  return pgNum+i;
+                 }
+             }
+         pgNum += n;
+        }
 
 // Everything matched.
 //
@@ -274,30 +294,20 @@ int  XrdOucCRC::Ver32C(const void*     data,  size_t    count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
                        const uint32_t* csval, bool*  valok)
 {
-   int i, numpages = count/XrdSys::PageSize;
    const uint8_t* dataP = (const uint8_t*)data;
-   uint32_t actualCS;
+   uint32_t actualCS[pgBatch];
    bool retval = true;
+   int i, n, pgNum = 0;
 
 // Calculate the CRC32C for each page and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        actualCS = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
-//
-   if (count > 0)
-      {
-       actualCS = crc32c(0, dataP, count);
-       if (csval[i] == actualCS) valok[i] = true;
-           else valok[i] = retval = false;
-      }
+   while(count > 0)
+        {n = PageBatch(dataP, count, actualCS);
+         for (i = 0; i < n; i++, pgNum++)
+             {if (csval[pgNum] == actualCS[i]) valok[pgNum] = true;
+                 else valok[pgNum] = retval = false;
+             }
+        }
 
 // All done.
 //
@@ -309,27 +319,13 @@ bool XrdOucCRC::Ver32C(const void*     data,  size_t count,
 bool XrdOucCRC::Ver32C(const void*     data,  size_t    count,
                        const uint32_t* csval, uint32_t* valcs)
 {
-   int i, numpages = count/XrdSys::PageSize;
-   const uint8_t* dataP = (const uint8_t*)data;
+   int i, numpages = count/XrdSys::PageSize + (count%XrdSys::PageSize != 0);
    bool retval = true;
 
 // Calculate the CRC32C for each page and make sure it is the same.
 //
-   for (i = 0; i < numpages; i++)
-       {
-        valcs[i] = crc32c(0, dataP, XrdSys::PageSize);
-        if (csval[i] != valcs[i]) retval = false;
-        count -= XrdSys::PageSize;
-        dataP += XrdSys::PageSize;
-       }
-
-// if there is anything left, verify that as well
-//
-   if (count > 0)
-      {
-       valcs[i] = crc32c(0, dataP, count);
-       if (csval[i] != valcs[i]) retval = false;
-      }
+   Calc32C(data, count, valcs);
+   for (i = 0; i < numpages; i++) if (csval[i] != valcs[i]) retval = false;
 
 // All done.
 //
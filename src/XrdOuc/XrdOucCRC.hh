@@ -80,6 +80,21 @@ static uint32_t Calc32C(const void* data, size_t count, uint32_t prevcs=0);
 
 static void Calc32C(const void* data, size_t count, uint32_t* csval);
 
+//------------------------------------------------------------------------------
+//! Compute the CRC32C checksums of several independent buffers using hardware
+//! assist if available. The buffers are processed in parallel lanes, which is
+//! much faster than computing one checksum after another.
+//!
+//! @param  data   Pointer to a vector of num buffer pointers.
+//! @param  count  Pointer to a vector of num buffer lengths.
+//! @param  csval  Pointer to a vector of num elements to hold the checksum of
+//!                the corresponding buffer.
+//! @param  num    The number of buffers.
+//------------------------------------------------------------------------------
+
+static void Calc32C(const void* const* data, const size_t* count,
+                    uint32_t* csval, int num);
+
 //------------------------------------------------------------------------------
 //! Verify a CRC32C checksum using hardware assist if available.
 //!
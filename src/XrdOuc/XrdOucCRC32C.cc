@@ -45,10 +45,14 @@
                      XrdOucCRC32C.hh with corresponding change to include
                      statement herein. Add required casts to allow C++
                      compilation.
+        17 Oct 2026  Make crc32c_hw() external and have crc32c() use the
+                     kernel selected by XrdOucCRCEngine instead of checking
+                     for SSE 4.2 on every call.
  */
 
 #include <pthread.h>
 #include "XrdOuc/XrdOucCRC32C.hh"
+#include "XrdOuc/XrdOucCRCEngine.hh"
 
 /* CRC-32C (iSCSI) polynomial in reversed bit order. */
 #define POLY 0x82f63b78
@@ -160,7 +164,7 @@ static void crc32c_init_hw(void) {
 }
 
 /* Compute CRC-32C using the Intel hardware instruction. */
-static uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len) {
+uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len) {
     /* populate shift tables the first time through */
     pthread_once(&crc32c_once_hw, crc32c_init_hw);
 
@@ -247,39 +251,13 @@ static uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len) {
     return ~crc0;
 }
 
-/* Check for SSE 4.2.  SSE 4.2 was first supported in Nehalem processors
-   introduced in November, 2008.  This does not check for the existence of the
-   cpuid instruction itself, which was introduced on the 486SL in 1992, so this
-   will fail on earlier x86 processors.  cpuid works on all Pentium and later
-   processors. */
-#define SSE42(have) \
-    do { \
-        uint32_t eax, ecx; \
-        eax = 1; \
-        __asm__("cpuid" \
-                : "=c"(ecx) \
-                : "a"(eax) \
-                : "%ebx", "%edx"); \
-        (have) = (ecx >> 20) & 1; \
-    } while (0)
-
-/* Compute a CRC-32C.  If the crc32 instruction is available, use the hardware
-   version.  Otherwise, use the software version. */
-uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
-    int sse42;
-    
-    SSE42(sse42);
-    return sse42 ? crc32c_hw(crc, buf, len) : crc32c_sw(crc, buf, len);
-}
-
-#else /* !__x86_64__ */
+#endif /* __x86_64__ */
 
+/* Compute a CRC-32C using the fastest kernel available on this host. */
 uint32_t crc32c(uint32_t crc, void const *buf, size_t len) {
-    return crc32c_sw(crc, buf, len);
+    return XrdOucCRCEngine::Crc32C(crc, buf, len);
 }
 
-#endif
-
 /* Construct table for software CRC-32C little-endian calculation. */
 static pthread_once_t crc32c_once_little = PTHREAD_ONCE_INIT;
 static uint32_t crc32c_table_little[8][256];
@@ -16,4 +16,10 @@ uint32_t crc32c(uint32_t crc, void const *buf, size_t len);
 // crc32c_sw() is the same, but does not use the hardware instruction, even if
 // available.
 uint32_t crc32c_sw(uint32_t crc, void const *buf, size_t len);
+
+#ifdef __x86_64__
+// crc32c_hw() always uses the hardware instruction. It must only be called
+// when SSE 4.2 is available.
+uint32_t crc32c_hw(uint32_t crc, void const *buf, size_t len);
+#endif
 #endif
@@ -0,0 +1,704 @@
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O u c C R C E n g i n e . c c                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstring>
+
+#include "XrdOuc/XrdOucCRCEngine.hh"
+#include "XrdOuc/XrdOucCRC32C.hh"
+
+#if defined(__x86_64__) && \
+   (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8))
+#define XRDOUC_CRC_X86 1
+#include <immintrin.h>
+#endif
+
+/* The folding kernels follow "Fast CRC Computation for Generic Polynomials
+   Using PCLMULQDQ Instruction" (Gopal et al., Intel, 2009). The input is kept
+   in several 128 bit accumulators (four xmm or four zmm registers). Each
+   accumulator X = H*x^64 + L is advanced by D bits by computing
+
+      H * (x^(D+64) mod P) + L * (x^D mod P)
+
+   with two carry-less multiplies and adding it to the data D bits further on.
+   At the end the accumulators are folded into one 128 bit value which is
+   reduced to 32 bits with a Barrett reduction.
+
+   For the reflected CRC-32C every constant is bit-reflected and multiplied by
+   x, and the 32 bit crc register is aligned with the low end of the vector,
+   which leads to the well known x^(D+32) and x^(D-32) constant pairs. The
+   non-reflected CRC-32 (POSIX cksum) uses byte-swapped data and the
+   constants as shown above. All constants are computed at run time from the
+   polynomial so that there are no magic tables to get wrong.
+*/
+
+namespace
+{
+
+/******************************************************************************/
+/*                      P o l y n o m i a l   H e l p e r s                   */
+/******************************************************************************/
+
+const uint32_t PolyC = 0x1EDC6F41;  // CRC-32C in normal bit order
+const uint32_t PolyP = 0x04C11DB7;  // CRC-32  in normal bit order
+
+// Return x^n mod P(x) in normal bit order.
+//
+uint32_t xPowMod(unsigned int n, uint32_t poly)
+{
+   uint64_t r = 1;
+
+   while(n--)
+        {r <<= 1;
+         if (r & 0x100000000ULL) r ^= 0x100000000ULL | poly;
+        }
+   return (uint32_t)r;
+}
+
+// Return a(x)*b(x) mod P(x) in normal bit order.
+//
+uint32_t MulMod(uint32_t a, uint32_t b, uint32_t poly)
+{
+   uint32_t r = 0;
+
+   for (int i = 31; i >= 0; i--)
+       {r = (r & 0x80000000 ? (r << 1) ^ poly : r << 1);
+        if ((b >> i) & 1) r ^= a;
+       }
+   return r;
+}
+
+// Return x^(8*n) mod P(x) in normal bit order using square and multiply so
+// that very large byte counts are cheap.
+//
+uint32_t xPowBytes(uint64_t n, uint32_t poly)
+{
+   uint32_t r = 1, sq = xPowMod(8, poly);
+
+   while(n)
+        {if (n & 1) r = MulMod(r, sq, poly);
+         sq = MulMod(sq, sq, poly);
+         n >>= 1;
+        }
+   return r;
+}
+
+// Return floor(x^64 / P(x)), a 33 bit quantity in normal bit order.
+//
+uint64_t xDiv64(uint32_t poly)
+{
+   const uint64_t pfull = 0x100000000ULL | poly;
+   uint64_t r = (uint64_t)poly << 32, q = 1ULL << 32;
+
+   for (int i = 63; i >= 32; i--)
+       if ((r >> i) & 1) {q |= 1ULL << (i-32); r ^= pfull << (i-32);}
+   return q;
+}
+
+uint64_t Reflect(uint64_t v, int nbits)
+{
+   uint64_t r = 0;
+
+   for (int i = 0; i < nbits; i++) if ((v >> i) & 1) r |= 1ULL << (nbits-1-i);
+   return r;
+}
+
+/******************************************************************************/
+/*                       F o l d i n g   C o n s t a n t s                    */
+/******************************************************************************/
+
+// k[0] multiplies the low and k[1] the high 64 bits of an accumulator.
+//
+struct foldK {uint64_t k[2];};
+
+struct crcConsts
+      {foldK    f2048;  // Fold by 2048 bits (4 zmm accumulators)
+       foldK    f512;   // Fold by  512 bits (4 xmm or 1 zmm accumulator)
+       foldK    f384;
+       foldK    f256;
+       foldK    f128;   // Fold by  128 bits (1 xmm accumulator)
+       uint64_t k96;    // Final reduction constants
+       uint64_t k64;
+       uint64_t mu;     // Barrett constant floor(x^64/P)
+       uint64_t poly;   // Full 33 bit polynomial
+      };
+
+crcConsts MakeReflected(uint32_t poly)
+{
+   auto kRef = [poly](unsigned int n)
+               {return Reflect(xPowMod(n, poly), 32) << 1;};
+   auto kFold = [kRef](unsigned int d) {return foldK{{kRef(d+32), kRef(d-32)}};};
+   crcConsts kc;
+
+   kc.f2048 = kFold(2048);
+   kc.f512  = kFold(512);
+   kc.f384  = kFold(384);
+   kc.f256  = kFold(256);
+   kc.f128  = kFold(128);
+   kc.k96   = kRef(96);
+   kc.k64   = kRef(64);
+   kc.mu    = Reflect(xDiv64(poly), 33);
+   kc.poly  = Reflect(0x100000000ULL | poly, 33);
+   return kc;
+}
+
+crcConsts MakeNormal(uint32_t poly)
+{
+   auto kFold = [poly](unsigned int d)
+                {return foldK{{xPowMod(d, poly), xPowMod(d+64, poly)}};};
+   crcConsts kc;
+
+   kc.f2048 = kFold(2048);
+   kc.f512  = kFold(512);
+   kc.f384  = kFold(384);
+   kc.f256  = kFold(256);
+   kc.f128  = kFold(128);
+   kc.k96   = xPowMod(96, poly);
+   kc.k64   = xPowMod(64, poly);
+   kc.mu    = xDiv64(poly);
+   kc.poly  = 0x100000000ULL | poly;
+   return kc;
+}
+
+const crcConsts &ConstC() {static const crcConsts kc = MakeReflected(PolyC);
+                           return kc;
+                          }
+
+const crcConsts &ConstP() {static const crcConsts kc = MakeNormal(PolyP);
+                           return kc;
+                          }
+
+/******************************************************************************/
+/*                         c r c 3 2 p _ s w                                  */
+/******************************************************************************/
+
+// This is the non-reflected table driven method documented by Ross Williams
+// and used by XrdCksCalccrc32 since its inception.
+//
+struct crcTableP
+      {uint32_t tab[256];
+       crcTableP()
+                {for (uint32_t n = 0; n < 256; n++)
+                     {uint32_t crc = n << 24;
+                      for (int k = 0; k < 8; k++)
+                          crc = (crc & 0x80000000 ? (crc << 1) ^ PolyP
+                                                  : crc << 1);
+                      tab[n] = crc;
+                     }
+                }
+      };
+
+uint32_t crc32p_sw(uint32_t crc, const void *buff, size_t blen)
+{
+   static const crcTableP crcTab;
+   const unsigned char *p = (const unsigned char *)buff;
+
+   while(blen--) crc = (crc << 8) ^ crcTab.tab[(crc >> 24) ^ *p++];
+   return crc;
+}
+
+#ifdef XRDOUC_CRC_X86
+/******************************************************************************/
+/*                     1 2 8   B i t   F o l d i n g                          */
+/******************************************************************************/
+
+#define XRDOUC_PCLMUL  __attribute__((target("pclmul,sse4.1,ssse3")))
+#define XRDOUC_VPCLMUL \
+        __attribute__((target("avx512f,avx512bw,vpclmulqdq,pclmul,sse4.1,ssse3")))
+
+XRDOUC_PCLMUL
+inline __m128i Fold128(__m128i x, __m128i k, __m128i y)
+{
+   return _mm_xor_si128(y, _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                                         _mm_clmulepi64_si128(x, k, 0x11)));
+}
+
+XRDOUC_PCLMUL
+inline __m128i SetK(const foldK &f)
+{
+   return _mm_set_epi64x((long long)f.k[1], (long long)f.k[0]);
+}
+
+XRDOUC_PCLMUL
+inline uint64_t ClMul64(uint64_t a, uint64_t b)
+{
+   return (uint64_t)_mm_cvtsi128_si64(
+                    _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+                                         _mm_cvtsi64_si128((long long)b), 0));
+}
+
+// Load 16 bytes so that the first byte is the most significant in the
+// non-reflected case.
+//
+template<bool Refl>
+XRDOUC_PCLMUL
+inline __m128i Load128(const unsigned char *buf)
+{
+   __m128i x = _mm_loadu_si128((const __m128i *)buf);
+   if (Refl) return x;
+   return _mm_shuffle_epi8(x, _mm_setr_epi8(15,14,13,12,11,10,9,8,
+                                             7, 6, 5, 4, 3, 2,1,0));
+}
+
+// Return a vector holding the crc register in the position of the first
+// four bytes of the stream.
+//
+template<bool Refl>
+XRDOUC_PCLMUL
+inline __m128i Seed128(uint32_t crc)
+{
+   if (Refl) return _mm_cvtsi32_si128((int)crc);
+   return _mm_set_epi32((int)crc, 0, 0, 0);
+}
+
+// Reduce a 128 bit accumulator to the 32 bit crc register.
+//
+template<bool Refl>
+XRDOUC_PCLMUL
+inline uint32_t Reduce128(__m128i x, const crcConsts &kc)
+{
+   if (Refl)
+      {const __m128i mask32 = _mm_setr_epi32(-1, 0, 0, 0);
+       const __m128i pu = _mm_set_epi64x((long long)kc.mu, (long long)kc.poly);
+       __m128i t;
+
+    // Fold 128 bits to 64 bits while appending 32 zero bits.
+    //
+       t = _mm_clmulepi64_si128(x, _mm_cvtsi64_si128((long long)kc.k96), 0x00);
+       x = _mm_xor_si128(_mm_srli_si128(x, 8), t);
+
+    // Fold 64 bits to 32 bits.
+    //
+       t = _mm_and_si128(x, mask32);
+       x = _mm_srli_si128(x, 4);
+       t = _mm_clmulepi64_si128(t, _mm_cvtsi64_si128((long long)kc.k64), 0x00);
+       x = _mm_xor_si128(x, t);
+
+    // Reflected Barrett reduction to 32 bits.
+    //
+       t = _mm_and_si128(x, mask32);
+       t = _mm_clmulepi64_si128(t, pu, 0x10);
+       t = _mm_and_si128(t, mask32);
+       t = _mm_clmulepi64_si128(t, pu, 0x00);
+       x = _mm_xor_si128(x, t);
+       return (uint32_t)_mm_extract_epi32(x, 1);
+      }
+
+// Compute X*x^32 mod P. First fold to a 96 bit and then to a 64 bit value.
+//
+   __m128i t = _mm_xor_si128(
+               _mm_clmulepi64_si128(x,_mm_cvtsi64_si128((long long)kc.k96),0x01),
+               _mm_slli_si128(_mm_move_epi64(x), 4));
+   uint64_t v = ClMul64((uint64_t)_mm_extract_epi64(t, 1), kc.k64)
+              ^ (uint64_t)_mm_cvtsi128_si64(t);
+
+// Barrett reduction to 32 bits.
+//
+   uint64_t q = ClMul64(v >> 32, kc.mu) >> 32;
+   return (uint32_t)(v ^ ClMul64(q, kc.poly));
+}
+
+// Fold blen bytes (a multiple of 16, at least 64) into the crc register.
+//
+template<bool Refl>
+XRDOUC_PCLMUL
+uint32_t FoldSSE(uint32_t crc, const unsigned char *buf, size_t blen,
+                 const crcConsts &kc)
+{
+   __m128i x0 = _mm_xor_si128(Load128<Refl>(buf), Seed128<Refl>(crc));
+   __m128i x1 = Load128<Refl>(buf+16);
+   __m128i x2 = Load128<Refl>(buf+32);
+   __m128i x3 = Load128<Refl>(buf+48);
+   buf += 64; blen -= 64;
+
+   const __m128i k512 = SetK(kc.f512);
+   while(blen >= 64)
+        {x0 = Fold128(x0, k512, Load128<Refl>(buf));
+         x1 = Fold128(x1, k512, Load128<Refl>(buf+16));
+         x2 = Fold128(x2, k512, Load128<Refl>(buf+32));
+         x3 = Fold128(x3, k512, Load128<Refl>(buf+48));
+         buf += 64; blen -= 64;
+        }
+
+   const __m128i k128 = SetK(kc.f128);
+   x1 = Fold128(x0, k128, x1);
+   x2 = Fold128(x1, k128, x2);
+   x3 = Fold128(x2, k128, x3);
+   while(blen >= 16)
+        {x3 = Fold128(x3, k128, Load128<Refl>(buf));
+         buf += 16; blen -= 16;
+        }
+   return Reduce128<Refl>(x3, kc);
+}
+
+/******************************************************************************/
+/*                     5 1 2   B i t   F o l d i n g                          */
+/******************************************************************************/
+
+XRDOUC_VPCLMUL
+inline __m512i Fold512(__m512i x, __m512i k, __m512i y)
+{
+   return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(x, k, 0x00),
+                                    _mm512_clmulepi64_epi128(x, k, 0x11),
+                                    y, 0x96);
+}
+
+// Note that _mm512_broadcast_i32x4() triggers bogus uninitialized warnings in
+// some gcc versions, so the 128 bit lanes are replicated by hand.
+//
+XRDOUC_VPCLMUL
+inline __m512i SetK512(uint64_t lo, uint64_t hi)
+{
+   return _mm512_set_epi64((long long)hi, (long long)lo, (long long)hi,
+                           (long long)lo, (long long)hi, (long long)lo,
+                           (long long)hi, (long long)lo);
+}
+
+template<bool Refl>
+XRDOUC_VPCLMUL
+inline __m512i Load512(const unsigned char *buf)
+{
+   __m512i x = _mm512_loadu_si512((const void *)buf);
+   if (Refl) return x;
+   return _mm512_shuffle_epi8(x, SetK512(0x08090a0b0c0d0e0fULL,
+                                         0x0001020304050607ULL));
+}
+
+// Fold blen bytes (a multiple of 16, at least 256) into the crc register.
+//
+template<bool Refl>
+XRDOUC_VPCLMUL
+uint32_t FoldAVX512(uint32_t crc, const unsigned char *buf, size_t blen,
+                    const crcConsts &kc)
+{
+   const __m512i zero = _mm512_setzero_si512();
+   __m512i z0 = _mm512_xor_si512(Load512<Refl>(buf),
+                _mm512_inserti32x4(zero, Seed128<Refl>(crc), 0));
+   __m512i z1 = Load512<Refl>(buf+64);
+   __m512i z2 = Load512<Refl>(buf+128);
+   __m512i z3 = Load512<Refl>(buf+192);
+   buf += 256; blen -= 256;
+
+   const __m512i k2048 = SetK512(kc.f2048.k[0], kc.f2048.k[1]);
+   while(blen >= 256)
+        {z0 = Fold512(z0, k2048, Load512<Refl>(buf));
+         z1 = Fold512(z1, k2048, Load512<Refl>(buf+64));
+         z2 = Fold512(z2, k2048, Load512<Refl>(buf+128));
+         z3 = Fold512(z3, k2048, Load512<Refl>(buf+192));
+         buf += 256; blen -= 256;
+        }
+
+   const __m512i k512  = SetK512(kc.f512.k[0], kc.f512.k[1]);
+   z1 = Fold512(z0, k512, z1);
+   z2 = Fold512(z1, k512, z2);
+   z3 = Fold512(z2, k512, z3);
+   while(blen >= 64)
+        {z3 = Fold512(z3, k512, Load512<Refl>(buf));
+         buf += 64; blen -= 64;
+        }
+
+// Fold the four lanes into one; the last lane is not moved at all.
+//
+   __m512i kl = _mm512_inserti32x4(zero, SetK(kc.f384), 0);
+   kl = _mm512_inserti32x4(kl, SetK(kc.f256), 1);
+   kl = _mm512_inserti32x4(kl, SetK(kc.f128), 2);
+   __m512i t = Fold512(z3, kl, zero);
+
+   __m128i tl[4], zl[4];
+   _mm512_storeu_si512((void *)tl, t);
+   _mm512_storeu_si512((void *)zl, z3);
+   __m128i x = _mm_xor_si128(_mm_xor_si128(tl[0], tl[1]),
+                             _mm_xor_si128(tl[2], zl[3]));
+
+   const __m128i k128 = SetK(kc.f128);
+   while(blen >= 16)
+        {x = Fold128(x, k128, Load128<Refl>(buf));
+         buf += 16; blen -= 16;
+        }
+   return Reduce128<Refl>(x, kc);
+}
+
+/******************************************************************************/
+/*                       F o l d i n g   K e r n e l s                        */
+/******************************************************************************/
+
+uint32_t crc32c_pclmul(uint32_t crc, const void *buff, size_t blen)
+{
+   const unsigned char *buf = (const unsigned char *)buff;
+   size_t bulk = blen & ~(size_t)15;
+
+   if (blen < 64) return crc32c_sw(crc, buff, blen);
+
+   crc = ~FoldSSE<true>(~crc, buf, bulk, ConstC());
+   return (bulk == blen ? crc : crc32c_sw(crc, buf+bulk, blen-bulk));
+}
+
+uint32_t crc32c_vpclmul(uint32_t crc, const void *buff, size_t blen)
+{
+   const unsigned char *buf = (const unsigned char *)buff;
+   size_t bulk = blen & ~(size_t)15;
+
+// Hosts that have vpclmulqdq also have the crc32 instruction which is faster
+// for short buffers.
+//
+   if (blen < 256) return crc32c_hw(crc, buff, blen);
+
+   crc = ~FoldAVX512<true>(~crc, buf, bulk, ConstC());
+   return (bulk == blen ? crc : crc32c_hw(crc, buf+bulk, blen-bulk));
+}
+
+uint32_t crc32p_pclmul(uint32_t crc, const void *buff, size_t blen)
+{
+   const unsigned char *buf = (const unsigned char *)buff;
+   size_t bulk = blen & ~(size_t)15;
+
+   if (blen < 64) return crc32p_sw(crc, buff, blen);
+
+   crc = FoldSSE<false>(crc, buf, bulk, ConstP());
+   return (bulk == blen ? crc : crc32p_sw(crc, buf+bulk, blen-bulk));
+}
+
+uint32_t crc32p_vpclmul(uint32_t crc, const void *buff, size_t blen)
+{
+   const unsigned char *buf = (const unsigned char *)buff;
+   size_t bulk = blen & ~(size_t)15;
+
+   if (blen < 256) return crc32p_pclmul(crc, buff, blen);
+
+   crc = FoldAVX512<false>(crc, buf, bulk, ConstP());
+   return (bulk == blen ? crc : crc32p_sw(crc, buf+bulk, blen-bulk));
+}
+#endif
+
+/******************************************************************************/
+/*                        B a t c h   K e r n e l s                           */
+/******************************************************************************/
+
+#ifdef XRDOUC_CRC_X86
+// Compute four independent crc's using one crc32 instruction chain per lane.
+// The lanes share the common length and each lane finishes on its own.
+//
+__attribute__((target("sse4.2")))
+void crc32c_lanes4(const void *const *buff, const size_t *blen, uint32_t *csval)
+{
+   const unsigned char *p0 = (const unsigned char *)buff[0];
+   const unsigned char *p1 = (const unsigned char *)buff[1];
+   const unsigned char *p2 = (const unsigned char *)buff[2];
+   const unsigned char *p3 = (const unsigned char *)buff[3];
+   uint64_t c0 = 0xffffffff, c1 = 0xffffffff, c2 = 0xffffffff, c3 = 0xffffffff;
+   uint64_t w0, w1, w2, w3;
+   size_t   n = blen[0];
+
+   for (int i = 1; i < 4; i++) if (blen[i] < n) n = blen[i];
+   n &= ~(size_t)7;
+
+   for (size_t k = 0; k < n; k += 8)
+       {memcpy(&w0, p0+k, 8); memcpy(&w1, p1+k, 8);
+        memcpy(&w2, p2+k, 8); memcpy(&w3, p3+k, 8);
+        c0 = _mm_crc32_u64(c0, w0); c1 = _mm_crc32_u64(c1, w1);
+        c2 = _mm_crc32_u64(c2, w2); c3 = _mm_crc32_u64(c3, w3);
+       }
+
+   csval[0] = crc32c_hw(~(uint32_t)c0, p0+n, blen[0]-n);
+   csval[1] = crc32c_hw(~(uint32_t)c1, p1+n, blen[1]-n);
+   csval[2] = crc32c_hw(~(uint32_t)c2, p2+n, blen[2]-n);
+   csval[3] = crc32c_hw(~(uint32_t)c3, p3+n, blen[3]-n);
+}
+
+void crc32c_lanes(const void *const *buff, const size_t *blen,
+                  uint32_t *csval, int bnum)
+{
+   int i;
+
+   for (i = 0; i+4 <= bnum; i += 4) crc32c_lanes4(buff+i, blen+i, csval+i);
+   for (     ; i < bnum; i++) csval[i] = crc32c_hw(0, buff[i], blen[i]);
+}
+#endif
+
+void crc32c_loop(const void *const *buff, const size_t *blen,
+                 uint32_t *csval, int bnum)
+{
+   for (int i = 0; i < bnum; i++)
+       csval[i] = XrdOucCRCEngine::Crc32C(0, buff[i], blen[i]);
+}
+
+/******************************************************************************/
+/*                           K e r n e l   T a b l e                          */
+/******************************************************************************/
+
+bool isUsable() {return true;}
+
+#ifdef XRDOUC_CRC_X86
+bool hasSSE42()   {return __builtin_cpu_supports("sse4.2");}
+bool hasPCLMUL()  {return __builtin_cpu_supports("pclmul")
+                       && __builtin_cpu_supports("sse4.1")
+                       && __builtin_cpu_supports("ssse3");}
+bool hasVPCLMUL() {return hasPCLMUL() && hasSSE42()
+                       && __builtin_cpu_supports("avx512f")
+                       && __builtin_cpu_supports("avx512bw")
+                       && __builtin_cpu_supports("vpclmulqdq");}
+#endif
+
+struct crcKernel
+      {const char              *name;
+       XrdOucCRCEngine::Kernel  kern;
+       bool                   (*usable)();
+      };
+
+// Each table is ordered from most to least preferred kernel and always ends
+// with the software kernel.
+//
+const crcKernel kernC[] =
+{
+#ifdef XRDOUC_CRC_X86
+   {"vpclmul", crc32c_vpclmul, hasVPCLMUL},
+   {"sse42",   crc32c_hw,      hasSSE42},
+   {"pclmul",  crc32c_pclmul,  hasPCLMUL},
+#endif
+   {"sw",      crc32c_sw,      isUsable},
+   {0, 0, 0}
+};
+
+const crcKernel kernP[] =
+{
+#ifdef XRDOUC_CRC_X86
+   {"vpclmul", crc32p_vpclmul, hasVPCLMUL},
+   {"pclmul",  crc32p_pclmul,  hasPCLMUL},
+#endif
+   {"sw",      crc32p_sw,      isUsable},
+   {0, 0, 0}
+};
+
+const crcKernel *kernTab[XrdOucCRCEngine::nAlgo] = {kernC, kernP};
+
+const crcKernel *bestKernel(XrdOucCRCEngine::Algo algo)
+{
+   const crcKernel *kP = kernTab[algo];
+
+   while(!(kP->usable())) kP++;
+   return kP;
+}
+}
+
+/******************************************************************************/
+/*                               C o m b i n e                                */
+/******************************************************************************/
+
+uint32_t XrdOucCRCEngine::Combine(Algo algo, uint32_t crc1, uint32_t crc2,
+                                  uint64_t len2)
+{
+
+// Appending len2 bytes multiplies the first crc by x^(8*len2). The pre- and
+// post-conditioning of CRC-32C cancel out so the same identity holds for the
+// conditioned values once they are brought into normal bit order.
+//
+   switch(algo)
+         {case CRC32C:
+               crc1 = (uint32_t)Reflect(crc1, 32);
+               crc1 = MulMod(crc1, xPowBytes(len2, PolyC), PolyC);
+               return (uint32_t)Reflect(crc1, 32) ^ crc2;
+          case CRC32P:
+               return MulMod(crc1, xPowBytes(len2, PolyP), PolyP) ^ crc2;
+          default: break;
+         }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                C r c 3 2 C                                 */
+/******************************************************************************/
+
+uint32_t XrdOucCRCEngine::Crc32C(uint32_t crc, const void *buff, size_t blen)
+{
+   static const Kernel kern = bestKernel(CRC32C)->kern;
+
+   return kern(crc, buff, blen);
+}
+
+/******************************************************************************/
+
+void XrdOucCRCEngine::Crc32C(const void *const *buff, const size_t *blen,
+                             uint32_t *csval, int bnum)
+{
+   static const BKernel bkern = BatchEngine();
+
+   bkern(buff, blen, csval, bnum);
+}
+
+/******************************************************************************/
+/*                                C r c 3 2 P                                 */
+/******************************************************************************/
+
+uint32_t XrdOucCRCEngine::Crc32P(uint32_t crc, const void *buff, size_t blen)
+{
+   static const Kernel kern = bestKernel(CRC32P)->kern;
+
+   return kern(crc, buff, blen);
+}
+
+/******************************************************************************/
+/*                           B a t c h E n g i n e                            */
+/******************************************************************************/
+
+XrdOucCRCEngine::BKernel XrdOucCRCEngine::BatchEngine(const char *kname)
+{
+#ifdef XRDOUC_CRC_X86
+// Interleaving lanes only pays when the crc instruction is the best we have.
+// The folding kernels already keep the multipliers busy on their own.
+//
+   if (!kname) kname = (Engine(CRC32C) == crc32c_hw ? "lanes" : "loop");
+   if (!strcmp(kname, "lanes")) return (hasSSE42() ? crc32c_lanes : 0);
+#else
+   if (!kname) kname = "loop";
+#endif
+   if (!strcmp(kname, "loop")) return crc32c_loop;
+   return 0;
+}
+
+/******************************************************************************/
+/*                                E n g i n e                                 */
+/******************************************************************************/
+
+XrdOucCRCEngine::Kernel XrdOucCRCEngine::Engine(Algo algo, const char *kname)
+{
+   if (algo < 0 || algo >= nAlgo) return 0;
+   if (!kname) return bestKernel(algo)->kern;
+
+   for (const crcKernel *kP = kernTab[algo]; kP->name; kP++)
+       if (!strcmp(kname, kP->name)) return (kP->usable() ? kP->kern : 0);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  N a m e                                   */
+/******************************************************************************/
+
+const char *XrdOucCRCEngine::Name(Algo algo)
+{
+   if (algo < 0 || algo >= nAlgo) return "?";
+   return bestKernel(algo)->name;
+}
@@ -0,0 +1,157 @@
+#ifndef __XRDOUCCRCENGINE_HH__
+#define __XRDOUCCRCENGINE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                    X r d O u c C R C E n g i n e . h h                     */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+//! This class is the dispatch table for the CRC kernels. For each algorithm
+//! the fastest kernel supported by the cpu is selected once at run time. The
+//! following kernels exist (not all are available on every host):
+//!
+//! "sw"      - table driven software computation (always available).
+//! "sse42"   - the Intel crc32 instruction (crc32c only).
+//! "pclmul"  - 128 bit carry-less multiply folding.
+//! "vpclmul" - 512 bit carry-less multiply folding (AVX-512 hosts).
+//!
+//! All kernels of an algorithm produce identical results.
+//------------------------------------------------------------------------------
+
+class XrdOucCRCEngine
+{
+public:
+
+typedef uint32_t (*Kernel)(uint32_t crc, const void *buff, size_t blen);
+
+typedef void     (*BKernel)(const void *const *buff, const size_t *blen,
+                            uint32_t *csval, int bnum);
+
+enum Algo {CRC32C = 0,   //!< CRC-32C (Castagnoli) as computed by crc32c()
+           CRC32P,       //!< CRC-32 non-reflected (POSIX cksum) raw register
+           nAlgo
+          };
+
+//------------------------------------------------------------------------------
+//! Compute a CRC-32C using the best available kernel.
+//!
+//! @param  crc    The previous checksum value, the initial value is zero.
+//! @param  buff   Pointer to the data to be checksummed.
+//! @param  blen   The number of bytes pointed to by buff.
+//!
+//! @return The updated checksum.
+//------------------------------------------------------------------------------
+
+static uint32_t Crc32C(uint32_t crc, const void *buff, size_t blen);
+
+//------------------------------------------------------------------------------
+//! Compute the CRC-32C of several independent buffers (typically pages). The
+//! buffers are processed in parallel lanes so that the latency of the crc
+//! instruction is hidden when that is the best kernel for the host.
+//!
+//! @param  buff   Pointer to a vector of bnum buffer pointers.
+//! @param  blen   Pointer to a vector of bnum buffer lengths.
+//! @param  csval  Pointer to a vector of bnum elements to receive the CRC-32C
+//!                of the corresponding buffer (the initial crc is zero).
+//! @param  bnum   The number of buffers.
+//------------------------------------------------------------------------------
+
+static void     Crc32C(const void *const *buff, const size_t *blen,
+                       uint32_t *csval, int bnum);
+
+//------------------------------------------------------------------------------
+//! Update the raw register of a non-reflected CRC-32 (polynomial 0x04C11DB7,
+//! the POSIX cksum computation) using the best available kernel. Neither
+//! pre- nor post-conditioning is applied; that is left to the caller.
+//!
+//! @param  crc    The previous register value, the POSIX initial value is 0.
+//! @param  buff   Pointer to the data to be checksummed.
+//! @param  blen   The number of bytes pointed to by buff.
+//!
+//! @return The updated register value.
+//------------------------------------------------------------------------------
+
+static uint32_t Crc32P(uint32_t crc, const void *buff, size_t blen);
+
+//------------------------------------------------------------------------------
+//! Combine the checksums of two adjacent pieces of data so that the result is
+//! the checksum of their concatenation. This allows a large file to be
+//! checksummed in independent pieces (e.g. in parallel).
+//!
+//! @param  algo   The algorithm. For CRC32C the values are the ones returned
+//!                by Crc32C() and for CRC32P the raw register values returned
+//!                by Crc32P(); in both cases starting with a zero crc.
+//! @param  crc1   The checksum of the first piece.
+//! @param  crc2   The checksum of the second piece.
+//! @param  len2   The length of the second piece in bytes.
+//!
+//! @return The checksum of the first piece followed by the second piece.
+//------------------------------------------------------------------------------
+
+static uint32_t Combine(Algo algo, uint32_t crc1, uint32_t crc2,
+                        uint64_t len2);
+
+//------------------------------------------------------------------------------
+//! Obtain a specific kernel (mainly used for testing and benchmarking).
+//!
+//! @param  algo   The algorithm.
+//! @param  kname  The kernel name (see above). When nil, the kernel that is
+//!                used by default for the algorithm is returned.
+//!
+//! @return Pointer to the kernel or nil if it is not supported on this host.
+//------------------------------------------------------------------------------
+
+static Kernel   Engine(Algo algo, const char *kname=0);
+
+//------------------------------------------------------------------------------
+//! Get the name of the default kernel for an algorithm.
+//!
+//! @param  algo   The algorithm.
+//!
+//! @return The kernel name.
+//------------------------------------------------------------------------------
+
+static const char *Name(Algo algo);
+
+//------------------------------------------------------------------------------
+//! Obtain a specific CRC-32C batch kernel (mainly used for benchmarking).
+//!
+//! @param  kname  "lanes" for the interleaved crc instruction kernel or
+//!                "loop" to compute each buffer with the default kernel. When
+//!                nil, the batch kernel used by Crc32C() is returned.
+//!
+//! @return Pointer to the kernel or nil if it is not supported on this host.
+//------------------------------------------------------------------------------
+
+static BKernel  BatchEngine(const char *kname=0);
+
+                XrdOucCRCEngine() {}
+               ~XrdOucCRCEngine() {}
+};
+#endif
@@ -319,25 +319,30 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
              minpages  smallest number of pages allowed (default 256)
              mode      {r | w}
              pagesize  size of each cache page (can be suffixed with k, m, g).
+             policy    {lru | 2q}
              preread   [minpages [minrdsz]] [perf nn [recalc]]
              r/w       enables caching for files opened read/write.
              sfiles    {on | off | .<sfx>}
              size      size of cache in bytes  (can be suffixed with k, m, g).
+             stream    sequential bytes after which reads bypass the cache
+                       (can be suffixed with k, m, g).
 
    Output: true upon success or false upon failure.
 */
 
 bool XrdOucPsx::ParseCache(XrdSysError *Eroute, XrdOucStream &Config)
 {
-   long long llVal, cSize=-1, m2Cache=-1, pSize=-1, minPg = -1;
+   long long llVal, cSize=-1, m2Cache=-1, pSize=-1, minPg = -1, sSize = -1;
    const char *ivN = 0;
    char  *val, *sfSfx = 0, sfVal = '0', lgVal = '0', dbVal = '0', rwVal = '0';
+   char  plVal = 0;
    char eBuff[2048], pBuff[1024], *eP;
    struct sztab {const char *Key; long long *Val;} szopts[] =
                {{"max2cache", &m2Cache},
                 {"minpages",  &minPg},
                 {"pagesize",  &pSize},
-                {"size",      &cSize}
+                {"size",      &cSize},
+                {"stream",    &sSize}
                };
    int i, numopts = sizeof(szopts)/sizeof(struct sztab);
 
@@ -365,6 +370,12 @@ do{for (i = 0; i < numopts; i++) if (!strcmp(szopts[i].Key, val)) break;
                    else dbVal = *val;
                }
        else if (!strcmp("logstats", val)) lgVal = '1';
+       else if (!strcmp("policy", val))
+               {     if (!(val = Config.GetWord())) ivN = "policy";
+                else if (!strcmp("lru", val)) plVal = 'l';
+                else if (!strcmp("2q",  val)) plVal = '2';
+                else ivN = "policy";
+               }
        else if (!strcmp("preread", val))
                {if ((val = ParseCache(Eroute, Config, pBuff))) continue;
                 if (*pBuff == '?') return false;
@@ -402,6 +413,8 @@ do{for (i = 0; i < numopts; i++) if (!strcmp(szopts[i].Key, val)) break;
        eP += sprintf(eP, "&minpages=%lld", minPg);
       }
    if (pSize > 0)    eP += sprintf(eP, "&pagesz=%lld", pSize);
+   if (plVal)        eP += sprintf(eP, "&policy=%s", (plVal == '2' ? "2q":"lru"));
+   if (sSize > 0)    eP += sprintf(eP, "&stream=%lld", sSize);
    if (lgVal != '0') strcat(eP, "&optlg=1");
    if (sfVal != '0' || sfSfx)
       {if (!sfSfx)   strcat(eP, "&optsf=1");
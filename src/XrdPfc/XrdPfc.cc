@@ -30,7 +30,6 @@
 #include "XrdOuc/XrdOucPrivateUtils.hh"
 #include "XrdOuc/XrdOucJson.hh"
 
-#include "XrdSys/XrdSysTimer.hh"
 #include "XrdSys/XrdSysTrace.hh"
 #include "XrdSys/XrdSysXAttr.hh"
 
@@ -113,7 +112,10 @@ XrdOucCache *XrdOucGetCache(XrdSysLogger *logger,
 
       if (instance.is_prefetch_enabled())
       {
-         XrdSysThread::Run(&tid, PrefetchThread, 0, 0, "XrdPfc Prefetch ");
+         for (int pti = 0; pti < instance.RefConfiguration().m_prefetch_threads; ++pti)
+         {
+            XrdSysThread::Run(&tid, PrefetchThread, 0, 0, "XrdPfc Prefetch ");
+         }
       }
    }
 
@@ -170,6 +172,8 @@ Cache::Cache(XrdSysLogger *logger, XrdOucEnv *env) :
    m_purge_pin(0),
    m_prefetch_condVar(0),
    m_prefetch_enabled(false),
+   m_prefetch_RAM_cond(0),
+   m_prefetch_RAM_waiters(0),
    m_RAM_used(0),
    m_RAM_write_queue(0),
    m_RAM_std_size(0),
@@ -235,13 +239,27 @@ void Cache::AddWriteTask(Block* b, bool fromRead)
       m_RAM_write_queue += b->get_size();
    }
 
+   // Blocks are queued per file so that only one writer thread works on a
+   // given file at a time and adjacent blocks can be written out together.
+   // Files that are not being written are handed out in round-robin order.
    m_writeQ.condVar.Lock();
+   WriteQ::FileQ &fq = m_writeQ.files[b->m_file];
+   bool new_file = fq.blocks.empty() && ! fq.busy;
    if (fromRead)
-      m_writeQ.queue.push_back(b);
+      fq.blocks.push_back(b);
    else
-      m_writeQ.queue.push_front(b);
-   m_writeQ.size++;
-   m_writeQ.condVar.Signal();
+      fq.blocks.push_front(b);
+   if (new_file)
+   {
+      if (fromRead)
+         m_writeQ.ready.push_back(b->m_file);
+      else
+         m_writeQ.ready.push_front(b->m_file);
+      m_writeQ.condVar.Signal();
+   }
+   if (++m_writeQ.size > m_writeQ.size_max)
+      m_writeQ.size_max = m_writeQ.size;
+   b->m_wq_depth = m_writeQ.size;
    m_writeQ.condVar.UnLock();
 }
 
@@ -251,21 +269,22 @@ void Cache::RemoveWriteQEntriesFor(File *file)
    long long         sum_size = 0;
 
    m_writeQ.condVar.Lock();
-   std::list<Block*>::iterator i = m_writeQ.queue.begin();
-   while (i != m_writeQ.queue.end())
+   std::map<File*, WriteQ::FileQ>::iterator fqi = m_writeQ.files.find(file);
+   if (fqi != m_writeQ.files.end())
    {
-      if ((*i)->m_file == file)
+      for (std::list<Block*>::iterator i = fqi->second.blocks.begin(); i != fqi->second.blocks.end(); ++i)
       {
          TRACE(Dump, "Remove entries for " <<  (void*)(*i) << " path " <<  file->lPath());
-         std::list<Block*>::iterator j = i++;
-         removed_blocks.push_back(*j);
-         sum_size += (*j)->get_size();
-         m_writeQ.queue.erase(j);
-         --m_writeQ.size;
+         sum_size += (*i)->get_size();
       }
-      else
+      m_writeQ.size -= fqi->second.blocks.size();
+      removed_blocks.swap(fqi->second.blocks);
+
+      // A busy entry is cleaned up by its writer thread.
+      if ( ! fqi->second.busy)
       {
-         ++i;
+         m_writeQ.ready.remove(file);
+         m_writeQ.files.erase(fqi);
       }
    }
    m_writeQ.condVar.UnLock();
@@ -280,34 +299,40 @@ void Cache::RemoveWriteQEntriesFor(File *file)
 
 void Cache::ProcessWriteTasks()
 {
-   std::vector<Block*> blks_to_write(m_configuration.m_wqueue_blocks);
+   std::vector<Block*> blks_to_write;
+   blks_to_write.reserve(m_configuration.m_wqueue_blocks);
 
    while (true)
    {
       m_writeQ.condVar.Lock();
-      while (m_writeQ.size == 0)
+      while (m_writeQ.ready.empty())
       {
          m_writeQ.condVar.Wait();
       }
 
-      // MT -- optimize to pop several blocks if they are available (or swap the list).
-      // This makes sense especially for smallish block sizes.
+      // Take up to m_wqueue_blocks blocks of the next file. The file stays
+      // busy until we are done so no other thread will write to it.
+      File *file = m_writeQ.ready.front();
+      m_writeQ.ready.pop_front();
+
+      std::map<File*, WriteQ::FileQ>::iterator fqi = m_writeQ.files.find(file);
+      std::list<Block*> &fq_blocks = fqi->second.blocks;
+      fqi->second.busy = true;
 
-      int       n_pushed = std::min(m_writeQ.size, m_configuration.m_wqueue_blocks);
       long long sum_size = 0;
 
-      for (int bi = 0; bi < n_pushed; ++bi)
+      while ( ! fq_blocks.empty() && (int) blks_to_write.size() < m_configuration.m_wqueue_blocks)
       {
-         Block* block = m_writeQ.queue.front();
-         m_writeQ.queue.pop_front();
+         Block* block = fq_blocks.front();
+         fq_blocks.pop_front();
          m_writeQ.writes_between_purges += block->get_size();
          sum_size += block->get_size();
 
-         blks_to_write[bi] = block;
+         blks_to_write.push_back(block);
 
          TRACE(Dump, "ProcessWriteTasks for block " <<  (void*)(block) << " path " << block->m_file->lPath());
       }
-      m_writeQ.size -= n_pushed;
+      m_writeQ.size -= blks_to_write.size();
 
       m_writeQ.condVar.UnLock();
 
@@ -316,12 +341,23 @@ void Cache::ProcessWriteTasks()
          m_RAM_write_queue -= sum_size;
       }
 
-      for (int bi = 0; bi < n_pushed; ++bi)
-      {
-         Block* block = blks_to_write[bi];
+      // The file object may be gone once this returns; it is only used as
+      // a key below.
+      file->WriteBlocksToDisk(blks_to_write);
+      blks_to_write.clear();
 
-         block->m_file->WriteBlockToDisk(block);
+      m_writeQ.condVar.Lock();
+      fqi->second.busy = false;
+      if (fqi->second.blocks.empty())
+      {
+         m_writeQ.files.erase(fqi);
       }
+      else
+      {
+         m_writeQ.ready.push_back(file);
+         m_writeQ.condVar.Signal();
+      }
+      m_writeQ.condVar.UnLock();
    }
 }
 
@@ -334,6 +370,15 @@ long long Cache::WritesSinceLastCall()
    return ret;
 }
 
+void Cache::WriteQueueStats(int &size, int &size_max, int &n_files)
+{
+   XrdSysCondVarHelper lock(&m_writeQ.condVar);
+   size     = m_writeQ.size;
+   size_max = m_writeQ.size_max;
+   n_files  = m_writeQ.files.size();
+   m_writeQ.size_max = m_writeQ.size;
+}
+
 //==============================================================================
 
 char* Cache::RequestRAM(long long size)
@@ -379,19 +424,36 @@ char* Cache::RequestRAM(long long size)
 void Cache::ReleaseRAM(char* buf, long long size)
 {
    bool std_size = (size == m_configuration.m_bufferSize);
+   bool kept     = false;
+   bool crossed;
    {
       XrdSysMutexHelper lock(&m_RAM_mutex);
 
       m_RAM_used -= size;
 
+      const long long limit = prefetch_RAM_limit();
+      crossed = m_RAM_used < limit && m_RAM_used + size >= limit;
+
       if (std_size && m_RAM_std_size < m_configuration.m_RamKeepStdBlocks)
       {
          m_RAM_std_blocks.push_back(buf);
          ++m_RAM_std_size;
-         return;
+         kept = true;
       }
    }
-   free(buf);
+   if ( ! kept)
+   {
+      free(buf);
+   }
+
+   // Prefetch threads blocked on RAM increment the waiter count before checking
+   // m_RAM_used, so one of them is either already waiting or will see the release.
+   if (crossed && m_prefetch_RAM_waiters.load() > 0)
+   {
+      m_prefetch_RAM_cond.Lock();
+      m_prefetch_RAM_cond.Broadcast();
+      m_prefetch_RAM_cond.UnLock();
+   }
 }
 
 File* Cache::GetFile(const std::string& path, IO* io, long long off, long long filesize)
@@ -660,13 +722,15 @@ void Cache::dec_ref_cnt(File* f, bool high_debug)
                               "\"lfn\":\"%s\",\"size\":%lld,\"blk_size\":%d,\"n_blks\":%d,\"n_blks_done\":%d,"
                               "\"access_cnt\":%lu,\"attach_t\":%lld,\"detach_t\":%lld,\"remotes\":%s,"
                               "\"b_hit\":%lld,\"b_miss\":%lld,\"b_bypass\":%lld,"
-                              "\"b_todisk\":%lld,\"b_prefetch\":%lld,\"n_cks_errs\":%d}",
+                              "\"b_todisk\":%lld,\"b_prefetch\":%lld,\"n_cks_errs\":%d,\"n_disk_writes\":%d,"
+                              "\"n_blks_coalesced\":%d,\"wq_max\":%d}",
                               f->GetLocalPath().c_str(), f->GetFileSize(), f->GetBlockSize(),
                               f->GetNBlocks(), f->GetNDownloadedBlocks(),
                               (unsigned long) f->GetAccessCnt(), (long long) as->AttachTime, (long long) as->DetachTime,
                               f->GetRemoteLocations().c_str(),
                               as->BytesHit, as->BytesMissed, as->BytesBypassed,
-                              st.m_BytesWritten, f->GetPrefetchedBytes(), st.m_NCksumErrors
+                              st.m_BytesWritten, f->GetPrefetchedBytes(), st.m_NCksumErrors, st.m_NDiskWrites,
+                              st.m_NBlksCoalesced, st.m_WriteQueueMax
          );
          bool suc = false;
          if (len < 4096)
@@ -739,6 +803,45 @@ void Cache::DeRegisterPrefetchFile(File* file)
 }
 
 
+double Cache::prefetch_priority(File *f, std::chrono::steady_clock::time_point now)
+{
+   // Called under m_prefetch_condVar; only uses File's published metrics.
+   //
+   // Priority estimates how much a file's readers stand to gain from having
+   // data fetched ahead: client read rate times source latency is the amount
+   // of data needed in flight to hide the latency. Every file gets a base rate
+   // of one block per second so that idle ones still progress. This is then
+   // weighted by how useful prefetching has been for the file so far and by
+   // the number of blocks still missing, up to the per-file in-flight limit.
+
+   const int missing = f->GetNMissingBlocks();
+   if (missing <= 0)
+   {
+      return 0;
+   }
+
+   File::PrefetchSched &ps = f->RefPrefetchSched();
+
+   const double dt = std::chrono::duration<double>(now - ps.m_sample_time).count();
+   if (dt >= 1)
+   {
+      const long long bytes = f->GetClientReadBytes();
+      if (ps.m_sample_time.time_since_epoch().count() != 0)
+      {
+         ps.m_read_rate = 0.5 * ps.m_read_rate + 0.5 * (bytes - ps.m_read_bytes) / dt;
+      }
+      ps.m_read_bytes  = bytes;
+      ps.m_sample_time = now;
+   }
+
+   const int    lat_us  = f->GetRemoteLatencyUs();
+   const double latency = (lat_us > 0 ? lat_us : 10000) * 1e-6 + 1e-3;
+   const int    depth   = std::min(missing, std::max(1, m_configuration.m_prefetch_max_blocks));
+
+   return (ps.m_read_rate + m_configuration.m_bufferSize) * latency * f->GetPrefetchHitWeight() * depth;
+}
+
+
 File* Cache::GetNextFileToPrefetch()
 {
    m_prefetch_condVar.Lock();
@@ -747,10 +850,33 @@ File* Cache::GetNextFileToPrefetch()
       m_prefetch_condVar.Wait();
    }
 
-   //  std::sort(m_prefetchList.begin(), m_prefetchList.end(), myobject);
+   const auto   now = std::chrono::steady_clock::now();
+   const size_t l   = m_prefetchList.size();
 
-   size_t l = m_prefetchList.size();
-   int idx = rand() % l;
+   m_prefetchWeights.resize(l);
+   double sum = 0;
+   for (size_t i = 0; i < l; ++i)
+   {
+      m_prefetchWeights[i] = prefetch_priority(m_prefetchList[i], now);
+      sum += m_prefetchWeights[i];
+   }
+
+   // Lottery selection: busy files are picked more often without starving the rest.
+   // When nothing is missing anywhere any choice will do, File::Prefetch() deregisters it.
+   size_t idx = l - 1;
+   if (sum > 0)
+   {
+      double r = sum * (rand() / (RAND_MAX + 1.0));
+      for (size_t i = 0; i < l; ++i)
+      {
+         r -= m_prefetchWeights[i];
+         if (r < 0) { idx = i; break; }
+      }
+   }
+   else
+   {
+      idx = rand() % l;
+   }
    File* f = m_prefetchList[idx];
 
    m_prefetch_condVar.UnLock();
@@ -760,23 +886,28 @@ File* Cache::GetNextFileToPrefetch()
 
 void Cache::Prefetch()
 {
-   const long long limit_RAM = m_configuration.m_RamAbsAvailable * 7 / 10;
+   const long long limit_RAM = prefetch_RAM_limit();
 
    while (true)
    {
-      m_RAM_mutex.Lock();
-      bool doPrefetch = (m_RAM_used < limit_RAM);
-      m_RAM_mutex.UnLock();
-
-      if (doPrefetch)
-      {
-         File* f = GetNextFileToPrefetch();
-         f->Prefetch();
-      }
-      else
+      // Wait until RAM usage drops below the limit; ReleaseRAM() wakes us up.
+      m_prefetch_RAM_cond.Lock();
+      ++m_prefetch_RAM_waiters;
+      while (true)
       {
-         XrdSysTimer::Wait(5);
+         m_RAM_mutex.Lock();
+         bool doPrefetch = (m_RAM_used < limit_RAM);
+         m_RAM_mutex.UnLock();
+
+         if (doPrefetch) break;
+
+         m_prefetch_RAM_cond.Wait();
       }
+      --m_prefetch_RAM_waiters;
+      m_prefetch_RAM_cond.UnLock();
+
+      File* f = GetNextFileToPrefetch();
+      f->Prefetch();
    }
 }
 
@@ -17,6 +17,8 @@
 // You should have received a copy of the GNU Lesser General Public License
 // along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
 //----------------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <list>
 #include <map>
@@ -113,6 +115,7 @@ struct Configuration
    int       m_wqueue_blocks;           //!< maximum number of blocks written per write-queue loop
    int       m_wqueue_threads;          //!< number of threads writing blocks to disk
    int       m_prefetch_max_blocks;     //!< default maximum number of blocks to prefetch per file
+   int       m_prefetch_threads;        //!< number of threads issuing prefetch requests
 
    long long m_cgi_min_bufferSize = 0;          //!< min buffer size allowed in pfc.blocksize
    long long m_cgi_max_bufferSize = 0;          //!< max buffer size allowed in pfc.blocksize
@@ -278,14 +281,26 @@ public:
 
    long long WritesSinceLastCall();
 
+   //---------------------------------------------------------------------
+   //! Current and maximum (since the previous call) number of blocks in
+   //! the write queue along with the number of files they belong to.
+   //---------------------------------------------------------------------
+   void WriteQueueStats(int &size, int &size_max, int &n_files);
+
    char* RequestRAM(long long size);
    void  ReleaseRAM(char* buf, long long size);
 
    void RegisterPrefetchFile(File*);
    void DeRegisterPrefetchFile(File*);
 
+   //---------------------------------------------------------------------
+   //! Select a registered file by lottery, weighted by prefetch priority.
+   //---------------------------------------------------------------------
    File* GetNextFileToPrefetch();
 
+   //---------------------------------------------------------------------
+   //! Prefetch thread loop; waits for RAM release when over the limit.
+   //---------------------------------------------------------------------
    void Prefetch();
 
    XrdOss* GetOss() const { return m_oss; }
@@ -349,6 +364,9 @@ private:
    XrdSysCondVar m_prefetch_condVar;        //!< lock for vector of prefetching files
    bool          m_prefetch_enabled;        //!< set to true when prefetching is enabled
 
+   XrdSysCondVar    m_prefetch_RAM_cond;    //!< prefetch threads wait here for RAM to be released
+   std::atomic<int> m_prefetch_RAM_waiters; //!< number of prefetch threads waiting for RAM
+
    XrdSysMutex m_RAM_mutex;                 //!< lock for allcoation of RAM blocks
    long long   m_RAM_used;
    long long   m_RAM_write_queue;
@@ -361,12 +379,20 @@ private:
 
    struct WriteQ
    {
-      WriteQ() : condVar(0), writes_between_purges(0), size(0) {}
+      WriteQ() : condVar(0), writes_between_purges(0), size(0), size_max(0) {}
+
+      struct FileQ
+      {
+         std::list<Block*> blocks;         //!< blocks of the file waiting to be written
+         bool              busy = false;   //!< a writer thread is working on the file
+      };
 
-      XrdSysCondVar     condVar;      //!< write list condVar
-      std::list<Block*> queue;        //!< container
+      XrdSysCondVar           condVar;     //!< write list condVar
+      std::map<File*, FileQ>  files;       //!< per-file queues
+      std::list<File*>        ready;       //!< files with queued blocks and no active writer
       long long         writes_between_purges; //!< upper bound on amount of bytes written between two purge passes
       int               size;         //!< current size of write queue
+      int               size_max;     //!< largest size of write queue since last call to WriteQueueStats()
    };
 
    WriteQ m_writeQ;
@@ -389,7 +415,12 @@ private:
 
    // prefetching
    typedef std::vector<File*>  PrefetchList;
-   PrefetchList m_prefetchList;
+   PrefetchList        m_prefetchList;
+   std::vector<double> m_prefetchWeights;   //!< scratch for GetNextFileToPrefetch()
+
+   long long prefetch_RAM_limit() const { return m_configuration.m_RamAbsAvailable * 7 / 10; }
+
+   double prefetch_priority(File *f, std::chrono::steady_clock::time_point now);
 };
 
 }
@@ -0,0 +1,161 @@
+#ifndef __XRDPFC_BITMAP_HH__
+#define __XRDPFC_BITMAP_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstring>
+
+namespace XrdPfc
+{
+
+//------------------------------------------------------------------------------
+//! Word-at-a-time operations on the block state bit vectors of Info.
+//!
+//! The vectors are byte arrays as stored in cinfo files: block i is bit i%8 of
+//! byte i/8. They are processed as little-endian 64-bit words so that bit i of
+//! word w is block 64*w + i on any host. All ranges are half-open [first, last)
+//! and only the bytes needed to cover bit last-1 are ever accessed, so the
+//! buffers do not need any padding.
+//------------------------------------------------------------------------------
+
+namespace Bitmap
+{
+   //! Load word w, zero-filling bytes at or beyond nbytes.
+   inline uint64_t LoadWord(const unsigned char *b, int w, int nbytes)
+   {
+      uint64_t v = 0;
+      const int off = w * 8;
+      memcpy(&v, b + off, nbytes - off >= 8 ? 8 : nbytes - off);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      v = __builtin_bswap64(v);
+#endif
+      return v;
+   }
+
+   //! Store word w, writing only bytes below nbytes.
+   inline void StoreWord(unsigned char *b, int w, int nbytes, uint64_t v)
+   {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      v = __builtin_bswap64(v);
+#endif
+      const int off = w * 8;
+      memcpy(b + off, &v, nbytes - off >= 8 ? 8 : nbytes - off);
+   }
+
+   //! Mask of the bits of word w that fall into [first, last).
+   inline uint64_t RangeMask(int w, int first, int last)
+   {
+      uint64_t m = ~0ull;
+      if (w == first / 64) m &= ~0ull << (first % 64);
+      if (w == (last - 1) / 64) m &= ~0ull >> (63 - (last - 1) % 64);
+      return m;
+   }
+
+   //! Number of set bits in [first, last).
+   inline int CountSet(const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return 0;
+      const int nbytes = (last + 7) / 8;
+      int cnt = 0;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+         cnt += __builtin_popcountll(LoadWord(b, w, nbytes) & RangeMask(w, first, last));
+      return cnt;
+   }
+
+   //! Number of bits set in a and clear in b in [first, last).
+   inline int CountAndNot(const unsigned char *a, const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return 0;
+      const int nbytes = (last + 7) / 8;
+      int cnt = 0;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+         cnt += __builtin_popcountll(LoadWord(a, w, nbytes) & ~LoadWord(b, w, nbytes) & RangeMask(w, first, last));
+      return cnt;
+   }
+
+   //! dst = a & ~b for bits in [first, last), bits of dst outside the range are kept.
+   inline void AndNot(unsigned char *dst, const unsigned char *a, const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return;
+      const int nbytes = (last + 7) / 8;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+      {
+         const uint64_t m = RangeMask(w, first, last);
+         const uint64_t v = LoadWord(a, w, nbytes) & ~LoadWord(b, w, nbytes);
+         StoreWord(dst, w, nbytes, (LoadWord(dst, w, nbytes) & ~m) | (v & m));
+      }
+   }
+
+   //! Index of the first set bit in [first, last), -1 if none.
+   inline int FindFirstSet(const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return -1;
+      const int nbytes = (last + 7) / 8;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+      {
+         const uint64_t v = LoadWord(b, w, nbytes) & RangeMask(w, first, last);
+         if (v) return w * 64 + __builtin_ctzll(v);
+      }
+      return -1;
+   }
+
+   //! Index of the first clear bit in [first, last), -1 if none.
+   inline int FindFirstClear(const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return -1;
+      const int nbytes = (last + 7) / 8;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+      {
+         const uint64_t v = ~LoadWord(b, w, nbytes) & RangeMask(w, first, last);
+         if (v) return w * 64 + __builtin_ctzll(v);
+      }
+      return -1;
+   }
+
+   //! Index of the last set bit in [first, last), -1 if none.
+   inline int FindLastSet(const unsigned char *b, int first, int last)
+   {
+      if (first >= last) return -1;
+      const int nbytes = (last + 7) / 8;
+      for (int w = (last - 1) / 64; w >= first / 64; --w)
+      {
+         const uint64_t v = LoadWord(b, w, nbytes) & RangeMask(w, first, last);
+         if (v) return w * 64 + 63 - __builtin_clzll(v);
+      }
+      return -1;
+   }
+
+   //! True if all bits in [first, last) are set; an empty range is all set.
+   inline bool TestRangeSet(const unsigned char *b, int first, int last)
+   {
+      return FindFirstClear(b, first, last) < 0;
+   }
+
+   //! Set all bits in [first, last).
+   inline void SetRange(unsigned char *b, int first, int last)
+   {
+      if (first >= last) return;
+      const int nbytes = (last + 7) / 8;
+      for (int w = first / 64; w <= (last - 1) / 64; ++w)
+         StoreWord(b, w, nbytes, LoadWord(b, w, nbytes) | RangeMask(w, first, last));
+   }
+}
+
+}
+
+#endif
@@ -54,6 +54,7 @@ Configuration::Configuration() :
    m_wqueue_blocks(16),
    m_wqueue_threads(4),
    m_prefetch_max_blocks(10),
+   m_prefetch_threads(1),
    m_hdfsbsize(128*1024*1024),
    m_flushCnt(2000),
    m_cs_UVKeep(-1),
@@ -701,7 +702,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
       loff = snprintf(buff, sizeof(buff), "Config effective %s pfc configuration:\n"
                       "       pfc.cschk %s uvkeep %s\n"
                       "       pfc.blocksize %lldk\n"
-                      "       pfc.prefetch %d\n"
+                      "       pfc.prefetch %d threads %d\n"
                       "       pfc.urlcgi blocksize %s prefetch %s\n"
                       "       pfc.ram %.fg\n"
                       "       pfc.writequeue %d %d\n"
@@ -716,7 +717,7 @@ bool Cache::Config(const char *config_filename, const char *parameters, XrdOucEn
                       config_filename,
                       csc[int(m_configuration.m_cs_Chk)], uvk,
                       m_configuration.m_bufferSize >> 10,
-                      m_configuration.m_prefetch_max_blocks,
+                      m_configuration.m_prefetch_max_blocks, m_configuration.m_prefetch_threads,
                       urlcgi_blks, urlcgi_npref,
                       ram_gb,
                       m_configuration.m_wqueue_blocks, m_configuration.m_wqueue_threads,
@@ -1016,9 +1017,24 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          m_log.Emsg("Config", "pfc.nramprefetch is deprecated, please use pfc.prefetch instead. Replacing the directive internally.");
       }
 
+      //  pfc.prefetch <max-blocks> [threads <n>]
       if ( ! prefetch_str2value("Config", cwg.GetWord(), CFG.m_prefetch_max_blocks,
                                 0, CFG.s_max_prefetch_max_blocks))
          return false;
+
+      const char *p = cwg.GetWord();
+      if (p && cwg.HasLast())
+      {
+         if (strcmp(p, "threads") != 0)
+         {
+            m_log.Emsg("Config", "Error: pfc.prefetch unknown option '", p, "'");
+            return false;
+         }
+         if (XrdOuca2x::a2i(m_log, "Error getting pfc.prefetch threads", cwg.GetWord(), &CFG.m_prefetch_threads, 1, 64))
+         {
+            return false;
+         }
+      }
    }
    else if ( part == "urlcgi" )
    {
@@ -32,7 +32,7 @@
 namespace XrdPfc
 {
 PFC_DEFINE_TYPE_NON_INTRUSIVE(DirStats,
-   m_NumIos, m_Duration, m_BytesHit, m_BytesMissed, m_BytesBypassed, m_BytesWritten, m_StBlocksAdded, m_NCksumErrors,
+   m_NumIos, m_Duration, m_BytesHit, m_BytesMissed, m_BytesBypassed, m_BytesWritten, m_StBlocksAdded, m_NCksumErrors, m_NDiskWrites, m_NBlksCoalesced, m_WriteQueueMax,
    m_StBlocksRemoved, m_NFilesOpened, m_NFilesClosed, m_NFilesCreated, m_NFilesRemoved, m_NDirectoriesCreated, m_NDirectoriesRemoved)
 PFC_DEFINE_TYPE_NON_INTRUSIVE(DirUsage,
     m_LastOpenTime, m_LastCloseTime, m_StBlocks, m_NFilesOpen, m_NFiles, m_NDirectories)
@@ -33,6 +33,7 @@
 #include "XrdCl/XrdClURL.hh"
 #include "XrdCl/XrdClFileStateHandler.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <sstream>
@@ -588,6 +589,7 @@ bool File::Open(XrdOucCacheIO *inputIO)
    m_state_cond.Lock();
    m_block_size = m_cfi.GetBufferSize();
    m_num_blocks = m_cfi.GetNBlocks();
+   m_missing_blocks = m_cfi.GetNMissingBlocks();
    m_prefetch_state = (m_cfi.IsComplete()) ? kComplete : kStopped; // Will engage in AddIO().
    m_prefetch_max_blocks_in_flight = pfc_prefetch;
    if (pfc_prefetch != conf.m_prefetch_max_blocks)
@@ -938,6 +940,8 @@ int File::ReadOpusCoalescere(IO *io, const XrdOucIOVec *readV, int readVnum,
       int         iUserSize = iov.size;
       char       *iUserBuff = iov.data;
 
+      m_client_read_bytes.fetch_add(iUserSize, std::memory_order_relaxed);
+
       const int idx_first = iUserOff / m_block_size;
       const int idx_last  = (iUserOff + iUserSize - 1) / m_block_size;
 
@@ -1174,6 +1178,65 @@ void File::WriteBlockToDisk(Block* b)
    else
       retval = m_data_file->Write(b->get_buff(), offset, size);
 
+   ProcessBlockWritten(b, retval, false);
+}
+
+//------------------------------------------------------------------------------
+
+void File::WriteBlocksToDisk(std::vector<Block*>& blocks)
+{
+   // Only one writer thread works on a file at a time so the blocks can be
+   // sorted and adjacent ones written out with a single vectored write.
+   // Checksummed caches need page writes and are done block by block.
+   // Note that this object may be deleted once the last block is processed.
+
+   if (m_cfi.IsCkSumCache() || blocks.size() < 2)
+   {
+      for (Block *b : blocks)
+         WriteBlockToDisk(b);
+      return;
+   }
+
+   std::sort(blocks.begin(), blocks.end(),
+             [](const Block *a, const Block *b) { return a->m_offset < b->m_offset; });
+
+   std::vector<XrdOucIOVec> iov;
+   iov.reserve(blocks.size());
+
+   const size_t n_blocks = blocks.size();
+   size_t       i = 0, k;
+   while (i < n_blocks)
+   {
+      iov.clear();
+      for (k = i; k < n_blocks; ++k)
+      {
+         if (k > i && blocks[k]->m_offset != blocks[k-1]->m_offset + blocks[k-1]->get_size())
+            break;
+         iov.push_back({ blocks[k]->m_offset - m_offset, blocks[k]->get_size(), 0, blocks[k]->get_buff() });
+      }
+
+      ssize_t retval;
+      if (iov.size() == 1)
+         retval = m_data_file->Write(iov[0].data, iov[0].offset, iov[0].size);
+      else
+         retval = m_data_file->WriteV(iov.data(), (int) iov.size());
+
+      TRACEF(Dump, "WriteBlocksToDisk() wrote " << iov.size() << " blocks at " << iov[0].offset << " ret=" << retval);
+
+      for (size_t j = i; j < k; ++j)
+      {
+         ProcessBlockWritten(blocks[j], retval < 0 ? retval : blocks[j]->get_size(), j != i);
+      }
+      i = k;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void File::ProcessBlockWritten(Block* b, ssize_t retval, bool coalesced)
+{
+   long long size = b->get_size();
+
    if (retval < size)
    {
       if (retval < 0) {
@@ -1198,7 +1261,10 @@ void File::WriteBlockToDisk(Block* b)
    {
       XrdSysCondVarHelper _lck(m_state_cond);
 
+      m_delta_stats.AddDiskWrite(coalesced);
+      m_delta_stats.AddWriteQueueDepth(b->m_wq_depth);
       m_cfi.SetBitWritten(blk_idx);
+      m_missing_blocks.store(m_cfi.GetNMissingBlocks(), std::memory_order_relaxed);
 
       if (b->m_prefetch)
       {
@@ -1289,7 +1355,7 @@ void File::Sync()
       return;
    }
 
-   int  written_while_in_sync;
+   int  written_while_in_sync, unsynced;
    bool resync = false;
    {
       XrdSysCondVarHelper _lck(&m_state_cond);
@@ -1299,6 +1365,7 @@ void File::Sync()
       }
       written_while_in_sync = m_non_flushed_cnt = (int) m_writes_during_sync.size();
       m_writes_during_sync.clear();
+      unsynced = m_cfi.GetNUnsyncedBlocks();
 
       // If there were writes during sync and the file is now complete,
       // let us call Sync again without resetting the m_in_sync flag.
@@ -1307,7 +1374,8 @@ void File::Sync()
       else
          m_in_sync = false;
    }
-   TRACEF(Dump, "Sync "<< written_while_in_sync  << " blocks written during sync." << (resync ? " File is now complete - resyncing." : ""));
+   TRACEF(Dump, "Sync "<< written_while_in_sync  << " blocks written during sync, " << unsynced << " unsynced."
+                << (resync ? " File is now complete - resyncing." : ""));
 
    if (resync)
       Sync();
@@ -1670,31 +1738,28 @@ void File::Prefetch()
       }
 
       // Select block(s) to fetch.
-      for (int f = 0; f < m_num_blocks; ++f)
+      for (int f = m_cfi.GetFirstMissingBlock(0); f >= 0; f = m_cfi.GetFirstMissingBlock(f + 1))
       {
-         if ( ! m_cfi.TestBitWritten(f))
-         {
-            int f_act = f + m_offset / m_block_size;
+         int f_act = f + m_offset / m_block_size;
 
-            BlockMap_i bi = m_block_map.find(f_act);
-            if (bi == m_block_map.end())
+         BlockMap_i bi = m_block_map.find(f_act);
+         if (bi == m_block_map.end())
+         {
+            Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
+            if (b)
             {
-               Block *b = PrepareBlockRequest(f_act, *m_current_io, nullptr, true);
-               if (b)
-               {
-                  TRACEF(Dump, "Prefetch take block " << f_act);
-                  blks.push_back(b);
-                  // Note: block ref_cnt not increased, it will be when placed into write queue.
+               TRACEF(Dump, "Prefetch take block " << f_act);
+               blks.push_back(b);
+               // Note: block ref_cnt not increased, it will be when placed into write queue.
 
-                  inc_prefetch_read_cnt(1);
-               }
-               else
-               {
-                  // This shouldn't happen as prefetching stops when RAM is 70% full.
-                  TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
-               }
-               break;
+               inc_prefetch_read_cnt(1);
+            }
+            else
+            {
+               // This shouldn't happen as prefetching stops when RAM is 70% full.
+               TRACEF(Warning, "Prefetch allocation failed for block " << f_act);
             }
+            break;
          }
       }
 
@@ -1724,6 +1789,15 @@ float File::GetPrefetchScore() const
    return m_prefetch_score;
 }
 
+void File::record_remote_latency(std::chrono::steady_clock::duration d)
+{
+   // Exponential moving average, weight 1/8. Concurrent updates may lose a sample,
+   // which is fine for a scheduling hint.
+   int us  = (int) std::min<long long>(std::chrono::duration_cast<std::chrono::microseconds>(d).count(), 60000000);
+   int old = m_remote_latency_us.load(std::memory_order_relaxed);
+   m_remote_latency_us.store(old ? old + (us - old) / 8 : us, std::memory_order_relaxed);
+}
+
 XrdSysError* File::GetLog() const
 {
    return Cache::TheOne().GetLog();
@@ -1777,6 +1851,10 @@ std::string File::GetRemoteLocations() const
 
 void BlockResponseHandler::Done(int res)
 {
+   if (res > 0)
+   {
+      m_block->m_file->record_remote_latency(std::chrono::steady_clock::now() - m_start_time);
+   }
    m_block->m_file->ProcessBlockResponse(m_block, res);
    delete this;
 }
@@ -25,6 +25,8 @@
 #include "XrdOuc/XrdOucCache.hh"
 #include "XrdOuc/XrdOucIOVec.hh"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <map>
@@ -121,6 +123,7 @@ public:
    bool                m_req_cksum_net;
    vCkSum_t            m_cksum_vec;
    int                 m_n_cksum_errors;
+   int                 m_wq_depth;      // write queue depth when the block was queued
 
    vChunkRequest_t     m_chunk_reqs;
 
@@ -129,7 +132,7 @@ public:
       m_file(f), m_io(io), m_req_id(rid),
       m_buff(buf), m_offset(off), m_size(size), m_req_size(rsize),
       m_refcnt(0), m_errno(0), m_downloaded(false), m_prefetch(m_prefetch),
-      m_req_cksum_net(cks_net), m_n_cksum_errors(0)
+      m_req_cksum_net(cks_net), m_n_cksum_errors(0), m_wq_depth(0)
    {}
 
    char*     get_buff()     const { return m_buff;     }
@@ -173,7 +176,9 @@ class BlockResponseHandler : public XrdOucCacheIOCB
 public:
    Block *m_block;
 
-   BlockResponseHandler(Block *b) : m_block(b) {}
+   std::chrono::steady_clock::time_point m_start_time; //!< when the remote request was issued
+
+   BlockResponseHandler(Block *b) : m_block(b), m_start_time(std::chrono::steady_clock::now()) {}
 
    void Done(int result) override;
 };
@@ -252,10 +257,34 @@ public:
 
    void WriteBlockToDisk(Block *b);
 
+   //----------------------------------------------------------------------
+   //! Write blocks taken from the write queue, coalescing adjacent ones.
+   //----------------------------------------------------------------------
+   void WriteBlocksToDisk(std::vector<Block*>& blocks);
+
    void Prefetch();
 
    float GetPrefetchScore() const;
 
+   //----------------------------------------------------------------------
+   //! Prefetch scheduler bookkeeping. Only accessed by Cache under its
+   //! prefetch lock, which must never be taken together with m_state_cond.
+   //----------------------------------------------------------------------
+   struct PrefetchSched
+   {
+      std::chrono::steady_clock::time_point m_sample_time; //!< time of last read-rate sample
+      long long m_read_bytes = 0;   //!< client bytes requested at last sample
+      double    m_read_rate  = 0;   //!< moving average of client read rate, bytes/s
+   };
+
+   PrefetchSched& RefPrefetchSched() { return m_prefetch_sched; }
+
+   // Demand metrics used by the prefetch scheduler, safe to read without m_state_cond.
+   long long GetClientReadBytes()   const { return m_client_read_bytes.load(std::memory_order_relaxed); }
+   int       GetRemoteLatencyUs()   const { return m_remote_latency_us.load(std::memory_order_relaxed); }
+   int       GetNMissingBlocks()    const { return m_missing_blocks.load(std::memory_order_relaxed); }
+   float     GetPrefetchHitWeight() const { return m_prefetch_hit_weight.load(std::memory_order_relaxed); }
+
    //! Log path
    const char* lPath() const;
 
@@ -374,7 +403,22 @@ private:
 
    void inc_prefetch_read_cnt(int prc) { if (prc) { m_prefetch_read_cnt += prc; calc_prefetch_score(); } }
    void inc_prefetch_hit_cnt (int phc) { if (phc) { m_prefetch_hit_cnt  += phc; calc_prefetch_score(); } }
-   void calc_prefetch_score() { m_prefetch_score = float(m_prefetch_hit_cnt) / m_prefetch_read_cnt; }
+   void calc_prefetch_score()
+   {
+      m_prefetch_score = float(m_prefetch_hit_cnt) / m_prefetch_read_cnt;
+      // Smoothed so that files with few prefetched blocks are treated neutrally.
+      m_prefetch_hit_weight.store(float(m_prefetch_hit_cnt + 1) / (m_prefetch_read_cnt + 2), std::memory_order_relaxed);
+   }
+
+   // Published for the prefetch scheduler, see GetClientReadBytes() & co.
+   std::atomic<long long> m_client_read_bytes   {0};    //!< bytes requested by clients while file is incomplete
+   std::atomic<int>       m_remote_latency_us   {0};    //!< moving average of remote block request duration
+   std::atomic<int>       m_missing_blocks      {0};    //!< blocks not yet written to disk
+   std::atomic<float>     m_prefetch_hit_weight {0.5f}; //!< smoothed fraction of prefetched blocks that were used
+
+   PrefetchSched m_prefetch_sched;
+
+   void record_remote_latency(std::chrono::steady_clock::duration d);
 
    // Helpers
 
@@ -407,6 +451,7 @@ private:
    void FinalizeReadRequest(ReadRequest *rreq);
 
    void ProcessBlockResponse(Block *b, int res);
+   void ProcessBlockWritten(Block *b, ssize_t retval, bool coalesced);
 
    // Block management
 
@@ -143,15 +143,8 @@ Info::~Info()
 
 void Info::SetAllBitsSynced()
 {
-   // The following should be:
-   //   memset(m_buff_synced, 255, GetBitvecSizeInBytes());
-   // but GCC produces an overzealous 'possible argument transpose warning' and
-   // xrootd build uses warnings->errors escalation.
-   // This workaround can be removed for gcc >= 5.
-   // See also: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61294
-   const int nb = GetBitvecSizeInBytes();
-   for (int i = 0; i < nb; ++i)
-      m_buff_synced[i] = 255;
+   // Whole bytes, including the padding bits of the last one, as before.
+   Bitmap::SetRange(m_buff_synced, 0, 8 * GetBitvecSizeInBytes());
 
    m_complete = true;
 }
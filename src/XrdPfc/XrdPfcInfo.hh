@@ -19,6 +19,7 @@
 //----------------------------------------------------------------------------------
 
 #include "XrdPfcTypes.hh"
+#include "XrdPfcBitmap.hh"
 
 #include <cstdio>
 #include <ctime>
@@ -235,6 +236,26 @@ public:
    //---------------------------------------------------------------------
    int GetNDownloadedBlocks() const;
 
+   //---------------------------------------------------------------------
+   //! Get number of blocks not yet written to disk (cached, O(1))
+   //---------------------------------------------------------------------
+   int GetNMissingBlocks() const { return m_missingBlocks; }
+
+   //---------------------------------------------------------------------
+   //! Get index of first block at or after from that is not written, -1 if none
+   //---------------------------------------------------------------------
+   int GetFirstMissingBlock(int from) const;
+
+   //---------------------------------------------------------------------
+   //! Test if all blocks in [first, last) are written to disk
+   //---------------------------------------------------------------------
+   bool TestRangeWritten(int first, int last) const;
+
+   //---------------------------------------------------------------------
+   //! Get number of blocks written to disk but not yet synced
+   //---------------------------------------------------------------------
+   int GetNUnsyncedBlocks() const;
+
    //---------------------------------------------------------------------
    //! Get number of downloaded bytes
    //---------------------------------------------------------------------
@@ -397,11 +418,23 @@ inline void Info::SetBitSynced(int i)
 
 inline int Info::GetNDownloadedBlocks() const
 {
-   int cntd = 0;
-   for (int i = 0; i < m_bitvecSizeInBits; ++i)
-      if (TestBitWritten(i)) cntd++;
+   return Bitmap::CountSet(m_buff_written, 0, m_bitvecSizeInBits);
+}
+
+inline int Info::GetFirstMissingBlock(int from) const
+{
+   return Bitmap::FindFirstClear(m_buff_written, from, m_bitvecSizeInBits);
+}
 
-   return cntd;
+inline bool Info::TestRangeWritten(int first, int last) const
+{
+   assert(last <= m_bitvecSizeInBits);
+   return Bitmap::TestRangeSet(m_buff_written, first, last);
+}
+
+inline int Info::GetNUnsyncedBlocks() const
+{
+   return Bitmap::CountAndNot(m_buff_written, m_buff_synced, 0, m_bitvecSizeInBits);
 }
 
 inline long long Info::GetNDownloadedBytes() const
@@ -411,10 +444,7 @@ inline long long Info::GetNDownloadedBytes() const
 
 inline int Info::GetLastDownloadedBlock() const
 {
-   for (int i = m_bitvecSizeInBits - 1; i >= 0; --i)
-      if (TestBitWritten(i)) return i;
-
-   return -1;
+   return Bitmap::FindLastSet(m_buff_written, 0, m_bitvecSizeInBits);
 }
 
 inline long long Info::GetExpectedDataFileSize() const
@@ -451,13 +481,8 @@ inline bool Info::IsComplete() const
 
 inline int Info::CountBlocksNotWrittenInRng(int firstIdx, int lastIdx) const
 {
-   // TODO rewrite to use full byte comparisons outside of edges ?
-   // Also, it seems to be always called with firstIdx = 0, lastIdx = m_bitvecSizeInBits.
-   int cnt = 0;
-   for (int i = firstIdx; i < lastIdx; ++i)
-      if (! TestBitWritten(i)) ++cnt;
-
-   return cnt;
+   if (firstIdx >= lastIdx) return 0;
+   return (lastIdx - firstIdx) - Bitmap::CountSet(m_buff_written, firstIdx, lastIdx);
 }
 
 inline void Info::UpdateDownloadCompleteStatus()
@@ -400,6 +400,13 @@ void ResourceMonitor::heart_beat()
       next_queue_proc_time = queue_swap_time + s_queue_proc_interval;
       TRACE(Dump, tpfx << "process_queues -- n_records=" << n_processed);
 
+      {
+         int wq_size, wq_size_max, wq_n_files;
+         Cache::GetInstance().WriteQueueStats(wq_size, wq_size_max, wq_n_files);
+         TRACE(Debug, tpfx << "write queue -- n_blocks=" << wq_size << ", max_n_blocks=" << wq_size_max
+                           << ", n_files=" << wq_n_files);
+      }
+
       // Always update basic info on m_fs_state (space, usage, file_usage).
       update_vs_and_file_usage_info();
 
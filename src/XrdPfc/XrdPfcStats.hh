@@ -19,6 +19,8 @@
 // along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
 //----------------------------------------------------------------------------------
 
+#include <algorithm>
+
 namespace XrdPfc
 {
 
@@ -42,6 +44,9 @@ public:
    long long m_BytesWritten = 0;    //!< number of bytes written to disk
    long long m_StBlocksAdded = 0;   //!< number of 512-byte blocks the file has grown by
    int       m_NCksumErrors = 0;    //!< number of checksum errors while getting data from remote
+   int       m_NDiskWrites = 0;     //!< number of disk write operations (a vectored write counts once)
+   int       m_NBlksCoalesced = 0;  //!< number of blocks written by the disk write of a preceding block
+   int       m_WriteQueueMax = 0;   //!< largest write queue depth seen when queuing a block
 
    //----------------------------------------------------------------------
 
@@ -59,7 +64,10 @@ public:
       m_BytesBypassed (a.m_BytesBypassed + b.m_BytesBypassed),
       m_BytesWritten  (a.m_BytesWritten  + b.m_BytesWritten),
       m_StBlocksAdded (a.m_StBlocksAdded + b.m_StBlocksAdded),
-      m_NCksumErrors  (a.m_NCksumErrors  + b.m_NCksumErrors)
+      m_NCksumErrors  (a.m_NCksumErrors  + b.m_NCksumErrors),
+      m_NDiskWrites   (a.m_NDiskWrites   + b.m_NDiskWrites),
+      m_NBlksCoalesced(a.m_NBlksCoalesced + b.m_NBlksCoalesced),
+      m_WriteQueueMax (std::max(a.m_WriteQueueMax, b.m_WriteQueueMax))
    {}
 
    //----------------------------------------------------------------------
@@ -82,6 +90,19 @@ public:
       m_NCksumErrors += n_cks_errs;
    }
 
+   void AddDiskWrite(bool coalesced)
+   {
+      if (coalesced)
+         ++m_NBlksCoalesced;
+      else
+         ++m_NDiskWrites;
+   }
+
+   void AddWriteQueueDepth(int depth)
+   {
+      m_WriteQueueMax = std::max(m_WriteQueueMax, depth);
+   }
+
    void IoAttach()
    {
       ++m_NumIos;
@@ -114,6 +135,9 @@ public:
       m_BytesWritten  = ref.m_BytesWritten  - m_BytesWritten;
       m_StBlocksAdded = ref.m_StBlocksAdded - m_StBlocksAdded;
       m_NCksumErrors  = ref.m_NCksumErrors  - m_NCksumErrors;
+      m_NDiskWrites   = ref.m_NDiskWrites   - m_NDiskWrites;
+      m_NBlksCoalesced= ref.m_NBlksCoalesced- m_NBlksCoalesced;
+      m_WriteQueueMax = ref.m_WriteQueueMax; // a maximum has no delta
    }
 
    void AddUp(const Stats& s)
@@ -126,6 +150,9 @@ public:
       m_BytesWritten  += s.m_BytesWritten;
       m_StBlocksAdded += s.m_StBlocksAdded;
       m_NCksumErrors  += s.m_NCksumErrors;
+      m_NDiskWrites   += s.m_NDiskWrites;
+      m_NBlksCoalesced+= s.m_NBlksCoalesced;
+      m_WriteQueueMax  = std::max(m_WriteQueueMax, s.m_WriteQueueMax);
    }
 
    void Reset()
@@ -138,6 +165,9 @@ public:
       m_BytesWritten  = 0;
       m_StBlocksAdded = 0;
       m_NCksumErrors  = 0;
+      m_NDiskWrites   = 0;
+      m_NBlksCoalesced= 0;
+      m_WriteQueueMax = 0;
    }
 };
 
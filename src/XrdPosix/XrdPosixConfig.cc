@@ -232,6 +232,9 @@ bool XrdPosixConfig::initCCM(XrdOucPsx &parms)
 // optsf=<val> - optimize structured file: 1 = all, 0 = off, .<sfx> specific
 // optwr=1     - cache can be written to.
 // pagesz=n    - individual byte size of a page (can be suffized in k, m, g).
+// policy=p    - page replacement policy: lru (default) or 2q.
+// stream=n    - sequential bytes after which reads are treated as streaming
+//               and bypass the cache (can be suffized in k, m, g; 0 is off).
 //
 
 void XrdPosixConfig::initEnv(char *eData)
@@ -257,6 +260,10 @@ void XrdPosixConfig::initEnv(char *eData)
                                           myParms.minPages = Val;
                                          }
    initEnv(theEnv, "pagesz",    Val); if (Val >= 0) myParms.PageSize  = Val;
+   initEnv(theEnv, "stream",    Val); if (Val >= 0)
+                                         {if (Val > 0x7fffffff) Val = 0x7fffffff;
+                                          myParms.Stream = Val;
+                                         }
 
 // Get Debug setting
 //
@@ -273,6 +280,14 @@ void XrdPosixConfig::initEnv(char *eData)
                                     <<"' is invalid.");
       }
 
+// Get the replacement policy
+//
+   if ((tP = theEnv.Get("policy")))
+      {     if (!strcmp(tP, "lru")) myParms.Policy = XrdRmc::polLRU;
+       else if (!strcmp(tP, "2q"))  myParms.Policy = XrdRmc::pol2Q;
+       else DMSG("initEnv", "'XRDPOSIX_CACHE=policy=" <<tP <<"' is invalid.");
+      }
+
 // Get the structured file option
 //
    if ((tP = theEnv.Get("optsf")) && *tP && *tP != '0')
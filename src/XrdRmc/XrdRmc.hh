@@ -87,6 +87,21 @@
            marked for single use only. This means that the moment data is
            delivered from the page, the page is recycled.
     15. Invalid options silently force the use of the default.
+    16. The cache pages are spread over up to 16 independently locked shards
+        by page address so that concurrent readers rarely contend. Each
+        shard replaces its pages using the selected Policy:
+        - polLRU replaces the least recently used page (the default). A
+          single pass over a large file can displace every other page.
+        - pol2Q  admits new pages into a cold FIFO queue limited to a
+          quarter of the shard and remembers the addresses of pages evicted
+          from it. Only a page that is faulted in again while remembered
+          enters the hot LRU queue. Scans therefore cycle through the cold
+          queue and leave the working set in the hot queue untouched.
+    17. When Stream is positive, a file whose reads have been sequential for
+        more than Stream bytes is treated as streaming. Streaming reads of
+        at least PageSize bytes bypass the cache and shorter ones recycle
+        the pages they fault in as soon as they have been consumed. Pages
+        that were already in the cache are used and kept as usual.
 */
 
 class XrdRmc
@@ -104,14 +119,21 @@ struct Parms
        int       MaxFiles;  //!< Maximum number of files    (default 256 or 8K)
        int       Options;   //!< Options as defined below   (default r/o cache)
        short     minPages;  //!< Minimum number of pages    (default 256)
-       short     Reserve1;  //!< Reserved for future use
-       int       Reserve2;  //!< Reserved for future use
+       short     Policy;    //!< Replacement policy         (default polLRU)
+       int       Stream;    //!< Sequential bytes to stream (default 0 -> off)
 
                  Parms() : CacheSize(104857600), PageSize(32768),
                            Max2Cache(0), MaxFiles(0), Options(0),
-                           minPages(0), Reserve1(0),  Reserve2(0) {}
+                           minPages(0), Policy(polLRU), Stream(0) {}
       };
 
+// Valid policy values in Parms::Policy
+//
+static const int
+polLRU       = 0;      //!< Replace the least recently used page
+static const int
+pol2Q        = 1;      //!< Replace pages using the scan resistant 2Q policy
+
 // Valid option values in Parms::Options
 //
 static const int
@@ -55,8 +55,15 @@ XrdRmcData::XrdRmcData(XrdRmcReal *cP, XrdOucCacheIO *ioP,
    OffMask  = Cache->OffMask;
    SegSize  = Cache->SegSize;
    maxCache = Cache->maxCache;
+   stMin    = Cache->strMin;
    Debug    = Cache->Dbg;
 
+// Initialize the streaming area
+//
+   stNext   = 0;
+   stRun    = 0;
+   isSeq    = 0;
+
 // Initialize the pre-read area
 //
    memset(prRR,  -1, sizeof(prRR) );
@@ -340,7 +347,7 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
    XrdOucCacheStats Now;
    char *cBuff, *Dest = Buff;
    long long segOff, segNum = (Offs >> SegShft);
-   int noIO, rAmt, rGot, doPR = prAuto, rLeft = rLen;
+   int noIO, rAmt, rGot, doPR = prAuto, rLeft = rLen, sFlags;
 
 // Verify read length and offset
 //
@@ -358,9 +365,25 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
        return 0;
       }
 
-// Ignore caching it if it's too large. Use alternate read algorithm.
+// Track how long the reads have been sequential. This is advisory so we don't
+// need to obtain any locks to do this.
+//
+   if (stMin)
+      {if (Offs == stNext) stRun += rLen;
+          else stRun = rLen;
+       stNext = Offs + rLen;
+       if (isSeq != (stRun > stMin))
+          {isSeq = !isSeq;
+           if (Debug) std::cerr <<"Rdr: streaming " <<(isSeq ? "on " : "off ")
+                                <<ioObj->Path() <<std::endl;
+          }
+      }
+
+// Ignore caching it if it's too large or streams whole pages. Use alternate
+// read algorithm.
 //
-   if (rLen > maxCache) return Read(Now, Buff, Offs, rLen);
+   if (rLen > maxCache || (isSeq && rLen >= SegSize))
+      return Read(Now, Buff, Offs, rLen);
 
 // We check now whether or not we will try to do a preread later. This is
 // advisory at this point so we don't need to obtain any locks to do this.
@@ -385,7 +408,8 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
    rAmt   = SegSize - segOff;
    if (rAmt > rLen) rAmt = rLen;
 
-// Now fault the pages in
+// Now fault the pages in. When streaming, pages we brought in are not kept:
+// they are recycled once consumed and marked single use until then.
 //
    while((cBuff = Cache->Get(ioObj, segNum, rGot, noIO)))
         {if (rGot <= segOff + rAmt) rAmt = (rGot <= segOff ? 0 : rGot-segOff);
@@ -394,7 +418,10 @@ int XrdRmcData::Read(char *Buff, long long Offs, int rLen)
                    }
          if (noIO) {Now.X.Hits++; if (noIO < 0) Now.X.HitsPR++;}
             else   {Now.X.Miss++; Now.X.BytesRead  += rAmt;}
-         if (!(Cache->Ref(cBuff, (isFIS ? rAmt : 0)))) {doPR = 0; break;}
+         if (!isSeq || noIO > 0) sFlags = 0;
+            else sFlags = (segOff + rAmt >= SegSize ? XrdRmcSlot::isDone
+                                                    : XrdRmcSlot::isSUSE);
+         if (!(Cache->Ref(cBuff, (isFIS ? rAmt : 0), sFlags))) {doPR = 0; break;}
          segNum++; segOff = 0;
          if ((rLeft -= rAmt) <= 0) break;
          rAmt = (rLeft <= SegSize ? rLeft : SegSize);
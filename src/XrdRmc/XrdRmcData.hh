@@ -113,13 +113,20 @@ long long        SegSize;
 long long        OffMask;
 long long        SegShft;
 int              maxCache;
+int              stMin;          // Sequential bytes that make us streaming
 char             isFIS;
 char             isRW;
+char             isSeq;          // Reads are streaming
 char             Debug;
 
 static const int okRW   = 1;
 static const int xqRW   = 2;
 
+// Streaming Control Area
+//
+long long        stNext;         // Offset following the last read
+long long        stRun;          // Bytes read sequentially up to stNext
+
 // Preread Control Area
 //
 XrdRmcReal::prTask prReq;
@@ -58,6 +58,8 @@ void *XrdRmcRealPRXeq(void *parg)
 XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
                        XrdOucCacheIO::aprParms *aprP)
                 : XrdOucCache("rmc"),
+                  Shards(0), ShardNum(1), ShardMask(0), ShardSlots(1),
+                  Policy(XrdRmc::polLRU), strMin(0),
                   Slots(0), Slash(0), Base((char *)MAP_FAILED), Dbg(0), Lgs(0),
                   AZero(0), Attached(0), prFirst(0), prLast(0),
                   prReady(0), prStop(0), prNum(0)
@@ -99,6 +101,18 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
       else maxCache = ParmV.Max2Cache/SegSize*SegSize;
    SegFull = (Options & XrdRmc::isServer ? XrdRmcSlot::lenMask : SegSize);
 
+// Establish the replacement policy and the streaming threshold
+//
+   if (ParmV.Policy == XrdRmc::pol2Q) Policy = XrdRmc::pol2Q;
+   if (ParmV.Stream > 0) strMin = ParmV.Stream;
+
+// Divide the segments amongst up to 16 shards of at least 256 segments each.
+// Segment 0 is not part of any shard as its page holds the file hash table.
+//
+   while(ShardNum < 16 && (SegCnt-1)/(ShardNum*2) >= 256) ShardNum *= 2;
+   ShardMask  = ShardNum-1;
+   if (!(ShardSlots = (SegCnt-1)/ShardNum)) ShardSlots = 1;
+
 // Allocate the cache plus the cache hash table
 //
    Bytes = static_cast<size_t>(SegSize)*SegCnt;
@@ -109,9 +123,10 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
 
 // Now allocate the actual slots. We add additional slots to map files. These
 // do not have any memory backing but serve as anchors for memory mappings.
+// Likewise, each shard gets two slots to anchor its replacement queues.
 //
-   if (!(Slots = new XrdRmcSlot[SegCnt+maxFiles])) return;
-   XrdRmcSlot::Init(Slots, SegCnt);
+   if (!(Slots = new XrdRmcSlot[SegCnt+maxFiles+ShardNum*2])) return;
+   Slots->Own.Next = Slots->Own.Prev = 0;
 
 // Set pointers to be able to keep track of CacheIO objects and map them to
 // CacheData objects. The hash table will be the first page of slot memory.
@@ -129,6 +144,32 @@ XrdRmcReal::XrdRmcReal(int &rc, XrdRmc::Parms &ParmV,
        }
    Slots[sEnd-1].HLink = 0;
 
+// Initialize the shards. All of a shard's segments start out free on its cold
+// queue. The 2Q policy limits the cold queue to a quarter of the segments and
+// remembers the addresses of the last half shard's worth of cold evictions.
+//
+   Shards = new Shard[ShardNum];
+   for (n = 0; n < ShardNum; n++)
+       {Shard &Sh = Shards[n];
+        int sFirst = 1 + n*ShardSlots;
+        int sLast  = (n == ShardMask ? SegCnt : sFirst + ShardSlots);
+        Sh.Cold = sEnd + n*2; Sh.Hot = Sh.Cold + 1;
+        XrdRmcSlot::Init(Slots, Sh.Cold, sFirst, sLast);
+        XrdRmcSlot::Init(Slots, Sh.Hot,  0, 0);
+        if (Policy != XrdRmc::pol2Q) {Sh.maxCold = sLast - sFirst; continue;}
+        if (!(Sh.maxCold = (sLast - sFirst)/4)) Sh.maxCold = 1;
+        if (!(Sh.gMax    = (sLast - sFirst)/2)) Sh.gMax    = 1;
+        Sh.Ghost = new long long[Sh.gMax];
+        Sh.gLink = new int[Sh.gMax];
+        Sh.gHash = new int[Sh.gMax];
+        memset(Sh.Ghost, -1, sizeof(long long)*Sh.gMax);
+        memset(Sh.gLink, -1, sizeof(int)*Sh.gMax);
+        memset(Sh.gHash, -1, sizeof(int)*Sh.gMax);
+       }
+   if (Dbg) std::cerr <<"Cache: " <<ShardNum <<" shards of " <<ShardSlots
+                 <<" pages; policy " <<(Policy == XrdRmc::pol2Q ? "2q" : "lru")
+                 <<"; stream " <<strMin <<std::endl;
+
 // Setup the pre-readers if pre-read is enabled
 //
    if (Options & XrdRmc::canPreRead)
@@ -176,9 +217,10 @@ XrdRmcReal::~XrdRmcReal()
        prMutex.Lock();
       }
 
-// Delete the slots
+// Delete the slots and the shards
 //
-   delete Slots; Slots = 0;
+   delete [] Slots;  Slots  = 0;
+   delete [] Shards; Shards = 0;
 
 // Unmap cache memory and associated hash table
 //
@@ -193,6 +235,21 @@ XrdRmcReal::~XrdRmcReal()
    CMutex.UnLock();
 }
 
+/******************************************************************************/
+/*                                 A d m i t                                  */
+/******************************************************************************/
+
+void XrdRmcReal::Admit(XrdRmcReal::Shard &Sh, XrdRmcSlot *sP)
+{
+// A segment that is faulted in again while its address is remembered from an
+// eviction out of the cold queue has been re-referenced across a scan. So, it
+// goes into the hot queue. Everything else starts out cold.
+//
+   if (Sh.gMax && gDel(Sh, sP->Contents))
+      {sP->Queue = XrdRmcSlot::inHot;  Sh.nHot++;}
+      else {sP->Queue = XrdRmcSlot::inCold; Sh.nCold++;}
+}
+
 /******************************************************************************/
 /*                                A t t a c h                                 */
 /******************************************************************************/
@@ -257,7 +314,9 @@ int XrdRmcReal::Detach(XrdOucCacheIO *ioP)
    if (!sNum || sNum > 1) return 0;
 
 // We will be deleting the CramData object. So, we need to recycle its slots.
+// Its segments may be in any shard so we need to lock all of them.
 //
+   LockAll();
    oP = &Slots[Fnum];
    while(oP->Own.Next != Fnum)
         {sP = &Slots[oP->Own.Next];
@@ -265,10 +324,11 @@ int XrdRmcReal::Detach(XrdOucCacheIO *ioP)
          if (sP->Contents < 0 || sP->Status.LRU.Next < 0) Faults++;
             else {sP->Hide(Slots, Slash, sP->Contents%HNum);
                   sP->Pull(Slots);
-                  sP->unRef(Slots);
+                  Drop(ShardOf(sP-Slots), sP);
                   Free++;
                  }
         }
+   UnLockAll();
 
 // Reduce attach count and check if the cache is being deleted
 //
@@ -286,6 +346,21 @@ int XrdRmcReal::Detach(XrdOucCacheIO *ioP)
    return 1;
 }
 
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+
+void XrdRmcReal::Drop(XrdRmcReal::Shard &Sh, XrdRmcSlot *sP)
+{
+// Segments to be recycled leave their queue and go to the front of the cold
+// queue where they will be the first ones to be replaced.
+//
+        if (sP->Queue == XrdRmcSlot::inCold) Sh.nCold--;
+   else if (sP->Queue == XrdRmcSlot::inHot)  Sh.nHot--;
+   sP->Queue = XrdRmcSlot::inNone;
+   sP->unRef(Slots, Sh.Cold);
+}
+
 /******************************************************************************/
 /*                                  e M s g                                   */
 /******************************************************************************/
@@ -302,16 +377,54 @@ void XrdRmcReal::eMsg(const char *Path, const char *What, long long xOff,
       }
 }
   
+/******************************************************************************/
+/*                                 E v i c t                                  */
+/******************************************************************************/
+
+int XrdRmcReal::Evict(XrdRmcReal::Shard &Sh)
+{
+   XrdRmcSlot *sP;
+   int Slot, cSlot = Slots[Sh.Cold].Status.LRU.Next,
+             hSlot = Slots[Sh.Hot ].Status.LRU.Next;
+
+// Recycled segments are at the front of the cold queue and always go first.
+// Otherwise, the oldest cold segment goes if the cold queue exceeds its share
+// and the least recently used hot segment goes if it does not. With the LRU
+// policy the hot queue is always empty and the cold queue is the LRU queue.
+//
+   if (cSlot == Sh.Cold) cSlot = 0;
+   if (hSlot == Sh.Hot)  hSlot = 0;
+   if (!cSlot || (hSlot && Slots[cSlot].Queue == XrdRmcSlot::inCold
+              &&  Sh.nCold <= Sh.maxCold)) Slot = hSlot;
+      else Slot = cSlot;
+   if (!Slot) return 0;
+
+// Take the segment off its queue. Remember the address of a cold segment that
+// was not marked for single use in case it comes back.
+//
+   sP = &Slots[Slot];
+   sP->Pull(Slots);
+   if (sP->Queue == XrdRmcSlot::inCold)
+      {Sh.nCold--;
+       if (Sh.gMax && sP->Contents >= 0 && !(sP->Count & XrdRmcSlot::isSUSE))
+          gAdd(Sh, sP->Contents);
+      } else if (sP->Queue == XrdRmcSlot::inHot) Sh.nHot--;
+   sP->Queue = XrdRmcSlot::inNone;
+   return Slot;
+}
+
 /******************************************************************************/
 /*                                   G e t                                    */
 /******************************************************************************/
   
 char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
 {
-   XrdSysMutexHelper Monitor(CMutex);
+   int segHash = lAddr%HNum;
+   Shard &Sh = Shards[segHash & ShardMask];
+   XrdSysMutexHelper Monitor(Sh.Mutex);
    XrdRmcSlot::ioQ *Waiter;
    XrdRmcSlot *sP;
-   int nUse, Fnum, Slot, segHash = lAddr%HNum;
+   int nUse, Fnum, Slot;
    char *cBuff;
 
 // See if we have this logical address in the cache. Check if the page is in
@@ -326,7 +439,7 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
            XrdRmcSlot::ioQ ioTrans(sP->Status.waitQ, &ioSem);
            sP->Status.waitQ = &ioTrans;
            if (Dbg > 1) std::cerr <<"Cache: Wait slot " <<Slot <<std::endl;
-           CMutex.UnLock(); ioSem.Wait(); CMutex.Lock();
+           Sh.Mutex.UnLock(); ioSem.Wait(); Sh.Mutex.Lock();
            if (sP->Contents != lAddr) {rAmt = -EIO; return 0;}
           } else {
             if (sP->Status.inUse < 0) sP->Status.inUse--;
@@ -343,14 +456,15 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
 // Page is not here. If no allocation wanted or we cannot obtain a free slot
 // return and indicate there is no associated cache page.
 //
-   if (!ioP || !(Slot = Slots[Slots->Status.LRU.Next].Pull(Slots)))
-      {rAmt = -ENOMEM; return 0;}
+   if (!ioP || !(Slot = Evict(Sh))) {rAmt = -ENOMEM; return 0;}
 
 // Remove ownership over this slot and remove it from the hash table
 //
    sP = &Slots[Slot];
    if (sP->Contents >= 0)
-      {if (sP->Own.Next != Slot) sP->Owner(Slots);
+      {OMutex.Lock();
+       if (sP->Own.Next != Slot) sP->Owner(Slots);
+       OMutex.UnLock();
        sP->Hide(Slots, Slash, sP->Contents%HNum);
       }
 
@@ -358,12 +472,12 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
 //
    sP->Count |= XrdRmcSlot::inTrans;
    sP->Status.waitQ = 0;
-   CMutex.UnLock();
+   Sh.Mutex.UnLock();
    cBuff = Base+(static_cast<long long>(Slot)*SegSize);
    rAmt = ioP->Read(cBuff, (lAddr & Strip) << SegShft, SegSize);
-   CMutex.Lock();
+   Sh.Mutex.Lock();
 
-// Post anybody waiting for this slot. We hold the cache lock which will give us
+// Post anybody waiting for this slot. We hold the shard lock which will give us
 // time to complete the slot definition before the waiting thread looks at it.
 //
    nUse = -1;
@@ -381,16 +495,19 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
        sP->HLink      = Slash[segHash];
        Slash[segHash] = Slot;
        Fnum = (lAddr >> Shift) + SegCnt;
+       OMutex.Lock();
        Slots[Fnum].Owner(Slots, sP);
+       OMutex.UnLock();
        sP->Count = (rAmt == SegSize ? SegFull : rAmt|XrdRmcSlot::isShort);
        sP->Status.inUse = nUse;
+       Admit(Sh, sP);
        if (Dbg > 2) std::cerr <<"Cache: Miss slot " <<Slot <<" sz "
                          <<(sP->Count & XrdRmcSlot::lenMask) <<std::endl;
       } else {
        eMsg(ioP->Path(), "reading", (lAddr & Strip) << SegShft, SegSize, rAmt);
        cBuff = 0;
        sP->Contents = -1;
-       sP->unRef(Slots);
+       Drop(Sh, sP);
       }
 
 // Return the associated buffer or zero, as per above
@@ -398,6 +515,45 @@ char *XrdRmcReal::Get(XrdOucCacheIO *ioP, long long lAddr, int &rAmt, int &noIO)
    return cBuff;
 }
 
+/******************************************************************************/
+/*                                  g A d d                                   */
+/******************************************************************************/
+
+void XrdRmcReal::gAdd(XrdRmcReal::Shard &Sh, long long lAddr)
+{
+   int gNum = Sh.gNext;
+
+// The ghosts form a ring so we replace the oldest one. If it is still in the
+// hash table we need to remove it first.
+//
+   if (Sh.Ghost[gNum] >= 0) gDel(Sh, Sh.Ghost[gNum]);
+   Sh.gNext = (gNum+1) % Sh.gMax;
+
+// Add the address to the hash table
+//
+   int &gHead = Sh.gHash[lAddr % Sh.gMax];
+   Sh.Ghost[gNum] = lAddr;
+   Sh.gLink[gNum] = gHead;
+   gHead = gNum;
+}
+
+/******************************************************************************/
+/*                                  g D e l                                   */
+/******************************************************************************/
+
+int XrdRmcReal::gDel(XrdRmcReal::Shard &Sh, long long lAddr)
+{
+   int *gP = &Sh.gHash[lAddr % Sh.gMax];
+
+// Find the ghost with this address and unchain it if we have it
+//
+   while(*gP >= 0 && Sh.Ghost[*gP] != lAddr) gP = &Sh.gLink[*gP];
+   if (*gP < 0) return 0;
+   Sh.Ghost[*gP] = -1;
+   *gP = Sh.gLink[*gP];
+   return 1;
+}
+
 /******************************************************************************/
 /*                                 i o A d d                                  */
 /******************************************************************************/
@@ -449,6 +605,36 @@ int XrdRmcReal::ioDel(XrdOucCacheIO *KeyVal, int &iNum)
    return (cnt < 0 ? 1 : cnt+1);
 }
 
+/******************************************************************************/
+/*                                  K e e p                                   */
+/******************************************************************************/
+
+void XrdRmcReal::Keep(XrdRmcReal::Shard &Sh, XrdRmcSlot *sP)
+{
+// Segments to be kept go to the back of their queue. A segment that was to be
+// recycled but has been referenced again rejoins the cold queue.
+//
+   if (sP->Queue == XrdRmcSlot::inHot) sP->reRef(Slots, Sh.Hot);
+      else {if (sP->Queue == XrdRmcSlot::inNone)
+               {sP->Queue = XrdRmcSlot::inCold; Sh.nCold++;}
+            sP->reRef(Slots, Sh.Cold);
+           }
+}
+
+/******************************************************************************/
+/*                               L o c k A l l                                */
+/******************************************************************************/
+
+void XrdRmcReal::LockAll()
+{
+   int i;
+
+// Lock all of the shards in order followed by the ownership lists
+//
+   for (i = 0; i < ShardNum; i++) Shards[i].Mutex.Lock();
+   OMutex.Lock();
+}
+
 /******************************************************************************/
 /*                               P r e R e a d                                */
 /******************************************************************************/
@@ -504,35 +690,39 @@ void XrdRmcReal::PreRead(XrdRmcReal::prTask *prReq)
   
 int XrdRmcReal::Ref(char *Addr, int rAmt, int sFlags)
 {
-    XrdRmcSlot *sP = &Slots[(Addr-Base)>>SegShft];
+    int Slot = (Addr-Base)>>SegShft;
+    XrdRmcSlot *sP = &Slots[Slot];
+    Shard &Sh = ShardOf(Slot);
     int eof = 0;
 
-// Indicate how much data was not yet referenced
+// Indicate how much data was not yet referenced. A consumed segment is marked
+// single use if others are still using it and is otherwise recycled now.
 //
-   CMutex.Lock();
+   Sh.Mutex.Lock();
    if (sP->Contents >= 0)
       {if (sP->Count < 0) eof = 1;
        sP->Status.inUse++;
        if (sP->Status.inUse < 0)
-          {if (sFlags) sP->Count |= sFlags;
-              else if (!eof && (sP->Count -= rAmt) < 0) sP->Count = 0;
+          {     if (sFlags & XrdRmcSlot::isDone) sP->Count |= XrdRmcSlot::isSUSE;
+           else if (sFlags) sP->Count |= sFlags;
+           else if (!eof && (sP->Count -= rAmt) < 0) sP->Count = 0;
           } else {
-           if (sFlags) {sP->Count |= sFlags;                 sP->reRef(Slots);}
-              else {     if (sP->Count & XrdRmcSlot::isSUSE)
-                                                             sP->unRef(Slots);
-                    else if (eof || (sP->Count -= rAmt) > 0) sP->reRef(Slots);
-                    else   {sP->Count = SegSize/2;           sP->unRef(Slots);}
-                   }
+                if (sFlags & XrdRmcSlot::isDone)                Drop(Sh, sP);
+           else if (sFlags) {sP->Count |= sFlags;               Keep(Sh, sP);}
+           else {     if (sP->Count & XrdRmcSlot::isSUSE)      Drop(Sh, sP);
+                 else if (eof || (sP->Count -= rAmt) > 0)      Keep(Sh, sP);
+                 else   {sP->Count = SegSize/2;                Drop(Sh, sP);}
+                }
           }
       } else eof = 1;
 
 // All done
 //
    if (Dbg > 2) std::cerr <<"Cache: Ref " <<std::hex <<sP->Contents <<std::dec
-                     << " slot " <<((Addr-Base)>>SegShft)
+                     << " slot " <<Slot
                      <<" sz " <<(sP->Count & XrdRmcSlot::lenMask)
                      <<" uc " <<sP->Status.inUse <<std::endl;
-   CMutex.UnLock();
+   Sh.Mutex.UnLock();
    return !eof;
 }
 
@@ -547,7 +737,9 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
    int sNum, Free = 0, Left = 0, Fnum = (lAddr >> Shift) + SegCnt;
 
 // We will be truncating CacheData pages. So, we need to recycle those slots.
+// They may be in any shard so we need to lock all of them.
 //
+   LockAll();
    oP = &Slots[Fnum]; sP = &Slots[oP->Own.Next];
    while(oP != sP)
         {sNum = sP->Own.Next;
@@ -555,11 +747,12 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
             else {sP->Owner(Slots);
                   sP->Hide(Slots, Slash, sP->Contents%HNum);
                   sP->Pull(Slots);
-                  sP->unRef(Slots);
+                  Drop(ShardOf(sP-Slots), sP);
                   Free++;
                  }
          sP = &Slots[sNum];
         }
+   UnLockAll();
 
 // Issue debugging message
 //
@@ -568,17 +761,33 @@ void XrdRmcReal::Trunc(XrdOucCacheIO *ioP, long long lAddr)
                  <<ioP->Path() <<std::endl;
 }
   
+/******************************************************************************/
+/*                             U n L o c k A l l                              */
+/******************************************************************************/
+
+void XrdRmcReal::UnLockAll()
+{
+   int i;
+
+// Unlock everything locked by LockAll()
+//
+   OMutex.UnLock();
+   for (i = ShardNum-1; i >= 0; i--) Shards[i].Mutex.UnLock();
+}
+
 /******************************************************************************/
 /*                                   U p d                                    */
 /******************************************************************************/
   
 void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
 {
-    XrdRmcSlot *sP = &Slots[(Addr-Base)>>SegShft];
+    int Slot = (Addr-Base)>>SegShft;
+    XrdRmcSlot *sP = &Slots[Slot];
+    Shard &Sh = ShardOf(Slot);
 
 // Check if we extended a short page
 //
-   CMutex.Lock();
+   Sh.Mutex.Lock();
    if (sP->Count < 0)
       {int theLen = sP->Count & XrdRmcSlot::lenMask;
        if (wLen + wOff > theLen)
@@ -588,13 +797,13 @@ void XrdRmcReal::Upd(char *Addr, int wLen, int wOff)
 // Adjust the reference counter and if no references, place on the LRU chain
 //
    sP->Status.inUse++;
-   if (sP->Status.inUse >= 0) sP->reRef(Slots);
+   if (sP->Status.inUse >= 0) Keep(Sh, sP);
 
 // All done
 //
    if (Dbg > 2) std::cerr <<"Cache: Upd " <<std::hex <<sP->Contents <<std::dec
-                     << " slot " <<((Addr-Base)>>SegShft)
+                     << " slot " <<Slot
                      <<" sz " <<(sP->Count & XrdRmcSlot::lenMask)
                      <<" uc " <<sP->Status.inUse <<std::endl;
-   CMutex.UnLock();
+   Sh.Mutex.UnLock();
 }
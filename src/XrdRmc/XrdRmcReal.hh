@@ -56,6 +56,46 @@ private:
 void      eMsg(const char *Path, const char *What, long long xOff,
                int xLen, int ec);
 int       Detach(XrdOucCacheIO *ioP);
+
+// The segment slots are divided into shards. Each shard owns a contiguous
+// range of slots, the hash buckets whose number maps to it, and the queues
+// used to select the slot to be replaced. Segment addresses are assigned to
+// a shard by their hash bucket so that a segment is only ever looked up,
+// loaded, or replaced while holding the lock of its shard.
+//
+struct Shard
+      {XrdSysMutex  Mutex;
+       long long   *Ghost;    // Addresses recently evicted from the cold queue
+       int         *gLink;    // Ghost hash chains (-1 ends a chain)
+       int         *gHash;    // Ghost hash table
+       int          gMax;     // Number of ghosts remembered (0 -> none)
+       int          gNext;    // Next ghost to replace
+       int          Cold;     // Anchor slot of the cold (or only) queue
+       int          Hot;      // Anchor slot of the hot queue
+       int          nCold;    // Segments assigned to the cold queue
+       int          nHot;     // Segments assigned to the hot queue
+       int          maxCold;  // Cold segments above which cold ones go first
+
+                    Shard() : Ghost(0), gLink(0), gHash(0), gMax(0), gNext(0),
+                              Cold(0), Hot(0), nCold(0), nHot(0), maxCold(0) {}
+                   ~Shard() {delete [] Ghost; delete [] gLink; delete [] gHash;}
+      };
+
+inline
+Shard    &ShardOf(int Slot)
+                 {int n = (Slot-1)/ShardSlots;
+                  return Shards[(n < ShardNum ? n : ShardNum-1)];
+                 }
+
+void      Admit(Shard &Sh, XrdRmcSlot *sP);
+void      Drop(Shard &Sh, XrdRmcSlot *sP);
+int       Evict(Shard &Sh);
+void      gAdd(Shard &Sh, long long lAddr);
+int       gDel(Shard &Sh, long long lAddr);
+void      Keep(Shard &Sh, XrdRmcSlot *sP);
+void      LockAll();
+void      UnLockAll();
+
 char     *Get(XrdOucCacheIO *ioP, long long lAddr, int &rGot, int &bIO);
 
 int       ioAdd(XrdOucCacheIO *KeyVal, int &iNum);
@@ -85,7 +125,14 @@ static const long long MaxFO = 0x000007ffffffffffLL;  // Min 4K page -> 8TB-1
 
 XrdOucCacheIO::aprParms aprDefault; // Default automatic preread
 
-XrdSysMutex      CMutex;
+XrdSysMutex      CMutex;      // Serializes the attached file table
+XrdSysMutex      OMutex;      // Serializes the segment ownership lists
+Shard           *Shards;      // Segment slot shards
+int              ShardNum;    // Number of shards (a power of two)
+int              ShardMask;   // ShardNum - 1
+int              ShardSlots;  // Segment slots per shard (last one may have more)
+int              Policy;      // Replacement policy
+int              strMin;      // Sequential bytes that make a file streaming
 XrdRmcSlot     *Slots;       // 1-to-1 slot to memory map
 int             *Slash;       // Slot hash table
 char            *Base;        // Base of memory cache
@@ -60,14 +60,15 @@ inline void       Hide(XrdRmcSlot *Base, int *hTab, int hI)
                        Count = 0; Contents = -1;
                       }
 
-static void       Init(XrdRmcSlot *Base, int Num)
+static void       Init(XrdRmcSlot *Base, int Anchor, int First, int Last)
                      {int i;
-                      Base->Status.LRU.Next = Base->Status.LRU.Prev = 0;
-                      Base->Own.Next        = Base->Own.Prev = 0;
-                      for (i = 1; i < Num; i++)
+                      Base[Anchor].Status.LRU.Next = Anchor;
+                      Base[Anchor].Status.LRU.Prev = Anchor;
+                      Base[Anchor].Own.Next = Base[Anchor].Own.Prev = Anchor;
+                      for (i = First; i < Last; i++)
                           {Base[i].Status.LRU.Next = Base[i].Status.LRU.Prev = i;
                            Base[i].Own.Next = Base[i].Own.Prev = i;
-                           Base->Push(Base, &Base[i]);
+                           Base[Anchor].Push(Base, &Base[i]);
                           }
                      }
 
@@ -99,18 +100,18 @@ inline void       Owner(XrdRmcSlot *Base, XrdRmcSlot *sP)
                        Base[Own.Prev].Own.Next = UrNum; Own.Prev = UrNum;
                       }
 
-inline void       reRef(XrdRmcSlot *Base)
-                      {      Status.LRU.Prev           = Base->Status.LRU.Prev;
+inline void       reRef(XrdRmcSlot *Base, int Anchor=0)
+                      {      Status.LRU.Prev           = Base[Anchor].Status.LRU.Prev;
                        Base[ Status.LRU.Prev].Status.LRU.Next = this-Base;
-                       Base->Status.LRU.Prev           = this-Base;
-                             Status.LRU.Next           = 0;
+                       Base[Anchor].Status.LRU.Prev    = this-Base;
+                             Status.LRU.Next           = Anchor;
                       }
 
-inline void       unRef(XrdRmcSlot *Base)
-                      {      Status.LRU.Next           = Base->Status.LRU.Next;
+inline void       unRef(XrdRmcSlot *Base, int Anchor=0)
+                      {      Status.LRU.Next           = Base[Anchor].Status.LRU.Next;
                        Base [Status.LRU.Next].Status.LRU.Prev = this-Base;
-                       Base->Status.LRU.Next           = this-Base;
-                             Status.LRU.Prev           = 0;
+                       Base[Anchor].Status.LRU.Next    = this-Base;
+                             Status.LRU.Prev           = Anchor;
                       }
 
 struct SlotList
@@ -140,14 +141,20 @@ SlotState               Status;
 SlotList                Own;
 int                     HLink;
 int                     Count;
+char                    Queue;        // Replacement queue holding the segment
 
 static const int  lenMask = 0x01ffffff; // Mask to get true value in Count
 static const int  isShort = 0x80000000; // Short page, Count & lenMask == size
 static const int  inTrans = 0x40000000; // Segment is in transit
 static const int  isSUSE  = 0x20000000; // Segment is single use
 static const int  isNew   = 0x10000000; // Segment is new (not yet referenced)
+static const int  isDone  = 0x08000000; // Segment was consumed (Ref() only)
 
-                  XrdRmcSlot() : Contents(-1), HLink(0), Count(0) {}
+static const char inNone  = 0;          // Segment is free or to be recycled
+static const char inCold  = 1;          // Segment is in the cold (or LRU) queue
+static const char inHot   = 2;          // Segment is in the hot queue
+
+                  XrdRmcSlot() : Contents(-1), HLink(0), Count(0), Queue(inNone) {}
 
                  ~XrdRmcSlot() {}
 };
@@ -9,7 +9,6 @@
 #include "XrdTls/XrdTlsContext.hh"
 #include "XrdVersion.hh"
 
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -25,6 +24,7 @@
 #include "picojson.h"
 
 #include "scitokens/scitokens.h"
+#include "XrdSciTokens/XrdSciTokensCache.hh"
 #include "XrdSciTokens/XrdSciTokensHelper.hh"
 #include "XrdSciTokens/XrdSciTokensMon.hh"
 
@@ -466,6 +466,7 @@ XrdSciTokensHelper *SciTokensHelper = nullptr;
 class XrdAccSciTokens : public XrdAccAuthorize, public XrdSciTokensHelper,
                         public XrdSciTokensMon
 {
+    typedef XrdSciTokensCache<XrdAccRules> TokenCache;
 
     enum class AuthzBehavior {
         PASSTHROUGH,
@@ -521,17 +522,14 @@ public:
         std::shared_ptr<XrdAccRules> access_rules;
         uint64_t now = monotonic_time();
         Check(now);
-        {
-            std::lock_guard<std::mutex> guard(m_mutex);
-            const auto iter = m_map.find(authz);
-            if (iter != m_map.end() && !iter->second->expired()) {
-                access_rules = iter->second;
-            }
+        auto cache_entry = m_cache.get(authz, now);
+        if (cache_entry) {
+            access_rules = cache_entry->rules();
         }
         if (!access_rules) {
             m_log.Log(LogMask::Debug, "Access", "Token not found in recent cache; parsing.");
+            uint64_t cache_expiry = 0;
             try {
-                uint64_t cache_expiry;
                 AccessRulesRaw rules;
                 std::string username;
                 std::string token_subject;
@@ -553,8 +551,7 @@ public:
                 m_log.Log(LogMask::Warning, "Access", "Error generating ACLs for authorization", exc.what());
                 return OnMissing(Entity, path, oper, env);
             }
-            std::lock_guard<std::mutex> guard(m_mutex);
-            m_map[authz] = access_rules;
+            cache_entry = m_cache.put(authz, access_rules, now + cache_expiry);
         } else if (m_log.getMsgMask() & LogMask::Debug) {
             m_log.Log(LogMask::Debug, "Access", "Cached token", access_rules->str().c_str());
         }
@@ -595,13 +592,18 @@ public:
             group_success = true;
         }
 
-        std::string username;
-        bool mapping_success = false;
-        bool scope_success = false;
-        username = access_rules->get_username(path);
+        // The username and scope check only depend on the token and the request;
+        // a job usually repeats the same requests so remember their outcome.
+        TokenCache::Decision decision;
+        if (!cache_entry->recall(oper, path, decision)) {
+            decision.username = access_rules->get_username(path);
+            decision.scope_success = (access_rules->get_authz_strategy() & IssuerAuthz::Capability) && access_rules->apply(oper, path);
+            cache_entry->remember(oper, path, decision);
+        }
 
-        mapping_success = (access_rules->get_authz_strategy() & IssuerAuthz::Mapping) && !username.empty();
-        scope_success = (access_rules->get_authz_strategy() & IssuerAuthz::Capability) && access_rules->apply(oper, path);
+        std::string username = decision.username;
+        bool mapping_success = (access_rules->get_authz_strategy() & IssuerAuthz::Mapping) && !username.empty();
+        bool scope_success = decision.scope_success;
         if (scope_success && (m_log.getMsgMask() & LogMask::Debug)) {
             std::stringstream ss;
             ss << "Grant authorization based on scopes for operation=" << OpToName(oper) << ", path=" << path;
@@ -1182,6 +1184,8 @@ private:
         }
         std::vector<std::string> audiences;
         std::unordered_map<std::string, IssuerConfig> issuers;
+        long cache_tokens = m_default_cache_tokens;
+        long cache_decisions = m_default_cache_decisions;
         for (const auto &section : reader.Sections()) {
             std::string section_lower;
             std::transform(section.begin(), section.end(), std::back_inserter(section_lower),
@@ -1232,6 +1236,16 @@ private:
                     m_log.Log(LogMask::Error, "Reconfig", "Unknown value for onmissing key:", onmissing.c_str());
                     return false;
                 }
+                cache_tokens = reader.GetInteger(section, "cache_tokens", m_default_cache_tokens);
+                if (cache_tokens <= 0) {
+                    m_log.Log(LogMask::Error, "Reconfig", "cache_tokens must be a positive number.");
+                    return false;
+                }
+                cache_decisions = reader.GetInteger(section, "cache_decisions", m_default_cache_decisions);
+                if (cache_decisions < 0) {
+                    m_log.Log(LogMask::Error, "Reconfig", "cache_decisions must not be negative.");
+                    return false;
+                }
             }
 
             if (section_lower.substr(0, 7) != "issuer ") {continue;}
@@ -1332,6 +1346,7 @@ private:
                 m_valid_issuers_array[idx++] = issuer.first.c_str();
             }
             m_valid_issuers_array[idx] = nullptr;
+            m_cache.configure(cache_tokens, cache_decisions);
         } catch (...) {
             pthread_rwlock_unlock(&m_config_lock);
             return false;
@@ -1344,16 +1359,17 @@ private:
     {
         if (now <= m_next_clean) {return;}
         std::lock_guard<std::mutex> guard(m_mutex);
+        if (now <= m_next_clean) {return;}
 
-        for (auto iter = m_map.begin(); iter != m_map.end(); ) {
-            if (iter->second->expired()) {
-                iter = m_map.erase(iter);
-            } else {
-                ++iter;
-            }
-        }
+        m_cache.purge(now);
         Reconfig();
 
+        if (m_log.getMsgMask() & LogMask::Info) {
+            char buff[256];
+            Mon_CacheStats(buff, sizeof(buff), m_cache.stats());
+            m_log.Log(LogMask::Info, "Check", "Token cache statistics:", buff);
+        }
+
         m_next_clean = monotonic_time() + m_expiry_secs;
     }
 
@@ -1362,7 +1378,7 @@ private:
     pthread_rwlock_t m_config_lock;
     std::vector<std::string> m_audiences;
     std::vector<const char *> m_audiences_array;
-    std::map<std::string, std::shared_ptr<XrdAccRules>> m_map;
+    TokenCache m_cache;
     XrdAccAuthorize* m_chain;
     const std::string m_parms;
     std::vector<const char*> m_valid_issuers_array;
@@ -1373,6 +1389,8 @@ private:
     std::string m_cfg_file;
 
     static constexpr uint64_t m_expiry_secs = 60;
+    static constexpr long m_default_cache_tokens = 10000;
+    static constexpr long m_default_cache_decisions = 16;
 };
 
 void InitAccSciTokens(XrdSysLogger *lp, const char *cfn, const char *parm,
@@ -0,0 +1,234 @@
+#ifndef __XrdSciTokensCache_hh__
+#define __XrdSciTokensCache_hh__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d S c i T o k e n s C a c h e . h h                   */
+/*                                                                            */
+/******************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "XrdAcc/XrdAccAuthorize.hh"
+#include "XrdSciTokens/XrdSciTokensMon.hh"
+
+// The token cache holds the rules parsed from recently seen bearer tokens.
+// Tokens are spread by hash over independently locked shards, each of which
+// keeps its entries in least recently used order and evicts the oldest ones
+// once it holds more than its share of the configured number of tokens.
+// The token itself is kept with its entry so that two tokens that happen to
+// have the same hash can never share rules.
+//
+// Each entry also remembers the outcome of the last few (operation, path)
+// requests evaluated against its rules so that a job hammering the same
+// files does not re-evaluate them on every access.
+//
+template<class Rules>
+class XrdSciTokensCache
+{
+    struct Shard;
+
+public:
+
+    // The outcome of evaluating a token's rules for one request.
+    struct Decision {
+        bool        scope_success{false};
+        std::string username;
+    };
+
+    class Entry
+    {
+    public:
+        const std::shared_ptr<Rules> &rules() const {return m_rules;}
+
+        // Fill in the decision remembered for the request, if any.
+        bool recall(Access_Operation oper, const char *path, Decision &decision)
+        {
+            std::lock_guard<std::mutex> guard(m_memo_mutex);
+            for (const auto &memo : m_memo) {
+                if (memo.oper == oper && memo.path == path) {
+                    decision = memo.decision;
+                    m_shard->memo_hits.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            m_shard->memo_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Remember a decision, replacing the oldest one when the memo is full.
+        void remember(Access_Operation oper, const char *path, const Decision &decision)
+        {
+            if (!m_memo_size) {return;}
+            std::lock_guard<std::mutex> guard(m_memo_mutex);
+            if (m_memo.size() < m_memo_size) {
+                m_memo.push_back({oper, path, decision});
+            } else {
+                m_memo[m_memo_next] = {oper, path, decision};
+                m_memo_next = (m_memo_next + 1) % m_memo_size;
+            }
+        }
+
+        Entry(const std::string &token, uint64_t hash, std::shared_ptr<Rules> rules,
+              uint64_t expiry, size_t memo_size, Shard *shard) :
+            m_token(token),
+            m_hash(hash),
+            m_rules(std::move(rules)),
+            m_expiry(expiry),
+            m_memo_size(memo_size),
+            m_shard(shard)
+        {}
+
+    private:
+        friend class XrdSciTokensCache;
+
+        struct Memo {
+            Access_Operation oper;
+            std::string      path;
+            Decision         decision;
+        };
+
+        const std::string            m_token;
+        const uint64_t               m_hash;
+        const std::shared_ptr<Rules> m_rules;
+        const uint64_t               m_expiry;
+        std::mutex                   m_memo_mutex;
+        std::vector<Memo>            m_memo;
+        size_t                       m_memo_next{0};
+        const size_t                 m_memo_size;
+        Shard                       *m_shard;
+    };
+
+    // Return the live entry for a token or null if there is none.
+    std::shared_ptr<Entry> get(const std::string &token, uint64_t now)
+    {
+        uint64_t hash = std::hash<std::string>()(token);
+        Shard &shard = shard_of(hash);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+
+        auto iter = shard.index.find(hash);
+        if (iter == shard.index.end() || (*iter->second)->m_token != token) {
+            shard.misses++;
+            return nullptr;
+        }
+        if (now > (*iter->second)->m_expiry) {
+            shard.lru.erase(iter->second);
+            shard.index.erase(iter);
+            shard.expirations++;
+            shard.misses++;
+            return nullptr;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second);
+        shard.hits++;
+        return shard.lru.front();
+    }
+
+    // Add the rules of a token valid until expiry and return the new entry.
+    std::shared_ptr<Entry> put(const std::string &token, std::shared_ptr<Rules> rules,
+                               uint64_t expiry)
+    {
+        uint64_t hash = std::hash<std::string>()(token);
+        Shard &shard = shard_of(hash);
+        auto entry = std::make_shared<Entry>(token, hash, std::move(rules), expiry,
+                                             m_memo_size.load(std::memory_order_relaxed),
+                                             &shard);
+        size_t limit = m_shard_size.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> guard(shard.mutex);
+
+        auto iter = shard.index.find(hash);
+        if (iter != shard.index.end()) {
+            shard.lru.erase(iter->second);
+            shard.index.erase(iter);
+        }
+        shard.lru.push_front(entry);
+        shard.index[hash] = shard.lru.begin();
+
+        while (shard.lru.size() > limit) {
+            shard.index.erase(shard.lru.back()->m_hash);
+            shard.lru.pop_back();
+            shard.evictions++;
+        }
+        return entry;
+    }
+
+    // Drop every entry that expired before now; returns the number dropped.
+    size_t purge(uint64_t now)
+    {
+        size_t count = 0;
+        for (auto &shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard.mutex);
+            for (auto iter = shard.lru.begin(); iter != shard.lru.end(); ) {
+                if (now > (*iter)->m_expiry) {
+                    shard.index.erase((*iter)->m_hash);
+                    iter = shard.lru.erase(iter);
+                    shard.expirations++;
+                    count++;
+                } else {
+                    ++iter;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Set the number of tokens kept and the number of decisions remembered
+    // per token. The former takes effect as tokens are added, the latter for
+    // tokens added from now on.
+    void configure(size_t max_tokens, size_t memo_size)
+    {
+        size_t per_shard = max_tokens / m_shards.size();
+        m_shard_size.store(per_shard ? per_shard : 1, std::memory_order_relaxed);
+        m_memo_size.store(memo_size, std::memory_order_relaxed);
+    }
+
+    XrdSciTokensMon::CacheStats stats() const
+    {
+        XrdSciTokensMon::CacheStats total;
+        for (auto &shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard.mutex);
+            total.entries     += shard.lru.size();
+            total.hits        += shard.hits;
+            total.misses      += shard.misses;
+            total.evictions   += shard.evictions;
+            total.expirations += shard.expirations;
+            total.memo_hits   += shard.memo_hits.load(std::memory_order_relaxed);
+            total.memo_misses += shard.memo_misses.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    XrdSciTokensCache(size_t max_tokens = 10000, size_t memo_size = 16,
+                      size_t shards = 16) :
+        m_shards(shards ? shards : 1)
+    {
+        configure(max_tokens, memo_size);
+    }
+
+private:
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::list<std::shared_ptr<Entry>> lru;   // Most recently used first
+        std::unordered_map<uint64_t, typename std::list<std::shared_ptr<Entry>>::iterator> index;
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        uint64_t expirations{0};
+        std::atomic<uint64_t> memo_hits{0};
+        std::atomic<uint64_t> memo_misses{0};
+    };
+
+    Shard &shard_of(uint64_t hash) {return m_shards[(hash >> 32) % m_shards.size()];}
+
+    std::vector<Shard>  m_shards;
+    std::atomic<size_t> m_shard_size{1};
+    std::atomic<size_t> m_memo_size{0};
+};
+#endif
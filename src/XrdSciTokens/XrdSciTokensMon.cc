@@ -8,6 +8,28 @@
 #include "XrdSec/XrdSecEntity.hh"
 #include "XrdSec/XrdSecMonitor.hh"
 
+#include <cstdio>
+
+/******************************************************************************/
+/*                            C a c h e S t a t s                             */
+/******************************************************************************/
+
+int XrdSciTokensMon::Mon_CacheStats(char *buff, int blen,
+                                    const CacheStats &stats)
+{
+// Format the counters in cgi format, like the token information
+//
+   return snprintf(buff, blen,
+                   "n=%zu&hit=%llu&miss=%llu&evict=%llu&exp=%llu"
+                   "&dhit=%llu&dmiss=%llu", stats.entries,
+                   (unsigned long long)stats.hits,
+                   (unsigned long long)stats.misses,
+                   (unsigned long long)stats.evictions,
+                   (unsigned long long)stats.expirations,
+                   (unsigned long long)stats.memo_hits,
+                   (unsigned long long)stats.memo_misses);
+}
+
 /******************************************************************************/
 /*                                R e p o r t                                 */
 /******************************************************************************/
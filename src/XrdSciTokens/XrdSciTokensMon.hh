@@ -6,6 +6,8 @@
 /*                                                                            */
 /******************************************************************************/
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "XrdAcc/XrdAccAuthorize.hh"
@@ -14,6 +16,18 @@ class XrdSciTokensMon
 {
 public:
 
+struct CacheStats
+      {size_t   entries{0};     // Tokens currently cached
+       uint64_t hits{0};        // Lookups that found the token
+       uint64_t misses{0};      // Lookups that had to parse the token
+       uint64_t evictions{0};   // Tokens dropped to stay within bounds
+       uint64_t expirations{0}; // Tokens dropped because they expired
+       uint64_t memo_hits{0};   // Requests answered by a remembered decision
+       uint64_t memo_misses{0}; // Requests evaluated against the rules
+      };
+
+int  Mon_CacheStats(char *buff, int blen, const CacheStats &stats);
+
 bool Mon_isIO(const Access_Operation oper)
              {return oper == AOP_Read   || oper == AOP_Update 
                   || oper == AOP_Create || oper == AOP_Excl_Create;       
@@ -27,6 +27,8 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
+#include <cerrno>
 #include <fcntl.h>
 #include <signal.h>
 #include <cstdlib>
@@ -107,10 +109,307 @@ void Snatch(struct iovec *iov, int iovnum) // Called with logger mutex locked!
 
 bool XrdSysLogger::doForward = false;
 
+/******************************************************************************/
+/*                       C l a s s   X r d S y s L o g Q                      */
+/******************************************************************************/
+
+// The asynchronous message queue is a bounded multi-producer single-consumer
+// ring. Each slot carries a sequence number that tells whether it is free for
+// position pos (seq == pos) or holds the message for position pos (seq ==
+// pos+1). Producers claim a position with a CAS on the head and publish the
+// slot by advancing its sequence number; the writer thread consumes slots in
+// order and frees them by advancing the sequence by one lap. Messages that do
+// not fit into a slot are kept in an allocated buffer.
+//
+class XrdSysLogQ
+{
+public:
+
+static const int maxIov = 64;    // Messages written by a single writev()
+static const int recLen = 492;   // Inline message bytes (slot is 512 bytes)
+
+bool      Add(const struct iovec *iov, int iovcnt);
+
+long long Dropped() {return numDrop.load(std::memory_order_relaxed);}
+
+void      Drain();
+
+int       Start();
+
+void      Stop();
+
+void      Writer();
+
+          XrdSysLogQ(XrdSysLogger *lp, int qsz, int onfull);
+         ~XrdSysLogQ() {delete [] ring;}
+
+private:
+
+struct Slot
+      {std::atomic<unsigned long long> seq;
+       char                           *xbuf;
+       int                             mlen;
+       char                            data[recLen];
+      };
+
+Slot *Claim(unsigned long long &pos);
+bool  Empty() {return ring[tail & mask].seq.load(std::memory_order_acquire)
+                   != tail+1;
+              }
+void  Wake()  {wrCV.Lock(); wrCV.Signal(); wrCV.UnLock();}
+
+XrdSysLogger                   *logP;
+Slot                           *ring;
+unsigned long long              mask;
+int                             onFull;
+pthread_t                       wrTID;
+XrdSysCondVar                   wrCV;    // Writer waits here when idle
+XrdSysCondVar                   fullCV;  // Producers and Drain() wait here
+alignas(64)
+std::atomic<unsigned long long> head;    // Next position to claim
+alignas(64)
+std::atomic<unsigned long long> done;    // Positions written so far
+unsigned long long              tail;    // Next position to write (writer)
+long long                       numTold; // Drops reported so far (writer)
+std::atomic<long long>          numDrop;
+std::atomic<int>                numWait;
+std::atomic<bool>               wrIdle;
+std::atomic<bool>               doStop;
+};
+
+/******************************************************************************/
+/*                     X r d S y s L o g Q   M e t h o d s                    */
+/******************************************************************************/
+
+XrdSysLogQ::XrdSysLogQ(XrdSysLogger *lp, int qsz, int onfull)
+                      : logP(lp), onFull(onfull), wrTID(0),
+                        wrCV(0), fullCV(0), head(0), done(0), tail(0),
+                        numTold(0), numDrop(0), numWait(0), wrIdle(false),
+                        doStop(false)
+{
+   unsigned long long n = 2;
+
+   while(n < (unsigned long long)qsz) n <<= 1;
+   ring = new Slot[n];
+   mask = n - 1;
+   for (unsigned long long i = 0; i < n; i++)
+       {ring[i].seq.store(i, std::memory_order_relaxed);
+        ring[i].xbuf = 0;
+        ring[i].mlen = 0;
+       }
+}
+
+/******************************************************************************/
+
+bool XrdSysLogQ::Add(const struct iovec *iov, int iovcnt)
+{
+   unsigned long long pos;
+   Slot *sP;
+   char *bP;
+   int   mlen = 0;
+
+// Claim a slot. When the queue is full we either drop the message or wait for
+// the writer. The timed wait covers a broadcast that we may have just missed.
+//
+   while(!(sP = Claim(pos)))
+        {if (onFull == XrdSysLogger::asyncDrop)
+            {numDrop.fetch_add(1, std::memory_order_relaxed);
+             return false;
+            }
+         if (wrIdle.load()) Wake();
+         fullCV.Lock();
+         numWait++;
+         if (!(sP = Claim(pos))) fullCV.WaitMS(10);
+         numWait--;
+         fullCV.UnLock();
+         if (sP) break;
+        }
+
+// Copy the message into the slot. A message we can't allocate space for is
+// published empty as the slot can no longer be given back.
+//
+   for (int i = 0; i < iovcnt; i++) mlen += iov[i].iov_len;
+   if (mlen <= recLen) bP = sP->data;
+      else if (!(bP = (char *)malloc(mlen)))
+              {numDrop.fetch_add(1, std::memory_order_relaxed); mlen = 0;}
+   sP->xbuf = (bP == sP->data ? 0 : bP);
+   sP->mlen = mlen;
+   if (mlen)
+      for (int i = 0; i < iovcnt; i++)
+          {memcpy(bP, iov[i].iov_base, iov[i].iov_len); bP += iov[i].iov_len;}
+
+// Publish the message and wake up the writer if it is idle
+//
+   sP->seq.store(pos+1, std::memory_order_release);
+   if (wrIdle.load()) Wake();
+   return true;
+}
+
+/******************************************************************************/
+
+XrdSysLogQ::Slot *XrdSysLogQ::Claim(unsigned long long &pos)
+{
+   Slot *sP;
+   long long dif;
+
+   pos = head.load(std::memory_order_relaxed);
+   while(true)
+        {sP  = &ring[pos & mask];
+         dif = (long long)(sP->seq.load(std::memory_order_acquire) - pos);
+         if (!dif)
+            {if (head.compare_exchange_weak(pos, pos+1,
+                                            std::memory_order_relaxed))
+                return sP;
+            }
+            else if (dif < 0) return 0;
+            else pos = head.load(std::memory_order_relaxed);
+        }
+}
+
+/******************************************************************************/
+
+void XrdSysLogQ::Drain()
+{
+   unsigned long long endPos = head.load();
+
+// Wait until everything queued up to now has been written
+//
+   if (done.load() >= endPos) return;
+   if (wrIdle.load()) Wake();
+   fullCV.Lock();
+   numWait++;
+   while(done.load() < endPos) fullCV.WaitMS(10);
+   numWait--;
+   fullCV.UnLock();
+}
+
+/******************************************************************************/
+
+int XrdSysLogQ::Start()
+{
+   extern void *XrdSysLoggerAW(void *carg);
+
+   return XrdSysThread::Run(&wrTID, XrdSysLoggerAW, (void *)this,
+                            XRDSYSTHREAD_HOLD, "Async log writer");
+}
+
+/******************************************************************************/
+
+void XrdSysLogQ::Stop()
+{
+   doStop = true;
+   Wake();
+   XrdSysThread::Join(wrTID, 0);
+}
+
+/******************************************************************************/
+
+void XrdSysLogQ::Writer()
+{
+   struct iovec iov[maxIov+1];
+   Slot *sVec[maxIov];
+   char  tBuff[32], dBuff[80];
+   int   n, numS;
+
+// Write out queued messages in batches until we are told to stop
+//
+   while(true)
+        {for (numS = 0; numS < maxIov; numS++)
+             {Slot *sP = &ring[(tail + numS) & mask];
+              if (sP->seq.load(std::memory_order_acquire) != tail + numS + 1)
+                 break;
+              sVec[numS] = sP;
+              iov[numS].iov_base = (sP->xbuf ? sP->xbuf : sP->data);
+              iov[numS].iov_len  = sP->mlen;
+             }
+         n = numS;
+
+     // Report any messages that were dropped since the last report
+     //
+         long long nDrop = numDrop.load(std::memory_order_relaxed);
+         if (nDrop != numTold)
+            {struct timeval tVal;
+             gettimeofday(&tVal, 0);
+             int k = XrdSysLogger::TimeStamp(tVal, XrdSysThread::Num(),
+                                             tBuff, sizeof(tBuff), logP->hiRes);
+             snprintf(dBuff, sizeof(dBuff), "%.*sLogger dropped %lld "
+                      "message(s); queue full!\n", k, tBuff, nDrop - numTold);
+             iov[n].iov_base = dBuff;
+             iov[n].iov_len  = strlen(dBuff);
+             numTold = nDrop; n++;
+            }
+
+     // If there is nothing to do, wait for something to be queued. We
+     // advertise being idle before checking so a producer can't slip by.
+     //
+         if (!n)
+            {if (doStop) break;
+             wrCV.Lock();
+             wrIdle = true;
+             if (Empty() && !doStop) wrCV.WaitMS(1000);
+             wrIdle = false;
+             wrCV.UnLock();
+             continue;
+            }
+
+     // Write the batch and free the slots
+     //
+         logP->putBatch(iov, n);
+         for (int i = 0; i < numS; i++)
+             {if (sVec[i]->xbuf) {free(sVec[i]->xbuf); sVec[i]->xbuf = 0;}
+              sVec[i]->seq.store(tail + mask + 1, std::memory_order_release);
+              tail++;
+             }
+         done.store(tail);
+
+     // Tell anyone waiting for room or for the queue to drain
+     //
+         if (numWait.load())
+            {fullCV.Lock(); fullCV.Broadcast(); fullCV.UnLock();}
+        }
+}
+
+/******************************************************************************/
+/*                  A s y n c h r o n o u s   Q u e u e s                     */
+/******************************************************************************/
+
+// The queue of an asynchronous logger is kept here and the logger only holds
+// its index. Once the process starts to exit, queues are drained and messages
+// are written synchronously so nothing is left behind at exit().
+//
+namespace
+{
+const int                logQMax = 8;
+std::atomic<XrdSysLogQ*> logQTab[logQMax];
+std::atomic<bool>        logQSync(false);
+XrdSysMutex              logQMutex;
+
+XrdSysLogQ *LogQ(int qn)
+{
+   return (qn ? logQTab[qn-1].load(std::memory_order_acquire) : 0);
+}
+
+void LogQExit()
+{
+   XrdSysLogQ *qP;
+
+   logQSync = true;
+   logQMutex.Lock();
+   for (int i = 0; i < logQMax; i++) if ((qP = logQTab[i].load())) qP->Drain();
+   logQMutex.UnLock();
+}
+}
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
 
+void  *XrdSysLoggerAW(void *carg)
+      {XrdSysLogQ *qP = (XrdSysLogQ *)carg;
+       qP->Writer();
+       return (void *)0;
+      }
+
 void  *XrdSysLoggerMN(void *carg)
       {XrdSysLogger::Task *tP = (XrdSysLogger::Task *)carg;
        while(tP) {tP->Ring(); tP = tP->Next();}
@@ -152,7 +451,7 @@ XrdSysLogger::XrdSysLogger(int ErrFD, int dorotate)
    lfhTID  = 0;
    hiRes   = false;
    fifoFN  = 0;
-   reserved1 = 0;
+   logQN   = 0;
 
 // Establish default log file name
 //
@@ -166,6 +465,28 @@ XrdSysLogger::XrdSysLogger(int ErrFD, int dorotate)
            }
 }
   
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSysLogger::~XrdSysLogger()
+{
+
+// Write out anything still queued and stop the writer
+//
+   if (logQN)
+      {logQMutex.Lock();
+       XrdSysLogQ *qP = logQTab[logQN-1].exchange(0);
+       logQMutex.UnLock();
+       logQN = 0;
+       qP->Stop();
+       delete qP;
+      }
+
+   RmLogRotateLock();
+   if (ePath) free(ePath);
+}
+
 /******************************************************************************/
 /*                                A d d M s g                                 */
 /******************************************************************************/
@@ -288,6 +609,29 @@ void XrdSysLogger::Capture(XrdOucTListFIFO *tFIFO)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                               D r o p p e d                                */
+/******************************************************************************/
+
+long long XrdSysLogger::Dropped()
+{
+   XrdSysLogQ *qP = LogQ(logQN);
+
+   return (qP ? qP->Dropped() : 0);
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+void XrdSysLogger::Flush()
+{
+   XrdSysLogQ *qP = LogQ(logQN);
+
+   if (qP) qP->Drain();
+   fsync(eFD);
+}
+
 /******************************************************************************/
 /*                             P a r s e K e e p                              */
 /******************************************************************************/
@@ -331,6 +675,7 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
 {
     struct timeval tVal;
     unsigned long  tID = XrdSysThread::Num();
+    XrdSysLogQ    *qP;
     int retc;
     char tbuff[32];
 
@@ -354,6 +699,18 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
        iov[0].iov_len  = TimeStamp(tVal, tID, tbuff, sizeof(tbuff), hiRes);
       }
 
+// In asynchronous mode hand the message to the writer thread. Captured
+// messages are still handled inline as capturing is used synchronously. Once
+// the process is exiting we write what is queued and then this message.
+//
+   if (!tFifo && (qP = LogQ(logQN)))
+      {if (!logQSync.load())
+          {qP->Add(iov, iovcnt);
+           return;
+          }
+       qP->Drain();
+      }
+
 // Obtain the serailization mutex if need be
 //
    Logger_Mutex.Lock();
@@ -377,6 +734,51 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                              s e t A s y n c                               */
+/******************************************************************************/
+
+bool XrdSysLogger::setAsync(int qsz, int onfull)
+{
+   static bool atExit = false;
+   XrdSysLogQ *qP;
+   int qn, rc;
+
+// Asynchronous mode can only be set once
+//
+   if (logQN) return true;
+
+// Find a free queue slot and make sure queues are drained at exit
+//
+   logQMutex.Lock();
+   for (qn = 0; qn < logQMax && logQTab[qn].load(); qn++) {}
+   if (qn >= logQMax)
+      {logQMutex.UnLock();
+       errno = EMFILE;
+       return false;
+      }
+   if (!atExit) {atexit(LogQExit); atExit = true;}
+
+// Create the queue and start the writer
+//
+   qP = new XrdSysLogQ(this, qsz, onfull);
+   if ((rc = qP->Start()))
+      {logQMutex.UnLock();
+       delete qP;
+       errno = rc;
+       return false;
+      }
+
+// From now on all messages are queued
+//
+   logQTab[qn].store(qP, std::memory_order_release);
+   logQMutex.UnLock();
+   Logger_Mutex.Lock();
+   logQN = qn+1;
+   Logger_Mutex.UnLock();
+   return true;
+}
+
 /******************************************************************************/
 /* Private:                         T i m e                                   */
 /******************************************************************************/
@@ -591,6 +993,42 @@ void XrdSysLogger::FifoWait()
    close(pipeFD);
 }
 
+/******************************************************************************/
+/*                              p u t B a t c h                               */
+/******************************************************************************/
+
+// This internal method writes a batch of queued messages for the writer thread.
+// Unlike Put(), partial writes are handled as batches may be large.
+
+void XrdSysLogger::putBatch(struct iovec *iov, int iovcnt)
+{
+   ssize_t retc;
+
+// Obtain the serialization mutex so that rotation and trace output happen
+// between batches.
+//
+   Logger_Mutex.Lock();
+
+// Write out the whole vector
+//
+   while(iovcnt > 0)
+        {if ((retc = writev(eFD, (const struct iovec *)iov, iovcnt)) < 0)
+            {if (errno == EINTR) continue;
+             break;
+            }
+         while(iovcnt && retc >= (ssize_t)iov->iov_len)
+              {retc -= iov->iov_len; iov++; iovcnt--;}
+         if (iovcnt)
+            {iov->iov_base = (char *)iov->iov_base + retc;
+             iov->iov_len -= retc;
+            }
+        }
+
+// Release the serialization mutex
+//
+   Logger_Mutex.UnLock();
+}
+
 /******************************************************************************/
 /*                               p u t E m s g                                */
 /******************************************************************************/
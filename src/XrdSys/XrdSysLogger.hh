@@ -48,6 +48,7 @@
 //-----------------------------------------------------------------------------
 
 class XrdOucTListFIFO;
+class XrdSysLogQ;
 
 class XrdSysLogger
 {
@@ -68,12 +69,7 @@ public:
 //! Destructor
 //-----------------------------------------------------------------------------
 
-        ~XrdSysLogger()
-        {
-          RmLogRotateLock();
-          if (ePath)
-            free(ePath);
-        }
+        ~XrdSysLogger();
 
 //-----------------------------------------------------------------------------
 //! Add a message to be printed at midnight.
@@ -146,10 +142,20 @@ int Bind(const char *path, int lfh=0);
 void Capture(XrdOucTListFIFO *tFIFO);
 
 //-----------------------------------------------------------------------------
-//! Flush any pending output
+//! Get the number of messages discarded because the asynchronous queue was
+//! full. See setAsync().
+//!
+//! @return the number of discarded messages.
 //-----------------------------------------------------------------------------
 
-void Flush() {fsync(eFD);}
+long long Dropped();
+
+//-----------------------------------------------------------------------------
+//! Flush any pending output. In asynchronous mode this waits for all messages
+//! queued prior to the call to be written.
+//-----------------------------------------------------------------------------
+
+void Flush();
 
 //-----------------------------------------------------------------------------
 //! Get the file descriptor passed at construction time.
@@ -182,6 +188,33 @@ int  ParseKeep(const char *arg);
 
 void Put(int iovcnt, struct iovec *iov);
 
+//-----------------------------------------------------------------------------
+//! Route messages via an asynchronous queue. Put() then copies the formatted
+//! message into a lock-free queue and returns while a background thread writes
+//! queued messages in batches. Forwarding to a logging plug-in, capturing, and
+//! log file rotation work as before. Trace output via traceBeg()/traceEnd() is
+//! still written synchronously but never splits a batch. Once set,
+//! asynchronous mode cannot be turned off. Queued messages are written out
+//! when the process calls exit() and Put() becomes synchronous from then on;
+//! code that calls _exit() must call Flush() first.
+//!
+//! @param  qsz       The maximum number of queued messages. The value is
+//!                   rounded up to a power of two.
+//! @param  onfull    What to do when the queue is full: asyncDrop discards the
+//!                   message and counts it (see Dropped()), asyncBlock waits
+//!                   until the writer makes room.
+//!
+//! @return true      Asynchronous mode is in effect.
+//! @return false     The writer thread could not be started or too many
+//!                   loggers are asynchronous, errno holds the reason.
+//!                   Messages are written synchronously.
+//-----------------------------------------------------------------------------
+
+static const int asyncDrop  = 0;
+static const int asyncBlock = 1;
+
+bool setAsync(int qsz, int onfull=asyncDrop);
+
 //-----------------------------------------------------------------------------
 //! Set call-out to logging plug-in on or off.
 //-----------------------------------------------------------------------------
@@ -247,6 +280,8 @@ const char *xlogFN() {return (ePath ? ePath : "stderr");}
 void        zHandler();
 
 private:
+friend class XrdSysLogQ;
+
 int         FifoMake();
 void        FifoWait();
 int         Time(char *tbuff);
@@ -270,7 +305,7 @@ int        baseFD;
 char      *ePath;
 char       Filesfx[8];
 int        eInt;
-int        reserved1;
+int        logQN;            // Async queue is logQTab[logQN-1] (0 -> none)
 char      *fifoFN;
 bool       hiRes;
 bool       doLFR;
@@ -278,6 +313,7 @@ pthread_t  lfhTID;
 
 static bool doForward;
 
+void   putBatch(struct iovec *iov, int iovcnt);
 void   putEmsg(char *msg, int msz);
 int    ReBind(int dorename=1);
 void   Trim();
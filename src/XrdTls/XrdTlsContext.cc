@@ -744,6 +744,15 @@ XrdTlsContext::XrdTlsContext(const char *cert,  const char *key,
 //
    if (opts & artON) SSL_CTX_set_mode(pImpl->ctx, SSL_MODE_AUTO_RETRY);
 
+// Kernel TLS lets the kernel encrypt records once the handshake is done so
+// that sendfile() and splice() can be used on TLS connections. OpenSSL
+// silently falls back to user space encryption should the kernel or the
+// negotiated cipher not support it.
+//
+#ifdef SSL_OP_ENABLE_KTLS
+   if (opts & ktlON) SSL_CTX_set_options(pImpl->ctx, SSL_OP_ENABLE_KTLS);
+#endif
+
 // If there is no cert then assume this is a generic context for a client
 //
    if (cert == 0)
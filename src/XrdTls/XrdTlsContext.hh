@@ -255,6 +255,7 @@ static const uint64_t crlRF = 0x00000000ffff0000; //!< Mask to isolate crl refre
 static const int      crlRS = 16;                 //!< Bits to shift   vdept
 static const uint64_t artON = 0x0000002000000000; //!< Auto retry Handshake
 static const uint64_t clcOF = 0x0000010000000000; //!< Disable client certificate request
+static const uint64_t ktlON = 0x0000020000000000; //!< Enable kernel TLS offload
 
        XrdTlsContext(const char *cert=0,  const char *key=0,
                      const char *cadir=0, const char *cafile=0,
@@ -41,6 +41,12 @@
 
 #include <stdexcept>
 
+// Kernel TLS and SSL_sendfile() are only available as of OpenSSL 3.0
+//
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+#define XRDTLS_HAVE_KTLS 1
+#endif
+
 /******************************************************************************/
 /*                      X r d T l s S o c k e t I m p l                       */
 /******************************************************************************/
@@ -414,6 +420,24 @@ XrdTlsPeerCerts *XrdTlsSocket::getCerts(bool ver)
    return new XrdTlsPeerCerts(pcert, SSL_get_peer_cert_chain(pImpl->ssl));
 }
   
+/******************************************************************************/
+/*                               h a s K T L S                                */
+/******************************************************************************/
+
+bool XrdTlsSocket::hasKTLS()
+{
+#ifdef XRDTLS_HAVE_KTLS
+// The write BIO only changes during the handshake so no serialization is
+// needed once the connection is established.
+//
+   if (!pImpl->ssl || pImpl->fatal) return false;
+   BIO *wbio = SSL_get_wbio(pImpl->ssl);
+   return wbio && BIO_get_ktls_send(wbio) > 0;
+#else
+   return false;
+#endif
+}
+  
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
@@ -694,6 +718,73 @@ XrdTls::RC XrdTlsSocket::Read( char *buffer, size_t size, int &bytesRead )
     return XrdTls::TLS_SYS_Error;
   }
 
+/******************************************************************************/
+/*                              S e n d F i l e                               */
+/******************************************************************************/
+
+XrdTls::RC XrdTlsSocket::SendFile( int fd, off_t offset, size_t size,
+                                   int &bytesOut )
+{
+#ifdef XRDTLS_HAVE_KTLS
+    EPNAME("SendFile");
+    XrdSysMutexHelper mHelper;
+    int ssler;
+
+    //------------------------------------------------------------------------
+    // Serialize call if need be
+    //------------------------------------------------------------------------
+
+    if (pImpl->isSerial) mHelper.Lock(&(pImpl->sslMutex));
+
+    //------------------------------------------------------------------------
+    // Return an error if this socket received a fatal error as OpenSSL will
+    // SEGV when called after such an error.
+    //------------------------------------------------------------------------
+
+    if (pImpl->fatal)
+       {DBG_SIO("Failing due to previous error, fatal=" << (int)pImpl->fatal);
+        return (XrdTls::RC)pImpl->fatal;
+       }
+
+    //------------------------------------------------------------------------
+    // SSL_sendfile() hands the data to the kernel which frames and encrypts
+    // it. It fails unless kTLS is in effect for sending; the caller should
+    // have checked that using hasKTLS().
+    //------------------------------------------------------------------------
+
+ do{ossl_ssize_t rc = SSL_sendfile( pImpl->ssl, fd, offset, size, 0 );
+
+    if (rc > 0)
+      {bytesOut = static_cast<int>(rc);
+       DBG_SIO(rc <<" out of " <<size <<" bytes.");
+       return XrdTls::TLS_AOK;
+      }
+
+    // We have a potential error, see Write() for the handling.
+    //
+    ssler = Diagnose("TLS_SendFile", static_cast<int>(rc), XrdTls::dbgSIO);
+    if (ssler == SSL_ERROR_NONE)
+       {bytesOut = 0;
+        DBG_SIO(rc <<" out of " <<size <<" bytes.");
+        return XrdTls::TLS_AOK;
+       }
+
+    if (ssler != SSL_ERROR_WANT_READ && ssler != SSL_ERROR_WANT_WRITE)
+       return XrdTls::ssl2RC(ssler);
+
+    if (!(pImpl->cAttr & wBlocking)) return XrdTls::ssl2RC(ssler);
+
+    // Wait unil the write can get restarted
+
+   } while(Wait4OK(ssler == SSL_ERROR_WANT_READ));
+
+    return XrdTls::TLS_SYS_Error;
+#else
+    bytesOut = 0;
+    return XrdTls::TLS_UNK_Error;
+#endif
+}
+
 /******************************************************************************/
 /*                            S e t T r a c e I D                             */
 /******************************************************************************/
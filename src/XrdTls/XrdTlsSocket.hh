@@ -19,6 +19,7 @@
 //------------------------------------------------------------------------------
 
 #include <string>
+#include <sys/types.h>
 
 #include "XrdTls/XrdTls.hh"
 
@@ -136,6 +137,16 @@ enum HS_Mode
 
 XrdTlsPeerCerts *getCerts(bool ver=true);
 
+//------------------------------------------------------------------------
+//! Determine whether records sent on this connection are encrypted by the
+//! kernel (kTLS). This can only be true once the handshake has completed
+//! and the context was created with the XrdTlsContext::ktlON option.
+//!
+//! @return true when data can be sent using SendFile(), false otherwise.
+//------------------------------------------------------------------------
+
+  bool hasKTLS();
+
 //------------------------------------------------------------------------
 //! Initialize this object to handle the specified TLS I/O mode for the
 //! given file descriptor. Should an error occur, messages are automatically
@@ -205,6 +216,21 @@ XrdTlsPeerCerts *getCerts(bool ver=true);
 
   XrdTls::RC Read( char *buffer, size_t size, int &bytesRead );
 
+//------------------------------------------------------------------------
+//! Send file data over a kTLS connection without copying it to user space.
+//! This method may only be used when hasKTLS() returns true.
+//!
+//! @param  fd         - The file descriptor of the file holding the data.
+//! @param  offset     - The offset in the file of the data.
+//! @param  size       - The number of bytes to send.
+//! @param  bytesOut   - Number of bytes actually sent, if successful.
+//!
+//! @return TLS_AOK if the operation was successful; otherwise the appropraite
+//!                 return code indicating the problem.
+//------------------------------------------------------------------------
+
+  XrdTls::RC SendFile( int fd, off_t offset, size_t size, int &bytesOut );
+
 //------------------------------------------------------------------------
 //! Set the trace identifier (used when it's updated).
 //!
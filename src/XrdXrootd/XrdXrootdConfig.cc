@@ -46,6 +46,7 @@
 
 #include "XProtocol/XProtocol.hh"
 
+#include "XrdCks/XrdCksManager.hh"
 #include "XrdSfs/XrdSfsFlags.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
 #include "XrdNet/XrdNetOpts.hh"
@@ -1057,9 +1058,14 @@ int XrdXrootdProtocol::xbif(XrdOucStream &Config)
 
 /* Function: xcksum
 
-   Purpose:  To parse the directive: chksum [chkcgi] [max <n>] <type> [<path>]
+   Purpose:  To parse the directive: chksum [chkcgi] [max <n>] [threads <t>]
+                                            <type> [<path>]
 
              max       maximum number of simultaneous jobs
+             threads   number of threads used to compute a single local
+                       checksum (default 1). More than one overlaps reads with
+                       the computation and splits combinable checksums (e.g.
+                       adler32, crc32, crc32c) into pieces done in parallel.
              chkcgi    Always check for checksum type in cgo info.
              <type>    algorithm of checksum (e.g., md5). If more than one
                        checksum is supported then they should be listed with
@@ -1076,13 +1082,22 @@ int XrdXrootdProtocol::xcksum(XrdOucStream &Config)
    int (*Proc)(XrdOucStream *, char **, int) = 0;
    XrdOucTList *tP, *algFirst = 0, *algLast = 0;
    char *palg, prog[2048];
-   int jmax = 4, anum[2] = {0,0};
+   int jmax = 4, jthr = 1, anum[2] = {0,0};
 
 // Get the algorithm name and the program implementing it
 //
    JobCKCGI = 0;
    while ((palg = Config.GetWord()) && *palg != '/')
          {if (!strcmp(palg,"chkcgi")) {JobCKCGI = 1; continue;}
+          if (!strcmp(palg,"threads"))
+             {if (!(palg = Config.GetWord()))
+                 {eDest.Emsg("Config", "chksum threads not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2i(eDest,"chksum threads",palg,&jthr,1,64))
+                 return 1;
+              continue;
+             }
           if (strcmp(palg, "max"))
              {XrdOucUtils::toLower(palg);
               XrdOucTList *xalg = new XrdOucTList(palg, anum); anum[0]++;
@@ -1101,6 +1116,7 @@ int XrdXrootdProtocol::xcksum(XrdOucStream &Config)
    if (!algFirst)
       {eDest.Emsg("Config", "chksum algorithm not specified"); return 1;}
    if (JobCKT) free(JobCKT);
+   XrdCksManager::SetThreads(jthr);
    JobCKT = strdup(algFirst->text);
 
 // Handle alternate checksums
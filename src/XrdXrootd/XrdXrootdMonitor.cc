@@ -28,12 +28,14 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include "XrdVersion.hh"
 
@@ -42,6 +44,7 @@
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 #include "Xrd/XrdScheduler.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
@@ -98,6 +101,8 @@ char               XrdXrootdMonitor::monCLOCK   = 0;
   
 extern          XrdSysTrace        XrdXrootdTrace;
 
+class XrdXrootdMonitor_Sender;
+
 namespace XrdXrootdMonInfo
 {
 
@@ -114,6 +119,10 @@ long long       mySID     = 0;
 int32_t         startTime = InitStartTime();
 int             kySIDSZ   = 0;
 XrdSysMutex     seqMutex;
+XrdSysMutex     sendMutex;           // Serializes sends and packet sequences
+int             sendSeq1  = 0;
+int             sendSeq2  = 0;
+XrdXrootdMonitor_Sender *Sender = 0; // Sends full trace buffers
 
 char           *SidCGI[4] = {0};
 int             LidCGI[4] = {0};
@@ -196,6 +205,186 @@ XrdScheduler  *Sched;     // System scheduler
 int            Window;
 };
 
+/******************************************************************************/
+/*         C l a s s   X r d X r o o t d M o n i t o r _ S e n d e r          */
+/******************************************************************************/
+
+// Full trace buffers are handed to the sender thread so that the thread doing
+// the I/O never waits on the network. Each monitor swaps its full buffer for
+// an empty one held by a send request and pushes the request onto a lock-free
+// stack. The sender takes all pending requests at once and sends them in
+// order, as many per system call as possible. The number of requests is
+// capped; should they all be in flight the caller sends synchronously.
+//
+void *XrdXrootdMonitorSend(void *carg);
+
+class XrdXrootdMonitor_Sender
+{
+public:
+
+static const int maxReq = 256;   // Send requests in flight
+static const int maxVec = 64;    // Messages per SendBatch() call
+
+bool          Queue(XrdXrootdMonBuff *&buff, int size, int mode);
+
+void          Run();
+
+int           Start()
+                   {pthread_t tid;
+                    return XrdSysThread::Run(&tid, XrdXrootdMonitorSend,
+                                             (void *)this, 0, "Monitor sender");
+                   }
+
+      XrdXrootdMonitor_Sender() : sendQ(0), ready(0), freeQ(0), numReq(0) {}
+     ~XrdXrootdMonitor_Sender() {}
+
+private:
+
+struct SendReq
+      {SendReq          *next;
+       XrdXrootdMonBuff *buff;
+       int               size;
+       int               mode;
+      };
+
+void          Send(SendReq **rVec, int rNum);
+
+std::atomic<SendReq *> sendQ;
+XrdSysSemaphore        ready;
+XrdSysMutex            freeMutex;
+SendReq               *freeQ;
+int                    numReq;
+};
+
+/******************************************************************************/
+
+void *XrdXrootdMonitorSend(void *carg)
+{
+   XrdXrootdMonitor_Sender *sP = (XrdXrootdMonitor_Sender *)carg;
+   sP->Run();
+   return (void *)0;
+}
+
+/******************************************************************************/
+
+bool XrdXrootdMonitor_Sender::Queue(XrdXrootdMonBuff *&buff, int size,
+                                    int mode)
+{
+   XrdXrootdMonBuff *tBuff;
+   SendReq *rP, *oldQ;
+
+// Get a free request, allocating a new one if we are still below the cap
+//
+   freeMutex.Lock();
+   if ((rP = freeQ)) freeQ = rP->next;
+      else if (numReq < maxReq
+           &&  !posix_memalign((void **)&tBuff, getpagesize(),
+                               XrdXrootdMonitor::monBlen))
+              {rP = new SendReq;
+               rP->buff = tBuff;
+               numReq++;
+              }
+   freeMutex.UnLock();
+   if (!rP) return false;
+
+// Swap buffers with the request
+//
+   tBuff    = rP->buff;
+   rP->buff = buff;
+   rP->size = size;
+   rP->mode = mode;
+   buff     = tBuff;
+
+// Push the request and wake up the sender if the queue was empty
+//
+   oldQ = sendQ.load(std::memory_order_relaxed);
+   do {rP->next = oldQ;}
+      while(!sendQ.compare_exchange_weak(oldQ, rP, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+   if (!oldQ) ready.Post();
+   return true;
+}
+
+/******************************************************************************/
+
+void XrdXrootdMonitor_Sender::Run()
+{
+   SendReq *rVec[maxVec], *rP, *fifo, *lastP;
+   int n;
+
+// Wait for requests. The stack holds them newest first so we reverse it.
+//
+   while(1)
+        {ready.Wait();
+         if (!(rP = sendQ.exchange(0, std::memory_order_acquire))) continue;
+         fifo = 0;
+         while(rP) {SendReq *nP = rP->next; rP->next = fifo; fifo = rP; rP = nP;}
+
+     // Send the requests in batches and recycle them
+     //
+         while(fifo)
+              {for (n = 0, rP = fifo; rP && n < maxVec; rP = rP->next)
+                   rVec[n++] = rP;
+               fifo = rP;
+               Send(rVec, n);
+               for (int i = 0; i < n-1; i++) rVec[i]->next = rVec[i+1];
+               lastP = rVec[n-1];
+               freeMutex.Lock();
+               lastP->next = freeQ;
+               freeQ = rVec[0];
+               freeMutex.UnLock();
+              }
+        }
+}
+
+/******************************************************************************/
+
+void XrdXrootdMonitor_Sender::Send(SendReq **rVec, int rNum)
+{
+#ifndef NODEBUG
+    const char *TraceID = "Monitor";
+#endif
+   struct iovec mVec[maxVec];
+   int n, rc;
+
+// Send to each destination in turn. As each buffer goes to each destination
+// with its own sequence number, a destination is completely done before the
+// sequence numbers are set for the next one.
+//
+   sendMutex.Lock();
+   if (XrdXrootdMonitor::InetDest1)
+      {int k = 0;
+       for (n = 0; n < rNum; n++)
+           if (rVec[n]->mode & XrdXrootdMonitor::monMode1)
+              {rVec[n]->buff->hdr.pseq = (sendSeq1++) & 0xff;
+               mVec[k].iov_base = (void *)rVec[n]->buff;
+               mVec[k].iov_len  = rVec[n]->size;
+               k++;
+              }
+       if (k)
+          {rc = XrdXrootdMonitor::InetDest1->SendBatch(mVec, k);
+           TRACE(DEBUG,k <<" buffers sent to " <<XrdXrootdMonitor::Dest1
+                        <<" rc=" <<rc);
+          }
+      }
+   if (XrdXrootdMonitor::InetDest2)
+      {int k = 0;
+       for (n = 0; n < rNum; n++)
+           if (rVec[n]->mode & XrdXrootdMonitor::monMode2)
+              {rVec[n]->buff->hdr.pseq = (sendSeq2++) & 0xff;
+               mVec[k].iov_base = (void *)rVec[n]->buff;
+               mVec[k].iov_len  = rVec[n]->size;
+               k++;
+              }
+       if (k)
+          {rc = XrdXrootdMonitor::InetDest2->SendBatch(mVec, k);
+           TRACE(DEBUG,k <<" buffers sent to " <<XrdXrootdMonitor::Dest2
+                        <<" rc=" <<rc);
+          }
+      }
+   sendMutex.UnLock();
+}
+
 /******************************************************************************/
 /*            C l a s s   X r d X r o o t d M o n i t o r L o c k             */
 /******************************************************************************/
@@ -774,6 +963,15 @@ int XrdXrootdMonitor::Init()
            return 0;
           }
 
+// Start the thread that sends full trace buffers. Should that fail, buffers
+// are sent by whoever fills them.
+//
+   Sender = new XrdXrootdMonitor_Sender;
+   if ((i = Sender->Start()))
+      {eDest->Emsg("Monitor", i, "start monitor sender thread");
+       delete Sender; Sender = 0;
+      }
+
 // Turn on the monitoring clock if we need it running all the time
 //
    if (monCLOCK) startClock();
@@ -1098,12 +1296,13 @@ void XrdXrootdMonitor::Flush()
    now = lastWindow + sizeWindow;
    setTMark(monBuff, nextEnt, now);
 
-// Send off the buffer and reinitialize it
+// Send off the buffer and reinitialize it. If possible, the sender thread
+// sends it and we continue with a fresh buffer.
 //
-   if (this != altMon) Send(XROOTD_MON_IO, (void *)monBuff, size);
-      else {Send(XROOTD_MON_FILE, (void *)monBuff, size);
-            FlushTime = localWindow + autoFlush;
-           }
+   int mMode = (this != altMon ? XROOTD_MON_IO : XROOTD_MON_FILE);
+   if (!Sender || !Sender->Queue(monBuff, size, mMode))
+      Send(mMode, (void *)monBuff, size);
+   if (this == altMon) FlushTime = localWindow + autoFlush;
    setTMark(monBuff, 0, localWindow);
    nextEnt = 1;
 }
@@ -1200,8 +1399,6 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 #ifndef NODEBUG
     const char *TraceID = "Monitor";
 #endif
-    static XrdSysMutex sendMutex;
-    static int seq1=0, seq2=0;
     XrdXrootdMonHeader *mHdr=0;
     int rc1, rc2;
 
@@ -1212,13 +1409,13 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen, bool setseq)
 
     sendMutex.Lock();
     if (monMode & monMode1 && InetDest1)
-       {if (mHdr) mHdr->pseq = (seq1++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sendSeq1++) & 0xff;
         rc1  = InetDest1->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest1 <<" rc=" <<rc1);
        }
        else rc1 = 0;
     if (monMode & monMode2 && InetDest2)
-       {if (mHdr) mHdr->pseq = (seq2++) & 0xff;
+       {if (mHdr) mHdr->pseq = (sendSeq2++) & 0xff;
         rc2  = InetDest2->Send((char *)buff, blen);
         TRACE(DEBUG,blen <<" bytes sent to " <<Dest2 <<" rc=" <<rc2);
        }
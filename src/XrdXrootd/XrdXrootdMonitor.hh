@@ -71,6 +71,7 @@
 class XrdScheduler;
 class XrdNetMsg;
 class XrdXrootdMonFile;
+class XrdXrootdMonitor_Sender;
   
 /******************************************************************************/
 /*                C l a s s   X r d X r o o t d M o n i t o r                 */
@@ -82,6 +83,7 @@ public:
        class User;
 friend class User;
 friend class XrdXrootdMonFile;
+friend class XrdXrootdMonitor_Sender;
 
 // All values for Add_xx() must be passed in network byte order
 //
@@ -507,28 +507,40 @@ int XrdXrootdPgrwAio::SendDone()
 
 bool XrdXrootdPgrwAio::VerCks(XrdXrootdAioPgrw *aioP)
 {
+   static const int csBatch = 16;
+   const void *pgAddr[csBatch];
+   size_t      pgLen [csBatch];
+   uint32_t    pgCks [csBatch];
    off_t     dOffset = aioP->sfsAio.aio_offset;
    uint32_t *csVec, *csVP, csVal;
-   int       ioVNum, dLen;
+   int       ioVNum, n;
 
 // Get the iovec information as this will drive the checksum
 //
    struct iovec *ioV = aioP->iov4Data(ioVNum);
    csVP = csVec = (uint32_t*)ioV[0].iov_base;
 
-// Verify each page or page segment
-//
-   for (int i = 1; i < ioVNum; i +=2)
-       {dLen = ioV[i].iov_len;
-        csVal = ntohl(*csVP); *csVP++ = csVal;
-        if (!XrdOucCRC::Ver32C(ioV[i].iov_base, dLen, csVal))
-           {const char *eMsg = badCSP->boAdd(dataFile, dOffset, dLen);
-            if (eMsg) {SendError(ETOOMANYREFS, eMsg);
-                       aioP->Recycle();
-                       return false;
-                      }
-           }
-        dOffset += dLen;
+// Verify each page or page segment. We compute the checksums of a batch of
+// pages at a time as that is much faster than doing one page at a time.
+//
+   for (int i = 1; i < ioVNum; i += 2*n)
+       {for (n = 0; n < csBatch && i+2*n < ioVNum; n++)
+            {pgAddr[n] = ioV[i+2*n].iov_base;
+             pgLen [n] = ioV[i+2*n].iov_len;
+            }
+        XrdOucCRC::Calc32C(pgAddr, pgLen, pgCks, n);
+        for (int k = 0; k < n; k++)
+            {csVal = ntohl(*csVP); *csVP++ = csVal;
+             if (csVal != pgCks[k])
+                {const char *eMsg = badCSP->boAdd(dataFile, dOffset,
+                                                  (int)pgLen[k]);
+                 if (eMsg) {SendError(ETOOMANYREFS, eMsg);
+                            aioP->Recycle();
+                            return false;
+                           }
+                }
+             dOffset += pgLen[k];
+            }
        }
 
 // All done, while we may have checksum error there is nothing we can do about
@@ -2423,7 +2423,8 @@ int XrdXrootdProtocol::do_Read()
 // will use and if possible, do a fast dispatch.
 //
         if (IO.File->isMMapped) IO.Mode = XrdXrootd::IOParms::useMMap;
-   else if (IO.File->sfEnabled && !isTLS && IO.IOLen >= as_minsfsz
+   else if (IO.File->sfEnabled && (!isTLS || Link->hasKTLS())
+        &&  IO.IOLen >= as_minsfsz
         &&  IO.Offset+IO.IOLen <= IO.File->Stats.fSize)
            IO.Mode = XrdXrootd::IOParms::useSF;
    else if (IO.File->AsyncMode && IO.IOLen >= as_miniosz
@@ -2569,7 +2570,110 @@ int XrdXrootdProtocol::do_ReadNone(int &retc, int &pathID)
 /******************************************************************************/
 /*                               d o _ R e a d V                              */
 /******************************************************************************/
-  
+
+namespace
+{
+// A readv quantum describes the elements [beg,end) of the read vector whose
+// data, each preceded by its response header, is placed in buffer bP.
+//
+struct rvQuantum
+      {XrdBuffer     *bP;
+       XrdXrootdFile *fP;    // The file last read (the one in error if !isOK)
+       XrdSfsXferSize xfrSZ; // The result of the last readv()
+       int            beg;
+       int            end;
+       int            len;   // Number of bytes used in the buffer
+       bool           isOK;
+      };
+
+// Lay out a quantum starting at element beg and return the element past the
+// last one that fits. Each element is guaranteed to fit in an empty quantum.
+//
+int rvLayout(XrdOucIOVec *rdVec, int beg, int num, int Quantum, int &len)
+{
+   const int hdrSZ = sizeof(readahead_list);
+   int Qleft = Quantum;
+
+   while(beg < num && Qleft >= rdVec[beg].size + hdrSZ)
+        {Qleft -= rdVec[beg].size + hdrSZ; beg++;}
+   len = Quantum - Qleft;
+   return beg;
+}
+
+// Read in the data for a quantum. Adjacent elements for the same file are
+// read with a single readv(). The file handles have already been verified.
+//
+bool rvFill(XrdXrootdFileTable *fTab, XrdOucIOVec *rdVec, rvQuantum &rvQ)
+{
+   struct readahead_list respHdr;
+   char *buffp = rvQ.bP->buff;
+   XrdSfsXferSize rdVAmt = 0;
+   int currFH = rdVec[rvQ.beg].info, rdVNow = rvQ.beg;
+
+   rvQ.fP = fTab->Get(currFH);
+   memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
+   for (int i = rvQ.beg; i <= rvQ.end; i++)
+       {if (i == rvQ.end || rdVec[i].info != currFH)
+           {if (rdVAmt)
+               {rvQ.xfrSZ = rvQ.fP->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
+                if (rvQ.xfrSZ != rdVAmt) return (rvQ.isOK = false);
+               }
+            if (i == rvQ.end) break;
+            currFH = rdVec[i].info; rdVNow = i; rdVAmt = 0;
+            rvQ.fP = fTab->Get(currFH);
+            memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
+           }
+        rdVAmt        += rdVec[i].size;
+        respHdr.rlen   = htonl(rdVec[i].size);
+        respHdr.offset = htonll(rdVec[i].offset);
+        memcpy(buffp, &respHdr, sizeof(respHdr));
+        rdVec[i].data  = buffp + sizeof(respHdr);
+        buffp         += rdVec[i].size + sizeof(respHdr);
+       }
+   return (rvQ.isOK = true);
+}
+
+// An rvFiller reads in the next quantum using a scheduler thread while the
+// protocol thread sends the current one. The protocol thread must call
+// Finish() which either waits for the read to complete or, should no thread
+// have picked up the job yet, does the read itself so we never wait on an
+// overloaded scheduler. The object deletes itself when both are done with it.
+//
+class rvFiller : public XrdJob
+{
+public:
+
+void DoIt() override {if (Claim()) {rvFill(fTab, rdVec, rvQ); rvDone.Post();}
+                      Unref();
+                     }
+
+void Finish(bool doRead)
+           {if (Claim()) {if (doRead) rvFill(fTab, rdVec, rvQ);}
+               else rvDone.Wait();
+            Unref();
+           }
+
+     rvFiller(XrdXrootdFileTable *ftP, XrdOucIOVec *rvP, rvQuantum &qP)
+             : XrdJob("readv filler"), rvDone(0), fTab(ftP), rdVec(rvP),
+               rvQ(qP), isClaimed(false), refCnt(2) {}
+    ~rvFiller() {}
+
+private:
+
+bool Claim() {bool isFree = false;
+              return isClaimed.compare_exchange_strong(isFree, true);
+             }
+void Unref() {if (--refCnt == 0) delete this;}
+
+XrdSysSemaphore     rvDone;
+XrdXrootdFileTable *fTab;
+XrdOucIOVec        *rdVec;
+rvQuantum          &rvQ;
+RAtomic_bool        isClaimed;
+RAtomic_int         refCnt;
+};
+}
+
 int XrdXrootdProtocol::do_ReadV()
 {
 // This will read multiple buffers at the same time in an attempt to avoid
@@ -2581,14 +2685,18 @@ int XrdXrootdProtocol::do_ReadV()
 //
    const int hdrSZ = sizeof(readahead_list);
    struct XrdOucIOVec     rdVec[XrdProto::maxRvecsz+1];
-   struct readahead_list *raVec, respHdr;
+   struct readahead_list *raVec;
+   rvQuantum rvQ[2], *rvC = &rvQ[0], *rvN = &rvQ[1], *rvT;
+   rvFiller *fillP;
+   XrdBuffer *altBuff = 0;
    long long totSZ;
-   XrdSfsXferSize rdVAmt, rdVXfr, xfrSZ = 0;
-   int rdVBeg, rdVBreak, rdVNow, rdVNum, rdVecNum;
-   int currFH, i, k, Quantum, Qleft, rdVecLen = Request.header.dlen;
+   XrdSfsXferSize grpXfr = 0, xfrSZ;
+   int grpBeg = 0, grpFH, rdVBreak, rdVecNum;
+   int currFH, i, k, kEnd, Quantum, rc, rdVecLen = Request.header.dlen;
    int rvMon = Monitor.InOut();
    int ioMon = (rvMon > 1);
-   char *buffp, vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+   bool canPipe = true;
 
 // Compute number of elements in the read vector and make sure we have no
 // partial elements.
@@ -2630,7 +2738,6 @@ int XrdXrootdProtocol::do_ReadV()
    rdVec[i].size   =  0;
    rdVec[i].info   = -1;
    rdVBreak = rdVecNum;
-   rdVecNum++;
 
 // We limit the total size of the read to be 2GB for convenience
 //
@@ -2648,83 +2755,100 @@ int XrdXrootdProtocol::do_ReadV()
       {if ((k = getBuff(1, Quantum)) <= 0) return k;}
       else if (hcNow < hcNext) hcNow++;
 
-// Check that we really have at least one file open. This needs to be done 
-// only once as this code runs in the control thread.
+// Check that we really have at least one file open and that every element
+// refers to an open file. This needs to be done only once as this code runs
+// in the control thread. Doing it up front means that the quanta can be
+// read in by another thread without having to worry about this.
 //
    if (!FTab) return Response.Send(kXR_FileNotOpen,
                               "readv does not refer to an open file");
+   currFH = grpFH = rdVec[0].info;
+   if (!FTab->Get(currFH)) return Response.Send(kXR_FileNotOpen,
+                                  "readv does not refer to an open file");
+   for (i = 1; i < rdVecNum; i++)
+       if (rdVec[i].info != currFH)
+          {currFH = rdVec[i].info;
+           if (!FTab->Get(currFH)) return Response.Send(kXR_FileNotOpen,
+                                          "readv does not refer to an open file");
+          }
 
-// Preset the previous and current file handle to be the handle of the first
-// element and make sure the file is actually open.
-//
-   currFH = rdVec[0].info;
-   memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
-   if (!(IO.File = FTab->Get(currFH))) return Response.Send(kXR_FileNotOpen,
-                                      "readv does not refer to an open file");
-
-// Setup variables for running through the list.
-//
-   Qleft = Quantum; buffp = argp->buff; rvSeq++;
-   rdVBeg = rdVNow = 0; rdVXfr = rdVAmt = 0;
-
-// Now run through the elements
-//
-   for (i = 0; i < rdVecNum; i++)
-       {if (rdVec[i].info != currFH)
-           {xfrSZ = IO.File->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-            if (xfrSZ != rdVAmt) break;
-            rdVNum = i - rdVBeg; rdVXfr += rdVAmt;
-            IO.File->Stats.rvOps(rdVXfr, rdVNum);
-            if (rvMon)
-               {Monitor.Agent->Add_rv(IO.File->Stats.FileID, htonl(rdVXfr),
-                                              htons(rdVNum), rvSeq, vType);
-                if (ioMon) for (k = rdVBeg; k < i; k++)
-                    Monitor.Agent->Add_rd(IO.File->Stats.FileID,
-                            htonl(rdVec[k].size), htonll(rdVec[k].offset));
-               }
-            rdVXfr = rdVAmt = 0;
-            if (i == rdVBreak) break;
-            rdVBeg = rdVNow = i; currFH = rdVec[i].info;
-            memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
-            if (!(IO.File = FTab->Get(currFH)))
-               return Response.Send(kXR_FileNotOpen,
-                                    "readv does not refer to an open file");
+// Read in the first quantum
+//
+   rvSeq++;
+   rvC->bP  = argp;
+   rvC->beg = 0;
+   rvC->end = rvLayout(rdVec, 0, rdVBreak, Quantum, rvC->len);
+   for (k = rvC->beg; k < rvC->end; k++)
+       TRACEP(FSIO,"fh=" <<rdVec[k].info<<" readV "<< rdVec[k].size
+                         <<'@'<<rdVec[k].offset);
+   rvFill(FTab, rdVec, *rvC);
+
+// Now run through the quanta. While one quantum is being sent the next one is
+// read into an alternate buffer so that disk and network I/O overlap. Should
+// we not be able to get a second buffer, we read after sending as before.
+//
+   while(true)
+        {if (!rvC->isOK)
+            {IO.File = rvC->fP; xfrSZ = rvC->xfrSZ;
+             if (altBuff) BPool->Release(altBuff);
+             if (xfrSZ >= 0)
+                {xfrSZ = SFS_ERROR;
+                 IO.File->XrdSfsp->error.setErrInfo(-ENODATA,"readv past EOF");
+                }
+             return fsError(xfrSZ, 0, IO.File->XrdSfsp->error, 0, 0);
             }
 
-        if (Qleft < (rdVec[i].size + hdrSZ))
-           {if (rdVAmt)
-               {xfrSZ = IO.File->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-                if (xfrSZ != rdVAmt) break;
-               }
-            if (Response.Send(kXR_oksofar,argp->buff,Quantum-Qleft) < 0)
-               return -1;
-            Qleft = Quantum;
-            buffp = argp->buff;
-            rdVNow = i; rdVXfr += rdVAmt; rdVAmt = 0;
-           }
-
-        xfrSZ = rdVec[i].size; rdVAmt += xfrSZ;
-        respHdr.rlen   = htonl(xfrSZ);
-        respHdr.offset = htonll(rdVec[i].offset);
-        memcpy(buffp, &respHdr, hdrSZ);
-        rdVec[i].data = buffp + hdrSZ;
-        buffp += (xfrSZ+hdrSZ); Qleft -= (xfrSZ+hdrSZ);
-        TRACEP(FSIO,"fh=" <<currFH<<" readV "<< xfrSZ <<'@'<<rdVec[i].offset);
-       }
-
-// Check if we have an error here. This is indicated when rdVAmt is not zero.
-//
-   if (rdVAmt)
-      {if (xfrSZ >= 0)
-          {xfrSZ = SFS_ERROR;
-           IO.File->XrdSfsp->error.setErrInfo(-ENODATA,"readv past EOF");
-          }
-       return fsError(xfrSZ, 0, IO.File->XrdSfsp->error, 0, 0);
-      }
+         // Account for each run of elements for the same file once we have
+         // read all of it. The dummy element flushes out the last run.
+         //
+         kEnd = (rvC->end == rdVBreak ? rdVBreak+1 : rvC->end);
+         for (k = rvC->beg; k < kEnd; k++)
+             {if (rdVec[k].info != grpFH)
+                 {if ((IO.File = FTab->Get(grpFH)))
+                     {IO.File->Stats.rvOps(grpXfr, k - grpBeg);
+                      if (rvMon)
+                         {Monitor.Agent->Add_rv(IO.File->Stats.FileID,
+                                  htonl(grpXfr), htons(k - grpBeg), rvSeq, vType);
+                          if (ioMon) for (i = grpBeg; i < k; i++)
+                              Monitor.Agent->Add_rd(IO.File->Stats.FileID,
+                                  htonl(rdVec[i].size), htonll(rdVec[i].offset));
+                         }
+                     }
+                  grpBeg = k; grpFH = rdVec[k].info; grpXfr = 0;
+                 }
+              grpXfr += rdVec[k].size;
+             }
+         if (rvC->end == rdVBreak) break;
+
+         // Lay out the next quantum and start reading it if we can
+         //
+         if (!altBuff && canPipe && !(altBuff = BPool->Obtain(Quantum)))
+            canPipe = false;
+         rvN->bP  = (altBuff && rvC->bP == argp ? altBuff : argp);
+         rvN->beg = rvC->end;
+         rvN->end = rvLayout(rdVec, rvN->beg, rdVBreak, Quantum, rvN->len);
+         for (k = rvN->beg; k < rvN->end; k++)
+             TRACEP(FSIO,"fh=" <<rdVec[k].info<<" readV "<< rdVec[k].size
+                               <<'@'<<rdVec[k].offset);
+         if (altBuff)
+            {fillP = new rvFiller(FTab, rdVec, *rvN);
+             Sched->Schedule((XrdJob *)fillP);
+            } else fillP = 0;
+
+         // Send the current quantum and make sure the next one is in
+         //
+         rc = Response.Send(kXR_oksofar, rvC->bP->buff, rvC->len);
+         if (fillP) fillP->Finish(rc >= 0);
+            else if (rc >= 0) rvFill(FTab, rdVec, *rvN);
+         if (rc < 0) {if (altBuff) BPool->Release(altBuff); return -1;}
+         rvT = rvC; rvC = rvN; rvN = rvT;
+        }
 
-// All done, return result of the last segment or just zero
+// All done, return result of the last segment
 //
-   return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
+   rc = Response.Send(rvC->bP->buff, rvC->len);
+   if (altBuff) BPool->Release(altBuff);
+   return rc;
 }
 
 /******************************************************************************/
@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+// Path lookup benchmark for the XrdAcc capability lists.
+//
+// Usage: xrdacc-bench [<lookups> [<rules>]]
+//
+// A synthetic authorization database of about <rules> rules (10000 by default)
+// is built the way XrdAccConfig does: a default ("u *") list, per user lists
+// and per group lists, some of them referring to templates. Every lookup
+// resolves the privileges of a random path for a user in four groups, first by
+// walking the lists with XrdAccCapability::Privs() and then with one descent
+// of the XrdAccPathTrie. The results are checked to be identical and the
+// lookup rates of both methods are reported.
+//------------------------------------------------------------------------------
+
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPathTrie.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A capability list under construction
+  //----------------------------------------------------------------------------
+  struct ListBuilder
+  {
+    XrdAccCapability *head = 0;
+    XrdAccCapability *last = 0;
+
+    void Add( XrdAccCapability *cap )
+    {
+      if( last ) last->Add( cap );
+      else head = cap;
+      last = cap;
+    }
+
+    void Add( const std::string &path, int privs )
+    {
+      XrdAccPrivCaps caps;
+      caps.pprivs = (XrdAccPrivs)privs;
+      Add( new XrdAccCapability( (char*)path.c_str(), caps ) );
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  // The synthetic database
+  //----------------------------------------------------------------------------
+  struct AuthDB
+  {
+    std::vector<XrdAccCapability*> templates;
+    std::vector<XrdAccCapability*> users;
+    std::vector<XrdAccCapability*> groups;
+    XrdAccCapability              *deflt = 0;
+    std::vector<std::string>       dirs;
+    int                            rules = 0;
+
+    std::string Dir( std::mt19937 &rng )
+    {
+      return dirs[rng() % dirs.size()];
+    }
+
+    AuthDB( int nRules, std::mt19937 &rng )
+    {
+      for( int e = 0; e < 20; ++e )
+        for( int d = 0; d < 50; ++d )
+          dirs.push_back( "/store/exp" + std::to_string( e ) + "/data" +
+                          std::to_string( d ) + "/" );
+
+      for( int t = 0; t < 10; ++t )
+      {
+        ListBuilder lb;
+        for( int i = 0; i < 10; ++i, ++rules ) lb.Add( Dir( rng ), 0x28 );
+        templates.push_back( lb.head );
+      }
+
+      ListBuilder dl;
+      for( int i = 0; i < nRules / 5; ++i, ++rules )
+        dl.Add( Dir( rng ) + "sub" + std::to_string( i ), 0x28 );
+      dl.Add( "/store/", 0x08 ); ++rules;
+      deflt = dl.head;
+
+      int nUsers = ( nRules * 2 / 5 ) / 5, nGroups = ( nRules * 2 / 5 ) / 5;
+      for( int u = 0; u < nUsers; ++u )
+      {
+        ListBuilder lb;
+        lb.Add( "/home/user" + std::to_string( u ) + "/", 0x1ff );
+        for( int i = 0; i < 4; ++i, ++rules ) lb.Add( Dir( rng ), 0x7f );
+        users.push_back( lb.head );
+        ++rules;
+      }
+      for( int g = 0; g < nGroups; ++g )
+      {
+        ListBuilder lb;
+        for( int i = 0; i < 4; ++i, ++rules ) lb.Add( Dir( rng ), 0x63 );
+        lb.Add( new XrdAccCapability( templates[g % templates.size()] ) );
+        ++rules;
+        groups.push_back( lb.head );
+      }
+    }
+
+    ~AuthDB()
+    {
+      for( auto cap : users ) delete cap;
+      for( auto cap : groups ) delete cap;
+      for( auto cap : templates ) delete cap;
+      delete deflt;
+    }
+  };
+
+  struct Query
+  {
+    std::string                    path;
+    std::vector<XrdAccCapability*> lists;
+  };
+
+  template<typename Lookup>
+  double Measure( const std::vector<Query> &queries, int nLookups,
+                  std::vector<XrdAccPrivCaps> &results, Lookup lookup )
+  {
+    auto beg = std::chrono::steady_clock::now();
+    for( int i = 0; i < nLookups; ++i )
+    {
+      const Query &q = queries[i % queries.size()];
+      XrdAccPrivCaps caps;
+      lookup( caps, q );
+      if( i < (int)results.size() ) results[i] = caps;
+    }
+    auto end = std::chrono::steady_clock::now();
+    return nLookups / std::chrono::duration<double>( end - beg ).count();
+  }
+}
+
+int main( int argc, char **argv )
+{
+  int nLookups = ( argc > 1 ? atoi( argv[1] ) : 200000 );
+  int nRules   = ( argc > 2 ? atoi( argv[2] ) : 10000 );
+
+  if( nLookups <= 0 || nRules < 100 )
+  {
+    fprintf( stderr, "Usage: %s [<lookups> [<rules>]]\n"
+             "       At least 100 rules are needed.\n", argv[0] );
+    return 1;
+  }
+
+  std::mt19937 rng( 4711 );
+  AuthDB db( nRules, rng );
+
+  auto beg = std::chrono::steady_clock::now();
+  XrdAccPathTrie trie;
+  for( auto cap : db.users ) trie.Add( cap );
+  for( auto cap : db.groups ) trie.Add( cap );
+  trie.Add( db.deflt );
+  auto end = std::chrono::steady_clock::now();
+
+  std::vector<Query> queries( 4096 );
+  for( auto &q : queries )
+  {
+    size_t u = rng() % db.users.size();
+    switch( rng() % 3 )
+    {
+      case 0:  q.path = "/home/user" + std::to_string( u ) + "/f"; break;
+      case 1:  q.path = db.Dir( rng ) + "sub" +
+                        std::to_string( rng() % ( nRules / 5 ) ) + "/f"; break;
+      default: q.path = db.Dir( rng ) + "file"; break;
+    }
+    q.lists.push_back( db.deflt );
+    q.lists.push_back( db.users[u] );
+    for( int g = 0; g < 4; ++g )
+      q.lists.push_back( db.groups[rng() % db.groups.size()] );
+  }
+
+  std::vector<XrdAccPrivCaps> walkRes( queries.size() ), trieRes( queries.size() );
+  double walk = Measure( queries, nLookups, walkRes,
+    []( XrdAccPrivCaps &caps, const Query &q )
+    {
+      for( auto cap : q.lists ) cap->Privs( caps, q.path.c_str() );
+    } );
+  double fast = Measure( queries, nLookups, trieRes,
+    [&trie]( XrdAccPrivCaps &caps, const Query &q )
+    {
+      int lnVec[8], n = 0;
+      for( auto cap : q.lists ) lnVec[n++] = cap->ListNum();
+      trie.Privs( caps, q.path.c_str(), q.path.size(), lnVec, n );
+    } );
+
+  for( size_t i = 0; i < walkRes.size() && (int)i < nLookups; ++i )
+    if( walkRes[i].pprivs != trieRes[i].pprivs ||
+        walkRes[i].nprivs != trieRes[i].nprivs )
+    {
+      fprintf( stderr, "Mismatch for %s\n", queries[i].path.c_str() );
+      return 1;
+    }
+
+  printf( "%d rules in %d lists, trie built in %.1f ms; "
+          "throughput in lookups/sec\n", db.rules, trie.Lists(),
+          std::chrono::duration<double, std::milli>( end - beg ).count() );
+  printf( "%14s %14s %8s\n", "list walk", "path trie", "speedup" );
+  printf( "%14.0f %14.0f %7.2fx\n", walk, fast, fast / walk );
+  return 0;
+}
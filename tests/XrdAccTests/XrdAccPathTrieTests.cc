@@ -0,0 +1,158 @@
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdAcc/XrdAccPathTrie.hh"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  XrdAccPrivCaps MakePrivs( int pos, int neg = 0 )
+  {
+    XrdAccPrivCaps caps;
+    caps.pprivs = (XrdAccPrivs)pos;
+    caps.nprivs = (XrdAccPrivs)neg;
+    return caps;
+  }
+
+  // Build a capability list from paths and positive privileges
+  XrdAccCapability *MakeList( const std::vector<std::pair<std::string, int>> &rules )
+  {
+    XrdAccCapability *head = 0, *last = 0;
+    for( auto &rule : rules )
+    {
+      XrdAccPrivCaps caps = MakePrivs( rule.second );
+      XrdAccCapability *cap =
+        new XrdAccCapability( (char*)rule.first.c_str(), caps );
+      if( last ) last->Add( cap );
+      else head = cap;
+      last = cap;
+    }
+    return head;
+  }
+
+  XrdAccPrivCaps TrieLookup( const XrdAccPathTrie &trie, const char *path,
+                             const std::vector<XrdAccCapability*> &lists )
+  {
+    XrdAccPrivCaps caps;
+    std::vector<int> lnums;
+    for( auto cap : lists ) lnums.push_back( cap->ListNum() );
+    trie.Privs( caps, path, strlen( path ), lnums.data(), lnums.size() );
+    return caps;
+  }
+
+  XrdAccPrivCaps WalkLookup( const char *path,
+                             const std::vector<XrdAccCapability*> &lists )
+  {
+    XrdAccPrivCaps caps;
+    for( auto cap : lists ) cap->Privs( caps, path );
+    return caps;
+  }
+}
+
+TEST(XrdAccPathTrieTests, FirstMatchInListWins)
+{
+  XrdAccCapability *specific = MakeList( { {"/data/a", 0x20}, {"/data", 0x40} } );
+  XrdAccCapability *general  = MakeList( { {"/data", 0x40}, {"/data/a", 0x20} } );
+  XrdAccPathTrie trie;
+  trie.Add( specific );
+  trie.Add( general );
+  EXPECT_EQ( trie.Lists(), 2 );
+
+  EXPECT_EQ( TrieLookup( trie, "/data/a/f", { specific } ).pprivs, 0x20 );
+  EXPECT_EQ( TrieLookup( trie, "/data/b/f", { specific } ).pprivs, 0x40 );
+  EXPECT_EQ( TrieLookup( trie, "/data/a/f", { general } ).pprivs, 0x40 );
+  EXPECT_EQ( TrieLookup( trie, "/data/a/f", { specific, general } ).pprivs,
+             0x60 );
+  EXPECT_EQ( TrieLookup( trie, "/dat", { specific, general } ).pprivs, 0 );
+
+  delete specific;
+  delete general;
+}
+
+TEST(XrdAccPathTrieTests, PrefixesAreNotComponentBased)
+{
+  XrdAccCapability *list = MakeList( { {"/store/us", 0x20}, {"", 0x08} } );
+  XrdAccPathTrie trie;
+  trie.Add( list );
+
+  EXPECT_EQ( TrieLookup( trie, "/store/user/x", { list } ).pprivs, 0x20 );
+  EXPECT_EQ( TrieLookup( trie, "/store/u", { list } ).pprivs, 0x08 );
+  EXPECT_EQ( TrieLookup( trie, "/other", { list } ).pprivs, 0x08 );
+
+  delete list;
+}
+
+TEST(XrdAccPathTrieTests, TemplatesAreRankedInPlace)
+{
+  XrdAccCapability *tmplt = MakeList( { {"/t/x", 0x01}, {"/t", 0x02} } );
+  XrdAccCapability *list  = MakeList( { {"/t/x/y", 0x04} } );
+  XrdAccCapability *ref   = new XrdAccCapability( tmplt );
+  list->Add( ref );
+  XrdAccPrivCaps caps = MakePrivs( 0x08 );
+  ref->Add( new XrdAccCapability( (char*)"/t/x/y/z", caps ) );
+
+  XrdAccPathTrie trie;
+  trie.Add( list );
+
+  for( const char *path : { "/t/x/y/z", "/t/x/q", "/t/q", "/u" } )
+    EXPECT_EQ( TrieLookup( trie, path, { list } ).pprivs,
+               WalkLookup( path, { list } ).pprivs ) << path;
+
+  delete list;
+  delete tmplt;
+}
+
+TEST(XrdAccPathTrieTests, MatchesListWalk)
+{
+  std::mt19937 rng( 1234 );
+  const char alphabet[] = "/ab";
+  auto randomPath = [&]( int maxLen )
+  {
+    std::string path = "/";
+    int len = rng() % maxLen;
+    for( int i = 0; i < len; ++i ) path += alphabet[rng() % 3];
+    return path;
+  };
+
+  std::vector<XrdAccCapability*> lists;
+  XrdAccPathTrie trie;
+  for( int l = 0; l < 40; ++l )
+  {
+    XrdAccCapability *head = 0, *last = 0;
+    int n = 1 + rng() % 20;
+    for( int i = 0; i < n; ++i )
+    {
+      XrdAccCapability *cap;
+      if( !lists.empty() && rng() % 10 == 0 )
+        cap = new XrdAccCapability( lists[rng() % lists.size()] );
+      else
+      {
+        XrdAccPrivCaps caps = MakePrivs( rng() & 0x1ff,
+                                         ( rng() % 4 ) ? 0 : rng() & 0x1ff );
+        cap = new XrdAccCapability( (char*)randomPath( 8 ).c_str(), caps );
+      }
+      if( last ) last->Add( cap );
+      else head = cap;
+      last = cap;
+    }
+    lists.push_back( head );
+  }
+  for( auto cap : lists ) trie.Add( cap );
+
+  for( int q = 0; q < 20000; ++q )
+  {
+    std::vector<XrdAccCapability*> use;
+    int n = 1 + rng() % 6;
+    for( int i = 0; i < n; ++i ) use.push_back( lists[rng() % lists.size()] );
+    std::string path = randomPath( 12 );
+    XrdAccPrivCaps t = TrieLookup( trie, path.c_str(), use );
+    XrdAccPrivCaps w = WalkLookup( path.c_str(), use );
+    ASSERT_EQ( t.pprivs, w.pprivs ) << path;
+    ASSERT_EQ( t.nprivs, w.nprivs ) << path;
+  }
+
+  for( auto cap : lists ) delete cap;
+}
@@ -0,0 +1,136 @@
+#include "XrdSciTokens/XrdSciTokensCache.hh"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  struct Rules
+  {
+    std::string name;
+    Rules( const std::string &n ) : name( n ) {}
+  };
+
+  typedef XrdSciTokensCache<Rules> Cache;
+
+  std::shared_ptr<Rules> MakeRules( const std::string &name )
+  {
+    return std::make_shared<Rules>( name );
+  }
+}
+
+TEST(XrdSciTokensCacheTests, HitsMissesAndExpiry)
+{
+  Cache cache;
+  EXPECT_FALSE( cache.get( "tokenA", 100 ) );
+
+  cache.put( "tokenA", MakeRules( "A" ), 160 );
+  auto entry = cache.get( "tokenA", 150 );
+  ASSERT_TRUE( entry );
+  EXPECT_EQ( entry->rules()->name, "A" );
+  EXPECT_FALSE( cache.get( "tokenB", 150 ) );
+
+  // Past its expiry the token is gone for good
+  EXPECT_FALSE( cache.get( "tokenA", 161 ) );
+  EXPECT_FALSE( cache.get( "tokenA", 100 ) );
+
+  XrdSciTokensMon::CacheStats stats = cache.stats();
+  EXPECT_EQ( stats.entries, 0u );
+  EXPECT_EQ( stats.hits, 1u );
+  EXPECT_EQ( stats.misses, 4u );
+  EXPECT_EQ( stats.expirations, 1u );
+}
+
+TEST(XrdSciTokensCacheTests, EvictsLeastRecentlyUsed)
+{
+  Cache cache( 3, 4, 1 );
+  cache.put( "t1", MakeRules( "1" ), 1000 );
+  cache.put( "t2", MakeRules( "2" ), 1000 );
+  cache.put( "t3", MakeRules( "3" ), 1000 );
+  ASSERT_TRUE( cache.get( "t1", 0 ) );
+  cache.put( "t4", MakeRules( "4" ), 1000 );
+
+  EXPECT_TRUE( cache.get( "t1", 0 ) );
+  EXPECT_FALSE( cache.get( "t2", 0 ) );
+  EXPECT_TRUE( cache.get( "t3", 0 ) );
+  EXPECT_TRUE( cache.get( "t4", 0 ) );
+  EXPECT_EQ( cache.stats().evictions, 1u );
+  EXPECT_EQ( cache.stats().entries, 3u );
+
+  // Shrinking the cache takes effect as tokens are added
+  cache.configure( 1, 4 );
+  cache.put( "t5", MakeRules( "5" ), 1000 );
+  EXPECT_EQ( cache.stats().entries, 1u );
+  EXPECT_TRUE( cache.get( "t5", 0 ) );
+
+  // Expired tokens are purged whether or not they are looked up
+  cache.put( "t6", MakeRules( "6" ), 10 );
+  EXPECT_EQ( cache.purge( 11 ), 1u );
+  EXPECT_EQ( cache.stats().entries, 0u );
+}
+
+TEST(XrdSciTokensCacheTests, RemembersRecentDecisions)
+{
+  Cache cache( 10, 2 );
+  auto entry = cache.put( "token", MakeRules( "T" ), 1000 );
+
+  Cache::Decision decision;
+  EXPECT_FALSE( entry->recall( AOP_Read, "/a", decision ) );
+  decision.scope_success = true;
+  decision.username      = "alice";
+  entry->remember( AOP_Read, "/a", decision );
+  decision.scope_success = false;
+  entry->remember( AOP_Update, "/a", decision );
+
+  Cache::Decision out;
+  ASSERT_TRUE( cache.get( "token", 0 )->recall( AOP_Read, "/a", out ) );
+  EXPECT_TRUE( out.scope_success );
+  EXPECT_EQ( out.username, "alice" );
+  ASSERT_TRUE( entry->recall( AOP_Update, "/a", out ) );
+  EXPECT_FALSE( out.scope_success );
+  EXPECT_FALSE( entry->recall( AOP_Read, "/b", out ) );
+
+  // The memo is bounded, the oldest decision goes first
+  entry->remember( AOP_Read, "/b", decision );
+  EXPECT_FALSE( entry->recall( AOP_Read, "/a", out ) );
+  EXPECT_TRUE( entry->recall( AOP_Update, "/a", out ) );
+  EXPECT_TRUE( entry->recall( AOP_Read, "/b", out ) );
+
+  // A replaced token starts out with an empty memo
+  auto fresh = cache.put( "token", MakeRules( "T2" ), 1000 );
+  EXPECT_FALSE( fresh->recall( AOP_Read, "/b", out ) );
+
+  XrdSciTokensMon::CacheStats stats = cache.stats();
+  EXPECT_EQ( stats.memo_hits, 4u );
+  EXPECT_EQ( stats.memo_misses, 4u );
+}
+
+TEST(XrdSciTokensCacheTests, ConcurrentAccess)
+{
+  Cache cache( 64 );
+  std::vector<std::thread> threads;
+  for( int t = 0; t < 4; ++t )
+    threads.emplace_back( [&cache, t]()
+    {
+      for( int i = 0; i < 20000; ++i )
+      {
+        std::string token = "token" + std::to_string( ( i * 7 + t ) % 200 );
+        auto entry = cache.get( token, 0 );
+        if( !entry )
+          entry = cache.put( token, MakeRules( token ), 1000 );
+        ASSERT_EQ( entry->rules()->name, token );
+        Cache::Decision decision;
+        if( !entry->recall( AOP_Read, "/p", decision ) )
+          entry->remember( AOP_Read, "/p", decision );
+      }
+    } );
+  for( auto &thread : threads ) thread.join();
+
+  XrdSciTokensMon::CacheStats stats = cache.stats();
+  EXPECT_LE( stats.entries, 64u );
+  EXPECT_EQ( stats.hits + stats.misses, 80000u );
+  EXPECT_EQ( stats.memo_hits + stats.memo_misses, 80000u );
+}
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+// Micro-benchmark for the checksum kernels.
+//
+// Usage: xrdcks-bench [<MiB per measurement>]
+//
+// For each algorithm, each kernel available on this host and each buffer
+// size, the same buffer is checksummed repeatedly until the requested amount
+// of data has been processed. The throughput is reported in GB/s together
+// with the speedup relative to the software kernel of the algorithm. Finally,
+// the CRC-32C batch kernels are measured over 4 KiB pages.
+//------------------------------------------------------------------------------
+
+#include "XrdCks/XrdCksAdler32.hh"
+#include "XrdOuc/XrdOucCRCEngine.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+typedef uint32_t (*Kernel)(uint32_t, const void *, size_t);
+
+const size_t bSizes[] = {64, 512, 4096, 65536, 1024*1024, 16*1024*1024};
+
+struct Algo
+      {const char  *name;
+       uint32_t     seed;
+       const char  *kNames[5];
+       Kernel     (*getKern)(const char *kname);
+      };
+
+Kernel AdlerKern(const char *kname) {return XrdCksAdler32::Engine(kname);}
+
+Kernel Crc32CKern(const char *kname)
+       {return XrdOucCRCEngine::Engine(XrdOucCRCEngine::CRC32C, kname);}
+
+Kernel Crc32PKern(const char *kname)
+       {return XrdOucCRCEngine::Engine(XrdOucCRCEngine::CRC32P, kname);}
+
+// The first kernel listed is the reference for the speedup column.
+//
+const Algo algoTab[] =
+     {{"adler32", 1, {"scalar", "ssse3", "avx2", "avx512", "neon"}, AdlerKern},
+      {"crc32c",  0, {"sw", "sse42", "pclmul", "vpclmul", 0},       Crc32CKern},
+      {"crc32",   0, {"sw", "pclmul", "vpclmul", 0, 0},             Crc32PKern}
+     };
+
+// Measure the page checksum throughput of a batch kernel over pgNum pages.
+//
+double MeasurePages(XrdOucCRCEngine::BKernel bkern, const unsigned char *buff,
+                    size_t total)
+{
+   static const int pgNum = 64;
+   const void *pgP[pgNum];
+   size_t      pgL[pgNum];
+   uint32_t    csv[pgNum];
+   size_t      reps = total / (pgNum * 4096) + 1;
+
+   for (int i = 0; i < pgNum; i++) {pgP[i] = buff + i*4096; pgL[i] = 4096;}
+
+   auto beg = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < reps; i++) bkern(pgP, pgL, csv, pgNum);
+   auto end = std::chrono::steady_clock::now();
+
+   double secs = std::chrono::duration<double>(end - beg).count();
+   return (secs > 0 ? (double)(reps * pgNum * 4096) / secs / 1e9 : 0.0);
+}
+
+double Measure(Kernel kern, uint32_t seed, const unsigned char *buff,
+               size_t blen, size_t total, uint32_t &result)
+{
+   size_t   reps = total / blen + 1;
+   uint32_t val  = seed;
+
+   auto beg = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < reps; i++) val = kern(val, buff, blen);
+   auto end = std::chrono::steady_clock::now();
+
+   result = val;
+   double secs = std::chrono::duration<double>(end - beg).count();
+   return (secs > 0 ? (double)(reps * blen) / secs / 1e9 : 0.0);
+}
+}
+
+int main(int argc, char **argv)
+{
+   size_t total = (argc > 1 ? strtoul(argv[1], 0, 10) : 256) * 1024 * 1024;
+   std::vector<unsigned char> data(bSizes[sizeof(bSizes)/sizeof(size_t)-1]);
+
+   for (auto &c : data) c = (unsigned char)(rand() & 0xff);
+
+   printf("%8s %8s %10s %10s %8s\n",
+          "algo", "kernel", "bsize", "GB/s", "speedup");
+
+   for (const Algo &algo : algoTab)
+       {for (size_t bsz : bSizes)
+            {uint32_t refVal = 0, val;
+             double   refRate = 0;
+             for (const char *kname : algo.kNames)
+                 {Kernel kern;
+                  if (!kname || !(kern = algo.getKern(kname))) continue;
+                  double rate = Measure(kern, algo.seed, data.data(), bsz,
+                                        total, val);
+                  if (refRate == 0) {refRate = rate; refVal = val;}
+                  printf("%8s %8s %10zu %10.2f %8.2f%s\n", algo.name, kname,
+                         bsz, rate, rate/refRate,
+                         (val == refVal ? "" : "  MISMATCH!"));
+                 }
+            }
+       }
+
+   printf("\n%8s %8s %10s %10s\n", "pages", "batch", "bsize", "GB/s");
+   for (const char *bname : {"loop", "lanes"})
+       {XrdOucCRCEngine::BKernel bkern = XrdOucCRCEngine::BatchEngine(bname);
+        if (bkern) printf("%8s %8s %10d %10.2f\n", "crc32c", bname, 4096,
+                          MeasurePages(bkern, data.data(), total));
+       }
+   return 0;
+}
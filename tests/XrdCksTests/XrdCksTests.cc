@@ -0,0 +1,271 @@
+#undef NDEBUG
+
+#include "XrdCks/XrdCksAdler32.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32C.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdCks/XrdCksManager.hh"
+#include "XrdOuc/XrdOucCRC.hh"
+#include "XrdOuc/XrdOucCRC32C.hh"
+#include "XrdOuc/XrdOucCRCEngine.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdVersion.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <gtest/gtest.h>
+
+static const char *kernNames[] = {"scalar", "ssse3", "avx2", "avx512", "neon"};
+static const char *crcNames[]  = {"sw", "sse42", "pclmul", "vpclmul"};
+
+static uint32_t ntohcs(const char *csval)
+{
+   uint32_t val;
+   memcpy(&val, csval, sizeof(val));
+   return ntohl(val);
+}
+
+class XrdCksTests : public ::testing::Test
+{
+protected:
+
+void SetUp() override
+     {srand48(1234);
+      data.resize(1024*1024 + 256);
+      for (auto &c : data) c = (unsigned char)(lrand48() & 0xff);
+     }
+
+std::vector<unsigned char> data;
+};
+
+TEST_F(XrdCksTests, Adler32KernelsMatchZlib)
+{
+   static const size_t lens[] = {0, 1, 15, 16, 31, 32, 33, 63, 64, 65, 127,
+                                 5551, 5552, 5553, 65536, 1024*1024};
+
+   for (const char *kname : kernNames)
+       {XrdCksAdler32::Kernel kern = XrdCksAdler32::Engine(kname);
+        if (!kern) continue;
+        for (size_t len : lens)
+            for (size_t off = 0; off < 4; off++)
+                {uLong zval = adler32(1L, data.data()+off, len);
+                 EXPECT_EQ(kern(1, data.data()+off, len), (uint32_t)zval)
+                           << kname << " len=" << len << " off=" << off;
+                }
+       }
+}
+
+TEST_F(XrdCksTests, Adler32KernelsWorstCase)
+{
+// All 0xff bytes produce the largest intermediate sums.
+//
+   std::vector<unsigned char> ones(256*1024, 0xff);
+   const uint32_t seed = 0xfff0fff0;
+   uLong zval = adler32(seed, ones.data(), ones.size());
+
+   for (const char *kname : kernNames)
+       {XrdCksAdler32::Kernel kern = XrdCksAdler32::Engine(kname);
+        if (kern)
+           {EXPECT_EQ(kern(seed, ones.data(), ones.size()), (uint32_t)zval)
+                      << kname;
+           }
+       }
+}
+
+TEST_F(XrdCksTests, Adler32Incremental)
+{
+   XrdCksCalcadler32 calc;
+   size_t pos = 0, step = 1;
+
+   while(pos < data.size())
+        {size_t n = std::min(step, data.size() - pos);
+         calc.Update((const char *)data.data()+pos, (int)n);
+         pos += n; step = step * 3 + 1;
+        }
+
+   EXPECT_EQ(ntohcs(calc.Final()),
+             (uint32_t)adler32(1L, data.data(), data.size()));
+}
+
+TEST_F(XrdCksTests, Adler32EngineName)
+{
+   ASSERT_NE(XrdCksAdler32::Engine(), nullptr);
+   EXPECT_EQ(XrdCksAdler32::Engine(), XrdCksAdler32::Engine(XrdCksAdler32::Name()));
+   EXPECT_EQ(XrdCksAdler32::Engine("bogus"), nullptr);
+}
+
+TEST_F(XrdCksTests, CrcKnownValues)
+{
+   const char *check = "123456789";
+   XrdCksCalccrc32  crc32;
+   XrdCksCalccrc32C crc32C;
+
+// The POSIX cksum of the check string (i.e. "echo -n 123456789 | cksum").
+//
+   EXPECT_EQ(ntohcs(crc32.Calc(check, 9)), 930766865U);
+   EXPECT_EQ(ntohcs(crc32C.Calc(check, 9)), 0xE3069283U);
+}
+
+TEST_F(XrdCksTests, CrcKernelsMatchSoftware)
+{
+   static const size_t lens[] = {0, 1, 15, 16, 17, 63, 64, 65, 127, 128, 255,
+                                 256, 257, 511, 1000, 4095, 4096, 4097,
+                                 65536+48, 1024*1024};
+   static const XrdOucCRCEngine::Algo algos[] = {XrdOucCRCEngine::CRC32C,
+                                                 XrdOucCRCEngine::CRC32P};
+
+   for (auto algo : algos)
+       {XrdOucCRCEngine::Kernel sw = XrdOucCRCEngine::Engine(algo, "sw");
+        ASSERT_NE(sw, nullptr);
+        for (const char *kname : crcNames)
+            {XrdOucCRCEngine::Kernel kern = XrdOucCRCEngine::Engine(algo, kname);
+             if (!kern) continue;
+             for (size_t len : lens)
+                 for (size_t off = 0; off < 3; off++)
+                     {uint32_t seed = (uint32_t)(len * 2654435761U);
+                      EXPECT_EQ(kern(seed, data.data()+off, len),
+                                sw  (seed, data.data()+off, len))
+                                << "algo=" << algo << ' ' << kname
+                                << " len=" << len << " off=" << off;
+                     }
+            }
+       }
+}
+
+TEST_F(XrdCksTests, CrcDefaultKernel)
+{
+   EXPECT_EQ(crc32c(0, data.data(), data.size()),
+             crc32c_sw(0, data.data(), data.size()));
+   EXPECT_EQ(XrdOucCRCEngine::Engine(XrdOucCRCEngine::CRC32C),
+             XrdOucCRCEngine::Engine(XrdOucCRCEngine::CRC32C,
+                          XrdOucCRCEngine::Name(XrdOucCRCEngine::CRC32C)));
+   EXPECT_EQ(XrdOucCRCEngine::Engine(XrdOucCRCEngine::CRC32P, "bogus"),
+             nullptr);
+}
+
+TEST_F(XrdCksTests, Crc32CBatch)
+{
+   static const char *bNames[] = {"lanes", "loop"};
+   const void *bP[11];
+   size_t      bL[11];
+   uint32_t    csv[11];
+
+// Use buffers of different lengths and alignments.
+//
+   for (int i = 0; i < 11; i++)
+       {bP[i] = data.data() + i*4099 + i;
+        bL[i] = (i == 5 ? 0 : 4096 - (i & 3)*13 + (i == 9 ? 6000 : 0));
+       }
+
+   for (const char *bname : bNames)
+       {XrdOucCRCEngine::BKernel bkern = XrdOucCRCEngine::BatchEngine(bname);
+        if (!bkern) continue;
+        for (int n = 0; n <= 11; n++)
+            {memset(csv, 0xff, sizeof(csv));
+             bkern(bP, bL, csv, n);
+             for (int i = 0; i < n; i++)
+                 EXPECT_EQ(csv[i], crc32c_sw(0, bP[i], bL[i]))
+                           << bname << " n=" << n << " i=" << i;
+            }
+       }
+}
+
+TEST_F(XrdCksTests, Crc32CPages)
+{
+   const size_t count = 37*4096 + 1234;
+   const int    pgNum = 38;
+   std::vector<uint32_t> csval(pgNum), valcs(pgNum);
+   bool valok[pgNum];
+   uint32_t badcs;
+
+   XrdOucCRC::Calc32C(data.data(), count, csval.data());
+   for (int i = 0; i < pgNum; i++)
+       {size_t len = (i < pgNum-1 ? 4096 : 1234);
+        EXPECT_EQ(csval[i], crc32c_sw(0, data.data()+i*4096, len)) << i;
+       }
+
+   EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), count, csval.data(), badcs), -1);
+   EXPECT_TRUE(XrdOucCRC::Ver32C(data.data(), count, csval.data(), valok));
+   EXPECT_TRUE(XrdOucCRC::Ver32C(data.data(), count, csval.data(),
+                                 valcs.data()));
+
+   csval[20] ^= 1;
+   EXPECT_EQ(XrdOucCRC::Ver32C(data.data(), count, csval.data(), badcs), 20);
+   EXPECT_EQ(badcs, csval[20] ^ 1);
+   EXPECT_FALSE(XrdOucCRC::Ver32C(data.data(), count, csval.data(), valok));
+   for (int i = 0; i < pgNum; i++) EXPECT_EQ(valok[i], i != 20) << i;
+   EXPECT_FALSE(XrdOucCRC::Ver32C(data.data(), count, csval.data(),
+                                  valcs.data()));
+   EXPECT_EQ(valcs[20], csval[20] ^ 1);
+}
+
+TEST_F(XrdCksTests, MergePieces)
+{
+   static const size_t cuts[] = {0, 1, 7, 4096, 65537, 1024*1024};
+   XrdCksCalc *whole[] = {new XrdCksCalcadler32, new XrdCksCalccrc32,
+                          new XrdCksCalccrc32C};
+   const size_t len = 1024*1024 + 256;
+
+   for (XrdCksCalc *wP : whole)
+       {int csSize;
+        const char *name = wP->Type(csSize);
+        wP->Update((const char *)data.data(), len);
+        uint32_t want = ntohcs(wP->Final());
+        for (size_t cut : cuts)
+            {XrdCksCalc *aP = wP->New(), *bP = wP->New();
+             aP->Update((const char *)data.data(), cut);
+             bP->Update((const char *)data.data()+cut, len-cut);
+             XrdCksCalcMerge *mP = dynamic_cast<XrdCksCalcMerge *>(aP);
+             ASSERT_TRUE(mP) << name;
+             EXPECT_TRUE(mP->Merge(*bP, len-cut));
+             EXPECT_EQ(ntohcs(aP->Final()), want) << name << " cut=" << cut;
+             aP->Recycle(); bP->Recycle();
+            }
+        wP->Recycle();
+       }
+}
+
+TEST_F(XrdCksTests, ManagerParallelCalc)
+{
+   static XrdVERSIONINFODEF(myVer, XrdCksTests, XrdVNUMBER, XrdVERSION);
+   static const char *algs[] = {"adler32", "crc32", "crc32c", "md5"};
+   XrdSysLogger   logger;
+   XrdSysError    eDest(&logger, "XrdCksTests");
+   XrdCksManager  cksMan(&eDest, 0, myVer);
+   char fn[] = "/tmp/xrdcks-unit-test.XXXXXX";
+   int  fd = mkstemp(fn);
+
+// Create a file large enough to be split into pieces. The odd length makes
+// sure the last piece is not a multiple of anything interesting.
+//
+   ASSERT_GE(fd, 0);
+   for (int i = 0; i < 129; i++)
+       ASSERT_EQ(write(fd, data.data()+i, 1024*1024), 1024*1024);
+   ASSERT_EQ(write(fd, data.data(), 12345), 12345);
+   close(fd);
+   ASSERT_TRUE(cksMan.Init(0));
+
+   for (const char *alg : algs)
+       {XrdCksData cks1, cks2, cks3;
+        cks1.Set(alg); cks2.Set(alg); cks3.Set(alg);
+        XrdCksManager::SetThreads(1);
+        EXPECT_EQ(cksMan.Calc(fn, cks1, 0), 0) << alg;
+        XrdCksManager::SetThreads(2);
+        EXPECT_EQ(cksMan.Calc(fn, cks2, 0), 0) << alg;
+        XrdCksManager::SetThreads(5);
+        EXPECT_EQ(cksMan.Calc(fn, cks3, 0), 0) << alg;
+        EXPECT_EQ(cks1.Length, cks2.Length) << alg;
+        EXPECT_EQ(memcmp(cks1.Value, cks2.Value, cks1.Length), 0) << alg;
+        EXPECT_EQ(memcmp(cks1.Value, cks3.Value, cks1.Length), 0) << alg;
+       }
+   XrdCksManager::SetThreads(1);
+   unlink(fn);
+}
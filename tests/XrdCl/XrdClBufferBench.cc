@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+// Allocation benchmark for the XrdCl message buffers.
+//
+// Usage: xrdcl-buffer-bench [<requests per thread> [<max threads>]]
+//
+// Every simulated request goes through the buffer life cycle of a kXR_read:
+// the request message is allocated and grown to hold its arguments, the
+// response header is read into a second message which is then grown to the
+// size of the payload, and finally both are freed. For 1, 2, 4, ... up to the
+// number of cpus threads the time per request and the number of system
+// allocations per request are reported with the buffer pool switched off and
+// on.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClBlockPool.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  using namespace XrdCl;
+
+  const uint32_t payloads[] = { 512, 4096, 65536, 4096, 131072, 1024, 1048576,
+                                8192 };
+  const int      nPayloads  = sizeof( payloads ) / sizeof( payloads[0] );
+
+  struct Result
+  {
+    double nsPerReq;
+    double allocsPerReq;
+  };
+
+  void RunRequests( int nReqs )
+  {
+    for( int i = 0; i < nReqs; ++i )
+    {
+      Message *req = new Message( sizeof( ClientRequestHdr ) );
+      req->ReAllocate( sizeof( ClientReadRequest ) + sizeof( read_args ) );
+      req->Zero();
+
+      Message *rsp = new Message( sizeof( ServerResponseHeader ) );
+      rsp->Zero();
+      rsp->ReAllocate( sizeof( ServerResponseHeader )
+                       + payloads[i % nPayloads] );
+      rsp->GetBuffer( sizeof( ServerResponseHeader ) )[0] = 1;
+
+      delete rsp;
+      delete req;
+    }
+  }
+
+  Result Measure( uint64_t poolSize, int nThreads, int nReqs )
+  {
+    BlockPool::SetMaxCached( poolSize );
+    RunRequests( nReqs / 10 + 1 );   // warm up the caches
+
+    std::vector<std::thread> threads;
+    uint64_t before = BlockPool::GetStats().sysAllocs;
+    auto     beg    = std::chrono::steady_clock::now();
+    for( int t = 0; t < nThreads; ++t )
+      threads.emplace_back( RunRequests, nReqs );
+    for( auto &t : threads ) t.join();
+    auto     end    = std::chrono::steady_clock::now();
+    uint64_t after  = BlockPool::GetStats().sysAllocs;
+
+    double total = double( nThreads ) * nReqs;
+    Result result;
+    result.nsPerReq     = std::chrono::duration<double, std::nano>( end - beg ).count()
+                          / total;
+    result.allocsPerReq = double( after - before ) / total;
+    return result;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  int nReqs = ( argc > 1 ? atoi( argv[1] ) : 200000 );
+  int nCpus = static_cast<int>( sysconf( _SC_NPROCESSORS_ONLN ) );
+  int maxT  = ( argc > 2 ? atoi( argv[2] ) : nCpus );
+
+  if( nReqs <= 0 || maxT <= 0 )
+  {
+    fprintf( stderr, "Usage: %s [<requests per thread> [<max threads>]]\n",
+             argv[0] );
+    return 1;
+  }
+
+  printf( "%d cpus, %d requests per thread; ns and system allocations per "
+          "request\n", nCpus, nReqs );
+  printf( "%8s %10s %10s %10s %10s %8s\n", "threads", "malloc ns", "allocs",
+          "pool ns", "allocs", "speedup" );
+
+  for( int t = 1; t <= maxT; t = ( t < maxT && t*2 > maxT ? maxT : t*2 ) )
+  {
+    Result sys  = Measure( 0, t, nReqs );
+    Result pool = Measure( 64*1024*1024, t, nReqs );
+    printf( "%8d %10.1f %10.3f %10.1f %10.3f %7.2fx\n", t, sys.nsPerReq,
+            sys.allocsPerReq, pool.nsPerReq, pool.allocsPerReq,
+            sys.nsPerReq / pool.nsPerReq );
+    if( t == maxT ) break;
+  }
+  return 0;
+}
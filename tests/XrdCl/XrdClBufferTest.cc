@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include "XrdCl/XrdClBuffer.hh"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Switch the pool on for the duration of a test
+  //----------------------------------------------------------------------------
+  class BufferPoolTest: public ::testing::Test
+  {
+    protected:
+      void SetUp()    override { BlockPool::SetMaxCached( 64*1024*1024 ); }
+      void TearDown() override { BlockPool::SetMaxCached( 0 ); }
+  };
+
+  void Fill( Buffer &buffer, uint32_t size )
+  {
+    for( uint32_t i = 0; i < size; ++i )
+      buffer.GetBuffer()[i] = char( i % 251 );
+  }
+
+  bool Check( const char *data, uint32_t size )
+  {
+    for( uint32_t i = 0; i < size; ++i )
+      if( data[i] != char( i % 251 ) ) return false;
+    return true;
+  }
+}
+
+//------------------------------------------------------------------------------
+// With the pool off all memory is plain malloc memory
+//------------------------------------------------------------------------------
+TEST(BufferTest, PoolOff)
+{
+  BlockPool::SetMaxCached( 0 );
+  Buffer buffer( 100 );
+  EXPECT_EQ( BlockPool::Capacity( buffer.GetBuffer() ), 0u );
+  Fill( buffer, 100 );
+  buffer.ReAllocate( 5000 );
+  EXPECT_EQ( BlockPool::Capacity( buffer.GetBuffer() ), 0u );
+  EXPECT_TRUE( Check( buffer.GetBuffer(), 100 ) );
+  char *data = buffer.Release();
+  EXPECT_TRUE( Check( data, 100 ) );
+  free( data );
+}
+
+//------------------------------------------------------------------------------
+// Allocations come from size classes and freed blocks are reused
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, Allocate)
+{
+  char *first;
+  {
+    Buffer buffer( 100 );
+    first = buffer.GetBuffer();
+    EXPECT_EQ( buffer.GetSize(), 100u );
+    EXPECT_EQ( BlockPool::Capacity( first ), 128u );
+  }
+
+  uint64_t allocs = BlockPool::GetStats().sysAllocs;
+  Buffer buffer( 120 );
+  EXPECT_EQ( buffer.GetBuffer(), first );
+  EXPECT_EQ( BlockPool::GetStats().sysAllocs, allocs );
+
+  Buffer large( BlockPool::MaxBlock + 1 );
+  EXPECT_EQ( BlockPool::Capacity( large.GetBuffer() ), 0u );
+}
+
+//------------------------------------------------------------------------------
+// Blocks of a page or more are page aligned, smaller ones cache line aligned
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, Alignment)
+{
+  Buffer small( 200 ), page( 4096 ), large( 100000 );
+  EXPECT_EQ( uintptr_t( small.GetBuffer() ) % 64, 0u );
+  EXPECT_EQ( uintptr_t( page.GetBuffer() ) % 4096, 0u );
+  EXPECT_EQ( uintptr_t( large.GetBuffer() ) % 4096, 0u );
+}
+
+//------------------------------------------------------------------------------
+// Allocations are counted per thread and survive the thread's exit
+//------------------------------------------------------------------------------
+TEST(BufferTest, Stats)
+{
+  BlockPool::SetMaxCached( 0 );
+  BlockPool::Stats before = BlockPool::GetStats();
+  std::thread worker( []() {
+    for( int i = 0; i < 10; ++i ) Buffer buffer( 100 );
+  } );
+  worker.join();
+  BlockPool::Stats after = BlockPool::GetStats();
+  EXPECT_EQ( after.sysAllocs - before.sysAllocs, 10u );
+  EXPECT_EQ( after.sysFrees  - before.sysFrees,  10u );
+}
+
+//------------------------------------------------------------------------------
+// Growing within the block keeps it, outgrowing it moves the data
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, ReAllocate)
+{
+  Buffer buffer( 100 );
+  Fill( buffer, 100 );
+  char *block = buffer.GetBuffer();
+
+  buffer.ReAllocate( 128 );
+  EXPECT_EQ( buffer.GetBuffer(), block );
+  EXPECT_EQ( buffer.GetSize(), 128u );
+
+  buffer.ReAllocate( 3000 );
+  EXPECT_EQ( BlockPool::Capacity( buffer.GetBuffer() ), 4096u );
+  EXPECT_TRUE( Check( buffer.GetBuffer(), 100 ) );
+
+  Fill( buffer, 3000 );
+  buffer.ReAllocate( BlockPool::MaxBlock * 2 );
+  EXPECT_EQ( BlockPool::Capacity( buffer.GetBuffer() ), 0u );
+  EXPECT_TRUE( Check( buffer.GetBuffer(), 3000 ) );
+
+  buffer.ReAllocate( 50 );
+  EXPECT_EQ( buffer.GetSize(), 50u );
+  EXPECT_TRUE( Check( buffer.GetBuffer(), 50 ) );
+}
+
+//------------------------------------------------------------------------------
+// Released memory can always be given to free()
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, Release)
+{
+  Buffer buffer( 1000 );
+  Fill( buffer, 1000 );
+  char *block = buffer.GetBuffer();
+  char *data  = buffer.Release();
+
+  EXPECT_NE( data, block );
+  EXPECT_EQ( BlockPool::Capacity( data ), 0u );
+  EXPECT_TRUE( Check( data, 1000 ) );
+  EXPECT_EQ( buffer.GetBuffer(), nullptr );
+  EXPECT_EQ( buffer.GetSize(), 0u );
+  free( data );
+
+  // The block went back to the pool
+  Buffer other( 1000 );
+  EXPECT_EQ( other.GetBuffer(), block );
+}
+
+//------------------------------------------------------------------------------
+// Grabbed memory stays malloc memory, the block it replaces is pooled again
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, Grab)
+{
+  Buffer buffer( 200 );
+  char *block = buffer.GetBuffer();
+
+  char *data = static_cast<char*>( malloc( 200 ) );
+  memset( data, 'g', 200 );
+  buffer.Grab( data, 200 );
+  EXPECT_EQ( buffer.GetBuffer(), data );
+  EXPECT_EQ( BlockPool::Capacity( data ), 0u );
+
+  buffer.ReAllocate( 100000 );
+  EXPECT_EQ( BlockPool::Capacity( buffer.GetBuffer() ), 0u );
+  EXPECT_EQ( buffer.GetBuffer()[199], 'g' );
+
+  Buffer other( 200 );
+  EXPECT_EQ( other.GetBuffer(), block );
+}
+
+//------------------------------------------------------------------------------
+// Blocks still in use when the pool is switched off go back to the system
+//------------------------------------------------------------------------------
+TEST_F(BufferPoolTest, SwitchOff)
+{
+  Buffer *buffer = new Buffer( 300 );
+  EXPECT_EQ( BlockPool::Capacity( buffer->GetBuffer() ), 512u );
+
+  BlockPool::SetMaxCached( 0 );
+  uint64_t frees = BlockPool::GetStats().sysFrees;
+  delete buffer;
+  EXPECT_EQ( BlockPool::GetStats().sysFrees, frees + 1 );
+}
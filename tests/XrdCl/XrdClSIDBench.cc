@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+// Request/response round trip benchmark for the XrdCl stream ID tables.
+//
+// Usage: xrdcl-sid-bench [<round trips per thread> [<max threads> [<window>]]]
+//
+// Every thread keeps a window of requests in flight on one shared channel.
+// A round trip allocates a SID, installs a handler for it in the in-queue,
+// dispatches a response carrying the SID to the handler which then removes
+// itself, and releases the SID. For 1, 2, 4, ... up to the number of cpus
+// threads the throughput in round trips per second is reported for a copy of
+// the former mutex protected list and maps and for the SIDManager and
+// InQueue of the library.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClInQueue.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XrdCl/XrdClSIDManager.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XProtocol/XProtocol.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  using namespace XrdCl;
+
+  //----------------------------------------------------------------------------
+  // A handler that takes a single response
+  //----------------------------------------------------------------------------
+  class BenchHandler: public MsgHandler
+  {
+    public:
+      uint16_t Examine( std::shared_ptr<Message>& ) override
+      {
+        return RemoveHandler;
+      }
+      uint16_t InspectStatusRsp() override { return 0; }
+      uint16_t GetSid() const override { return sid; }
+      void OnStatusReady( const Message*, XRootDStatus ) override { }
+      time_t GetExpiration() override { return 0; }
+
+      uint16_t sid = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  // The former implementation: a free list and maps under one mutex each
+  //----------------------------------------------------------------------------
+  class OldTables
+  {
+    public:
+      bool Allocate( uint16_t &sid )
+      {
+        XrdSysMutexHelper lck( sidMtx );
+        if( !freeSIDs.empty() )
+        {
+          sid = freeSIDs.front();
+          freeSIDs.pop_front();
+        }
+        else
+        {
+          if( ceiling == 0xffff ) return false;
+          sid = ceiling++;
+        }
+        allocTime[sid] = time( 0 );
+        return true;
+      }
+
+      void Release( uint16_t sid )
+      {
+        XrdSysMutexHelper lck( sidMtx );
+        freeSIDs.push_back( sid );
+        allocTime.erase( sid );
+      }
+
+      void Add( MsgHandler *handler )
+      {
+        XrdSysMutexHelper lck( hMtx );
+        handlers[handler->GetSid()] = std::make_pair( handler, time_t( 0 ) );
+      }
+
+      MsgHandler *Dispatch( std::shared_ptr<Message> &msg, uint16_t sid )
+      {
+        XrdSysMutexHelper lck( hMtx );
+        auto it = handlers.find( sid );
+        if( it == handlers.end() ) return nullptr;
+        MsgHandler *handler = it->second.first;
+        if( handler->Examine( msg ) & MsgHandler::RemoveHandler )
+          handlers.erase( it );
+        return handler;
+      }
+
+    private:
+      XrdSysMutex                                           sidMtx;
+      std::list<uint16_t>                                   freeSIDs;
+      std::unordered_map<uint16_t, time_t>                  allocTime;
+      uint16_t                                              ceiling = 1;
+      XrdSysRecMutex                                        hMtx;
+      std::map<uint16_t, std::pair<MsgHandler*, time_t>>    handlers;
+  };
+
+  //----------------------------------------------------------------------------
+  // The library implementation
+  //----------------------------------------------------------------------------
+  class NewTables
+  {
+    public:
+      NewTables(): sidMgr( SIDMgrPool::Instance().GetSIDMgr(
+                             URL( "root://bench.invalid:1094" ) ) ) { }
+
+      bool Allocate( uint16_t &sid )
+      {
+        uint8_t s[2];
+        if( !sidMgr->AllocateSID( s ).IsOK() ) return false;
+        memcpy( &sid, s, 2 );
+        return true;
+      }
+
+      void Release( uint16_t sid )
+      {
+        uint8_t s[2];
+        memcpy( s, &sid, 2 );
+        sidMgr->ReleaseSID( s );
+      }
+
+      void Add( MsgHandler *handler )
+      {
+        bool rmMsg = false;
+        inQueue.AddMessageHandler( handler, rmMsg );
+      }
+
+      MsgHandler *Dispatch( std::shared_ptr<Message> &msg, uint16_t )
+      {
+        time_t   expires;
+        uint16_t action;
+        return inQueue.GetHandlerForMessage( msg, expires, action );
+      }
+
+    private:
+      std::shared_ptr<SIDManager> sidMgr;
+      InQueue                     inQueue;
+  };
+
+  //----------------------------------------------------------------------------
+  // Run the round trips of one thread
+  //----------------------------------------------------------------------------
+  template<typename Tables>
+  void RunRoundTrips( Tables &tables, int nTrips, int window )
+  {
+    std::vector<BenchHandler>             handlers( window );
+    std::vector<std::shared_ptr<Message>> responses( window );
+    for( auto &rsp : responses )
+    {
+      rsp = std::make_shared<Message>( sizeof( ServerResponseHeader ) );
+      rsp->Zero();
+    }
+
+    for( int n = 0; n < nTrips; n += window )
+    {
+      for( int i = 0; i < window; ++i )
+      {
+        if( !tables.Allocate( handlers[i].sid ) ) abort();
+        tables.Add( &handlers[i] );
+      }
+      for( int i = 0; i < window; ++i )
+      {
+        ServerResponseHeader *hdr =
+          (ServerResponseHeader*)responses[i]->GetBuffer();
+        hdr->streamid[0] = handlers[i].sid & 0xff;
+        hdr->streamid[1] = handlers[i].sid >> 8;
+        if( tables.Dispatch( responses[i], handlers[i].sid ) != &handlers[i] )
+          abort();
+        tables.Release( handlers[i].sid );
+      }
+    }
+  }
+
+  template<typename Tables>
+  double Measure( int nThreads, int nTrips, int window )
+  {
+    Tables tables;
+    std::vector<std::thread> threads;
+
+    auto beg = std::chrono::steady_clock::now();
+    for( int t = 0; t < nThreads; ++t )
+      threads.emplace_back( RunRoundTrips<Tables>, std::ref( tables ), nTrips,
+                            window );
+    for( auto &t : threads ) t.join();
+    auto end = std::chrono::steady_clock::now();
+
+    double secs = std::chrono::duration<double>( end - beg ).count();
+    return double( nThreads ) * ( ( nTrips + window - 1 ) / window ) * window
+           / secs;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  int nTrips = ( argc > 1 ? atoi( argv[1] ) : 1000000 );
+  int nCpus  = static_cast<int>( sysconf( _SC_NPROCESSORS_ONLN ) );
+  int maxT   = ( argc > 2 ? atoi( argv[2] ) : nCpus );
+  int window = ( argc > 3 ? atoi( argv[3] ) : 1024 );
+
+  if( nTrips <= 0 || maxT <= 0 || window <= 0 || window * maxT > 60000 )
+  {
+    fprintf( stderr, "Usage: %s [<round trips per thread> [<max threads> "
+             "[<window>]]]\n       At most 60000 requests may be in flight.\n",
+             argv[0] );
+    return 1;
+  }
+
+  printf( "%d cpus, %d round trips per thread, %d in flight per thread; "
+          "throughput in round trips/sec\n", nCpus, nTrips, window );
+  printf( "%8s %14s %14s %8s\n", "threads", "mutex+maps", "sid tables",
+          "speedup" );
+
+  for( int t = 1; t <= maxT; t = ( t < maxT && t*2 > maxT ? maxT : t*2 ) )
+  {
+    double old = Measure<OldTables>( t, nTrips, window );
+    double sid = Measure<NewTables>( t, nTrips, window );
+    printf( "%8d %14.0f %14.0f %7.2fx\n", t, old, sid, sid / old );
+    if( t == maxT ) break;
+  }
+  return 0;
+}
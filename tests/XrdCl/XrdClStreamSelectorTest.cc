@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include "XrdCl/XrdClStreamSelector.hh"
+#include "XrdCl/XrdClMessage.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Make an unmarshalled response header, kXR_status responses carry the
+  // status body as well
+  //----------------------------------------------------------------------------
+  Message *MakeResponse( uint16_t sid, uint16_t status,
+                         uint8_t resptype = XrdProto::kXR_FinalResult )
+  {
+    Message *msg = new Message( status == kXR_status ?
+                                sizeof( ServerResponseStatus ) :
+                                sizeof( ServerResponseHeader ) );
+    msg->Zero();
+    ServerResponseStatus *rsp = (ServerResponseStatus*)msg->GetBuffer();
+    memcpy( rsp->hdr.streamid, &sid, 2 );
+    rsp->hdr.status = status;
+    if( status == kXR_status )
+      rsp->bdy.resptype = resptype;
+    return msg;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Without measurements the sub-stream with the fewest bytes outstanding wins
+//------------------------------------------------------------------------------
+TEST(StreamSelectorTest, BalancesOutstandingBytes)
+{
+  StreamSelector sel( 4 );
+  std::vector<bool> connected( 3, true );
+
+  EXPECT_EQ( sel.Select( connected, 1, 1000, 0 ), 1 );
+  EXPECT_EQ( sel.Select( connected, 2, 100, 0 ), 2 );
+  EXPECT_EQ( sel.Select( connected, 3, 500, 0 ), 3 );
+  EXPECT_EQ( sel.Select( connected, 4, 10, 0 ), 2 );
+  EXPECT_EQ( sel.GetOutstanding( 2 ), 110u );
+
+  //----------------------------------------------------------------------------
+  // Responses release the bytes, unknown SIDs are ignored
+  //----------------------------------------------------------------------------
+  sel.MsgReceived( 1, 10 );
+  sel.MsgReceived( 99, 10 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 0u );
+  EXPECT_EQ( sel.Select( connected, 5, 10, 10 ), 1 );
+
+  //----------------------------------------------------------------------------
+  // Disconnected sub-streams are skipped, non-reads are not accounted for
+  //----------------------------------------------------------------------------
+  connected[0] = false;
+  EXPECT_EQ( sel.Select( connected, 6, 0, 20 ), 2 );
+  EXPECT_EQ( sel.GetOutstanding( 2 ), 110u );
+}
+
+//------------------------------------------------------------------------------
+// A slow sub-stream gets less work once its throughput has been measured
+//------------------------------------------------------------------------------
+TEST(StreamSelectorTest, PrefersFasterSubStream)
+{
+  StreamSelector sel( 3 );
+  std::vector<bool> connected( 2, true );
+  const uint64_t chunk = 1000000;
+
+  //----------------------------------------------------------------------------
+  // Sub-stream 1 delivers 1MB per 100ms, sub-stream 2 per 10ms
+  //----------------------------------------------------------------------------
+  uint64_t now = 0;
+  uint16_t sid = 1;
+  for( int i = 0; i < 5; ++i )
+  {
+    EXPECT_EQ( sel.Select( connected, sid, chunk, now ), 1 );
+    EXPECT_EQ( sel.Select( connected, sid + 1, chunk, now ), 2 );
+    sel.MsgReceived( sid + 1, now + 10000 );
+    sel.MsgReceived( sid, now + 100000 );
+    now += 100000;
+    sid += 2;
+  }
+
+  int fast = 0;
+  for( int i = 0; i < 10; ++i )
+    if( sel.Select( connected, sid++, chunk, now ) == 2 ) ++fast;
+  EXPECT_GE( fast, 8 );
+}
+
+//------------------------------------------------------------------------------
+// In adaptive mode only as many sub-streams as the backlog needs are used
+//------------------------------------------------------------------------------
+TEST(StreamSelectorTest, AdaptsSubStreamCount)
+{
+  StreamSelector sel( 5, true );
+  std::vector<bool> connected( 4, true );
+  EXPECT_EQ( sel.GetActive(), 4 );
+
+  //----------------------------------------------------------------------------
+  // Single small requests at a time: 10KB per 10ms with a 10ms rtt, the
+  // backlog fits in one sub-stream
+  //----------------------------------------------------------------------------
+  uint64_t now = 0;
+  uint16_t sid = 1;
+  for( int i = 0; i < 400; ++i )
+  {
+    uint16_t s = sel.Select( connected, sid, 10000, now );
+    EXPECT_GE( s, 1 );
+    EXPECT_LE( s, 4 );
+    now += 10000;
+    sel.MsgReceived( sid++, now );
+  }
+  EXPECT_EQ( sel.GetActive(), 1 );
+
+  //----------------------------------------------------------------------------
+  // A large backlog brings the other sub-streams back
+  //----------------------------------------------------------------------------
+  now += 1000000;
+  for( int i = 0; i < 100; ++i )
+    sel.Select( connected, sid++, 1000000, now );
+  now += 1000000;
+  sel.Select( connected, sid++, 1000000, now );
+  EXPECT_EQ( sel.GetActive(), 4 );
+}
+
+//------------------------------------------------------------------------------
+// Only the final response to a request releases its bytes
+//------------------------------------------------------------------------------
+TEST(StreamSelectorTest, RetiresOnFinalResponse)
+{
+  StreamSelector sel( 2 );
+  std::vector<bool> connected( 1, true );
+
+  EXPECT_EQ( sel.Select( connected, 1, 1000, 0 ), 1 );
+  EXPECT_EQ( sel.Select( connected, 2, 500, 0 ), 1 );
+  EXPECT_EQ( sel.Select( connected, 3, 300, 0 ), 1 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 1800u );
+
+  //----------------------------------------------------------------------------
+  // Partial and wait responses leave the request outstanding
+  //----------------------------------------------------------------------------
+  const uint16_t partial[] = { kXR_oksofar, kXR_wait, kXR_waitresp };
+  for( uint16_t status : partial )
+  {
+    std::unique_ptr<Message> msg( MakeResponse( 1, status ) );
+    EXPECT_FALSE( StreamSelector::IsFinal( *msg ) );
+    sel.MsgReceived( *msg, 10 );
+    EXPECT_EQ( sel.GetOutstanding( 1 ), 1800u );
+  }
+  std::unique_ptr<Message> part( MakeResponse( 2, kXR_status,
+                                               XrdProto::kXR_PartialResult ) );
+  sel.MsgReceived( *part, 10 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 1800u );
+
+  //----------------------------------------------------------------------------
+  // The final ones retire it
+  //----------------------------------------------------------------------------
+  std::unique_ptr<Message> ok( MakeResponse( 1, kXR_ok ) );
+  sel.MsgReceived( *ok, 20 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 800u );
+
+  std::unique_ptr<Message> last( MakeResponse( 2, kXR_status ) );
+  EXPECT_TRUE( StreamSelector::IsFinal( *last ) );
+  sel.MsgReceived( *last, 20 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 300u );
+
+  std::unique_ptr<Message> err( MakeResponse( 3, kXR_error ) );
+  sel.MsgReceived( *err, 20 );
+  EXPECT_EQ( sel.GetOutstanding( 1 ), 0u );
+
+  std::unique_ptr<Message> redir( MakeResponse( 4, kXR_redirect ) );
+  EXPECT_TRUE( StreamSelector::IsFinal( *redir ) );
+}
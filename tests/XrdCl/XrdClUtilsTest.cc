@@ -26,8 +26,19 @@
 #include "XrdCl/XrdClAnyObject.hh"
 #include "GTestXrdHelpers.hh"
 #include "XrdCl/XrdClTaskManager.hh"
+#include "XrdCl/XrdClJobManager.hh"
 #include "XrdCl/XrdClSIDManager.hh"
+#include "XrdCl/XrdClInQueue.hh"
+#include "XrdCl/XrdClMessage.hh"
 #include "XrdCl/XrdClPropertyList.hh"
+#include "XProtocol/XProtocol.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Declaration
@@ -163,6 +174,137 @@ TEST(UtilsTest, TaskManagerTest)
   EXPECT_TRUE( taskMan.Stop() );
 }
 
+//------------------------------------------------------------------------------
+// Job Manager test
+//------------------------------------------------------------------------------
+namespace
+{
+  class RecordJob: public XrdCl::Job
+  {
+    public:
+      RecordJob( XrdCl::JobManager &m, std::atomic<int> &d, int n = 0,
+                 bool own = false ): mgr( m ), done( d ), spawn( n ),
+                 selfDelete( own ) { }
+
+      void Run( void* ) override
+      {
+        isWorker = mgr.IsWorker();
+        thread   = pthread_self();
+        //----------------------------------------------------------------------
+        // Jobs queued from a worker go to its own queue
+        //----------------------------------------------------------------------
+        for( int i = 0; i < spawn; ++i )
+          mgr.QueueJob( new RecordJob( mgr, done, 0, true ) );
+        bool own = selfDelete;
+        if( own )
+        {
+          EXPECT_TRUE( isWorker );
+        }
+        ++done;
+        if( own ) delete this;
+      }
+
+      XrdCl::JobManager &mgr;
+      std::atomic<int>  &done;
+      int                spawn;
+      bool               selfDelete;
+      bool               isWorker = false;
+      pthread_t          thread   = 0;
+  };
+}
+
+TEST(UtilsTest, JobManagerTest)
+{
+  using namespace XrdCl;
+
+  for( bool perWorker : { false, true } )
+  {
+    JobManager mgr( 4, perWorker );
+    EXPECT_FALSE( mgr.IsWorker() );
+    EXPECT_TRUE( mgr.Start() );
+
+    const int nJobs = 2000;
+    std::atomic<int> done( 0 );
+    std::vector<RecordJob*> jobs;
+    for( int i = 0; i < nJobs; ++i )
+    {
+      jobs.push_back( new RecordJob( mgr, done, i % 100 ? 0 : 10 ) );
+      if( i % 2 )
+        mgr.QueueJob( jobs.back() );
+      else
+        mgr.QueueJob( jobs.back(), nullptr, 0x1234 );
+    }
+
+    const int expected = nJobs + ( nJobs / 100 ) * 10;
+    for( int i = 0; i < 1000 && done.load() < expected; ++i )
+      std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    EXPECT_EQ( done.load(), expected );
+    EXPECT_TRUE( mgr.Stop() );
+    EXPECT_TRUE( mgr.Finalize() );
+
+    //--------------------------------------------------------------------------
+    // All the jobs ran on a worker
+    //--------------------------------------------------------------------------
+    for( auto job : jobs )
+    {
+      EXPECT_TRUE( job->isWorker );
+      delete job;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Jobs queued by code built against the header that had QueueJob inline, i.e.
+// put straight into the shared queue, must also run with worker queues
+//------------------------------------------------------------------------------
+namespace
+{
+  struct LegacyJobManager
+  {
+    struct JobHelper
+    {
+      JobHelper( XrdCl::Job *j = 0, void *a = 0 ): job(j), arg(a) {}
+      XrdCl::Job *job;
+      void       *arg;
+    };
+
+    std::vector<pthread_t>          pWorkers;
+    XrdCl::SyncQueue<JobHelper>     pJobs;
+    XrdSysMutex                     pMutex;
+    bool                            pRunning;
+  };
+}
+
+TEST(UtilsTest, JobManagerLegacyQueueTest)
+{
+  using namespace XrdCl;
+
+  JobManager mgr( 4, true );
+  EXPECT_TRUE( mgr.Start() );
+
+  const int nJobs = 100;
+  std::atomic<int> done( 0 );
+  std::vector<RecordJob*> jobs;
+  LegacyJobManager *legacy = reinterpret_cast<LegacyJobManager*>( &mgr );
+  for( int i = 0; i < nJobs; ++i )
+  {
+    jobs.push_back( new RecordJob( mgr, done ) );
+    legacy->pJobs.Put( LegacyJobManager::JobHelper( jobs.back(), 0 ) );
+  }
+
+  for( int i = 0; i < 1000 && done.load() < nJobs; ++i )
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  EXPECT_EQ( done.load(), nJobs );
+  EXPECT_TRUE( mgr.Stop() );
+  EXPECT_TRUE( mgr.Finalize() );
+
+  for( auto job : jobs )
+  {
+    EXPECT_TRUE( job->isWorker );
+    delete job;
+  }
+}
+
 //------------------------------------------------------------------------------
 // SID Manager test
 //------------------------------------------------------------------------------
@@ -199,6 +341,141 @@ TEST(UtilsTest, SIDManagerTest)
   EXPECT_EQ( manager->NumberOfTimedOutSIDs(), 0u );
 }
 
+//------------------------------------------------------------------------------
+// SID Manager concurrency test
+//------------------------------------------------------------------------------
+TEST(UtilsTest, SIDManagerConcurrencyTest)
+{
+  using namespace XrdCl;
+  std::shared_ptr<SIDManager> manager = SIDMgrPool::Instance().GetSIDMgr( "root://fake-mt:1094//dir/file" );
+
+  const int nThreads = 4, nSIDs = 5000;
+  std::vector<std::vector<uint16_t>> sids( nThreads );
+  std::vector<std::thread> threads;
+  for( int t = 0; t < nThreads; ++t )
+    threads.emplace_back( [&, t]()
+    {
+      for( int i = 0; i < nSIDs; ++i )
+      {
+        uint8_t sid[2];
+        EXPECT_XRDST_OK( manager->AllocateSID( sid ) );
+        uint16_t s;
+        memcpy( &s, sid, 2 );
+        sids[t].push_back( s );
+        if( i % 2 ) continue;
+        manager->ReleaseSID( sid );
+        sids[t].pop_back();
+      }
+    } );
+  for( auto &t : threads ) t.join();
+
+  //----------------------------------------------------------------------------
+  // The SIDs held are unique and valid, released ones get reused
+  //----------------------------------------------------------------------------
+  std::set<uint16_t> held;
+  for( auto &v : sids )
+    for( uint16_t s : v )
+    {
+      EXPECT_TRUE( s != 0 && s != 0xffff );
+      EXPECT_TRUE( held.insert( s ).second );
+    }
+  EXPECT_EQ( manager->GetNumberOfAllocatedSIDs(), nThreads * nSIDs / 2 );
+  EXPECT_LE( *held.rbegin(), nThreads * nSIDs );
+  EXPECT_TRUE( manager->IsAnySIDOldAs( time( 0 ) ) );
+  EXPECT_FALSE( manager->IsAnySIDOldAs( time( 0 ) - 3600 ) );
+
+  for( uint16_t s : held )
+  {
+    uint8_t sid[2];
+    memcpy( sid, &s, 2 );
+    manager->ReleaseSID( sid );
+  }
+  EXPECT_EQ( manager->GetNumberOfAllocatedSIDs(), 0 );
+  EXPECT_FALSE( manager->IsAnySIDOldAs( time( 0 ) ) );
+}
+
+//------------------------------------------------------------------------------
+// In-queue test
+//------------------------------------------------------------------------------
+namespace
+{
+  class CountingHandler: public XrdCl::MsgHandler
+  {
+    public:
+      CountingHandler( uint16_t s, time_t e ): sid( s ), expires( e ) { }
+
+      uint16_t Examine( std::shared_ptr<XrdCl::Message>& ) override
+      {
+        ++examined;
+        return examined == 2 ? RemoveHandler : None;
+      }
+      uint16_t InspectStatusRsp() override { return 0; }
+      uint16_t GetSid() const override { return sid; }
+      void OnStatusReady( const XrdCl::Message*, XrdCl::XRootDStatus ) override { }
+      time_t GetExpiration() override { return expires; }
+      uint8_t OnStreamEvent( StreamEvent event, XrdCl::XRootDStatus ) override
+      {
+        lastEvent = event;
+        return RemoveHandler;
+      }
+
+      uint16_t sid;
+      time_t   expires;
+      int      examined  = 0;
+      int      lastEvent = 0;
+  };
+
+  std::shared_ptr<XrdCl::Message> Response( uint16_t sid )
+  {
+    auto msg = std::make_shared<XrdCl::Message>( sizeof( ServerResponseHeader ) );
+    msg->Zero();
+    ServerResponseHeader *hdr = (ServerResponseHeader*)msg->GetBuffer();
+    hdr->streamid[0] = sid & 0xff;
+    hdr->streamid[1] = sid >> 8;
+    return msg;
+  }
+}
+
+TEST(UtilsTest, InQueueTest)
+{
+  using namespace XrdCl;
+  InQueue queue;
+  CountingHandler h1( 1, 100 ), h2( 300, 200 ), h3( 0xfffe, 300 );
+  bool rmMsg = false;
+  queue.AddMessageHandler( &h1, rmMsg );
+  queue.AddMessageHandler( &h2, rmMsg );
+  queue.AddMessageHandler( &h3, rmMsg );
+
+  time_t   expires = 0;
+  uint16_t action  = 0;
+  auto msg = Response( 300 );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), &h2 );
+  EXPECT_EQ( expires, 200 );
+  EXPECT_EQ( action, MsgHandler::None );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), &h2 );
+  EXPECT_EQ( action, MsgHandler::RemoveHandler );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), nullptr );
+  msg = Response( 42 );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), nullptr );
+
+  //----------------------------------------------------------------------------
+  // Only the handlers with an expiry at or before now time out
+  //----------------------------------------------------------------------------
+  queue.AssignTimeout( &h1 );
+  queue.AssignTimeout( &h3 );
+  queue.ReportTimeout( 150 );
+  EXPECT_EQ( h1.lastEvent, MsgHandler::Timeout );
+  EXPECT_EQ( h3.lastEvent, 0 );
+  msg = Response( 1 );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), nullptr );
+
+  queue.ReportStreamEvent( MsgHandler::Broken, XRootDStatus() );
+  EXPECT_EQ( h3.lastEvent, MsgHandler::Broken );
+  EXPECT_EQ( h2.lastEvent, 0 );
+  msg = Response( 0xfffe );
+  EXPECT_EQ( queue.GetHandlerForMessage( msg, expires, action ), nullptr );
+}
+
 //------------------------------------------------------------------------------
 // Property List test
 //------------------------------------------------------------------------------
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// This file is part of the XRootD software suite.
+//
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include "XrdCl/XrdClZipIndexCache.hh"
+#include "XrdCl/XrdClMessageUtils.hh"
+
+#include <zlib.h>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+using namespace XrdCl;
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Compressible data made of random words
+  //----------------------------------------------------------------------------
+  std::vector<char> MakeData( size_t size )
+  {
+    static const char *words[] = { "alpha ", "beta ", "gamma ", "delta ",
+                                   "epsilon ", "zeta ", "eta ", "theta\n" };
+    std::mt19937 gen( 1234 );
+    std::vector<char> data;
+    data.reserve( size );
+    while( data.size() < size )
+    {
+      const char *w = words[gen() % 8];
+      data.insert( data.end(), w, w + strlen( w ) );
+      if( gen() % 16 == 0 ) data.push_back( 'a' + gen() % 26 );
+    }
+    data.resize( size );
+    return data;
+  }
+
+  //----------------------------------------------------------------------------
+  // Raw deflate as in a ZIP archive
+  //----------------------------------------------------------------------------
+  std::vector<char> Deflate( const std::vector<char> &data )
+  {
+    z_stream strm;
+    memset( &strm, 0, sizeof( strm ) );
+    EXPECT_EQ( deflateInit2( &strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS,
+                             8, Z_DEFAULT_STRATEGY ), Z_OK );
+    std::vector<char> out( deflateBound( &strm, data.size() ) );
+    strm.next_in   = (Bytef*)data.data();
+    strm.avail_in  = data.size();
+    strm.next_out  = (Bytef*)out.data();
+    strm.avail_out = out.size();
+    EXPECT_EQ( deflate( &strm, Z_FINISH ), Z_STREAM_END );
+    out.resize( strm.total_out );
+    deflateEnd( &strm );
+    return out;
+  }
+
+  //----------------------------------------------------------------------------
+  // Serves the compressed data from memory and counts the bytes served
+  //----------------------------------------------------------------------------
+  struct Source
+  {
+    Source( std::vector<char> data ) : data( std::move( data ) ), served( 0 )
+    {
+    }
+
+    ZipIndexCache::fetch_t Fetch()
+    {
+      return [this]( uint64_t off, uint32_t len, ZipIndexCache::fetched_t cb )
+      {
+        served += len;
+        auto begin = data.begin() + off;
+        cb( XRootDStatus(), ZipIndexCache::buffer_t( begin, begin + len ) );
+      };
+    }
+
+    std::vector<char>     data;
+    std::atomic<uint64_t> served;
+  };
+
+  //----------------------------------------------------------------------------
+  // Read synchronously and check the result against the original data
+  //----------------------------------------------------------------------------
+  void Read( ZipIndexCache &cache, const std::vector<char> &orig,
+             uint64_t offset, uint32_t length )
+  {
+    std::vector<char> buffer( length );
+    SyncResponseHandler handler;
+    cache.QueueReq( offset, length, buffer.data(), &handler );
+    ChunkInfo *chunk = nullptr;
+    XRootDStatus st = MessageUtils::WaitForResponse( &handler, chunk );
+    ASSERT_TRUE( st.IsOK() ) << st.ToString();
+    std::unique_ptr<ChunkInfo> ptr( chunk );
+    uint32_t expected = std::min<uint64_t>( length, orig.size() - offset );
+    ASSERT_EQ( chunk->GetOffset(), offset );
+    ASSERT_EQ( chunk->GetLength(), expected );
+    EXPECT_TRUE( std::equal( buffer.begin(), buffer.begin() + expected,
+                             orig.begin() + offset ) ) << "offset " << offset;
+  }
+
+  const size_t   DataSize = 8 * 1024 * 1024;
+  const uint32_t Span     = 256 * 1024;
+}
+
+//------------------------------------------------------------------------------
+// Reads anywhere return the right data and only inflate from the closest
+// checkpoint once the index covers them
+//------------------------------------------------------------------------------
+TEST(ZipIndexCacheTest, RandomReads)
+{
+  std::vector<char> orig = MakeData( DataSize );
+  Source src( Deflate( orig ) );
+  auto cache = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 0,
+                                           src.Fetch(), Span );
+
+  Read( *cache, orig, 5 * 1024 * 1024, 4096 );
+  Read( *cache, orig, 1000, 100000 );
+  Read( *cache, orig, 3 * 1024 * 1024 + 17, 70000 );
+  Read( *cache, orig, orig.size() - 10, 4096 );
+  EXPECT_TRUE( cache->IndexInfo().second );
+  EXPECT_GT( cache->IndexInfo().first, DataSize / Span / 2 );
+
+  std::mt19937 gen( 42 );
+  src.served = 0;
+  for( int i = 0; i < 50; ++i )
+  {
+    uint64_t offset = gen() % orig.size();
+    Read( *cache, orig, offset, gen() % 65536 + 1 );
+  }
+  // every read inflates at most a few spans worth of compressed data
+  EXPECT_LT( src.served.load(), 50 * uint64_t( 4 ) * Span );
+}
+
+//------------------------------------------------------------------------------
+// A complete index is saved and reused by a new cache for the same file only
+//------------------------------------------------------------------------------
+TEST(ZipIndexCacheTest, Sidecar)
+{
+  std::vector<char> orig = MakeData( DataSize );
+  Source src( Deflate( orig ) );
+  std::string sidecar = "/tmp/xrdcl-zipcache-test." + std::to_string( getpid() ) + ".zidx";
+
+  auto first = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 1, src.Fetch(),
+                                           Span, sidecar, "root://host//a.zip#f" );
+  EXPECT_FALSE( first->IndexInfo().second );
+  Read( *first, orig, orig.size() - 100, 100 );
+  ASSERT_TRUE( first->IndexInfo().second );
+
+  auto second = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 1, src.Fetch(),
+                                            Span, sidecar, "root://host//a.zip#f" );
+  EXPECT_TRUE( second->IndexInfo().second );
+  EXPECT_EQ( second->IndexInfo().first, first->IndexInfo().first );
+  src.served = 0;
+  Read( *second, orig, orig.size() - 100, 100 );
+  EXPECT_LT( src.served.load(), uint64_t( 2 ) * Span );
+
+  auto other = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 1, src.Fetch(),
+                                           Span, sidecar, "root://host//b.zip#f" );
+  EXPECT_FALSE( other->IndexInfo().second );
+  EXPECT_EQ( other->IndexInfo().first, 1u );
+  unlink( sidecar.c_str() );
+}
+
+//------------------------------------------------------------------------------
+// Corrupted and truncated data are reported as errors
+//------------------------------------------------------------------------------
+TEST(ZipIndexCacheTest, BadData)
+{
+  std::vector<char> orig = MakeData( 1024 * 1024 );
+  Source src( Deflate( orig ) );
+  src.data.resize( src.data.size() / 2 );
+  auto cache = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 0,
+                                           src.Fetch(), Span );
+
+  std::vector<char> buffer( 4096 );
+  SyncResponseHandler handler;
+  cache->QueueReq( orig.size() - 4096, 4096, buffer.data(), &handler );
+  ChunkInfo *chunk = nullptr;
+  XRootDStatus st = MessageUtils::WaitForResponse( &handler, chunk );
+  EXPECT_FALSE( st.IsOK() );
+  EXPECT_EQ( st.code, errDataError );
+
+  std::fill( src.data.begin() + 100, src.data.end(), 0xff );
+  SyncResponseHandler handler2;
+  cache = std::make_shared<ZipIndexCache>( src.data.size(), orig.size(), 0, src.Fetch(), Span );
+  cache->QueueReq( 200000, 4096, buffer.data(), &handler2 );
+  st = MessageUtils::WaitForResponse( &handler2, chunk );
+  EXPECT_FALSE( st.IsOK() );
+}
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+// Open rate benchmark for the cmsd location cache.
+//
+// Usage: xrdcms-bench [<opens per thread> [<paths> [<max threads>]]]
+//
+// Every synthetic open is handled the way a redirector handles it: the path
+// is looked up with XrdCmsCache::GetFile() and, when it is not cached, it is
+// added with no location information followed by the "have" response of the
+// server holding the file. Paths follow a skewed popularity distribution and
+// one open in 64 is for a path that gets deleted again right away. Servers
+// bounce now and then so that the bounce history is exercised as well. The
+// run is repeated with 1, 2, 4, ... threads and the open rate is reported.
+// Finally, every path is checked to be located on its server.
+//------------------------------------------------------------------------------
+
+#include "XrdCms/XrdCmsCache.hh"
+#include "XrdCms/XrdCmsRRQ.hh"
+#include "XrdCms/XrdCmsSelect.hh"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// The cache is exercised without the rest of the cmsd. Nothing here ever
+// waits for a location so the redirect request queue is a no-op and the
+// cache clock is never started.
+//------------------------------------------------------------------------------
+namespace XrdCms
+{
+  XrdScheduler *Sched = 0;
+  XrdCmsRRQ     RRQ;
+}
+
+XrdSysMutex    XrdCmsRRQSlot::myMutex;
+XrdCmsRRQSlot *XrdCmsRRQSlot::freeSlot = 0;
+short          XrdCmsRRQSlot::initSlot = 0;
+
+XrdCmsRRQSlot::XrdCmsRRQSlot() : Link(this) {}
+
+short XrdCmsRRQ::Add( short, XrdCmsRRQInfo* ) { return 0; }
+void  XrdCmsRRQ::Del( short, const void* ) {}
+int   XrdCmsRRQ::Ready( int, const void*, SMask_t, SMask_t ) { return 0; }
+
+namespace
+{
+  const int nServers = 32;
+
+  int ServerOf( size_t pathIdx ) { return pathIdx % nServers; }
+
+  //----------------------------------------------------------------------------
+  // One synthetic open, returns true if the cache knew the location
+  //----------------------------------------------------------------------------
+  bool Open( const std::string &path, int server, bool remove )
+  {
+    XrdCmsSelect sel( 0, (char*)path.c_str(), path.size() );
+    SMask_t      mask = 1ULL << server;
+
+    int rc = XrdCms::Cache.GetFile( sel, ~0ULL );
+    if( !rc )
+    {
+      XrdCms::Cache.AddFile( sel, 0 );
+      XrdCms::Cache.AddFile( sel, mask );
+    }
+    if( remove )
+      XrdCms::Cache.DelFile( sel, mask );
+    return rc != 0;
+  }
+
+  double Run( const std::vector<std::string> &paths, int nThreads,
+              int nOpens, std::atomic<long> &hits )
+  {
+    std::vector<std::thread> threads;
+    auto beg = std::chrono::steady_clock::now();
+    for( int t = 0; t < nThreads; ++t )
+      threads.emplace_back( [&, t]()
+      {
+        std::mt19937 rng( 17 + t );
+        std::geometric_distribution<size_t> popular( 20.0 / paths.size() );
+        long myHits = 0;
+        for( int i = 0; i < nOpens; ++i )
+        {
+          size_t p = popular( rng ) % paths.size();
+          if( Open( paths[p], ServerOf( p ), ( i & 63 ) == 63 ) ) ++myHits;
+          if( t == 0 && ( i & 0xffff ) == 0xffff )
+          {
+            int s = rng() % nServers;
+            XrdCms::Cache.Bounce( 1ULL << s, s );
+          }
+        }
+        hits += myHits;
+      } );
+    for( auto &thread : threads ) thread.join();
+    auto end = std::chrono::steady_clock::now();
+    return double( nOpens ) * nThreads /
+           std::chrono::duration<double>( end - beg ).count();
+  }
+}
+
+int main( int argc, char **argv )
+{
+  int nOpens   = ( argc > 1 ? atoi( argv[1] ) : 500000 );
+  int nPaths   = ( argc > 2 ? atoi( argv[2] ) : 200000 );
+  int nThreads = ( argc > 3 ? atoi( argv[3] ) : 8 );
+
+  if( nOpens <= 0 || nPaths <= 0 || nThreads <= 0 )
+  {
+    fprintf( stderr, "Usage: %s [<opens per thread> [<paths> "
+             "[<max threads>]]]\n", argv[0] );
+    return 1;
+  }
+
+  std::vector<std::string> paths;
+  for( int i = 0; i < nPaths; ++i )
+    paths.push_back( "/store/data/run" + std::to_string( i / 1000 ) +
+                     "/file" + std::to_string( i ) + ".root" );
+  for( int s = 0; s < nServers; ++s )
+    XrdCms::Cache.Bounce( 1ULL << s, s );
+
+  printf( "%d paths, %d opens per thread; throughput in opens/sec\n",
+          nPaths, nOpens );
+  printf( "%8s %14s %8s\n", "threads", "opens/sec", "hits" );
+  for( int t = 1; t <= nThreads; t *= 2 )
+  {
+    std::atomic<long> hits( 0 );
+    double rate = Run( paths, t, nOpens, hits );
+    printf( "%8d %14.0f %7.1f%%\n", t, rate,
+            100.0 * hits / ( double( nOpens ) * t ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Refresh every path from its server, the one the cache must locate it on
+  //----------------------------------------------------------------------------
+  for( int i = 0; i < nPaths; ++i )
+  {
+    SMask_t mask = 1ULL << ServerOf( i );
+    Open( paths[i], ServerOf( i ), false );
+    XrdCmsSelect sel( 0, (char*)paths[i].c_str(), paths[i].size() );
+    XrdCms::Cache.AddFile( sel, mask );
+    if( XrdCms::Cache.GetFile( sel, ~0ULL ) != 1 || sel.Vec.hf != mask )
+    {
+      fprintf( stderr, "Wrong location for %s\n", paths[i].c_str() );
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+// Micro-benchmark for the block state queries of XrdPfc::Info.
+//
+// Usage: xrdpfc-bench [<number of blocks> [<number of cinfo files>]]
+//
+// A set of synthetic cinfo files is written to memory for several download
+// patterns. Each file is then read back and the queries used by File::Open(),
+// the purge and the resource monitor are timed, both through Info and through
+// the per-block TestBitWritten() scan they used to be implemented with.
+//------------------------------------------------------------------------------
+
+#include "XrdOss/XrdOss.hh"
+#include "XrdPfc/XrdPfcInfo.hh"
+#include "XrdSys/XrdSysTrace.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace XrdPfc;
+
+namespace
+{
+// A cinfo "file" kept in memory.
+//
+class MemDF : public XrdOssDF
+{
+public:
+
+int     Close(long long *retsz=0) override {return 0;}
+
+ssize_t Read(void *buffer, off_t offset, size_t size) override
+            {if (offset >= (off_t)data.size()) return 0;
+             if (offset + size > data.size()) size = data.size() - offset;
+             memcpy(buffer, data.data() + offset, size);
+             return size;
+            }
+
+ssize_t Write(const void *buffer, off_t offset, size_t size) override
+             {if (offset + size > data.size()) data.resize(offset + size);
+              memcpy(&data[offset], buffer, size);
+              return size;
+             }
+
+std::string data;
+};
+
+struct Pattern
+      {const char *name;
+       int         density;   // percent of blocks downloaded
+       bool        lastBlock; // is the last block downloaded
+      };
+
+const Pattern patTab[] =
+     {{"empty",     0, false},
+      {"sparse",    1, false},
+      {"half",     50, true },
+      {"dense",    99, true },
+      {"full",    100, true }
+     };
+
+template<typename F>
+double Measure(F f, int reps, long long &sink)
+{
+   auto beg = std::chrono::steady_clock::now();
+   for (int i = 0; i < reps; i++) sink += f();
+   auto end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(end - beg).count() * 1e6 / reps;
+}
+
+// The per-block implementations Info used before the word-based ones.
+//
+long long RefDownloaded(const Info &cfi)
+{
+   int cnt = 0;
+   for (int i = 0; i < cfi.GetNBlocks(); ++i) if (cfi.TestBitWritten(i)) cnt++;
+   return cnt;
+}
+
+long long RefLast(const Info &cfi)
+{
+   for (int i = cfi.GetNBlocks() - 1; i >= 0; --i)
+       if (cfi.TestBitWritten(i)) return i;
+   return -1;
+}
+
+long long RefFirstMissing(const Info &cfi)
+{
+   for (int i = 0; i < cfi.GetNBlocks(); ++i)
+       if ( ! cfi.TestBitWritten(i)) return i;
+   return -1;
+}
+}
+
+int main(int argc, char **argv)
+{
+   int nBlocks = (argc > 1 ? atoi(argv[1]) : 4*1024*1024);
+   int nFiles  = (argc > 2 ? atoi(argv[2]) : 8);
+   if (nBlocks <= 0 || nFiles <= 0)
+      {fprintf(stderr, "Usage: %s [<number of blocks> [<number of cinfo files>]]\n", argv[0]);
+       return 1;
+      }
+
+   XrdSysTrace  trace("bench");
+   std::mt19937 rng(4321);
+   long long    sink = 0;
+   const int    reps = 5;
+
+   printf("%d blocks per file, %d files per pattern; times in us per file\n",
+          nBlocks, nFiles);
+   printf("%-8s %-14s %10s %10s %8s\n", "pattern", "query", "per-block", "word", "speedup");
+
+   for (const Pattern &pat : patTab)
+       {std::vector<MemDF> files(nFiles);
+        for (MemDF &df : files)
+            {Info cfi(&trace);
+             cfi.SetBufferSizeFileSizeAndCreationTime(4096, 4096LL * nBlocks);
+             for (int i = 0; i < nBlocks - 1; i++)
+                 if ((int)(rng() % 100) < pat.density)
+                    {cfi.SetBitWritten(i); cfi.SetBitSynced(i);}
+             if (pat.lastBlock)
+                {cfi.SetBitWritten(nBlocks - 1); cfi.SetBitSynced(nBlocks - 1);}
+             if (!cfi.Write(&df, "bench.cinfo"))
+                {fprintf(stderr, "Writing synthetic cinfo file failed\n"); return 1;}
+            }
+
+        std::vector<Info*> infos;
+        auto beg = std::chrono::steady_clock::now();
+        for (MemDF &df : files)
+            {infos.push_back(new Info(&trace));
+             if (!infos.back()->Read(&df, "bench.cinfo"))
+                {fprintf(stderr, "Reading synthetic cinfo file failed\n"); return 1;}
+            }
+        auto end = std::chrono::steady_clock::now();
+        printf("%-8s %-14s %10s %10.1f\n", pat.name, "read", "",
+               std::chrono::duration<double>(end - beg).count() * 1e6 / nFiles);
+
+        struct Query
+              {const char *name;
+               long long (*ref)(const Info &);
+               long long (*word)(const Info &);
+              };
+        const Query qTab[] =
+              {{"n_downloaded", RefDownloaded,
+                [](const Info &c) -> long long {return c.GetNDownloadedBlocks();}},
+               {"last_block",   RefLast,
+                [](const Info &c) -> long long {return c.GetLastDownloadedBlock();}},
+               {"first_missing", RefFirstMissing,
+                [](const Info &c) -> long long {return c.GetFirstMissingBlock(0);}}
+              };
+
+        for (const Query &q : qTab)
+            {double tRef = 0, tWord = 0;
+             for (Info *cfi : infos)
+                 {if (q.ref(*cfi) != q.word(*cfi))
+                     {fprintf(stderr, "%s mismatch for pattern %s\n", q.name, pat.name);
+                      return 1;
+                     }
+                  tRef  += Measure([&]{return q.ref(*cfi);},  reps, sink);
+                  tWord += Measure([&]{return q.word(*cfi);}, reps, sink);
+                 }
+             printf("%-8s %-14s %10.1f %10.1f %7.1fx\n", pat.name, q.name,
+                    tRef / nFiles, tWord / nFiles, tWord > 0 ? tRef / tWord : 0.0);
+            }
+
+        for (Info *cfi : infos) delete cfi;
+       }
+
+   if (sink == 42) printf(" \n");
+   return 0;
+}
@@ -1,7 +1,10 @@
 #include "XrdPfc/XrdPfcPathParseTools.hh"
+#include "XrdPfc/XrdPfcBitmap.hh"
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 class PathParseToolTest : public ::testing::Test {
 protected:
     std::vector<std::string> dirs { "vultures", "nest", "quite", "high", "in", "a",
@@ -83,3 +86,63 @@ TEST_F(PathParseToolTest, PathTokenizer)
     }
     clear_path();
 }
+
+class BitmapTest : public ::testing::Test {
+protected:
+    static bool bit(const std::vector<unsigned char> &b, int i) { return b[i/8] & (1 << (i%8)); }
+
+    // Fill nbits worth of bytes; density in percent.
+    static std::vector<unsigned char> make(int nbits, int density, std::mt19937 &rng)
+    {
+        std::vector<unsigned char> b((nbits + 7) / 8, 0);
+        for (int i = 0; i < nbits; ++i)
+            if ((int) (rng() % 100) < density) b[i/8] |= 1 << (i%8);
+        return b;
+    }
+};
+
+TEST_F(BitmapTest, MatchesBitwiseScan)
+{
+    std::mt19937 rng(1234);
+    const int sizes[]     = { 1, 7, 8, 63, 64, 65, 130, 1000, 4099 };
+    const int densities[] = { 0, 1, 50, 99, 100 };
+
+    for (int nbits : sizes)
+    for (int dens : densities)
+    {
+        auto a = make(nbits, dens, rng);
+        auto b = make(nbits, 50, rng);
+
+        for (int t = 0; t < 20; ++t)
+        {
+            int first = rng() % (nbits + 1);
+            int last  = first + rng() % (nbits - first + 1);
+
+            int cnt = 0, andnot = 0, ffs = -1, ffc = -1, fls = -1;
+            for (int i = first; i < last; ++i)
+            {
+                if (bit(a, i)) { ++cnt; fls = i; if (ffs < 0) ffs = i; }
+                else if (ffc < 0) ffc = i;
+                if (bit(a, i) && ! bit(b, i)) ++andnot;
+            }
+
+            EXPECT_EQ(Bitmap::CountSet(a.data(), first, last), cnt);
+            EXPECT_EQ(Bitmap::CountAndNot(a.data(), b.data(), first, last), andnot);
+            EXPECT_EQ(Bitmap::FindFirstSet(a.data(), first, last), ffs);
+            EXPECT_EQ(Bitmap::FindFirstClear(a.data(), first, last), ffc);
+            EXPECT_EQ(Bitmap::FindLastSet(a.data(), first, last), fls);
+            EXPECT_EQ(Bitmap::TestRangeSet(a.data(), first, last), ffc < 0);
+
+            auto d = b;
+            Bitmap::AndNot(d.data(), a.data(), b.data(), first, last);
+            auto s = a;
+            Bitmap::SetRange(s.data(), first, last);
+            for (int i = 0; i < nbits; ++i)
+            {
+                bool in = i >= first && i < last;
+                ASSERT_EQ(bit(d, i), in ? (bit(a, i) && ! bit(b, i)) : bit(b, i));
+                ASSERT_EQ(bit(s, i), in || bit(a, i));
+            }
+        }
+    }
+}
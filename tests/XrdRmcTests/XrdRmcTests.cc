@@ -0,0 +1,252 @@
+#include "XrdOuc/XrdOucCache.hh"
+#include "XrdRmc/XrdRmc.hh"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const int PageSize = 4096;
+
+  // A file whose contents are computed from its id and the offset. It counts
+  // the reads that reach it, which are the reads the cache did not satisfy.
+  class MemIO : public XrdOucCacheIO
+  {
+    public:
+      MemIO( int id, long long size ) :
+        id( id ), size( size ), path( "/file" + std::to_string( id ) ),
+        reads( 0 ) {}
+
+      static char Byte( int id, long long offs )
+      {
+        return char( ( offs / 7 ) ^ ( offs >> 12 ) ^ ( id * 31 ) );
+      }
+
+      bool Check( const char *buff, long long offs, int len ) const
+      {
+        for( int i = 0; i < len; ++i )
+          if( buff[i] != Byte( id, offs + i ) ) return false;
+        return true;
+      }
+
+      bool Detach( XrdOucCacheIOCD &iocd ) { (void)iocd; return true; }
+
+      long long FSize() { return size; }
+
+      const char *Path() { return path.c_str(); }
+
+      using XrdOucCacheIO::Read;
+
+      int Read( char *buff, long long offs, int rlen )
+      {
+        reads++;
+        if( offs >= size ) return 0;
+        if( offs + rlen > size ) rlen = size - offs;
+        for( int i = 0; i < rlen; ++i ) buff[i] = Byte( id, offs + i );
+        return rlen;
+      }
+
+      int Sync() { return 0; }
+
+      int Trunc( long long offs ) { (void)offs; return -ENOTSUP; }
+
+      using XrdOucCacheIO::Write;
+
+      int Write( char *buff, long long offs, int wlen )
+      {
+        (void)buff; (void)offs; (void)wlen;
+        return -ENOTSUP;
+      }
+
+      const int              id;
+      const long long        size;
+      const std::string      path;
+      std::atomic<long long> reads;
+  };
+
+  class NoDetach : public XrdOucCacheIOCD
+  {
+    public:
+      void DetachDone() {}
+  };
+
+  XrdOucCache *MakeCache( int pages, int policy, int stream = 0 )
+  {
+    XrdRmc::Parms parms;
+    parms.CacheSize = (long long)pages * PageSize;
+    parms.PageSize  = PageSize;
+    parms.minPages  = 16;
+    parms.Policy    = policy;
+    parms.Stream    = stream;
+    return XrdRmc::Create( parms );
+  }
+
+  // Read the given pages one at a time through the cache
+  void ReadPages( XrdOucCacheIO *io, const std::vector<long long> &pages )
+  {
+    char buff[PageSize];
+    for( long long page : pages )
+      ASSERT_EQ( io->Read( buff, page * PageSize, PageSize ), PageSize );
+  }
+
+  std::vector<long long> Shuffled( long long first, long long count )
+  {
+    std::vector<long long> pages;
+    for( long long i = 0; i < count; ++i ) pages.push_back( first + i );
+    std::shuffle( pages.begin(), pages.end(), std::mt19937( 7 ) );
+    return pages;
+  }
+
+  // Read a working set of 128 pages and then scan 1200 pages of another file
+  // that are never read again, several times over, in a cache of 1024 pages.
+  // Returns how often the working set had to be read from the file in the
+  // last round.
+  long long WorkingSetMisses( XrdOucCache *cache, int scanRead )
+  {
+    MemIO hotFile( 1, 128 * PageSize ), scanFile( 2, 20000LL * PageSize );
+    XrdOucCacheIO *hot  = cache->Attach( &hotFile );
+    XrdOucCacheIO *scan = cache->Attach( &scanFile );
+    std::vector<char> buff( scanRead );
+    std::vector<long long> working = Shuffled( 0, 128 );
+    long long scanOffs = 0, before = 0;
+
+    for( int round = 0; round < 5; ++round )
+    {
+      before = hotFile.reads;
+      ReadPages( hot, working );
+      for( long long end = scanOffs + 1200LL * PageSize; scanOffs < end;
+           scanOffs += scanRead )
+      {
+        EXPECT_EQ( scan->Read( buff.data(), scanOffs, scanRead ), scanRead );
+        EXPECT_TRUE( scanFile.Check( buff.data(), scanOffs, scanRead ) );
+      }
+    }
+
+    NoDetach iocd;
+    EXPECT_TRUE( hot->Detach( iocd ) );
+    EXPECT_TRUE( scan->Detach( iocd ) );
+    return hotFile.reads - before;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Reads return the file contents no matter where they fall
+//------------------------------------------------------------------------------
+TEST( XrdRmcTest, ReadsAreCorrect )
+{
+  for( int policy : { XrdRmc::polLRU, XrdRmc::pol2Q } )
+  {
+    XrdOucCache *cache = MakeCache( 300, policy );
+    ASSERT_NE( cache, nullptr );
+    MemIO file1( 1, 1000 * PageSize + 123 ), file2( 2, 77777 );
+    XrdOucCacheIO *io1 = cache->Attach( &file1 );
+    XrdOucCacheIO *io2 = cache->Attach( &file2 );
+    std::mt19937 rng( 42 );
+    char buff[3 * PageSize];
+
+    for( int i = 0; i < 5000; ++i )
+    {
+      MemIO *file = ( i & 1 ? &file1 : &file2 );
+      XrdOucCacheIO *io = ( i & 1 ? io1 : io2 );
+      long long offs = rng() % file->size;
+      int len = 1 + rng() % PageSize;
+      int want = std::min<long long>( len, file->size - offs );
+      ASSERT_EQ( io->Read( buff, offs, len ), want );
+      ASSERT_TRUE( file->Check( buff, offs, want ) );
+    }
+
+    NoDetach iocd;
+    EXPECT_TRUE( io1->Detach( iocd ) );
+    EXPECT_TRUE( io2->Detach( iocd ) );
+    delete cache;
+  }
+}
+
+//------------------------------------------------------------------------------
+// A scan flushes the working set out of an LRU cache but not out of a 2Q one
+//------------------------------------------------------------------------------
+TEST( XrdRmcTest, ScanResistance )
+{
+  XrdOucCache *lru = MakeCache( 1024, XrdRmc::polLRU );
+  EXPECT_EQ( WorkingSetMisses( lru, PageSize ), 128 );
+  delete lru;
+
+  XrdOucCache *twoQ = MakeCache( 1024, XrdRmc::pol2Q );
+  EXPECT_EQ( WorkingSetMisses( twoQ, PageSize ), 0 );
+  delete twoQ;
+}
+
+//------------------------------------------------------------------------------
+// Streaming reads do not displace the working set even of an LRU cache,
+// whether they are shorter than a page or bypass the cache altogether.
+//------------------------------------------------------------------------------
+TEST( XrdRmcTest, StreamingAdmission )
+{
+  for( int scanRead : { 1000, PageSize, 16 * PageSize } )
+  {
+    XrdOucCache *cache = MakeCache( 1024, XrdRmc::polLRU, 64 * 1024 );
+    EXPECT_EQ( WorkingSetMisses( cache, scanRead ), 0 ) << scanRead;
+    delete cache;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Pages are loaded and replaced correctly when many threads share the cache
+//------------------------------------------------------------------------------
+TEST( XrdRmcTest, ConcurrentReads )
+{
+  for( int policy : { XrdRmc::polLRU, XrdRmc::pol2Q } )
+  {
+    XrdOucCache *cache = MakeCache( 2048, policy, 256 * 1024 );
+    MemIO shared( 0, 3000 * PageSize );
+    XrdOucCacheIO *sharedIO = cache->Attach( &shared, XrdOucCache::optFIS );
+    std::atomic<int> errors( 0 );
+    std::vector<std::thread> threads;
+
+    for( int t = 1; t <= 4; ++t )
+      threads.emplace_back( [&, t]() {
+        MemIO own( t, 2000 * PageSize + t );
+        XrdOucCacheIO *ownIO = cache->Attach( &own );
+        std::mt19937 rng( t );
+        std::vector<char> buff( 8 * PageSize );
+        long long seqOffs = 0;
+        for( int i = 0; i < 5000; ++i )
+        {
+          bool useShared = ( i % 3 == 0 );
+          MemIO *file = ( useShared ? &shared : &own );
+          XrdOucCacheIO *io = ( useShared ? sharedIO : ownIO );
+          long long offs;
+          int len;
+          if( !useShared && i % 3 == 1 )
+          {
+            offs = seqOffs;
+            len  = 1 + rng() % ( 2 * PageSize );
+            seqOffs = ( seqOffs + len ) % file->size;
+          }
+          else
+          {
+            offs = rng() % file->size;
+            len  = 1 + rng() % buff.size();
+          }
+          int want = std::min<long long>( len, file->size - offs );
+          if( io->Read( buff.data(), offs, len ) != want
+           || !file->Check( buff.data(), offs, want ) ) errors++;
+        }
+        NoDetach iocd;
+        if( !ownIO->Detach( iocd ) ) errors++;
+      } );
+
+    for( auto &thread : threads ) thread.join();
+    EXPECT_EQ( errors, 0 );
+    NoDetach iocd;
+    EXPECT_TRUE( sharedIO->Detach( iocd ) );
+    delete cache;
+  }
+}
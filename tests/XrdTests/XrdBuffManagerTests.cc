@@ -0,0 +1,176 @@
+#include "Xrd/XrdBuffer.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::string GetStats(XrdBuffManager &bman)
+{
+    char buff[2048];
+    bman.Stats(buff, sizeof(buff), 1);
+    return buff;
+}
+
+bool HasStat(const std::string &stats, const std::string &tag, long long val)
+{
+    return stats.find("<" + tag + ">" + std::to_string(val) + "</" + tag + ">")
+           != std::string::npos;
+}
+
+// The per-thread magazine binds to the first buffer manager a thread uses, so
+// each test runs its work in fresh threads and uses its own manager. Managers
+// are never deleted.
+//
+template<typename F>
+void RunInThread(F f)
+{
+    std::thread t(f);
+    t.join();
+}
+}
+
+TEST(BuffManagerTest, MagazineReuse)
+{
+    XrdBuffManager *bman = new XrdBuffManager();
+
+    RunInThread([bman]() {
+        XrdBuffer *bp = bman->Obtain(3000);
+        ASSERT_NE(bp, nullptr);
+        EXPECT_EQ(bp->bsize, 4096);
+        char *mem = bp->buff;
+        bman->Release(bp);
+
+        // The buffer just released comes right back from the magazine.
+        for (int i = 0; i < 99; ++i)
+        {
+            bp = bman->Obtain(4096);
+            ASSERT_NE(bp, nullptr);
+            EXPECT_EQ(bp->buff, mem);
+            bman->Release(bp);
+        }
+    });
+
+    // The magazine published its counts when the thread exited.
+    std::string stats = GetStats(*bman);
+    EXPECT_TRUE(HasStat(stats, "reqs",  100)) << stats;
+    EXPECT_TRUE(HasStat(stats, "lreqs", 100)) << stats;
+    EXPECT_TRUE(HasStat(stats, "lhits",  99)) << stats;
+    EXPECT_TRUE(HasStat(stats, "buffs",   1)) << stats;
+}
+
+TEST(BuffManagerTest, NoMagazine)
+{
+    XrdBuffManager *bman = new XrdBuffManager();
+    bman->SetOpts(0, 0);
+
+    RunInThread([bman]() {
+        for (int i = 0; i < 10; ++i) bman->Release(bman->Obtain(1024));
+    });
+
+    std::string stats = GetStats(*bman);
+    EXPECT_TRUE(HasStat(stats, "reqs",  10)) << stats;
+    EXPECT_TRUE(HasStat(stats, "lreqs",  0)) << stats;
+    EXPECT_TRUE(HasStat(stats, "buffs",  1)) << stats;
+}
+
+TEST(BuffManagerTest, MagazineLimit)
+{
+    XrdBuffManager *bman = new XrdBuffManager();
+    XrdSysSemaphore haveMag(0), done(0);
+
+    // An eighth of the memory is enough for one magazine (about 1MB) only.
+    bman->Set(12*1024*1024);
+
+    std::thread holder([bman, &haveMag, &done]() {
+        bman->Release(bman->Obtain(1024));
+        haveMag.Post();
+        done.Wait();
+    });
+    haveMag.Wait();
+
+    // While the first thread holds its magazine others go without one.
+    RunInThread([bman]() {
+        for (int i = 0; i < 10; ++i) bman->Release(bman->Obtain(1024));
+    });
+    std::string stats = GetStats(*bman);
+    EXPECT_TRUE(HasStat(stats, "reqs",  11)) << stats;
+
+    // Once it exits its memory may be used by another thread's magazine.
+    done.Post();
+    holder.join();
+    RunInThread([bman]() {
+        for (int i = 0; i < 10; ++i) bman->Release(bman->Obtain(1024));
+    });
+    stats = GetStats(*bman);
+    EXPECT_TRUE(HasStat(stats, "reqs",  21)) << stats;
+    EXPECT_TRUE(HasStat(stats, "lreqs", 11)) << stats;
+}
+
+TEST(BuffManagerTest, CrossThreadRelease)
+{
+    const int nThreads = 4, nBuffs = 500;
+    XrdBuffManager *bman = new XrdBuffManager();
+    std::vector<std::vector<XrdBuffer *>> buffs(nThreads);
+    std::vector<std::thread> threads;
+
+    // Each thread obtains buffers of all the sizes that have magazines and
+    // some that do not, and the buffers are released by another thread.
+    for (int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < nBuffs; ++i)
+            {
+                XrdBuffer *bp = bman->Obtain(1 + (i * 7919) % (2*1024*1024));
+                ASSERT_NE(bp, nullptr);
+                bp->buff[0] = static_cast<char>(t);
+                buffs[t].push_back(bp);
+            }
+        });
+    for (auto &t : threads) t.join();
+    threads.clear();
+
+    for (int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t]() {
+            for (XrdBuffer *bp : buffs[(t + 1) % nThreads]) bman->Release(bp);
+        });
+    for (auto &t : threads) t.join();
+
+    // Every buffer is back in the pool so this obtains no new memory.
+    std::string before = GetStats(*bman);
+    RunInThread([&]() {
+        for (int t = 0; t < nThreads; ++t)
+            for (XrdBuffer *bp : buffs[t])
+                bman->Release(bman->Obtain(bp->bsize));
+    });
+    std::string after = GetStats(*bman);
+
+    EXPECT_TRUE(HasStat(after, "reqs", 2 * nThreads * nBuffs)) << after;
+    EXPECT_EQ(before.substr(before.find("<mem>"), before.find("<adj>") - before.find("<mem>")),
+              after.substr(after.find("<mem>"), after.find("<adj>") - after.find("<mem>")));
+}
+
+TEST(BuffManagerTest, HugePages)
+{
+    XrdBuffManager *bman = new XrdBuffManager();
+    bman->SetOpts(-1, XrdBuffManager::useHuge | XrdBuffManager::useNuma);
+    bool haveHuge = access("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", R_OK) == 0;
+
+    RunInThread([bman, haveHuge]() {
+        XrdBuffer *bp = bman->Obtain(bman->MaxSize());
+        ASSERT_NE(bp, nullptr);
+        EXPECT_EQ(bp->bsize, bman->MaxSize());
+        if (haveHuge)
+        {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(bp->buff) % bman->MaxSize(), 0u);
+        }
+        bman->Release(bp);
+        EXPECT_EQ(bman->Obtain(bman->MaxSize()), bp);
+    });
+}
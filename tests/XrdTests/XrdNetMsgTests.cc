@@ -0,0 +1,118 @@
+#include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// A UDP socket on the loopback interface that collects every datagram sent
+// to it until no more arrive.
+//
+class UdpSink
+{
+public:
+    std::string Dest() { return "127.0.0.1:" + std::to_string(port); }
+
+    void Start() { reader = std::thread([this]() {
+                       struct pollfd pfd = {fd, POLLIN, 0};
+                       std::vector<char> buff(70000);
+                       while (poll(&pfd, 1, 1000) > 0)
+                       {
+                           ssize_t n = recv(fd, buff.data(), buff.size(), 0);
+                           if (n < 0) break;
+                           msgs.emplace_back(buff.data(), n);
+                       }
+                   }); }
+
+    std::vector<std::string> Finish() { reader.join(); return msgs; }
+
+    UdpSink() : fd(socket(AF_INET, SOCK_DGRAM, 0)), port(0)
+    {
+        struct sockaddr_in sa = {};
+        socklen_t slen = sizeof(sa);
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        EXPECT_GE(fd, 0);
+        EXPECT_EQ(bind(fd, (struct sockaddr *)&sa, sizeof(sa)), 0);
+        EXPECT_EQ(getsockname(fd, (struct sockaddr *)&sa, &slen), 0);
+        port = ntohs(sa.sin_port);
+    }
+   ~UdpSink() { if (reader.joinable()) reader.join(); close(fd); }
+
+    int                      fd;
+    int                      port;
+    std::thread              reader;
+    std::vector<std::string> msgs;
+};
+
+std::string MakeMsg(int i)
+{
+    return "msg " + std::to_string(i) + " " + std::string(i % 97, 'a' + i % 26);
+}
+}
+
+TEST(NetMsgTest, SendBatchDeliversAll)
+{
+    const int nMsgs = 200;   // More than fit into a single sendmmsg() call
+    XrdSysLogger logger;
+    XrdSysError  eDest(&logger, "NetMsgTest");
+    UdpSink sink;
+    bool aOK;
+
+    XrdNetMsg netMsg(&eDest, sink.Dest().c_str(), &aOK);
+    ASSERT_TRUE(aOK);
+
+    std::vector<std::string> data;
+    std::vector<struct iovec> iov(nMsgs);
+    for (int i = 0; i < nMsgs; ++i) data.push_back(MakeMsg(i));
+    for (int i = 0; i < nMsgs; ++i)
+        iov[i] = {const_cast<char *>(data[i].data()), data[i].size()};
+
+    sink.Start();
+    EXPECT_EQ(netMsg.SendBatch(iov.data(), nMsgs), 0);
+
+    std::vector<std::string> got = sink.Finish();
+    ASSERT_EQ(got.size(), data.size());
+    for (int i = 0; i < nMsgs; ++i) EXPECT_EQ(got[i], data[i]) << i;
+}
+
+TEST(NetMsgTest, SendBatchSkipsFailedMessage)
+{
+    const int nMsgs = 100, badMsg = 40;
+    XrdSysLogger logger;
+    XrdSysError  eDest(&logger, "NetMsgTest");
+    UdpSink sink;
+    bool aOK;
+
+    XrdNetMsg netMsg(&eDest, sink.Dest().c_str(), &aOK);
+    ASSERT_TRUE(aOK);
+
+    // A message too large for a datagram makes the batch stop short; the
+    // remaining messages must still be sent in a further call.
+    std::vector<std::string> data;
+    std::vector<struct iovec> iov(nMsgs);
+    for (int i = 0; i < nMsgs; ++i)
+        data.push_back(i == badMsg ? std::string(70000, 'x') : MakeMsg(i));
+    for (int i = 0; i < nMsgs; ++i)
+        iov[i] = {const_cast<char *>(data[i].data()), data[i].size()};
+
+    sink.Start();
+    EXPECT_LT(netMsg.SendBatch(iov.data(), nMsgs), 0);
+
+    std::vector<std::string> got = sink.Finish();
+    data.erase(data.begin() + badMsg);
+    ASSERT_EQ(got.size(), data.size());
+    for (size_t i = 0; i < data.size(); ++i) EXPECT_EQ(got[i], data[i]) << i;
+}
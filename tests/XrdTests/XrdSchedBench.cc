@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// Scalability benchmark for the XrdScheduler run queues.
+//
+// Usage: xrdsched-bench [<jobs per thread> [<max threads> [<queues>]]]
+//
+// For 1, 2, 4, ... up to the number of cpus threads scheduling work (standing
+// in for the pollers) each thread repeatedly schedules a round of small jobs
+// and waits for them to complete. The throughput in jobs per second is
+// reported for the single queue scheduler and for multiple run queues, by
+// default one per cpu.
+//------------------------------------------------------------------------------
+
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const int roundSize = 64;
+
+std::atomic<unsigned long> sink(0);
+
+class BenchJob : public XrdJob
+{
+public:
+
+void DoIt() override
+     {unsigned long v = 0;
+      for (int i = 0; i < 200; i++) v += i * (unsigned long)this;
+      sink += v;
+      if (--*pending == 0) done->Post();
+     }
+
+     BenchJob() : XrdJob(".bench"), pending(0), done(0) {}
+
+std::atomic<int> *pending;
+XrdSysSemaphore  *done;
+};
+
+double Measure(int nQueues, int nThreads, int nJobs)
+{
+   XrdScheduler *sched = new XrdScheduler(nThreads*2, 4096, 0);
+   std::vector<std::thread> threads;
+
+   sched->setQueues(nQueues);
+   sched->Start();
+
+   auto beg = std::chrono::steady_clock::now();
+   for (int t = 0; t < nThreads; t++)
+       threads.emplace_back([sched, nJobs]()
+          {std::vector<BenchJob> jobs(roundSize);
+           std::atomic<int> pending;
+           XrdSysSemaphore  done(0);
+           for (auto &j : jobs) {j.pending = &pending; j.done = &done;}
+           for (int n = 0; n < nJobs; n += roundSize)
+               {pending = roundSize;
+                for (auto &j : jobs) sched->Schedule(&j);
+                done.Wait();
+               }
+          });
+   for (auto &t : threads) t.join();
+   auto end = std::chrono::steady_clock::now();
+
+// The scheduler can't be deleted, its workers simply stay idle from now on.
+//
+   double secs = std::chrono::duration<double>(end - beg).count();
+   return (double)nThreads * ((nJobs + roundSize - 1) / roundSize) * roundSize / secs;
+}
+}
+
+int main(int argc, char **argv)
+{
+   int nJobs = (argc > 1 ? atoi(argv[1]) : 200000);
+   int nCpus = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+   int maxT  = (argc > 2 ? atoi(argv[2]) : nCpus);
+   int nQ    = (argc > 3 ? atoi(argv[3]) : (nCpus > 1 ? nCpus : 2));
+
+   if (nJobs <= 0 || maxT <= 0 || nQ < 2)
+      {fprintf(stderr, "Usage: %s [<jobs per thread> [<max threads> [<queues>]]]\n"
+                       "       At least 2 queues are needed.\n", argv[0]);
+       return 1;
+      }
+
+   printf("%d cpus, %d jobs per thread, %d queues; throughput in jobs/sec\n",
+          nCpus, nJobs, nQ);
+   printf("%8s %14s %14s %8s\n", "threads", "single queue", "multi queue", "speedup");
+
+   for (int t = 1; t <= maxT; t = (t < maxT && t*2 > maxT ? maxT : t*2))
+       {double one = Measure(0, t, nJobs);
+        double cpu = Measure(nQ, t, nJobs);
+        printf("%8d %14.0f %14.0f %7.2fx\n", t, one, cpu, cpu / one);
+        if (t == maxT) break;
+       }
+   return 0;
+}
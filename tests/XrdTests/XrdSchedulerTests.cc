@@ -0,0 +1,189 @@
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// A job that counts its executions and posts a semaphore after each one.
+//
+class CountJob : public XrdJob
+{
+public:
+    void DoIt() override { ++*runs; done->Post(); }
+
+    CountJob(std::atomic<int> *r, XrdSysSemaphore *d) : XrdJob("count"), runs(r), done(d) {}
+
+    std::atomic<int> *runs;
+    XrdSysSemaphore  *done;
+};
+
+// A job that signals it started and then waits to be let go.
+//
+class BlockJob : public XrdJob
+{
+public:
+    void DoIt() override { started.Post(); release.Wait(); }
+
+    BlockJob() : XrdJob("block") {}
+
+    XrdSysSemaphore started{0};
+    XrdSysSemaphore release{0};
+};
+
+std::string GetStats(XrdScheduler &sched)
+{
+    char buff[1024];
+    sched.Stats(buff, sizeof(buff), 1);
+    return buff;
+}
+}
+
+class SchedulerTest : public ::testing::TestWithParam<int>
+{
+protected:
+    // Schedulers are never deleted as their threads keep running.
+    XrdScheduler *sched = nullptr;
+
+    void SetUp() override
+    {
+        sched = new XrdScheduler(4, 64, 0);
+        sched->setQueues(GetParam());
+        sched->Start();
+    }
+};
+
+TEST_P(SchedulerTest, RunsAllJobs)
+{
+    const int nThreads = 4, nJobs = 2000;
+    std::atomic<int> runs(0);
+    XrdSysSemaphore  done(0);
+    std::vector<std::vector<CountJob>> jobs(nThreads);
+    std::vector<std::thread> threads;
+
+    for (auto &v : jobs) v.assign(nJobs, CountJob(&runs, &done));
+
+    // Every thread schedules its jobs singly, the even ones also as a batch.
+    for (int t = 0; t < nThreads; ++t)
+        threads.emplace_back([&, t]() {
+            std::vector<CountJob> &v = jobs[t];
+            if (t % 2)
+            {
+                for (auto &j : v) sched->Schedule(&j);
+            }
+            else
+            {
+                for (int i = 0; i < nJobs - 1; ++i) v[i].NextJob = &v[i+1];
+                sched->Schedule(nJobs, &v[0], &v[nJobs-1]);
+            }
+        });
+    for (auto &t : threads) t.join();
+
+    for (int i = 0; i < nThreads * nJobs; ++i) done.Wait();
+    EXPECT_EQ(runs.load(), nThreads * nJobs);
+
+    std::string stats = GetStats(*sched);
+    EXPECT_NE(stats.find("<jobs>" + std::to_string(nThreads * nJobs) + "</jobs>"),
+              std::string::npos) << stats;
+    EXPECT_NE(stats.find("<inq>0</inq>"), std::string::npos) << stats;
+}
+
+TEST_P(SchedulerTest, TimedJobs)
+{
+    std::atomic<int> runs(0);
+    XrdSysSemaphore  done(0);
+    CountJob now(&runs, &done), later(&runs, &done), never(&runs, &done);
+
+    sched->Schedule(&now, time(0));
+    sched->Schedule(&later, time(0) + 1);
+    sched->Schedule(&never, time(0) + 3600);
+    sched->Cancel(&never);
+
+    done.Wait();
+    done.Wait();
+    EXPECT_EQ(runs.load(), 2);
+}
+
+TEST_P(SchedulerTest, ActiveCountsBusyWorkers)
+{
+    BlockJob job;
+
+    sched->Schedule(&job);
+    job.started.Wait();
+    EXPECT_GE(sched->Active(), 1);
+    EXPECT_TRUE(sched->canStick());
+
+    // Once the job is done every worker goes idle again, run queues or not.
+    job.release.Post();
+    for (int i = 0; i < 500 && sched->Active() != 0; ++i) XrdSysTimer::Wait(10);
+    EXPECT_EQ(sched->Active(), 0);
+}
+
+TEST(SchedulerAffinityTest, PinnedQueues)
+{
+    XrdScheduler *sched = new XrdScheduler(4, 64, 0);
+    std::atomic<int> runs(0);
+    XrdSysSemaphore  done(0);
+    const int nJobs = 100;
+
+    sched->setQueues(2);
+    sched->setAffinity(2);
+    sched->Start();
+
+    // A pinned thread feeding run queue 1 gets all of its jobs run.
+    std::thread feeder([&]() {
+        std::vector<CountJob> jobs(nJobs, CountJob(&runs, &done));
+        sched->Affine(1);
+#ifdef __linux__
+        cpu_set_t cset;
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(cset), &cset), 0);
+        EXPECT_GE(CPU_COUNT(&cset), 1);
+#endif
+        for (auto &j : jobs) sched->Schedule(&j);
+        for (int i = 0; i < nJobs; ++i) done.Wait();
+    });
+    feeder.join();
+    EXPECT_EQ(runs.load(), nJobs);
+}
+
+TEST(SchedulerAffinityTest, PollerFollowsQueue)
+{
+    XrdScheduler *sched = new XrdScheduler(4, 64, 0);
+
+    // Four pollers feed two run queues; poller 3 feeds queue 1 and must run
+    // on the cpus of that queue's workers, i.e. the upper half of the cpus.
+    sched->setQueues(2);
+    sched->setAffinity(4);
+    sched->Start();
+
+#ifdef __linux__
+    cpu_set_t all, want, have;
+    int cpus[CPU_SETSIZE], n = 0;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(all), &all), 0);
+    for (int i = 0; i < CPU_SETSIZE; i++) if (CPU_ISSET(i, &all)) cpus[n++] = i;
+    int lo = n / 2, hi = n;
+    if (hi <= lo) {lo = 1 % n; hi = lo + 1;}
+    CPU_ZERO(&want);
+    for (int i = lo; i < hi; i++) CPU_SET(cpus[i], &want);
+
+    std::thread poller([&]() {
+        sched->Affine(3);
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(have), &have), 0);
+    });
+    poller.join();
+    EXPECT_TRUE(CPU_EQUAL(&have, &want));
+#endif
+}
+
+INSTANTIATE_TEST_SUITE_P(Queues, SchedulerTest, ::testing::Values(0, 4));
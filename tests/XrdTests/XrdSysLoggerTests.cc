@@ -0,0 +1,143 @@
+#include "XrdSys/XrdSysLogger.hh"
+
+#include <gtest/gtest.h>
+
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Drains the read end of a pipe into a string until all writers are gone.
+//
+class PipeReader
+{
+public:
+    void Start() { reader = std::thread([this]() {
+                       char buff[65536];
+                       ssize_t n;
+                       while ((n = read(fds[0], buff, sizeof(buff))) > 0) data.append(buff, n);
+                   }); }
+
+    std::string Finish() { close(fds[1]); reader.join(); close(fds[0]); return data; }
+
+    PipeReader() { EXPECT_EQ(pipe(fds), 0); }
+
+    int         fds[2];
+    std::string data;
+    std::thread reader;
+};
+
+void PutMsg(XrdSysLogger &logger, const std::string &msg)
+{
+    struct iovec iov[3] = {{0, 0},
+                           {const_cast<char *>(msg.data()), msg.size()},
+                           {const_cast<char *>("\n"), 1}};
+    logger.Put(3, iov);
+}
+}
+
+TEST(SysLoggerTest, AsyncKeepsAllMessages)
+{
+    const int nThreads = 4, nMsgs = 2000;
+    const std::string longTail(1000, 'x');
+    PipeReader pr;
+    pr.Start();
+
+    {
+        XrdSysLogger logger(pr.fds[1], 0);
+        ASSERT_TRUE(logger.setAsync(64, XrdSysLogger::asyncBlock));
+
+        // Every tenth message is too long to fit into a queue slot.
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nThreads; ++t)
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < nMsgs; ++i)
+                    PutMsg(logger, "t" + std::to_string(t) + " m" + std::to_string(i)
+                                   + (i % 10 ? "" : " " + longTail));
+            });
+        for (auto &t : threads) t.join();
+        logger.Flush();
+        EXPECT_EQ(logger.Dropped(), 0);
+    }
+
+    // Each line is whole and the messages of every thread are in order.
+    std::string out = pr.Finish();
+    std::vector<int> next(nThreads, 0);
+    size_t beg = 0, end;
+    while ((end = out.find('\n', beg)) != std::string::npos)
+    {
+        std::string line = out.substr(beg, end - beg);
+        beg = end + 1;
+        int t, i;
+        size_t pos = line.find(" t");
+        ASSERT_NE(pos, std::string::npos) << line;
+        ASSERT_EQ(sscanf(line.c_str() + pos, " t%d m%d", &t, &i), 2) << line;
+        ASSERT_TRUE(t >= 0 && t < nThreads) << line;
+        EXPECT_EQ(i, next[t]) << line;
+        EXPECT_EQ(line.size() - pos > longTail.size(), i % 10 == 0) << line;
+        next[t] = i + 1;
+    }
+    for (int t = 0; t < nThreads; ++t) EXPECT_EQ(next[t], nMsgs);
+}
+
+TEST(SysLoggerTest, AsyncDropsWhenFull)
+{
+    const std::string msg(4000, 'd');
+    PipeReader pr;
+    long long dropped;
+
+    {
+        XrdSysLogger logger(pr.fds[1], 0);
+        ASSERT_TRUE(logger.setAsync(16, XrdSysLogger::asyncDrop));
+
+        // Nobody reads the pipe yet so the writer stalls and the queue fills.
+        for (int i = 0; i < 200; ++i) PutMsg(logger, msg);
+        dropped = logger.Dropped();
+        EXPECT_GT(dropped, 0);
+
+        // The drop report goes out at the latest with the next message.
+        pr.Start();
+        logger.Flush();
+        PutMsg(logger, "last");
+        logger.Flush();
+        EXPECT_EQ(logger.Dropped(), dropped);
+    }
+
+    std::string out = pr.Finish();
+    EXPECT_NE(out.find("Logger dropped"), std::string::npos);
+    EXPECT_NE(out.find(" last\n"), std::string::npos);
+}
+
+TEST(SysLoggerTest, AsyncWritesQueuedAtExit)
+{
+    const int nMsgs = 500;
+    PipeReader pr;
+    pr.Start();
+
+    // The child queues messages and exits at once; exit() must write them.
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (!pid)
+    {
+        XrdSysLogger *logger = new XrdSysLogger(pr.fds[1], 0);
+        if (!logger->setAsync(1024, XrdSysLogger::asyncBlock)) _exit(2);
+        for (int i = 0; i < nMsgs; ++i) PutMsg(*logger, "m" + std::to_string(i));
+        exit(0);
+    }
+
+    int status;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    std::string out = pr.Finish();
+    for (int i = 0; i < nMsgs; ++i)
+        EXPECT_NE(out.find(" m" + std::to_string(i) + "\n"), std::string::npos) << i;
+}